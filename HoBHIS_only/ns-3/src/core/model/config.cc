@@ -25,8 +25,11 @@
 #include "names.h"
 #include "pointer.h"
 #include "log.h"
+#include "simple-ref-count.h"
 
 #include <sstream>
+#include <algorithm>
+#include <map>
 
 NS_LOG_COMPONENT_DEFINE ("Config");
 
@@ -133,78 +136,115 @@ class ArrayMatcher
 public:
   ArrayMatcher (std::string element);
   bool Matches (uint32_t i) const;
+  /**
+   * \brief Check if only explicitly listed indexes (or ranges of indexes) are matched
+   */
+  bool IsBounded (void) const;
+  /**
+   * \brief Get sorted non-overlapping ranges of matched indexes (only if IsBounded)
+   */
+  const std::vector<std::pair<uint32_t, uint32_t> > &GetRanges (void) const;
 private:
+  void Parse (std::string element);
   bool StringToUint32 (std::string str, uint32_t *value) const;
   std::string m_element;
+  bool m_any;
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 };
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_any (false)
 {
+  // the element is parsed only once, while it can be matched against many indexes
+  Parse (element);
+
+  std::sort (m_ranges.begin (), m_ranges.end ());
+  std::vector<std::pair<uint32_t, uint32_t> > merged;
+  for (uint32_t i = 0; i < m_ranges.size (); i++)
+    {
+      if (!merged.empty () && m_ranges[i].first <= merged.back ().second)
+        {
+          merged.back ().second = std::max (merged.back ().second, m_ranges[i].second);
+        }
+      else
+        {
+          merged.push_back (m_ranges[i]);
+        }
+    }
+  m_ranges.swap (merged);
 }
-bool
-ArrayMatcher::Matches (uint32_t i) const
+void
+ArrayMatcher::Parse (std::string element)
 {
-  if (m_element == "*")
+  if (element == "*")
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches *");
-      return true;
+      m_any = true;
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp-0);
-      std::string right = m_element.substr (tmp+1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
-      return false;
+      Parse (element.substr (0, tmp-0));
+      Parse (element.substr (tmp+1, element.size () - (tmp + 1)));
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1 &&
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1 &&
       dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min) && 
           StringToUint32 (upperBound, &max) &&
-          i >= min && i <= max)
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
-          return true;
-        }
-      else
+          min <= max)
         {
-          NS_LOG_DEBUG ("Array "<<i<<" does not "<<m_element);
-          return false;
+          m_ranges.push_back (std::make_pair (min, max));
         }
+      return;
     }
   uint32_t value;
-  if (StringToUint32 (m_element, &value) &&
-      i == value)
+  if (StringToUint32 (element, &value))
+    {
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+bool
+ArrayMatcher::Matches (uint32_t i) const
+{
+  if (m_any)
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
+      NS_LOG_DEBUG ("Array "<<i<<" matches *");
       return true;
     }
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator range = m_ranges.begin ();
+       range != m_ranges.end (); range++)
+    {
+      if (i >= range->first && i <= range->second)
+        {
+          NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
+          return true;
+        }
+    }
   NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
   return false;
 }
+bool
+ArrayMatcher::IsBounded (void) const
+{
+  return !m_any;
+}
+const std::vector<std::pair<uint32_t, uint32_t> > &
+ArrayMatcher::GetRanges (void) const
+{
+  return m_ranges;
+}
 
 bool
 ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
@@ -216,54 +256,100 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
 }
 
 
+/**
+ * \brief One element of a compiled path
+ */
+struct PathItem
+{
+  PathItem (const std::string &item)
+    : name (item),
+      isGetObject (item.find ("$") == 0),
+      hasTid (false),
+      matcher (item)
+  {
+    if (isGetObject)
+      {
+        // type can be registered later, then it is looked up during the resolution
+        hasTid = TypeId::LookupByNameFailSafe (item.substr (1, item.size () - 1), &tid);
+      }
+  }
+
+  std::string name;
+  bool isGetObject;  ///< \brief the item is "$TypeId" (GetObject call)
+  bool hasTid;
+  TypeId tid;
+  ArrayMatcher matcher;  ///< \brief used if the item refers to an element of an object vector
+};
+
+/**
+ * \brief Path split into items, each parsed only once
+ */
+class CompiledPath : public SimpleRefCount<CompiledPath>
+{
+public:
+  CompiledPath (std::string path);
+
+  std::vector<PathItem> m_items;
+};
+
+CompiledPath::CompiledPath (std::string path)
+{
+  // ensure that we start and end with a '/'
+  std::string::size_type tmp = path.find ("/");
+  if (tmp != 0)
+    {
+      // no slash at start
+      path = "/" + path;
+    }
+  tmp = path.find_last_of ("/");
+  if (tmp != (path.size () - 1))
+    {
+      // no slash at end
+      path = path + "/";
+    }
+
+  // every item is between two slashes
+  std::string::size_type cur = 0;
+  std::string::size_type next = path.find ("/", cur + 1);
+  while (next != std::string::npos)
+    {
+      m_items.push_back (PathItem (path.substr (cur + 1, next - (cur + 1))));
+      cur = next;
+      next = path.find ("/", cur + 1);
+    }
+}
+
+
 class Resolver
 {
 public:
-  Resolver (std::string path);
+  Resolver (Ptr<const CompiledPath> path);
   virtual ~Resolver ();
 
   void Resolve (Ptr<Object> root);
 private:
-  void Canonicalize (void);
-  void DoResolve (std::string path, Ptr<Object> root);
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoResolve (uint32_t item, Ptr<Object> root);
+  void DoArrayResolve (uint32_t item, const ObjectPtrContainerValue &vector);
+  bool DoArrayResolveBounded (uint32_t item, Ptr<Object> root, const ObjectPtrContainerAccessor *accessor);
   void DoResolveOne (Ptr<Object> object);
   std::string GetResolvedPath (void) const;
   virtual void DoOne (Ptr<Object> object, std::string path) = 0;
   std::vector<std::string> m_workStack;
-  std::string m_path;
+  Ptr<const CompiledPath> m_path;
 };
 
-Resolver::Resolver (std::string path)
+Resolver::Resolver (Ptr<const CompiledPath> path)
   : m_path (path)
 {
-  Canonicalize ();
 }
 Resolver::~Resolver ()
 {
 }
-void
-Resolver::Canonicalize (void)
-{
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
-    {
-      // no slash at start
-      m_path = "/" + m_path;
-    }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
-    {
-      // no slash at end
-      m_path = m_path + "/";
-    }
-}
 
 void 
 Resolver::Resolve (Ptr<Object> root)
 {
-  DoResolve (m_path, root);
+  DoResolve (0, root);
 }
 
 std::string
@@ -285,13 +371,11 @@ Resolver::DoResolveOne (Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (uint32_t itemIndex, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (itemIndex << root);
 
-  if (next == std::string::npos)
+  if (itemIndex >= m_path->m_items.size ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name 
@@ -307,8 +391,8 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  const PathItem &pathItem = m_path->m_items[itemIndex];
+  const std::string &item = pathItem.name;
 
   //
   // If root is zero, we're beginning to see if we can use the object name 
@@ -319,11 +403,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (itemIndex + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -340,7 +423,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (itemIndex + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -356,13 +439,12 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       return;
     }
-  std::string::size_type dollarPos = item.find ("$");
-  if (dollarPos == 0)
+  if (pathItem.isGetObject)
     {
       // This is a call to GetObject
       std::string tidString = item.substr (1, item.size () - 1);
       NS_LOG_DEBUG ("GetObject="<<tidString<<" on path="<<GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
+      TypeId tid = pathItem.hasTid ? pathItem.tid : TypeId::LookupByName (tidString);
       Ptr<Object> object = root->GetObject<Object> (tid);
       if (object == 0)
         {
@@ -370,67 +452,82 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (itemIndex + 1, object);
       m_workStack.pop_back ();
     }
   else 
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
-      bool foundMatch = false;
-      
-      do
+      std::vector<struct TypeId::AttributeInformation> attributes;
+      if (item == "*")
         {
-          tid = nextTid;
-          
-          for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+          TypeId tid;
+          TypeId nextTid = root->GetInstanceTypeId ();
+          do
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute(i);
-              if (info.name != item && item != "*")
+              tid = nextTid;
+              for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
                 {
-                  continue;
+                  attributes.push_back (tid.GetAttribute (i));
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *ptr = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (ptr != 0)
+              nextTid = tid.GetParent ();
+            } while (nextTid != tid);
+        }
+      else
+        {
+          // attribute names are unique within the inheritance tree
+          struct TypeId::AttributeInformation info;
+          if (root->GetInstanceTypeId ().LookupAttributeByName (item, &info))
+            {
+              attributes.push_back (info);
+            }
+        }
+
+      bool foundMatch = false;
+      for (std::vector<struct TypeId::AttributeInformation>::const_iterator info = attributes.begin ();
+           info != attributes.end (); info++)
+        {
+          // attempt to cast to a pointer checker.
+          const PointerChecker *ptr = dynamic_cast<const PointerChecker *> (PeekPointer (info->checker));
+          if (ptr != 0)
+            {
+              NS_LOG_DEBUG ("GetAttribute(ptr)="<<info->name<<" on path="<<GetResolvedPath ());
+              PointerValue ptr;
+              root->GetAttribute (info->name, ptr);
+              Ptr<Object> object = ptr.Get<Object> ();
+              if (object == 0)
                 {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)="<<info.name<<" on path="<<GetResolvedPath ());
-                  PointerValue ptr;
-                  root->GetAttribute (info.name, ptr);
-                  Ptr<Object> object = ptr.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\""<<item<<
-                                    "\" exists on path=\""<<GetResolvedPath ()<<"\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
+                  NS_LOG_ERROR ("Requested object name=\""<<item<<
+                                "\" exists on path=\""<<GetResolvedPath ()<<"\""
+                                " but is null.");
+                  continue;
                 }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker = 
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
+              foundMatch = true;
+              m_workStack.push_back (info->name);
+              DoResolve (itemIndex + 1, object);
+              m_workStack.pop_back ();
+            }
+          // attempt to cast to an object vector.
+          const ObjectPtrContainerChecker *vectorChecker = 
+            dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info->checker));
+          if (vectorChecker != 0)
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)="<<info->name<<" on path="<<GetResolvedPath ());
+              foundMatch = true;
+              m_workStack.push_back (info->name);
+              const ObjectPtrContainerAccessor *accessor =
+                dynamic_cast<const ObjectPtrContainerAccessor *> (PeekPointer (info->accessor));
+              if (!DoArrayResolveBounded (itemIndex + 1, root, accessor))
                 {
-                  NS_LOG_DEBUG ("GetAttribute(vector)="<<info.name<<" on path="<<GetResolvedPath () << pathLeft);
-                  foundMatch = true;
                   ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
+                  root->GetAttribute (info->name, vector);
+                  DoArrayResolve (itemIndex + 1, vector);
                 }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              m_workStack.pop_back ();
             }
-
-          nextTid = tid.GetParent ();
-        } while (nextTid != tid);
+          // this could be anything else and we don't know what to do with it.
+          // So, we just ignore it.
+        }
       
       if (!foundMatch)
         {
@@ -440,21 +537,71 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     }
 }
 
+bool
+Resolver::DoArrayResolveBounded (uint32_t itemIndex, Ptr<Object> root, const ObjectPtrContainerAccessor *accessor)
+{
+  NS_LOG_FUNCTION (this << itemIndex);
+  if (itemIndex >= m_path->m_items.size ())
+    {
+      // path ends with the container, nothing to resolve
+      return true;
+    }
+  const ArrayMatcher &matcher = m_path->m_items[itemIndex].matcher;
+  uint32_t n;
+  if (accessor == 0 || !matcher.IsBounded () || !accessor->GetN (PeekPointer (root), &n))
+    {
+      return false;
+    }
+
+  // Get only the matched items (e.g., a single node of the NodeList), instead of all
+  // items of the container.  This is possible only if indexes of the items are equal
+  // to their positions, which is checked before resolving the rest of the path.
+  // Containers keyed otherwise (e.g., an ObjectMap with non-contiguous keys) may hold
+  // a requested index beyond the last position or at another position, so they are
+  // left to DoArrayResolve, which matches the indexes themselves.
+  std::vector<Ptr<Object> > objects;
+  std::vector<uint32_t> indexes;
+  const std::vector<std::pair<uint32_t, uint32_t> > &ranges = matcher.GetRanges ();
+  for (uint32_t range = 0; range < ranges.size (); range++)
+    {
+      if (ranges[range].second >= n)
+        {
+          return false;
+        }
+      for (uint32_t i = ranges[range].first; i <= ranges[range].second; i++)
+        {
+          uint32_t index;
+          Ptr<Object> object = accessor->Get (PeekPointer (root), i, &index);
+          if (index != i)
+            {
+              return false;
+            }
+          objects.push_back (object);
+          indexes.push_back (index);
+        }
+    }
+
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      std::ostringstream oss;
+      oss << indexes[i];
+      m_workStack.push_back (oss.str ());
+      DoResolve (itemIndex + 1, objects[i]);
+      m_workStack.pop_back ();
+    }
+  return true;
+}
+
 void 
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (uint32_t itemIndex, const ObjectPtrContainerValue &container)
 {
-  NS_LOG_FUNCTION(this << path);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION(this << itemIndex);
+  if (itemIndex >= m_path->m_items.size ())
     {
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
+  const ArrayMatcher &matcher = m_path->m_items[itemIndex].matcher;
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
@@ -463,7 +610,7 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
           std::ostringstream oss;
           oss << (*it).first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (itemIndex + 1, (*it).second);
           m_workStack.pop_back ();
         }
     }
@@ -478,6 +625,7 @@ public:
   void Connect (std::string path, const CallbackBase &cb);
   void DisconnectWithoutContext (std::string path, const CallbackBase &cb);
   void Disconnect (std::string path, const CallbackBase &cb);
+  void ConnectAll (const std::vector<std::string> &paths, const std::vector<CallbackBase> &cbs, bool withContext);
   Config::MatchContainer LookupMatches (std::string path);
 
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -488,10 +636,36 @@ public:
 
 private:
   void ParsePath (std::string path, std::string *root, std::string *leaf) const;
+  Ptr<const CompiledPath> Compile (const std::string &path);
+
   typedef std::vector<Ptr<Object> > Roots;
   Roots m_roots;
+
+  typedef std::map<std::string, Ptr<const CompiledPath> > CompiledPaths;
+  CompiledPaths m_compiledPaths;
 };
 
+// paths usually differ only by node number, so there is no point to cache too many of them
+#define COMPILED_PATHS_CACHE_SIZE 1024
+
+Ptr<const CompiledPath>
+ConfigImpl::Compile (const std::string &path)
+{
+  CompiledPaths::const_iterator compiled = m_compiledPaths.find (path);
+  if (compiled != m_compiledPaths.end ())
+    {
+      return compiled->second;
+    }
+
+  if (m_compiledPaths.size () >= COMPILED_PATHS_CACHE_SIZE)
+    {
+      m_compiledPaths.clear ();
+    }
+  Ptr<const CompiledPath> program = Create<CompiledPath> (path);
+  m_compiledPaths[path] = program;
+  return program;
+}
+
 void 
 ConfigImpl::ParsePath (std::string path, std::string *root, std::string *leaf) const
 {
@@ -543,6 +717,34 @@ ConfigImpl::Disconnect (std::string path, const CallbackBase &cb)
   container.Disconnect (leaf, cb);
 }
 
+void
+ConfigImpl::ConnectAll (const std::vector<std::string> &paths, const std::vector<CallbackBase> &cbs, bool withContext)
+{
+  NS_ASSERT (paths.size () == cbs.size ());
+
+  // objects are looked up only once for all trace sources with the same path
+  std::map<std::string, Config::MatchContainer> containers;
+  for (uint32_t i = 0; i < paths.size (); i++)
+    {
+      std::string root, leaf;
+      ParsePath (paths[i], &root, &leaf);
+      std::map<std::string, Config::MatchContainer>::iterator container = containers.find (root);
+      if (container == containers.end ())
+        {
+          container = containers.insert (std::make_pair (root, LookupMatches (root))).first;
+        }
+
+      if (withContext)
+        {
+          container->second.Connect (leaf, cbs[i]);
+        }
+      else
+        {
+          container->second.ConnectWithoutContext (leaf, cbs[i]);
+        }
+    }
+}
+
 Config::MatchContainer 
 ConfigImpl::LookupMatches (std::string path)
 {
@@ -550,7 +752,7 @@ ConfigImpl::LookupMatches (std::string path)
   class LookupMatchesResolver : public Resolver 
   {
   public:
-    LookupMatchesResolver (std::string path)
+    LookupMatchesResolver (Ptr<const CompiledPath> path)
       : Resolver (path)
     {}
     virtual void DoOne (Ptr<Object> object, std::string path) {
@@ -559,7 +761,7 @@ ConfigImpl::LookupMatches (std::string path)
     }
     std::vector<Ptr<Object> > m_objects;
     std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+  } resolver = LookupMatchesResolver (Compile (path));
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -694,6 +896,16 @@ Disconnect (std::string path, const CallbackBase &cb)
 {
   Singleton<ConfigImpl>::Get ()->Disconnect (path, cb);
 }
+void
+ConnectAll (const std::vector<std::string> &paths, const std::vector<CallbackBase> &cbs)
+{
+  Singleton<ConfigImpl>::Get ()->ConnectAll (paths, cbs, true);
+}
+void
+ConnectAllWithoutContext (const std::vector<std::string> &paths, const std::vector<CallbackBase> &cbs)
+{
+  Singleton<ConfigImpl>::Get ()->ConnectAll (paths, cbs, false);
+}
 Config::MatchContainer LookupMatches (std::string path)
 {
   return Singleton<ConfigImpl>::Get ()->LookupMatches (path);
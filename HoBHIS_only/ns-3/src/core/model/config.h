@@ -21,6 +21,7 @@
 #define CONFIG_H
 
 #include "ptr.h"
+#include "callback.h"
 #include <string>
 #include <vector>
 
@@ -116,6 +117,26 @@ void Connect (std::string path, const CallbackBase &cb);
  * This function undoes the work of Config::ConnectWithContext.
  */
 void Disconnect (std::string path, const CallbackBase &cb);
+/**
+ * \param paths paths to match trace sources.
+ * \param cbs the callbacks to connect to the trace sources matching the
+ *        corresponding paths (one callback per path).
+ *
+ * This function is equivalent to calling Config::Connect for every path,
+ * but objects are looked up only once for all paths which differ only by the
+ * name of the trace source.
+ */
+void ConnectAll (const std::vector<std::string> &paths, const std::vector<CallbackBase> &cbs);
+/**
+ * \param paths paths to match trace sources.
+ * \param cbs the callbacks to connect to the trace sources matching the
+ *        corresponding paths (one callback per path).
+ *
+ * This function is equivalent to calling Config::ConnectWithoutContext for
+ * every path, but objects are looked up only once for all paths which differ
+ * only by the name of the trace source.
+ */
+void ConnectAllWithoutContext (const std::vector<std::string> &paths, const std::vector<CallbackBase> &cbs);
 
 /**
  * \brief hold a set of objects which match a specific search string.
@@ -27,6 +27,7 @@
 #include "pointer.h"
 #include "assert.h"
 #include "log.h"
+#include "profiler.h"
 
 #include <cmath>
 
@@ -135,7 +136,10 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  {
+    ProfilerScope scope (Profiler::GetEventStage (), m_currentContext);
+    next.impl->Invoke ();
+  }
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
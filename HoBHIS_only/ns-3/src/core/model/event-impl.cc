@@ -19,15 +19,118 @@
  */
 
 #include "event-impl.h"
+#include "thread-exit.h"
+
+#include <new>
 
 namespace ns3 {
 
+// events up to 256 bytes (in practice, all events created by MakeEvent) are pooled
+static const std::size_t POOL_GRANULARITY = 16;
+static const std::size_t POOL_CLASSES = 16;
+// the number of free blocks kept by a thread in every size class
+static const uint32_t POOL_MAX_FREE = 65536;
+
+struct EventFreeBlock
+{
+  EventFreeBlock *m_next;
+};
+
+struct EventFreeList
+{
+  EventFreeBlock *m_head;
+  uint32_t m_size;
+};
+
+// free lists of the current thread ("initial-exec" avoids a call to __tls_get_addr on
+// every access from the shared library)
+static __thread EventFreeList g_eventFreeLists[POOL_CLASSES] __attribute__ ((tls_model ("initial-exec")));
+static __thread bool g_eventFreeListsAtExit __attribute__ ((tls_model ("initial-exec"))) = false;
+static bool g_eventFreeListsDestroyed = false;
+
+static void
+ReleaseEventFreeLists (void)
+{
+  for (std::size_t sizeClass = 0; sizeClass < POOL_CLASSES; sizeClass++)
+    {
+      EventFreeList &list = g_eventFreeLists[sizeClass];
+      while (list.m_head != 0)
+        {
+          EventFreeBlock *block = list.m_head;
+          list.m_head = block->m_next;
+          ::operator delete (block);
+        }
+      list.m_size = 0;
+    }
+}
+
+// releases the free lists of the main thread
+static struct EventFreeListsDestructor
+{
+  ~EventFreeListsDestructor ()
+  {
+    ReleaseEventFreeLists ();
+    g_eventFreeListsDestroyed = true;
+  }
+} g_eventFreeListsDestructor;
+
+void*
+EventImpl::operator new (std::size_t size)
+{
+  std::size_t sizeClass = (size - 1) / POOL_GRANULARITY;
+  if (sizeClass >= POOL_CLASSES)
+    {
+      return ::operator new (size);
+    }
+
+  EventFreeList &list = g_eventFreeLists[sizeClass];
+  if (list.m_head == 0)
+    {
+      return ::operator new ((sizeClass + 1) * POOL_GRANULARITY);
+    }
+  EventFreeBlock *block = list.m_head;
+  list.m_head = block->m_next;
+  list.m_size--;
+  return block;
+}
+
+void
+EventImpl::operator delete (void *ptr, std::size_t size)
+{
+  if (ptr == 0)
+    {
+      return;
+    }
+
+  std::size_t sizeClass = (size - 1) / POOL_GRANULARITY;
+  if (sizeClass >= POOL_CLASSES || g_eventFreeLists[sizeClass].m_size >= POOL_MAX_FREE ||
+      g_eventFreeListsDestroyed)
+    {
+      ::operator delete (ptr);
+      return;
+    }
+
+  if (!g_eventFreeListsAtExit)
+    {
+      // the lists of a worker thread are released when it exits
+      g_eventFreeListsAtExit = true;
+      AtThreadExit (&ReleaseEventFreeLists);
+    }
+
+  EventFreeList &list = g_eventFreeLists[sizeClass];
+  EventFreeBlock *block = static_cast<EventFreeBlock *> (ptr);
+  block->m_next = list.m_head;
+  list.m_head = block;
+  list.m_size++;
+}
+
 EventImpl::~EventImpl ()
 {
 }
 
 EventImpl::EventImpl ()
-  : m_cancel (false)
+  : m_schedulerIndex (0),
+    m_cancel (false)
 {
 }
 
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 namespace ns3 {
@@ -58,13 +59,54 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * \returns the position of this event in the event list, as set by the scheduler
+   *
+   * Schedulers which support fast removal of events (e.g., IndexedHeapScheduler)
+   * use this value to find the event without searching the event list.
+   */
+  uint32_t GetSchedulerIndex (void) const;
+  /**
+   * \param index the position of this event in the event list
+   */
+  void SetSchedulerIndex (uint32_t index);
+
+  /**
+   * \brief Allocate memory for an event
+   *
+   * An event is created and destroyed for every scheduled call, so memory of
+   * destroyed events is not returned to the system allocator.  Instead, it is kept
+   * in free lists of the thread that destroyed the event (one list per size class)
+   * and is reused for the next event of the same size created by that thread.
+   * Events can be created and destroyed in different threads (e.g., when
+   * Simulator::ScheduleWithContext is called from another thread).
+   */
+  static void* operator new (std::size_t size);
+  /**
+   * \brief Release memory of an event (put it to the free list of the current thread)
+   */
+  static void operator delete (void *ptr, std::size_t size);
+
 protected:
   virtual void Notify (void) = 0;
 
 private:
+  uint32_t m_schedulerIndex;
   bool m_cancel;
 };
 
+inline uint32_t
+EventImpl::GetSchedulerIndex (void) const
+{
+  return m_schedulerIndex;
+}
+
+inline void
+EventImpl::SetSchedulerIndex (uint32_t index)
+{
+  m_schedulerIndex = index;
+}
+
 } // namespace ns3
 
 #endif /* EVENT_IMPL_H */
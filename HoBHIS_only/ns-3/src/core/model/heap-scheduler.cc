@@ -209,6 +209,14 @@ HeapScheduler::Remove (const Event &ev)
           NS_ASSERT (m_heap[i].impl == ev.impl);
           Exch (i, Last ());
           m_heap.pop_back ();
+          // the last event, moved in place of the removed one, can be
+          // smaller than its new parent as well as larger than its children
+          while (!IsBottom (i) && !IsRoot (i)
+                 && IsLessStrictly (i, Parent (i)))
+            {
+              Exch (i, Parent (i));
+              i = Parent (i);
+            }
           TopDown (i);
           return;
         }
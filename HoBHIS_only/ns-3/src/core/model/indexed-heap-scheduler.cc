@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "indexed-heap-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "fatal-error.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+NS_LOG_COMPONENT_DEFINE ("IndexedHeapScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (IndexedHeapScheduler);
+
+const uint32_t IndexedHeapScheduler::Arity;
+const uint32_t IndexedHeapScheduler::Root;
+
+static const uint32_t CacheLineSize = 64;
+
+TypeId
+IndexedHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::IndexedHeapScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<IndexedHeapScheduler> ()
+  ;
+  return tid;
+}
+
+IndexedHeapScheduler::IndexedHeapScheduler ()
+  : m_keys (0),
+    m_end (Root),
+    m_capacity (0)
+{
+  Grow ();
+}
+
+IndexedHeapScheduler::~IndexedHeapScheduler ()
+{
+  std::free (m_keys);
+}
+
+uint32_t
+IndexedHeapScheduler::Parent (uint32_t id) const
+{
+  return id / Arity + Arity - 2;
+}
+
+uint32_t
+IndexedHeapScheduler::FirstChild (uint32_t id) const
+{
+  return Arity * (id - Arity + 2);
+}
+
+void
+IndexedHeapScheduler::Set (uint32_t id, const EventKey &key, EventImpl *impl)
+{
+  m_keys[id] = key;
+  m_impls[id] = impl;
+  impl->SetSchedulerIndex (id);
+}
+
+void
+IndexedHeapScheduler::Grow (void)
+{
+  uint32_t capacity = m_capacity == 0 ? 1024 : m_capacity * 2;
+  NS_LOG_DEBUG ("Grow to " << capacity);
+
+  void *keys = 0;
+  if (posix_memalign (&keys, CacheLineSize, capacity * sizeof (EventKey)) != 0)
+    {
+      NS_FATAL_ERROR ("Cannot allocate memory for " << capacity << " events");
+    }
+  if (m_keys != 0)
+    {
+      std::memcpy (keys, m_keys, m_end * sizeof (EventKey));
+      std::free (m_keys);
+    }
+  m_keys = static_cast<EventKey *> (keys);
+  m_impls.resize (capacity, 0);
+  m_capacity = capacity;
+}
+
+void
+IndexedHeapScheduler::SiftUp (uint32_t id, const EventKey &key, EventImpl *impl)
+{
+  while (id != Root)
+    {
+      uint32_t parent = Parent (id);
+      if (!(key < m_keys[parent]))
+        {
+          break;
+        }
+      Set (id, m_keys[parent], m_impls[parent]);
+      id = parent;
+    }
+  Set (id, key, impl);
+}
+
+void
+IndexedHeapScheduler::SiftDown (uint32_t id, const EventKey &key, EventImpl *impl)
+{
+  while (true)
+    {
+      uint32_t first = FirstChild (id);
+      if (first >= m_end)
+        {
+          break;
+        }
+      uint32_t last = std::min (first + Arity, m_end);
+
+      uint32_t smallest = first;
+      for (uint32_t child = first + 1; child < last; child++)
+        {
+          if (m_keys[child] < m_keys[smallest])
+            {
+              smallest = child;
+            }
+        }
+
+      if (!(m_keys[smallest] < key))
+        {
+          break;
+        }
+      Set (id, m_keys[smallest], m_impls[smallest]);
+      id = smallest;
+    }
+  Set (id, key, impl);
+}
+
+void
+IndexedHeapScheduler::Insert (const Event &ev)
+{
+  if (m_end == m_capacity)
+    {
+      Grow ();
+    }
+  m_end++;
+  SiftUp (m_end - 1, ev.key, ev.impl);
+}
+
+bool
+IndexedHeapScheduler::IsEmpty (void) const
+{
+  return m_end == Root;
+}
+
+Scheduler::Event
+IndexedHeapScheduler::PeekNext (void) const
+{
+  NS_ASSERT (!IsEmpty ());
+  Event next;
+  next.impl = m_impls[Root];
+  next.key = m_keys[Root];
+  return next;
+}
+
+Scheduler::Event
+IndexedHeapScheduler::RemoveNext (void)
+{
+  Event next = PeekNext ();
+
+  m_end--;
+  if (m_end != Root)
+    {
+      SiftDown (Root, m_keys[m_end], m_impls[m_end]);
+    }
+  m_impls[m_end] = 0;
+  return next;
+}
+
+void
+IndexedHeapScheduler::Remove (const Event &ev)
+{
+  uint32_t id = ev.impl->GetSchedulerIndex ();
+  NS_ASSERT_MSG (id >= Root && id < m_end && m_impls[id] == ev.impl && m_keys[id].m_uid == ev.key.m_uid,
+                 "Event is not in the event list");
+
+  m_end--;
+  if (id != m_end)
+    {
+      EventKey key = m_keys[m_end];
+      EventImpl *impl = m_impls[m_end];
+      if (id != Root && key < m_keys[Parent (id)])
+        {
+          SiftUp (id, key, impl);
+        }
+      else
+        {
+          SiftDown (id, key, impl);
+        }
+    }
+  m_impls[m_end] = 0;
+}
+
+} // namespace ns3
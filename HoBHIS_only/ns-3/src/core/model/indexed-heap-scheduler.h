@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef INDEXED_HEAP_SCHEDULER_H
+#define INDEXED_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a 4-ary heap event scheduler with O(log n) removal of events
+ *
+ * Unlike HeapScheduler, which has to search the whole heap to remove
+ * a cancelled event (Simulator::Remove), this scheduler stores the
+ * position of each event in the heap in the event itself (see
+ * EventImpl::SetSchedulerIndex), so Remove takes the same O(log n)
+ * time as Insert and RemoveNext.
+ *
+ * The heap is 4-ary: it is two times shallower than a binary heap
+ * and all children of a node are compared in one pass.  Event keys
+ * are stored separately from event pointers, in an array aligned to
+ * the cache line size, and the root is placed so that all 4 children
+ * of any node (4 x 16 bytes) occupy exactly one cache line.
+ *
+ * This scheduler can be selected with
+ * \code
+ * GlobalValue::Bind ("SchedulerType", StringValue ("ns3::IndexedHeapScheduler"));
+ * \endcode
+ * or with --SchedulerType=ns3::IndexedHeapScheduler command line argument.
+ */
+class IndexedHeapScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  IndexedHeapScheduler ();
+  virtual ~IndexedHeapScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  static const uint32_t Arity = 4;
+  /* Position of the root in the arrays: children of every node start at a multiple of Arity */
+  static const uint32_t Root = Arity - 1;
+
+  inline uint32_t Parent (uint32_t id) const;
+  inline uint32_t FirstChild (uint32_t id) const;
+
+  /* Put event to the position (and let the event know its new position) */
+  inline void Set (uint32_t id, const EventKey &key, EventImpl *impl);
+
+  void SiftUp (uint32_t id, const EventKey &key, EventImpl *impl);
+  void SiftDown (uint32_t id, const EventKey &key, EventImpl *impl);
+  void Grow (void);
+
+  EventKey *m_keys;                 // cache-line aligned
+  std::vector<EventImpl *> m_impls;
+  uint32_t m_end;                   // position after the last event
+  uint32_t m_capacity;
+};
+
+} // namespace ns3
+
+#endif /* INDEXED_HEAP_SCHEDULER_H */
@@ -0,0 +1,300 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+const uint32_t LadderScheduler::Threshold;
+const uint32_t LadderScheduler::MaxRungs;
+const uint32_t LadderScheduler::MaxBuckets;
+
+/* Bottom is sorted in reverse order */
+static bool
+IsLater (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return a.key > b.key;
+}
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topStart (0),
+    m_rungs (MaxRungs),
+    m_nRungs (0),
+    m_size (0)
+{
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+}
+
+uint64_t
+LadderScheduler::Rung::CurrentStart (void) const
+{
+  if (m_current >= m_nBuckets)
+    {
+      return m_end;
+    }
+  return std::min (m_start + m_current * m_width, m_end);
+}
+
+uint32_t
+LadderScheduler::Rung::BucketIndex (uint64_t ts) const
+{
+  uint64_t index = (ts - m_start) / m_width;
+  // the last bucket also holds everything up to the end of the rung
+  return index < m_nBuckets ? index : m_nBuckets - 1;
+}
+
+uint32_t
+LadderScheduler::FindRung (uint64_t ts) const
+{
+  uint32_t i = 0;
+  while (i < m_nRungs && ts < m_rungs[i].CurrentStart ())
+    {
+      i++;
+    }
+  return i;
+}
+
+uint64_t
+LadderScheduler::BottomEnd (void) const
+{
+  return m_nRungs > 0 ? m_rungs[m_nRungs - 1].CurrentStart () : m_topStart;
+}
+
+void
+LadderScheduler::Push (Bucket &bucket, const Event &ev)
+{
+  ev.impl->SetSchedulerIndex (bucket.size ());
+  bucket.push_back (ev);
+}
+
+void
+LadderScheduler::Erase (Bucket &bucket, const Event &ev)
+{
+  uint32_t index = ev.impl->GetSchedulerIndex ();
+  NS_ASSERT_MSG (index < bucket.size () && bucket[index].impl == ev.impl,
+                 "Event is not in the event list");
+
+  if (index != bucket.size () - 1)
+    {
+      bucket[index] = bucket.back ();
+      bucket[index].impl->SetSchedulerIndex (index);
+    }
+  bucket.pop_back ();
+}
+
+bool
+LadderScheduler::Spawn (Bucket &bucket, uint64_t end)
+{
+  NS_ASSERT (m_nRungs < MaxRungs && !bucket.empty ());
+
+  uint64_t min = bucket.front ().key.m_ts;
+  uint64_t max = min;
+  for (Bucket::const_iterator i = bucket.begin (); i != bucket.end (); i++)
+    {
+      min = std::min (min, i->key.m_ts);
+      max = std::max (max, i->key.m_ts);
+    }
+  if (min == max)
+    {
+      // no way to spread events over buckets
+      return false;
+    }
+
+  Rung &rung = m_rungs[m_nRungs];
+  m_nRungs++;
+
+  rung.m_nBuckets = std::min<uint32_t> (bucket.size (), MaxBuckets);
+  rung.m_start = min;
+  rung.m_width = (max - min) / rung.m_nBuckets + 1;
+  rung.m_end = end;
+  rung.m_current = 0;
+  if (rung.m_buckets.size () < rung.m_nBuckets)
+    {
+      rung.m_buckets.resize (rung.m_nBuckets);
+    }
+  NS_LOG_DEBUG ("Rung " << m_nRungs - 1 << ": " << bucket.size () << " events, "
+                << rung.m_nBuckets << " buckets of " << rung.m_width << " starting at " << min);
+
+  for (Bucket::const_iterator i = bucket.begin (); i != bucket.end (); i++)
+    {
+      Push (rung.m_buckets[rung.BucketIndex (i->key.m_ts)], *i);
+    }
+  bucket.clear ();
+  return true;
+}
+
+void
+LadderScheduler::Sort (Bucket &bucket)
+{
+  NS_ASSERT (m_bottom.empty ());
+  // keep memory allocated by both vectors
+  m_bottom.swap (bucket);
+  std::sort (m_bottom.begin (), m_bottom.end (), IsLater);
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  while (m_bottom.empty ())
+    {
+      if (m_nRungs == 0)
+        {
+          NS_ASSERT (!m_top.empty ());
+          uint64_t max = 0;
+          for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); i++)
+            {
+              max = std::max (max, i->key.m_ts);
+            }
+          m_topStart = max + 1;
+
+          if (m_top.size () <= Threshold || !Spawn (m_top, m_topStart))
+            {
+              Sort (m_top);
+            }
+          continue;
+        }
+
+      Rung &rung = m_rungs[m_nRungs - 1];
+      while (rung.m_current < rung.m_nBuckets && rung.m_buckets[rung.m_current].empty ())
+        {
+          rung.m_current++;
+        }
+      if (rung.m_current == rung.m_nBuckets)
+        {
+          m_nRungs--;
+          continue;
+        }
+
+      Bucket &bucket = rung.m_buckets[rung.m_current];
+      rung.m_current++;
+      if (bucket.size () <= Threshold || m_nRungs == MaxRungs ||
+          !Spawn (bucket, rung.CurrentStart ()))
+        {
+          Sort (bucket);
+        }
+    }
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  m_size++;
+
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      Push (m_top, ev);
+      return;
+    }
+
+  uint32_t r = FindRung (ts);
+  if (r < m_nRungs)
+    {
+      Rung &rung = m_rungs[r];
+      Push (rung.m_buckets[rung.BucketIndex (ts)], ev);
+      return;
+    }
+
+  m_bottom.insert (std::upper_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater), ev);
+  if (m_bottom.size () > Threshold && m_nRungs < MaxRungs &&
+      m_bottom.front ().key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      // too many events are scheduled in the near future, spread them over a new rung
+      Spawn (m_bottom, BottomEnd ());
+    }
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_ASSERT (!IsEmpty ());
+  // the next event is known only after the ladder is rearranged
+  const_cast<LadderScheduler *> (this)->Refill ();
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_ASSERT (!IsEmpty ());
+  Refill ();
+
+  Event next = m_bottom.back ();
+  m_bottom.pop_back ();
+  m_size--;
+  return next;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_ASSERT (!IsEmpty ());
+  m_size--;
+
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      Erase (m_top, ev);
+      return;
+    }
+
+  uint32_t r = FindRung (ts);
+  if (r < m_nRungs)
+    {
+      Rung &rung = m_rungs[r];
+      Erase (rung.m_buckets[rung.BucketIndex (ts)], ev);
+      return;
+    }
+
+  Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater);
+  NS_ASSERT_MSG (i != m_bottom.end () && i->impl == ev.impl, "Event is not in the event list");
+  m_bottom.erase (i);
+}
+
+} // namespace ns3
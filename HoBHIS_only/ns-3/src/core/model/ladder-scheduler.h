@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue described in "Ladder Queue: An O(1)
+ * Priority Queue Structure for Large-Scale Discrete Event Simulation" by W. T. Tang,
+ * R. S. M. Goh, and I. L.-J. Thng (ACM TOMACS, 2005).  Unlike the calendar queue, it does
+ * not need any resize heuristics: buckets are created on demand, only for the events that
+ * are about to be dequeued.
+ *
+ * Events are kept in three tiers:
+ *  - Top: unsorted list of far-future events (at or after the time when the ladder ends);
+ *  - Ladder: several rungs of buckets, each rung spreading the events of one bucket of
+ *    the previous rung (or the whole Top) over smaller time intervals; events within a
+ *    bucket are not sorted;
+ *  - Bottom: short sorted list of the earliest events.
+ *
+ * When Bottom is empty, the first non-empty bucket of the last rung is either sorted into
+ * Bottom (if it is small) or spread over a new rung.  Insert and RemoveNext take O(1)
+ * amortized time, independently of the number of events and of their time distribution.
+ *
+ * All tiers are stored in vectors, which are reused during the whole simulation, so no
+ * memory is allocated per event.  Events in Top and in rungs remember their position in
+ * the bucket (see EventImpl::SetSchedulerIndex), so Remove also takes O(1) time for them.
+ * This is important for NDN simulations, where far-future PIT and retransmission timers
+ * are often cancelled.
+ *
+ * This scheduler can be selected with
+ * \code
+ * GlobalValue::Bind ("SchedulerType", StringValue ("ns3::LadderScheduler"));
+ * \endcode
+ * or with --SchedulerType=ns3::LadderScheduler command line argument.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  LadderScheduler ();
+  virtual ~LadderScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  typedef std::vector<Event> Bucket;
+
+  struct Rung
+  {
+    uint64_t m_start;  // time of the first bucket
+    uint64_t m_width;  // duration of a bucket
+    uint64_t m_end;    // end of the last bucket (start of the current bucket of the previous rung)
+    uint32_t m_nBuckets;
+    uint32_t m_current; // first bucket that was not yet moved to the next rung or to Bottom
+    std::vector<Bucket> m_buckets;
+
+    inline uint64_t CurrentStart (void) const;
+    inline uint32_t BucketIndex (uint64_t ts) const;
+  };
+
+  /* Maximum number of events in Bottom and in a bucket that can be sorted */
+  static const uint32_t Threshold = 50;
+  static const uint32_t MaxRungs = 8;
+  static const uint32_t MaxBuckets = 65536;
+
+  /* Rung that contains the time ts, or m_nRungs if the time is before all rungs (Bottom) */
+  inline uint32_t FindRung (uint64_t ts) const;
+  /* Time from which events are stored in the last rung (or Top, if there are no rungs) */
+  inline uint64_t BottomEnd (void) const;
+
+  inline void Push (Bucket &bucket, const Event &ev);
+  inline void Erase (Bucket &bucket, const Event &ev);
+
+  /* Spread events from the bucket over a new rung (ending at end) and clear the bucket,
+     returns false if all events in the bucket have the same time */
+  bool Spawn (Bucket &bucket, uint64_t end);
+  /* Sort the bucket into (empty) Bottom */
+  void Sort (Bucket &bucket);
+  /* Make sure that Bottom contains the next event */
+  void Refill (void);
+
+  Bucket m_top;
+  uint64_t m_topStart;
+
+  std::vector<Rung> m_rungs; // MaxRungs, only first m_nRungs are used
+  uint32_t m_nRungs;
+
+  Bucket m_bottom;           // sorted in reverse order, the next event is the last one
+
+  uint32_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -161,6 +161,26 @@ void LogComponentDisableAll (enum LogLevel level);
 #define NS_LOG_APPEND_CONTEXT
 #endif /* NS_LOG_APPEND_CONTEXT */
 
+/**
+ * \ingroup logging
+ *
+ * Log levels that are compiled into the code.  Logging statements of all
+ * other levels are removed at compile time (including evaluation of their
+ * parameters), so they cannot be enabled at run time and cost nothing.
+ *
+ * The mask can be set for the whole build, e.g.
+ * CXXFLAGS="-DNS_LOG_COMPILE_MASK=ns3::LOG_LEVEL_WARN", or for the
+ * components of a single file by defining it before including any ns-3
+ * header (or by redefining it after the includes):
+ * \code
+ * #undef NS_LOG_COMPILE_MASK
+ * #define NS_LOG_COMPILE_MASK ns3::LOG_LEVEL_ERROR
+ * \endcode
+ */
+#ifndef NS_LOG_COMPILE_MASK
+#define NS_LOG_COMPILE_MASK ns3::LOG_ALL
+#endif /* NS_LOG_COMPILE_MASK */
+
 
 
 #ifdef NS3_LOG_ENABLE
@@ -215,7 +235,8 @@ void LogComponentDisableAll (enum LogLevel level);
 #define NS_LOG(level, msg)                                      \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (level))                              \
+      if ((NS_LOG_COMPILE_MASK & (level)) &&                    \
+          g_log.IsEnabled (level))                              \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -274,7 +295,8 @@ void LogComponentDisableAll (enum LogLevel level);
 #define NS_LOG_FUNCTION_NOARGS()                                \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
+      if ((NS_LOG_COMPILE_MASK & ns3::LOG_FUNCTION) &&          \
+          g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -310,7 +332,8 @@ void LogComponentDisableAll (enum LogLevel level);
 #define NS_LOG_FUNCTION(parameters)                             \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
+      if ((NS_LOG_COMPILE_MASK & ns3::LOG_FUNCTION) &&          \
+          g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -378,6 +378,53 @@ public:
       }
     return v;
   }
+  /**
+   * \param ticks number of time units to convert into a Time object
+   * \param timeUnit the unit of the value to convert
+   * \return a new Time object
+   *
+   * Signed integer conversion with the factor precomputed for the
+   * current resolution, without any int64x64_t arithmetic.  This is
+   * much cheaper than FromDouble (e.g., Seconds (double)) and is meant
+   * for code that keeps time in integer units, e.g.,
+   * Time::FromTicks (delay, Time::NS).  Values finer than the
+   * resolution are truncated towards zero, and values that do not fit
+   * into 64 bits of the resolution are caught by an assert.
+   *
+   * \sa ToTicks
+   */
+  inline static Time FromTicks (int64_t ticks, enum Unit timeUnit)
+  {
+    struct Information *info = PeekInformation (timeUnit);
+    int64_t factor = static_cast<int64_t> (info->factor);
+    if (info->fromMul)
+      {
+        NS_ASSERT_MSG (ticks <= info->maxTicks && ticks >= -info->maxTicks,
+                       "Time value " << ticks << " overflows the resolution");
+        return Time (ticks * factor);
+      }
+    return Time (ticks / factor);
+  }
+  /**
+   * \param timeUnit the unit of the value to return
+   * \return number of time units (truncated towards zero)
+   *
+   * Signed counterpart of FromTicks.  Only integer operations are used.
+   *
+   * \sa FromTicks
+   */
+  inline int64_t ToTicks (enum Unit timeUnit) const
+  {
+    struct Information *info = PeekInformation (timeUnit);
+    int64_t factor = static_cast<int64_t> (info->factor);
+    if (info->toMul)
+      {
+        NS_ASSERT_MSG (m_data <= info->maxTicks && m_data >= -info->maxTicks,
+                       "Time value " << m_data << " overflows the requested unit");
+        return m_data * factor;
+      }
+    return m_data / factor;
+  }
   /**
    * \param value to convert into a Time object
    * \param timeUnit the unit of the value to convert
@@ -448,6 +495,7 @@ private:
     bool toMul;
     bool fromMul;
     uint64_t factor;
+    int64_t maxTicks; // largest value that can be multiplied by the factor
     int64x64_t timeTo;
     int64x64_t timeFrom;
   };
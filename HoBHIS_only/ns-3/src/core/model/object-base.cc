@@ -59,6 +59,11 @@ ObjectBase::NotifyConstructionCompleted (void)
 void
 ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
 {
+#ifdef HAVE_GETENV
+  // the environment is checked for every attribute without a value, so get it only once
+  char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
+#endif /* HAVE_GETENV */
+
   // loop over the inheritance tree back to the Object base class.
   TypeId tid = GetInstanceTypeId ();
   do {
@@ -91,7 +96,6 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
             {
               // No matching attribute value so we try to look at the env var.
 #ifdef HAVE_GETENV
-              char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
               if (envVar != 0)
                 {
                   std::string env = std::string (envVar);
@@ -108,6 +108,16 @@ ObjectPtrContainerAccessor::Get (const ObjectBase * object, AttributeValue &valu
     }
   return true;
 }
+bool
+ObjectPtrContainerAccessor::GetN (const ObjectBase *object, uint32_t *n) const
+{
+  return DoGetN (object, n);
+}
+Ptr<Object>
+ObjectPtrContainerAccessor::Get (const ObjectBase *object, uint32_t i, uint32_t *index) const
+{
+  return DoGet (object, i, index);
+}
 bool 
 ObjectPtrContainerAccessor::HasGetter (void) const
 {
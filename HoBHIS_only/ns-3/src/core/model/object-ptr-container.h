@@ -139,6 +139,20 @@ public:
   virtual bool Get (const ObjectBase * object, AttributeValue &value) const;
   virtual bool HasGetter (void) const;
   virtual bool HasSetter (void) const;
+
+  /**
+   * \brief Get number of items in the container, without getting the items
+   * \returns false if the object does not have this container
+   */
+  bool GetN (const ObjectBase *object, uint32_t *n) const;
+
+  /**
+   * \brief Get a single item of the container
+   * \param object object with the container
+   * \param i position of the item ([0, n[)
+   * \param index index of the item in the container (may differ from the position)
+   */
+  Ptr<Object> Get (const ObjectBase *object, uint32_t i, uint32_t *index) const;
 private:
   virtual bool DoGetN (const ObjectBase *object, uint32_t *n) const = 0;
   virtual Ptr<Object> DoGet (const ObjectBase *object, uint32_t i, uint32_t *index) const = 0;
@@ -88,11 +88,11 @@ Object::Object ()
   : m_tid (Object::GetTypeId ()),
     m_disposed (false),
     m_started (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
-    m_getObjectCount (0)
+    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates)))
 {
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
+  ClearCache (m_aggregates);
 }
 Object::~Object () 
 {
@@ -109,6 +109,7 @@ Object::~Object ()
           m_aggregates->n--;
         }
     }
+  ClearCache (m_aggregates);
   // finally, if all objects have been removed from the list,
   // delete the aggregate list
   if (m_aggregates->n == 0)
@@ -121,11 +122,11 @@ Object::Object (const Object &o)
   : m_tid (o.m_tid),
     m_disposed (false),
     m_started (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
-    m_getObjectCount (0)
+    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates)))
 {
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
+  ClearCache (m_aggregates);
 }
 void
 Object::Construct (const AttributeConstructionList &attributes)
@@ -138,6 +139,15 @@ Object::DoGetObject (TypeId tid) const
 {
   NS_ASSERT (CheckLoose ());
 
+  uint16_t uid = tid.GetUid ();
+  volatile uint64_t &entry = m_aggregates->cache[uid % Aggregates::CACHE_SIZE];
+  uint64_t cached = entry;
+  if ((cached >> Aggregates::CACHE_UID_SHIFT) == uid)
+    {
+      uint64_t object = cached & ((static_cast<uint64_t> (1) << Aggregates::CACHE_UID_SHIFT) - 1);
+      return reinterpret_cast<Object *> (static_cast<uintptr_t> (object));
+    }
+
   uint32_t n = m_aggregates->n;
   TypeId objectTid = Object::GetTypeId ();
   for (uint32_t i = 0; i < n; i++)
@@ -150,20 +160,15 @@ Object::DoGetObject (TypeId tid) const
         }
       if (cur == tid)
         {
-          // This is an attempt to 'cache' the result of this lookup.
-          // the idea is that if we perform a lookup for a TypeId on this object,
-          // we are likely to perform the same lookup later so, we make sure
-          // that the aggregate array is sorted by the number of accesses
-          // to each object.
-
-          // first, increment the access count
-          current->m_getObjectCount++;
-          // then, update the sort
-          UpdateSortedArray (m_aggregates, i);
-          // finally, return the match
+          // remember the match.  The aggregate array is only read here, so that
+          // concurrent lookups can scan it safely
+          uint64_t object = reinterpret_cast<uintptr_t> (current);
+          NS_ASSERT_MSG ((object >> Aggregates::CACHE_UID_SHIFT) == 0, "Object address does not fit into the cache entry");
+          entry = (static_cast<uint64_t> (uid) << Aggregates::CACHE_UID_SHIFT) | object;
           return const_cast<Object *> (current);
         }
     }
+  entry = static_cast<uint64_t> (uid) << Aggregates::CACHE_UID_SHIFT;
   return 0;
 }
 void
@@ -215,15 +220,12 @@ restart:
     }
 }
 void
-Object::UpdateSortedArray (struct Aggregates *aggregates, uint32_t j) const
+Object::ClearCache (struct Aggregates *aggregates)
 {
-  while (j > 0 && 
-         aggregates->buffer[j]->m_getObjectCount > aggregates->buffer[j-1]->m_getObjectCount)
+  // uid 0 is never allocated to a valid TypeId
+  for (uint32_t i = 0; i < Aggregates::CACHE_SIZE; i++)
     {
-      Object *tmp = aggregates->buffer[j-1];
-      aggregates->buffer[j-1] = aggregates->buffer[j];
-      aggregates->buffer[j] = tmp;
-      j--;
+      aggregates->cache[i] = 0;
     }
 }
 void 
@@ -247,6 +249,7 @@ Object::AggregateObject (Ptr<Object> o)
   struct Aggregates *aggregates = 
     (struct Aggregates *)std::malloc (sizeof(struct Aggregates)+(total-1)*sizeof(Object*));
   aggregates->n = total;
+  ClearCache (aggregates);
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0], 
@@ -257,7 +260,6 @@ Object::AggregateObject (Ptr<Object> o)
   for (uint32_t i = 0; i < other->m_aggregates->n; i++)
     {
       aggregates->buffer[m_aggregates->n+i] = other->m_aggregates->buffer[i];
-      UpdateSortedArray (aggregates, m_aggregates->n + i);
     }
 
   // keep track of the old aggregate buffers for the iteration
@@ -235,8 +235,20 @@ private:
    * chunk of memory than the struct to allow space for a larger
    * variable sized buffer whose size is indicated by the element
    * 'n'
+   *
+   * The structure also caches results of the GetObject lookups (including
+   * unsuccessful ones), indexed by the uid of the requested TypeId, so that
+   * repeated GetObject calls do not need to scan the array.  The cache is
+   * shared by all aggregated objects and is cleared every time the array
+   * is modified.  Every entry holds the uid in the upper 16 bits and the
+   * found object (0 if not found) in the lower 48 bits, so an entry is
+   * read and written as one word and lookups done concurrently by several
+   * threads (e.g., by MultithreadedSimulatorImpl) can only overwrite an
+   * entry with another valid one.
    */
   struct Aggregates {
+    enum { CACHE_SIZE = 8, CACHE_UID_SHIFT = 48 };
+    volatile uint64_t cache[CACHE_SIZE];
     uint32_t n;
     Object *buffer[1];
   };
@@ -262,7 +274,10 @@ private:
   */
   void Construct (const AttributeConstructionList &attributes);
 
-  void UpdateSortedArray (struct Aggregates *aggregates, uint32_t i) const;
+  /**
+   * \param aggregates the aggregate array to invalidate the lookup cache of
+   */
+  static void ClearCache (struct Aggregates *aggregates);
   /**
    * Attempt to delete this object. This method iterates
    * over all aggregated objects to check if they all 
@@ -292,13 +307,6 @@ private:
    * so the size of the array is indirectly a reference count.
    */
   struct Aggregates * m_aggregates;
-  /**
-   * Indicates the number of times the object was accessed with a
-   * call to GetObject. This integer is used to implement a
-   * heuristic to sort the array of aggregates to put at the start
-   * of the array the most-frequently accessed elements.
-   */
-  uint32_t m_getObjectCount;
 };
 
 /**
@@ -331,15 +339,17 @@ template <typename T>
 Ptr<T> 
 Object::GetObject () const
 {
-  // This is an optimization: if the cast works (which is likely),
-  // things will be pretty fast.
-  T *result = dynamic_cast<T *> (m_aggregates->buffer[0]);
-  if (result != 0)
+  // This is an optimization: if the same type was already requested
+  // (which is likely), the result is taken directly from the cache.
+  TypeId tid = T::GetTypeId ();
+  uint64_t entry = m_aggregates->cache[tid.GetUid () % Aggregates::CACHE_SIZE];
+  if ((entry >> Aggregates::CACHE_UID_SHIFT) == tid.GetUid ())
     {
-      return Ptr<T> (result);
+      uint64_t object = entry & ((static_cast<uint64_t> (1) << Aggregates::CACHE_UID_SHIFT) - 1);
+      return Ptr<T> (static_cast<T *> (reinterpret_cast<Object *> (static_cast<uintptr_t> (object))));
     }
-  // if the cast does not work, we try to do a full type check.
-  Ptr<Object> found = DoGetObject (T::GetTypeId ());
+  // otherwise, we try to do a full type check.
+  Ptr<Object> found = DoGetObject (tid);
   if (found != 0)
     {
       return Ptr<T> (static_cast<T *> (PeekPointer (found)));
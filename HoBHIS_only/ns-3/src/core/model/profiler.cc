@@ -0,0 +1,356 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "profiler.h"
+#include "simulator.h"
+#include "fatal-error.h"
+#include "ns3/core-config.h"
+
+#include <map>
+#include <fstream>
+#include <sys/time.h>
+
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+
+namespace ns3 {
+
+namespace {
+
+/**
+ * \brief Counters of one stage in one context
+ */
+struct ProfilerCounters
+{
+  uint64_t count;
+  uint64_t samples;
+  uint64_t cycles;
+};
+
+/**
+ * \brief Counters of one thread
+ */
+struct ProfilerTable
+{
+  std::vector< std::vector<ProfilerCounters> > contexts; ///< \brief [context + 1][stage id], 0 is "no context"
+  uint32_t random; ///< \brief state of the generator selecting sampled executions
+  ProfilerTable *nextTable;
+};
+
+uint64_t g_samplingMask = 63;
+ProfilerTable *g_tables = 0; // list of tables of all threads
+
+__thread ProfilerTable *g_table __attribute__ ((tls_model ("initial-exec"))) = 0;
+
+/**
+ * \brief Get names of all registered stages, indexed by the stage id
+ *
+ * The names are copied, so the report can be printed after the stages
+ * themselves have been destroyed
+ */
+std::vector<std::string> *
+GetStageList (void)
+{
+  // never destroyed, as the report can be printed at exit
+  static std::vector<std::string> *stages = new std::vector<std::string> ();
+  return stages;
+}
+
+inline uint64_t
+ReadCycles (void)
+{
+#if defined (__i386__) || defined (__x86_64__)
+  uint32_t low, high;
+  __asm__ __volatile__ ("rdtsc" : "=a" (low), "=d" (high));
+  return (static_cast<uint64_t> (high) << 32) | low;
+#else
+  // no cycle counter, use nanoseconds instead
+  struct timeval tv;
+  gettimeofday (&tv, 0);
+  return static_cast<uint64_t> (tv.tv_sec) * 1000000000 + tv.tv_usec * 1000;
+#endif
+}
+
+ProfilerTable *
+GetTable (void)
+{
+  ProfilerTable *table = g_table;
+  if (table == 0)
+    {
+      table = g_table = new ProfilerTable;
+      table->random = 2463534242U;
+
+      // threads are created rarely, so a simple lock-free push is sufficient
+      do
+        {
+          table->nextTable = g_tables;
+        }
+      while (!__sync_bool_compare_and_swap (&g_tables, table->nextTable, table));
+    }
+  return table;
+}
+
+inline ProfilerCounters &
+GetCounters (ProfilerTable *table, uint32_t context, uint16_t stage)
+{
+  uint32_t slot = context + 1; // 0xffffffff (no context) becomes 0
+  if (slot >= table->contexts.size ())
+    {
+      table->contexts.resize (slot + 1);
+    }
+
+  std::vector<ProfilerCounters> &stages = table->contexts[slot];
+  if (stage >= stages.size ())
+    {
+      stages.resize (GetStageList ()->size ());
+    }
+  return stages[stage];
+}
+
+/**
+ * \brief Enables the profiler from NS_PROFILE and releases the tables at exit
+ */
+struct ProfilerInitializer
+{
+  ProfilerInitializer ()
+  {
+#ifdef HAVE_GETENV
+    char *envVar = getenv ("NS_PROFILE");
+    if (envVar != 0)
+      {
+        int period = atoi (envVar);
+        if (period > 0)
+          {
+            Profiler::SetSamplingPeriod (period);
+          }
+        Profiler::Enable ();
+      }
+#endif
+  }
+
+  ~ProfilerInitializer ()
+  {
+    while (g_tables != 0)
+      {
+        ProfilerTable *table = g_tables;
+        g_tables = table->nextTable;
+        delete table;
+      }
+    g_table = 0;
+  }
+} g_profilerInitializer;
+
+} // anonymous namespace
+
+ProfilerStage::ProfilerStage (char const *name)
+  : m_name (name)
+{
+  std::vector<std::string> *stages = GetStageList ();
+  for (std::vector<std::string>::iterator i = stages->begin (); i != stages->end (); i++)
+    {
+      if (*i == name)
+        {
+          NS_FATAL_ERROR ("Profiler stage \"" << name << "\" has already been registered once.");
+        }
+    }
+  m_id = stages->size ();
+  stages->push_back (name);
+}
+
+char const *
+ProfilerStage::GetName (void) const
+{
+  return m_name;
+}
+
+uint16_t
+ProfilerStage::GetId (void) const
+{
+  return m_id;
+}
+
+double
+ProfilerEntry::GetEstimatedCycles (void) const
+{
+  if (samples == 0)
+    {
+      return 0;
+    }
+  return static_cast<double> (cycles) * count / samples;
+}
+
+bool Profiler::s_enabled = false;
+
+void
+Profiler::Enable (void)
+{
+  s_enabled = true;
+}
+
+void
+Profiler::Disable (void)
+{
+  s_enabled = false;
+}
+
+void
+Profiler::SetSamplingPeriod (uint32_t period)
+{
+  uint64_t size = 1;
+  while (size < period)
+    {
+      size <<= 1;
+    }
+  g_samplingMask = size - 1;
+}
+
+void
+Profiler::Clear (void)
+{
+  for (ProfilerTable *table = g_tables; table != 0; table = table->nextTable)
+    {
+      table->contexts.clear ();
+    }
+}
+
+std::vector<ProfilerEntry>
+Profiler::GetEntries (void)
+{
+  std::vector<std::string> *stages = GetStageList ();
+
+  // merge tables of all threads
+  std::map<std::pair<uint32_t, uint16_t>, ProfilerCounters> merged;
+  for (ProfilerTable *table = g_tables; table != 0; table = table->nextTable)
+    {
+      for (uint32_t slot = 0; slot < table->contexts.size (); slot++)
+        {
+          for (uint16_t stage = 0; stage < table->contexts[slot].size (); stage++)
+            {
+              const ProfilerCounters &counters = table->contexts[slot][stage];
+              if (counters.count == 0)
+                {
+                  continue;
+                }
+
+              ProfilerCounters &total = merged[std::make_pair (slot - 1, stage)];
+              total.count += counters.count;
+              total.samples += counters.samples;
+              total.cycles += counters.cycles;
+            }
+        }
+    }
+
+  std::vector<ProfilerEntry> entries;
+  for (std::map<std::pair<uint32_t, uint16_t>, ProfilerCounters>::iterator i = merged.begin (); i != merged.end (); i++)
+    {
+      ProfilerEntry entry;
+      entry.context = i->first.first;
+      entry.stage = (*stages)[i->first.second];
+      entry.count = i->second.count;
+      entry.samples = i->second.samples;
+      entry.cycles = i->second.cycles;
+      entries.push_back (entry);
+    }
+  return entries;
+}
+
+void
+Profiler::Print (std::ostream &os)
+{
+  os << "Context" << "\t" << "Stage" << "\t" << "Count" << "\t" << "Samples" << "\t"
+     << "AvgCycles" << "\t" << "EstCycles" << "\n";
+
+  std::vector<ProfilerEntry> entries = GetEntries ();
+  for (std::vector<ProfilerEntry>::iterator i = entries.begin (); i != entries.end (); i++)
+    {
+      os << i->context << "\t" << i->stage << "\t" << i->count << "\t" << i->samples << "\t"
+         << (i->samples > 0 ? static_cast<double> (i->cycles) / i->samples : 0.0) << "\t"
+         << static_cast<uint64_t> (i->GetEstimatedCycles ()) << "\n";
+    }
+  os.flush ();
+}
+
+void
+Profiler::Report (void)
+{
+  char *file = 0;
+#ifdef HAVE_GETENV
+  file = getenv ("NS_PROFILE_FILE");
+#endif
+  if (file != 0)
+    {
+      std::ofstream os (file, std::ios::out | std::ios::trunc);
+      Print (os);
+    }
+  else
+    {
+      Print (std::clog);
+    }
+  Clear ();
+}
+
+const ProfilerStage &
+Profiler::GetEventStage (void)
+{
+  static ProfilerStage stage ("Simulator.Event");
+  return stage;
+}
+
+uint64_t
+Profiler::Start (const ProfilerStage &stage, uint32_t context)
+{
+  ProfilerTable *table = GetTable ();
+  ProfilerCounters &counters = GetCounters (table, context, stage.GetId ());
+  counters.count++;
+
+  // executions are sampled randomly (xorshift), as periodic sampling would follow
+  // periodic patterns of the events (e.g., always measure the same type of events)
+  uint32_t random = table->random;
+  random ^= random << 13;
+  random ^= random >> 17;
+  random ^= random << 5;
+  table->random = random;
+  if ((random & g_samplingMask) != 0)
+    {
+      return 0;
+    }
+
+  uint64_t start = ReadCycles ();
+  return start != 0 ? start : 1;
+}
+
+void
+Profiler::Stop (const ProfilerStage &stage, uint32_t context, uint64_t start)
+{
+  uint64_t end = ReadCycles ();
+
+  ProfilerCounters &counters = GetCounters (GetTable (), context, stage.GetId ());
+  counters.samples++;
+  counters.cycles += end - start;
+}
+
+uint32_t
+Profiler::GetContext (void)
+{
+  return Simulator::GetContext ();
+}
+
+} // namespace ns3
@@ -0,0 +1,294 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <iostream>
+
+/**
+ * \ingroup logging
+ * \defgroup profiler Profiler
+ * \brief Low-overhead per-context profiling of simulation stages
+ *
+ * The profiler counts how many times each stage (an instrumented block of
+ * code) was executed in each simulation context (node id), and measures
+ * the CPU cycles spent in the stage for a random sample of the executions
+ * (by default, one of 64 executions).  Every processed event is
+ * accounted in the built-in "Simulator.Event" stage, so the report shows
+ * which nodes consume the wall clock time, and the other stages show where
+ * this time is spent.
+ *
+ * The profiler is compiled in all builds.  While it is disabled, a stage
+ * costs a single check of a flag.  It is enabled with ns3::Profiler::Enable
+ * or with the NS_PROFILE environment variable, whose value is the sampling
+ * period (NS_PROFILE=1 measures every execution).  The report is printed
+ * when the simulation is destroyed (ns3::Simulator::Destroy) to std::clog,
+ * or to the file specified in NS_PROFILE_FILE environment variable.
+ *
+ * Typical usage:
+ * \code
+ * NS_PROFILER_STAGE_DEFINE (g_lookupStage, "ContentStore.Lookup");
+ *
+ * void
+ * Lookup (...)
+ * {
+ *   NS_PROFILE (g_lookupStage);
+ *   ...
+ * }
+ * \endcode
+ */
+
+/**
+ * \ingroup profiler
+ * \param var name of the stage variable
+ * \param name unique name of the stage
+ *
+ * Define a profiled stage.  Should be used at file scope.
+ */
+#define NS_PROFILER_STAGE_DEFINE(var, name)                     \
+  static ns3::ProfilerStage var (name)
+
+#define NS_PROFILER_CONCAT2(a, b) a ## b
+#define NS_PROFILER_CONCAT(a, b) NS_PROFILER_CONCAT2 (a, b)
+
+/**
+ * \ingroup profiler
+ * \param var stage variable defined with NS_PROFILER_STAGE_DEFINE
+ *
+ * Account the rest of the enclosing block in the stage.
+ */
+#define NS_PROFILE(var)                                                 \
+  ns3::ProfilerScope NS_PROFILER_CONCAT (ns3ProfilerScope, __LINE__) (var)
+
+namespace ns3 {
+
+/**
+ * \ingroup profiler
+ * \brief A profiled stage (should be defined with NS_PROFILER_STAGE_DEFINE)
+ */
+class ProfilerStage
+{
+public:
+  /**
+   * \param name unique name of the stage
+   */
+  ProfilerStage (char const *name);
+
+  /**
+   * \brief Get name of the stage
+   */
+  char const *
+  GetName (void) const;
+
+  /**
+   * \brief Get id of the stage
+   */
+  uint16_t
+  GetId (void) const;
+
+private:
+  // stages are identified by their ids and cannot be copied
+  ProfilerStage (const ProfilerStage &o);
+  ProfilerStage &operator = (const ProfilerStage &o);
+
+  char const *m_name;
+  uint16_t m_id;
+};
+
+/**
+ * \ingroup profiler
+ * \brief Accumulated statistics of one stage in one context
+ */
+struct ProfilerEntry
+{
+  uint32_t context;  ///< \brief simulation context (node id)
+  std::string stage; ///< \brief name of the stage
+  uint64_t count;    ///< \brief number of executions
+  uint64_t samples;  ///< \brief number of executions with measured time
+  uint64_t cycles;   ///< \brief cycles spent in the sampled executions
+
+  /**
+   * \brief Get estimated number of cycles spent in all executions
+   */
+  double
+  GetEstimatedCycles (void) const;
+};
+
+/**
+ * \ingroup profiler
+ * \brief Controls the profiler and reports collected statistics
+ */
+class Profiler
+{
+public:
+  /**
+   * \brief Check if the profiler is enabled
+   */
+  static inline bool
+  IsEnabled (void)
+  {
+    return s_enabled;
+  }
+
+  /**
+   * \brief Enable the profiler
+   */
+  static void
+  Enable (void);
+
+  /**
+   * \brief Disable the profiler (collected statistics are preserved)
+   */
+  static void
+  Disable (void);
+
+  /**
+   * \param period measure time of one of period executions on average
+   *        (rounded up to a power of two, default 64)
+   */
+  static void
+  SetSamplingPeriod (uint32_t period);
+
+  /**
+   * \brief Remove all collected statistics
+   */
+  static void
+  Clear (void);
+
+  /**
+   * \brief Get statistics of all stages in all contexts, ordered by
+   * context and stage
+   */
+  static std::vector<ProfilerEntry>
+  GetEntries (void);
+
+  /**
+   * \brief Print per-context, per-stage report in text format
+   *
+   * Each line contains context, name of the stage, number of executions,
+   * number of sampled executions, average cycles per execution, and
+   * estimated total cycles.
+   */
+  static void
+  Print (std::ostream &os);
+
+  /**
+   * \brief Print the report (to NS_PROFILE_FILE, if set, or to std::clog)
+   * and clear statistics.  Called by ns3::Simulator::Destroy, if the
+   * profiler is enabled
+   */
+  static void
+  Report (void);
+
+  /**
+   * \brief Get the built-in stage accounting execution of simulation events
+   * (used by the simulator implementations)
+   */
+  static const ProfilerStage &
+  GetEventStage (void);
+
+  /**
+   * \internal
+   * \brief Account the start of the stage execution
+   * \returns cycle counter, if the execution is sampled, or zero
+   */
+  static uint64_t
+  Start (const ProfilerStage &stage, uint32_t context);
+
+  /**
+   * \internal
+   * \brief Account the end of the sampled stage execution
+   */
+  static void
+  Stop (const ProfilerStage &stage, uint32_t context, uint64_t start);
+
+  /**
+   * \internal
+   * \brief Get current simulation context (to avoid including simulator.h)
+   */
+  static uint32_t
+  GetContext (void);
+
+private:
+  static bool s_enabled;
+};
+
+/**
+ * \ingroup profiler
+ * \brief Accounts the lifetime of the object in the stage (see NS_PROFILE)
+ */
+class ProfilerScope
+{
+public:
+  /**
+   * \param stage the stage
+   *
+   * Execution is accounted to the current simulation context
+   */
+  inline
+  ProfilerScope (const ProfilerStage &stage)
+    : m_stage (stage)
+    , m_start (0)
+  {
+    if (Profiler::IsEnabled ())
+      {
+        m_context = Profiler::GetContext ();
+        m_start = Profiler::Start (stage, m_context);
+      }
+  }
+
+  /**
+   * \param stage the stage
+   * \param context simulation context to which the execution is accounted
+   */
+  inline
+  ProfilerScope (const ProfilerStage &stage, uint32_t context)
+    : m_stage (stage)
+    , m_context (context)
+    , m_start (0)
+  {
+    if (Profiler::IsEnabled ())
+      {
+        m_start = Profiler::Start (stage, context);
+      }
+  }
+
+  inline
+  ~ProfilerScope ()
+  {
+    if (m_start != 0)
+      {
+        Profiler::Stop (m_stage, m_context, m_start);
+      }
+  }
+
+private:
+  const ProfilerStage &m_stage;
+  uint32_t m_context;
+  uint64_t m_start;
+};
+
+} // namespace ns3
+
+#endif /* PROFILER_H */
@@ -31,6 +31,7 @@
 #include "system-mutex.h"
 #include "boolean.h"
 #include "enum.h"
+#include "profiler.h"
 
 
 #include <cmath>
@@ -377,7 +378,10 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
 
   EventImpl *event = next.impl;
   m_synchronizer->EventStart ();
-  event->Invoke ();
+  {
+    ProfilerScope scope (Profiler::GetEventStage (), next.key.m_context);
+    event->Invoke ();
+  }
   m_synchronizer->EventEnd ();
   event->Unref ();
 }
@@ -2,11 +2,13 @@
 #include "global-value.h"
 #include "attribute-helper.h"
 #include "integer.h"
+#include "enum.h"
 #include "config.h"
 
 namespace ns3 {
 
 static uint64_t g_nextStreamIndex = 0;
+static __thread uint64_t g_threadNextStreamIndex __attribute__ ((tls_model ("initial-exec"))) = 0;
 static ns3::GlobalValue g_rngSeed ("RngSeed", 
                                    "The global seed of all rng streams",
                                    ns3::IntegerValue(1),
@@ -15,6 +17,11 @@ static ns3::GlobalValue g_rngRun ("RngRun",
                                   "The run number used to modify the global seed",
                                   ns3::IntegerValue (1),
                                   ns3::MakeIntegerChecker<int64_t> ());
+static ns3::GlobalValue g_rngEngine ("RngEngine",
+                                     "The generator of all rng streams",
+                                     ns3::EnumValue (RngSeedManager::MRG32K3A),
+                                     ns3::MakeEnumChecker (RngSeedManager::MRG32K3A, "MRG32k3a",
+                                                           RngSeedManager::PHILOX, "Philox"));
 
 
 uint32_t RngSeedManager::GetSeed (void)
@@ -44,9 +51,32 @@ uint64_t RngSeedManager::GetRun ()
 
 uint64_t RngSeedManager::GetNextStreamIndex (void)
 {
+  if (g_threadNextStreamIndex != 0)
+    {
+      return g_threadNextStreamIndex++;
+    }
   uint64_t next = g_nextStreamIndex;
   g_nextStreamIndex++;
   return next;
 }
 
+void RngSeedManager::SetEngine (Engine engine)
+{
+  Config::SetGlobal ("RngEngine", EnumValue (engine));
+}
+
+RngSeedManager::Engine RngSeedManager::GetEngine (void)
+{
+  EnumValue value;
+  g_rngEngine.GetValue (value);
+  return static_cast<Engine> (value.Get ());
+}
+
+uint64_t RngSeedManager::SetThreadStreamIndex (uint64_t next)
+{
+  uint64_t previous = g_threadNextStreamIndex;
+  g_threadNextStreamIndex = next;
+  return previous;
+}
+
 } // namespace ns3
@@ -8,6 +8,15 @@ namespace ns3 {
 class RngSeedManager
 {
 public:
+  /**
+   * \brief Generators used by the random number streams (see ns3::RngStream)
+   */
+  enum Engine
+  {
+    MRG32K3A, ///< combined multiple-recursive generator (default)
+    PHILOX    ///< counter-based Philox4x32-10
+  };
+
   /**
    * \brief set the seed
    * it will duplicate the seed value 6 times
@@ -62,6 +71,36 @@ public:
 
   static uint64_t GetNextStreamIndex(void);
 
+  /**
+   * \brief Set the generator of the streams created after this call
+   *
+   * The same can be done with "RngEngine" global value (e.g.,
+   * --RngEngine=Philox on the command line).  Philox streams are created
+   * in constant time for any stream and run number, but produce a
+   * different sequence of numbers than the default MRG32k3a.
+   */
+  static void SetEngine (Engine engine);
+
+  /**
+   * \returns the generator used by newly created streams
+   */
+  static Engine GetEngine (void);
+
+  /**
+   * \brief Allocate stream indexes of the current thread from a separate range
+   *
+   * After this call, GetNextStreamIndex called from the current thread
+   * returns next, next + 1, ... instead of the values of the global
+   * counter, so that assignment of streams does not depend on the order
+   * in which threads run (used by the multithreaded simulator).
+   *
+   * \param next the index of the next stream allocated by the current
+   *        thread, or 0 to use the global counter again
+   * \returns the index that the current thread would have allocated next
+   *          from its previous range (0 if the global counter was used)
+   */
+  static uint64_t SetThreadStreamIndex (uint64_t next);
+
 };
 
 // for compatibility
@@ -23,6 +23,7 @@
 #include <cstdlib>
 #include <iostream>
 #include "rng-stream.h"
+#include "rng-seed-manager.h"
 #include "fatal-error.h"
 
 namespace
@@ -252,6 +253,11 @@ namespace ns3 {
 // Generate the next random number.
 //
 double RngStream::RandU01 ()
+{
+  return m_philox ? RandU01Philox () : RandU01Mrg ();
+}
+
+double RngStream::RandU01Mrg ()
 {
   int32_t k;
   double p1, p2, u;
@@ -282,8 +288,70 @@ double RngStream::RandU01 ()
   return u;
 }
 
+//-------------------------------------------------------------------------
+// Philox4x32-10: the next block of four 32-bit numbers for the current
+// counter, then the 64-bit block number (lower half of the counter) is
+// incremented
+//
+void RngStream::PhiloxBlock ()
+{
+  const uint32_t M0 = 0xD2511F53;
+  const uint32_t M1 = 0xCD9E8D57;
+  const uint32_t W0 = 0x9E3779B9;
+  const uint32_t W1 = 0xBB67AE85;
+
+  uint32_t c0 = m_counter[0], c1 = m_counter[1], c2 = m_counter[2], c3 = m_counter[3];
+  uint32_t k0 = m_key[0], k1 = m_key[1];
+  for (int round = 0; round < 10; round++)
+    {
+      uint64_t p0 = static_cast<uint64_t> (M0) * c0;
+      uint64_t p1 = static_cast<uint64_t> (M1) * c2;
+      uint32_t n0 = static_cast<uint32_t> (p1 >> 32) ^ c1 ^ k0;
+      uint32_t n2 = static_cast<uint32_t> (p0 >> 32) ^ c3 ^ k1;
+      c1 = static_cast<uint32_t> (p1);
+      c3 = static_cast<uint32_t> (p0);
+      c0 = n0;
+      c2 = n2;
+      k0 += W0;
+      k1 += W1;
+    }
+  m_output[0] = c0;
+  m_output[1] = c1;
+  m_output[2] = c2;
+  m_output[3] = c3;
+  m_outputIndex = 0;
+
+  if (++m_counter[0] == 0)
+    {
+      ++m_counter[1];
+    }
+}
+
+double RngStream::RandU01Philox ()
+{
+  if (m_outputIndex == 4)
+    {
+      PhiloxBlock ();
+    }
+  // (x + 0.5) / 2^32, strictly between 0 and 1
+  return (m_output[m_outputIndex++] + 0.5) * 2.3283064365386963e-10;
+}
+
 RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
 {
+  m_philox = RngSeedManager::GetEngine () == RngSeedManager::PHILOX;
+  if (m_philox)
+    {
+      m_key[0] = static_cast<uint32_t> (stream);
+      m_key[1] = static_cast<uint32_t> (stream >> 32);
+      m_counter[0] = 0;
+      m_counter[1] = 0;
+      m_counter[2] = static_cast<uint32_t> (substream);
+      m_counter[3] = seedNumber;
+      m_outputIndex = 4; // the first block is generated on the first request
+      return;
+    }
+
   if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
     {
       NS_FATAL_ERROR ("invalid Seed " << seedNumber);
@@ -297,11 +365,20 @@ RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
 }
 
 RngStream::RngStream(const RngStream& r)
+  : m_philox (r.m_philox),
+    m_outputIndex (r.m_outputIndex)
 {
   for (int i = 0; i < 6; ++i)
     {
       m_currentState[i] = r.m_currentState[i];
     }
+  for (int i = 0; i < 4; ++i)
+    {
+      m_counter[i] = r.m_counter[i];
+      m_output[i] = r.m_output[i];
+    }
+  m_key[0] = r.m_key[0];
+  m_key[1] = r.m_key[1];
 }
 
 void 
@@ -35,6 +35,17 @@ namespace ns3 {
  * holds a static instance of this class.  The details of this
  * class are explained in:
  * http://www.iro.umontreal.ca/~lecuyer/myftp/papers/streams00.pdf
+ *
+ * If "RngEngine" global value is set to Philox (see
+ * ns3::RngSeedManager::SetEngine), the counter-based generator
+ * Philox4x32-10 is used instead:
+ * http://www.thesalmons.org/john/random123/papers/random123sc11.pdf
+ * The stream number is used as the key, and the run number (lower 32
+ * bits) and the seed select the range of the 128-bit counter, so any
+ * stream of any run is created in constant time (MRG32k3a needs to
+ * advance the state by the stream and substream number).  This makes it
+ * cheap to give every object its own stream derived from its id (see
+ * ns3::RandomVariableStream::SetStream).
  */
 class RngStream
 {
@@ -49,8 +60,18 @@ public:
 
 private:
   void AdvanceNthBy (uint64_t nth, int by, double state[6]);
+  double RandU01Mrg (void);
+  double RandU01Philox (void);
+  void PhiloxBlock (void);
 
+  bool m_philox;
   double m_currentState[6];
+
+  // Philox4x32-10 state
+  uint32_t m_key[2];
+  uint32_t m_counter[4];
+  uint32_t m_output[4];
+  uint32_t m_outputIndex;
 };
 
 } // namespace ns3
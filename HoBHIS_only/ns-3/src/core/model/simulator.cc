@@ -30,6 +30,7 @@
 #include "global-value.h"
 #include "assert.h"
 #include "log.h"
+#include "profiler.h"
 
 #include <cmath>
 #include <fstream>
@@ -131,6 +132,10 @@ Simulator::Destroy (void)
   LogSetTimePrinter (0);
   LogSetNodePrinter (0);
   (*pimpl)->Destroy ();
+  if (Profiler::IsEnabled ())
+    {
+      Profiler::Report ();
+    }
   (*pimpl)->Unref ();
   *pimpl = 0;
 }
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "thread-exit.h"
+#include "ns3/core-config.h"
+
+#include <vector>
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+namespace ns3 {
+
+#ifdef HAVE_PTHREAD_H
+
+namespace {
+
+typedef std::vector<void (*) (void)> ThreadExitFunctions;
+
+pthread_key_t g_threadExitKey;
+pthread_once_t g_threadExitOnce = PTHREAD_ONCE_INIT;
+
+void
+RunThreadExitFunctions (void *arg)
+{
+  ThreadExitFunctions *functions = static_cast<ThreadExitFunctions *> (arg);
+  for (ThreadExitFunctions::reverse_iterator i = functions->rbegin (); i != functions->rend (); i++)
+    {
+      (*i) ();
+    }
+  delete functions;
+}
+
+void
+CreateThreadExitKey (void)
+{
+  pthread_key_create (&g_threadExitKey, &RunThreadExitFunctions);
+}
+
+} // anonymous namespace
+
+void
+AtThreadExit (void (*function) (void))
+{
+  pthread_once (&g_threadExitOnce, &CreateThreadExitKey);
+  ThreadExitFunctions *functions = static_cast<ThreadExitFunctions *> (pthread_getspecific (g_threadExitKey));
+  if (functions == 0)
+    {
+      functions = new ThreadExitFunctions ();
+      pthread_setspecific (g_threadExitKey, functions);
+    }
+  functions->push_back (function);
+}
+
+#else /* HAVE_PTHREAD_H */
+
+void
+AtThreadExit (void (*function) (void))
+{
+  // without threads there is only the main thread
+}
+
+#endif /* HAVE_PTHREAD_H */
+
+} // namespace ns3
@@ -0,0 +1,41 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef THREAD_EXIT_H
+#define THREAD_EXIT_H
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ * \param function function to call when the current thread exits
+ *
+ * Per-thread free lists (events, packets, buffers) register a function
+ * that releases the list of the thread, so that memory kept by worker
+ * threads (e.g., of MultithreadedSimulatorImpl) is not leaked when they
+ * exit.  Functions are called in the reverse order of registration.  They
+ * are not called for the main thread, whose free lists are released by
+ * static destructors.
+ */
+void AtThreadExit (void (*function) (void));
+
+} // namespace ns3
+
+#endif /* THREAD_EXIT_H */
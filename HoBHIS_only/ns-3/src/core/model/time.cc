@@ -27,6 +27,7 @@
 #include "object.h"
 #include "config.h"
 #include <cmath>
+#include <limits>
 #include <sstream>
 
 namespace ns3 {
@@ -104,6 +105,7 @@ Time::SetResolution (enum Unit unit, struct Resolution *resolution)
       uint64_t factor = (uint64_t) std::pow (10, std::fabs (shift));
       struct Information *info = &resolution->info[i];
       info->factor = factor;
+      info->maxTicks = std::numeric_limits<int64_t>::max () / static_cast<int64_t> (factor);
       if (shift == 0)
         {
           info->timeFrom = int64x64_t (1);
@@ -0,0 +1,332 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "tracepoint.h"
+#include "simulator.h"
+#include "fatal-error.h"
+#include "ns3/core-config.h"
+
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <string.h>
+
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+
+namespace ns3 {
+
+namespace {
+
+const uint32_t TRACEPOINT_MAGIC = 0x4e535450; // "NSTP"
+const uint32_t TRACEPOINT_VERSION = 1;
+
+/**
+ * \brief Ring buffer of the records of one thread
+ */
+struct TracepointBuffer
+{
+  TracepointRecord *records;
+  uint64_t mask;
+  uint64_t next; ///< \brief total number of records written into the buffer
+  uint16_t thread;
+  TracepointBuffer *nextBuffer;
+};
+
+uint32_t g_bufferSize = 65536;
+uint16_t g_nThreads = 0;
+TracepointBuffer *g_buffers = 0; // list of buffers of all threads
+
+__thread TracepointBuffer *g_buffer __attribute__ ((tls_model ("initial-exec"))) = 0;
+
+/**
+ * \brief Registered trace point (the name is copied, so the trace can be
+ * dumped after the trace point itself has been destroyed)
+ */
+struct TracepointEntry
+{
+  std::string name;
+  Tracepoint *tracepoint; ///< \brief 0 if the trace point has been destroyed
+};
+
+std::vector<TracepointEntry> *
+GetTracepointList (void)
+{
+  // never destroyed, as trace points can be dumped at exit
+  static std::vector<TracepointEntry> *tracepoints = new std::vector<TracepointEntry> ();
+  return tracepoints;
+}
+
+bool
+Matches (char const *pattern, char const *name)
+{
+  return strcmp (pattern, "*") == 0 || strcmp (pattern, name) == 0;
+}
+
+TracepointBuffer *
+AllocateBuffer (void)
+{
+  uint32_t size = 1;
+  while (size < g_bufferSize)
+    {
+      size <<= 1;
+    }
+
+  TracepointBuffer *buffer = new TracepointBuffer;
+  buffer->records = new TracepointRecord [size];
+  buffer->mask = size - 1;
+  buffer->next = 0;
+  buffer->thread = __sync_fetch_and_add (&g_nThreads, 1);
+
+  // threads are created rarely, so a simple lock-free push is sufficient
+  do
+    {
+      buffer->nextBuffer = g_buffers;
+    }
+  while (!__sync_bool_compare_and_swap (&g_buffers, buffer->nextBuffer, buffer));
+
+  return buffer;
+}
+
+bool
+RecordTimeLess (const TracepointRecord &a, const TracepointRecord &b)
+{
+  return a.time < b.time;
+}
+
+/**
+ * \brief Get copy of all records, ordered by time
+ */
+std::vector<TracepointRecord>
+CollectRecords (void)
+{
+  std::vector<TracepointRecord> records;
+  for (TracepointBuffer *buffer = g_buffers; buffer != 0; buffer = buffer->nextBuffer)
+    {
+      uint64_t size = buffer->mask + 1;
+      uint64_t first = buffer->next > size ? buffer->next - size : 0;
+      for (uint64_t i = first; i < buffer->next; i++)
+        {
+          records.push_back (buffer->records[i & buffer->mask]);
+        }
+    }
+  std::stable_sort (records.begin (), records.end (), RecordTimeLess);
+  return records;
+}
+
+/**
+ * \brief Dumps the trace into NS_TRACEPOINT_FILE on exit and releases the buffers
+ */
+struct TracepointFinalizer
+{
+  ~TracepointFinalizer ()
+  {
+#ifdef HAVE_GETENV
+    char *file = getenv ("NS_TRACEPOINT_FILE");
+    if (file != 0 && g_buffers != 0)
+      {
+        std::ofstream os (file, std::ios::out | std::ios::binary);
+        TracepointDump (os);
+      }
+#endif
+
+    while (g_buffers != 0)
+      {
+        TracepointBuffer *buffer = g_buffers;
+        g_buffers = buffer->nextBuffer;
+        delete [] buffer->records;
+        delete buffer;
+      }
+    g_buffer = 0;
+  }
+} g_tracepointFinalizer;
+
+} // anonymous namespace
+
+Tracepoint::Tracepoint (char const *name)
+  : m_name (name)
+  , m_enabled (false)
+{
+  std::vector<TracepointEntry> *tracepoints = GetTracepointList ();
+  for (std::vector<TracepointEntry>::iterator i = tracepoints->begin (); i != tracepoints->end (); i++)
+    {
+      if (i->name == name)
+        {
+          NS_FATAL_ERROR ("Trace point \"" << name << "\" has already been registered once.");
+        }
+    }
+  m_id = tracepoints->size ();
+  TracepointEntry entry;
+  entry.name = name;
+  entry.tracepoint = this;
+  tracepoints->push_back (entry);
+
+#ifdef HAVE_GETENV
+  char *envVar = getenv ("NS_TRACEPOINT");
+  if (envVar != 0)
+    {
+      std::string env = envVar;
+      std::string::size_type cur = 0;
+      std::string::size_type next = 0;
+      while (next != std::string::npos)
+        {
+          next = env.find_first_of (":", cur);
+          std::string tmp = std::string (env, cur, next - cur);
+          if (Matches (tmp.c_str (), name))
+            {
+              m_enabled = true;
+            }
+          cur = next + 1;
+        }
+    }
+#endif
+}
+
+Tracepoint::~Tracepoint ()
+{
+  // the entry (and the id) is kept, as the recorded events may still refer to it
+  (*GetTracepointList ())[m_id].tracepoint = 0;
+}
+
+void
+Tracepoint::Enable (void)
+{
+  m_enabled = true;
+}
+
+void
+Tracepoint::Disable (void)
+{
+  m_enabled = false;
+}
+
+char const *
+Tracepoint::GetName (void) const
+{
+  return m_name;
+}
+
+uint16_t
+Tracepoint::GetId (void) const
+{
+  return m_id;
+}
+
+void
+Tracepoint::Record (uint64_t a, uint64_t b) const
+{
+  TracepointBuffer *buffer = g_buffer;
+  if (buffer == 0)
+    {
+      buffer = g_buffer = AllocateBuffer ();
+    }
+
+  TracepointRecord &record = buffer->records[buffer->next & buffer->mask];
+  record.time = Simulator::Now ().GetTimeStep ();
+  record.context = Simulator::GetContext ();
+  record.id = m_id;
+  record.thread = buffer->thread;
+  record.a = a;
+  record.b = b;
+  buffer->next++;
+}
+
+void
+TracepointEnable (char const *name)
+{
+  std::vector<TracepointEntry> *tracepoints = GetTracepointList ();
+  for (std::vector<TracepointEntry>::iterator i = tracepoints->begin (); i != tracepoints->end (); i++)
+    {
+      if (i->tracepoint != 0 && Matches (name, i->name.c_str ()))
+        {
+          i->tracepoint->Enable ();
+        }
+    }
+}
+
+void
+TracepointDisable (char const *name)
+{
+  std::vector<TracepointEntry> *tracepoints = GetTracepointList ();
+  for (std::vector<TracepointEntry>::iterator i = tracepoints->begin (); i != tracepoints->end (); i++)
+    {
+      if (i->tracepoint != 0 && Matches (name, i->name.c_str ()))
+        {
+          i->tracepoint->Disable ();
+        }
+    }
+}
+
+void
+TracepointSetBufferSize (uint32_t records)
+{
+  g_bufferSize = std::max<uint32_t> (records, 1);
+}
+
+void
+TracepointClear (void)
+{
+  for (TracepointBuffer *buffer = g_buffers; buffer != 0; buffer = buffer->nextBuffer)
+    {
+      buffer->next = 0;
+    }
+}
+
+void
+TracepointDump (std::ostream &os)
+{
+  os.write (reinterpret_cast<const char *> (&TRACEPOINT_MAGIC), sizeof (TRACEPOINT_MAGIC));
+  os.write (reinterpret_cast<const char *> (&TRACEPOINT_VERSION), sizeof (TRACEPOINT_VERSION));
+
+  std::vector<TracepointEntry> *tracepoints = GetTracepointList ();
+  uint32_t nTracepoints = tracepoints->size ();
+  os.write (reinterpret_cast<const char *> (&nTracepoints), sizeof (nTracepoints));
+  for (uint32_t i = 0; i < nTracepoints; i++)
+    {
+      uint16_t id = i;
+      uint16_t length = (*tracepoints)[i].name.size ();
+      os.write (reinterpret_cast<const char *> (&id), sizeof (id));
+      os.write (reinterpret_cast<const char *> (&length), sizeof (length));
+      os.write ((*tracepoints)[i].name.data (), length);
+    }
+
+  std::vector<TracepointRecord> records = CollectRecords ();
+  uint64_t nRecords = records.size ();
+  os.write (reinterpret_cast<const char *> (&nRecords), sizeof (nRecords));
+  if (nRecords > 0)
+    {
+      os.write (reinterpret_cast<const char *> (&records[0]), nRecords * sizeof (TracepointRecord));
+    }
+}
+
+void
+TracepointPrint (std::ostream &os)
+{
+  std::vector<TracepointEntry> *tracepoints = GetTracepointList ();
+  std::vector<TracepointRecord> records = CollectRecords ();
+  for (std::vector<TracepointRecord>::iterator i = records.begin (); i != records.end (); i++)
+    {
+      os << i->time << "\t" << i->context << "\t" << i->thread << "\t"
+         << (*tracepoints)[i->id].name << "\t" << i->a << "\t" << i->b << std::endl;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef TRACEPOINT_H
+#define TRACEPOINT_H
+
+#include <stdint.h>
+#include <string>
+#include <iostream>
+
+/**
+ * \ingroup logging
+ * \defgroup tracepoint Trace points
+ * \brief Low-overhead binary trace points
+ *
+ * Unlike logging, trace points are compiled in all builds and are intended
+ * for the few hot events that need to be recorded in production (optimized)
+ * runs.  A disabled trace point costs a single check of a flag.  An enabled
+ * trace point stores a fixed-size binary record (simulation time, context,
+ * trace point id, and two integer values) into a per-thread ring buffer,
+ * keeping only the most recent records.  No formatting is done until the
+ * records are printed or dumped.
+ *
+ * Trace points are enabled with ns3::TracepointEnable or with the
+ * NS_TRACEPOINT environment variable, a ':'-separated list of trace point
+ * names ('*' enables all trace points).  If NS_TRACEPOINT_FILE environment
+ * variable is set, the recorded trace is dumped in the binary format
+ * (see ns3::TracepointDump) to this file when the program exits.
+ *
+ * Typical usage:
+ * \code
+ * NS_TRACEPOINT_DEFINE (g_enqueue, "DropTailQueue.Enqueue");
+ *
+ * bool
+ * DropTailQueue::DoEnqueue (Ptr<Packet> p)
+ * {
+ *   NS_TRACEPOINT (g_enqueue, m_packets.size (), p->GetSize ());
+ *   ...
+ * }
+ * \endcode
+ */
+
+/**
+ * \ingroup tracepoint
+ * \param var name of the trace point variable
+ * \param name unique name of the trace point
+ *
+ * Define a trace point.  Should be used at file scope.
+ */
+#define NS_TRACEPOINT_DEFINE(var, name)                         \
+  static ns3::Tracepoint var (name)
+
+/**
+ * \ingroup tracepoint
+ * \param var trace point variable defined with NS_TRACEPOINT_DEFINE
+ * \param a first value to record
+ * \param b second value to record
+ *
+ * Record an event, if the trace point is enabled.  The values are
+ * evaluated only if the trace point is enabled.
+ */
+#define NS_TRACEPOINT(var, a, b)                                \
+  do                                                            \
+    {                                                           \
+      if (var.IsEnabled ())                                     \
+        {                                                       \
+          var.Record (static_cast<uint64_t> (a),                \
+                      static_cast<uint64_t> (b));               \
+        }                                                       \
+    }                                                           \
+  while (false)
+
+namespace ns3 {
+
+/**
+ * \ingroup tracepoint
+ * \brief Binary record of one trace point event
+ */
+struct TracepointRecord
+{
+  int64_t time;     ///< \brief simulation time (in time steps)
+  uint32_t context; ///< \brief simulation context (node id)
+  uint16_t id;      ///< \brief id of the trace point (see ns3::Tracepoint::GetId)
+  uint16_t thread;  ///< \brief number of the thread that recorded the event
+  uint64_t a;       ///< \brief first recorded value
+  uint64_t b;       ///< \brief second recorded value
+};
+
+/**
+ * \ingroup tracepoint
+ * \brief A trace point (should be defined with NS_TRACEPOINT_DEFINE)
+ */
+class Tracepoint
+{
+public:
+  /**
+   * \param name unique name of the trace point
+   */
+  Tracepoint (char const *name);
+  ~Tracepoint ();
+
+  /**
+   * \brief Check if the trace point is enabled
+   */
+  inline bool
+  IsEnabled (void) const
+  {
+    return m_enabled;
+  }
+
+  /**
+   * \brief Enable the trace point
+   */
+  void
+  Enable (void);
+
+  /**
+   * \brief Disable the trace point
+   */
+  void
+  Disable (void);
+
+  /**
+   * \brief Get name of the trace point
+   */
+  char const *
+  GetName (void) const;
+
+  /**
+   * \brief Get id of the trace point (used in the binary records)
+   */
+  uint16_t
+  GetId (void) const;
+
+  /**
+   * \brief Record an event into the ring buffer of the current thread
+   */
+  void
+  Record (uint64_t a, uint64_t b) const;
+
+private:
+  // trace points are registered by address and cannot be copied
+  Tracepoint (const Tracepoint &o);
+  Tracepoint &operator = (const Tracepoint &o);
+
+  char const *m_name;
+  uint16_t m_id;
+  bool m_enabled;
+};
+
+/**
+ * \ingroup tracepoint
+ * \param name name of the trace point or '*' to enable all trace points
+ */
+void TracepointEnable (char const *name);
+
+/**
+ * \ingroup tracepoint
+ * \param name name of the trace point or '*' to disable all trace points
+ */
+void TracepointDisable (char const *name);
+
+/**
+ * \ingroup tracepoint
+ * \param records number of records kept in the ring buffer of each thread
+ *        (rounded up to a power of two, default 65536)
+ *
+ * Affects only buffers of threads that have not recorded anything yet.
+ */
+void TracepointSetBufferSize (uint32_t records);
+
+/**
+ * \ingroup tracepoint
+ * \brief Remove all recorded events
+ */
+void TracepointClear (void);
+
+/**
+ * \ingroup tracepoint
+ * \brief Write all recorded events in the binary format
+ *
+ * The format (in the host byte order) is the magic number 0x4e535450
+ * ("NSTP") and the format version (both uint32_t), the number of trace
+ * points (uint32_t) followed by their ids (uint16_t), name lengths
+ * (uint16_t) and names, the number of records (uint64_t), and the records
+ * themselves (ns3::TracepointRecord, 32 bytes each) ordered by time.
+ */
+void TracepointDump (std::ostream &os);
+
+/**
+ * \ingroup tracepoint
+ * \brief Print all recorded events (ordered by time) in text format
+ *
+ * Each line contains time (in time steps), context, thread, name of the
+ * trace point, and the two recorded values.
+ */
+void TracepointPrint (std::ostream &os);
+
+} // namespace ns3
+
+#endif /* TRACEPOINT_H */
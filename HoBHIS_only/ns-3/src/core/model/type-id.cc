@@ -22,6 +22,7 @@
 #include "trace-source-accessor.h"
 #include <vector>
 #include <sstream>
+#include <tr1/unordered_map>
 
 /*********************************************************************
  *         Helper code
@@ -65,11 +66,20 @@ public:
   uint32_t GetTraceSourceN (uint16_t uid) const;
   struct ns3::TypeId::TraceSourceInformation GetTraceSource(uint16_t uid, uint32_t i) const;
   bool MustHideFromDocumentation (uint16_t uid) const;
+  bool LookupAttribute (uint16_t uid, const std::string &name,
+                        struct ns3::TypeId::AttributeInformation *info);
+  ns3::Ptr<const ns3::TraceSourceAccessor> LookupTraceSource (uint16_t uid, const std::string &name);
 
 private:
   bool HasTraceSource (uint16_t uid, std::string name);
   bool HasAttribute (uint16_t uid, std::string name);
 
+  /**
+   * \brief Location of an attribute or a trace source: uid of the declaring TypeId and index
+   */
+  typedef std::pair<uint16_t, uint32_t> Location;
+  typedef std::tr1::unordered_map<std::string, Location> Index;
+
   struct IidInformation {
     std::string name;
     uint16_t parent;
@@ -79,30 +89,39 @@ private:
     bool mustHideFromDocumentation;
     std::vector<struct ns3::TypeId::AttributeInformation> attributes;
     std::vector<struct ns3::TypeId::TraceSourceInformation> traceSources;
+
+    // attributes and trace sources of the TypeId and all its parents, built on demand
+    Index attributeIndex;
+    Index traceSourceIndex;
+    volatile uint32_t indexGeneration;
   };
   typedef std::vector<struct IidInformation>::const_iterator Iterator;
 
   struct IidManager::IidInformation *LookupInformation (uint16_t uid) const;
+  void UpdateIndex (uint16_t uid);
 
   std::vector<struct IidInformation> m_information;
+  std::tr1::unordered_map<std::string, uint16_t> m_namemap;
+  // incremented whenever a parent, an attribute, or a trace source is registered, which
+  // invalidates the indexes
+  uint32_t m_generation;
+  // serializes rebuilds of the indexes by concurrent lookups
+  volatile int m_indexLock;
 };
 
 IidManager::IidManager ()
+  : m_generation (1),
+    m_indexLock (0)
 {
 }
 
 uint16_t
 IidManager::AllocateUid (std::string name)
 {
-  uint16_t j = 1;
-  for (Iterator i = m_information.begin (); i != m_information.end (); i++)
+  if (m_namemap.find (name) != m_namemap.end ())
     {
-      if (i->name == name)
-        {
-          NS_FATAL_ERROR ("Trying to allocate twice the same uid: " << name);
-          return 0;
-        }
-      j++;
+      NS_FATAL_ERROR ("Trying to allocate twice the same uid: " << name);
+      return 0;
     }
   struct IidInformation information;
   information.name = name;
@@ -110,9 +129,11 @@ IidManager::AllocateUid (std::string name)
   information.groupName = "";
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
+  information.indexGeneration = 0;
   m_information.push_back (information);
   uint32_t uid = m_information.size ();
   NS_ASSERT (uid <= 0xffff);
+  m_namemap[name] = uid;
   return uid;
 }
 
@@ -129,6 +150,7 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  m_generation++;
 }
 void 
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -158,17 +180,12 @@ IidManager::AddConstructor (uint16_t uid, ns3::Callback<ns3::ObjectBase *> callb
 uint16_t 
 IidManager::GetUid (std::string name) const
 {
-  uint32_t j = 1;
-  for (Iterator i = m_information.begin (); i != m_information.end (); i++)
+  std::tr1::unordered_map<std::string, uint16_t>::const_iterator i = m_namemap.find (name);
+  if (i == m_namemap.end ())
     {
-      if (i->name == name)
-        {
-          NS_ASSERT (j <= 0xffff);
-          return j;
-        }
-      j++;
+      return 0;
     }
-  return 0;
+  return i->second;
 }
 std::string 
 IidManager::GetName (uint16_t uid) const
@@ -269,6 +286,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.accessor = accessor;
   info.checker = checker;
   information->attributes.push_back (info);
+  m_generation++;
 }
 void 
 IidManager::SetAttributeInitialValue(uint16_t uid,
@@ -340,6 +358,7 @@ IidManager::AddTraceSource (uint16_t uid,
   source.help = help;
   source.accessor = accessor;
   information->traceSources.push_back (source);
+  m_generation++;
 }
 uint32_t 
 IidManager::GetTraceSourceN (uint16_t uid) const
@@ -361,6 +380,85 @@ IidManager::MustHideFromDocumentation (uint16_t uid) const
   return information->mustHideFromDocumentation;
 }
 
+void
+IidManager::UpdateIndex (uint16_t uid)
+{
+  struct IidInformation *information = LookupInformation (uid);
+  if (information->indexGeneration == m_generation)
+    {
+      // pairs with the barrier before indexGeneration is published below
+      __sync_synchronize ();
+      return;
+    }
+
+  // lookups are done from const paths, possibly by several threads at once
+  // (e.g., workers of MultithreadedSimulatorImpl), so only one of them may rebuild
+  while (__sync_lock_test_and_set (&m_indexLock, 1))
+    {
+    }
+  if (information->indexGeneration == m_generation)
+    {
+      // rebuilt by another thread while we were waiting
+      __sync_lock_release (&m_indexLock);
+      return;
+    }
+
+  information->attributeIndex.clear ();
+  information->traceSourceIndex.clear ();
+  uint16_t current = uid;
+  while (true)
+    {
+      // names are unique within the inheritance chain, so the first found declaration is the only one
+      struct IidInformation *declaring = LookupInformation (current);
+      for (uint32_t i = 0; i < declaring->attributes.size (); i++)
+        {
+          information->attributeIndex.insert (std::make_pair (declaring->attributes[i].name, Location (current, i)));
+        }
+      for (uint32_t i = 0; i < declaring->traceSources.size (); i++)
+        {
+          information->traceSourceIndex.insert (std::make_pair (declaring->traceSources[i].name, Location (current, i)));
+        }
+      if (declaring->parent == current)
+        {
+          // top of inheritance tree
+          break;
+        }
+      current = declaring->parent;
+    }
+  // make the index visible before the generation that validates it
+  __sync_synchronize ();
+  information->indexGeneration = m_generation;
+  __sync_lock_release (&m_indexLock);
+}
+
+bool
+IidManager::LookupAttribute (uint16_t uid, const std::string &name,
+                             struct ns3::TypeId::AttributeInformation *info)
+{
+  UpdateIndex (uid);
+  struct IidInformation *information = LookupInformation (uid);
+  Index::const_iterator i = information->attributeIndex.find (name);
+  if (i == information->attributeIndex.end ())
+    {
+      return false;
+    }
+  *info = LookupInformation (i->second.first)->attributes[i->second.second];
+  return true;
+}
+
+ns3::Ptr<const ns3::TraceSourceAccessor>
+IidManager::LookupTraceSource (uint16_t uid, const std::string &name)
+{
+  UpdateIndex (uid);
+  struct IidInformation *information = LookupInformation (uid);
+  Index::const_iterator i = information->traceSourceIndex.find (name);
+  if (i == information->traceSourceIndex.end ())
+    {
+      return 0;
+    }
+  return LookupInformation (i->second.first)->traceSources[i->second.second].accessor;
+}
+
 } // anonymous namespace
 
 namespace ns3 {
@@ -414,22 +512,7 @@ TypeId::GetRegistered (uint32_t i)
 bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
-  TypeId tid;
-  TypeId nextTid = *this;
-  do {
-      tid = nextTid;
-      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute(i);
-          if (tmp.name == name)
-            {
-              *info = tmp;
-              return true;
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return false;
+  return Singleton<IidManager>::Get ()->LookupAttribute (m_tid, name, info);
 }
 
 TypeId 
@@ -588,28 +671,9 @@ TypeId::HideFromDocumentation (void)
 Ptr<const TraceSourceAccessor> 
 TypeId::LookupTraceSourceByName (std::string name) const
 {
-  TypeId tid;
-  TypeId nextTid = *this;
-  do {
-      tid = nextTid;
-      for (uint32_t i = 0; i < tid.GetTraceSourceN (); i++)
-        {
-          struct TypeId::TraceSourceInformation info = tid.GetTraceSource (i);
-          if (info.name == name)
-            {
-              return info.accessor;
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return 0;
+  return Singleton<IidManager>::Get ()->LookupTraceSource (m_tid, name);
 }
 
-uint16_t 
-TypeId::GetUid (void) const
-{
-  return m_tid;
-}
 void 
 TypeId::SetUid (uint16_t tid)
 {
@@ -27,6 +27,7 @@
 #include "ns3/singleton.h"
 #include "ns3/object.h"
 #include "ns3/object-vector.h"
+#include "ns3/object-map.h"
 #include "ns3/names.h"
 #include "ns3/pointer.h"
 #include "ns3/log.h"
@@ -46,6 +47,7 @@ public:
 
   void AddNodeA (Ptr<ConfigTestObject> a);
   void AddNodeB (Ptr<ConfigTestObject> b);
+  void AddNodeC (uint32_t key, Ptr<ConfigTestObject> c);
 
   void SetNodeA (Ptr<ConfigTestObject> a);
   void SetNodeB (Ptr<ConfigTestObject> b);
@@ -56,6 +58,7 @@ public:
 private:
   std::vector<Ptr<ConfigTestObject> > m_nodesA;
   std::vector<Ptr<ConfigTestObject> > m_nodesB;
+  std::map<uint32_t, Ptr<ConfigTestObject> > m_nodesC;
   Ptr<ConfigTestObject> m_nodeA;
   Ptr<ConfigTestObject> m_nodeB;
   int8_t m_a;
@@ -76,6 +79,10 @@ ConfigTestObject::GetTypeId (void)
                    ObjectVectorValue (),
                    MakeObjectVectorAccessor (&ConfigTestObject::m_nodesB),
                    MakeObjectVectorChecker<ConfigTestObject> ())
+    .AddAttribute ("NodesC", "",
+                   ObjectMapValue (),
+                   MakeObjectMapAccessor (&ConfigTestObject::m_nodesC),
+                   MakeObjectMapChecker<ConfigTestObject> ())
     .AddAttribute ("NodeA", "",
                    PointerValue (),
                    MakePointerAccessor (&ConfigTestObject::m_nodeA),
@@ -126,6 +133,12 @@ ConfigTestObject::AddNodeB (Ptr<ConfigTestObject> b)
   m_nodesB.push_back (b);
 }
 
+void
+ConfigTestObject::AddNodeC (uint32_t key, Ptr<ConfigTestObject> c)
+{
+  m_nodesC[key] = c;
+}
+
 int8_t 
 ConfigTestObject::GetA (void) const
 {
@@ -606,6 +619,170 @@ ObjectVectorTraceConfigTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_path, "/NodeA/NodeB/NodesB/1/Source", "Trace 1 did not provide expected context");
 }
 
+// ===========================================================================
+// Test for the batched connection of trace sources
+// ===========================================================================
+class ConnectAllConfigTestCase : public TestCase
+{
+public:
+  ConnectAllConfigTestCase ();
+  virtual ~ConnectAllConfigTestCase () {}
+
+  void TraceA (int16_t oldValue, int16_t newValue) { m_newValueA = newValue; }
+  void TraceB (std::string path, int16_t oldValue, int16_t newValue) { m_newValueB = newValue; m_path = path; }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t m_newValueA;
+  int16_t m_newValueB;
+  std::string m_path;
+};
+
+ConnectAllConfigTestCase::ConnectAllConfigTestCase ()
+  : TestCase ("Check ability to connect several trace sources at once")
+{
+}
+
+void
+ConnectAllConfigTestCase::DoRun (void)
+{
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+
+  Ptr<ConfigTestObject> obj0 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj1 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj2 = CreateObject<ConfigTestObject> ();
+  root->AddNodeB (obj0);
+  root->AddNodeB (obj1);
+  root->AddNodeB (obj2);
+
+  std::vector<std::string> paths;
+  std::vector<CallbackBase> cbs;
+  paths.push_back ("/NodesB/2|0/Source");
+  cbs.push_back (MakeCallback (&ConnectAllConfigTestCase::TraceA, this));
+  Config::ConnectAllWithoutContext (paths, cbs);
+
+  paths.clear ();
+  cbs.clear ();
+  paths.push_back ("/NodesB/[1-5]/Source");
+  cbs.push_back (MakeCallback (&ConnectAllConfigTestCase::TraceB, this));
+  paths.push_back ("/NodesB/[1-5]/Source");
+  cbs.push_back (MakeCallback (&ConnectAllConfigTestCase::TraceB, this));
+  Config::ConnectAll (paths, cbs);
+
+  m_newValueA = 0;
+  m_newValueB = 0;
+  obj0->SetAttribute ("Source", IntegerValue (-2));
+  NS_TEST_ASSERT_MSG_EQ (m_newValueA, -2, "Trace 0 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_newValueB, 0, "Trace 0 fired unexpectedly");
+
+  m_newValueA = 0;
+  m_newValueB = 0;
+  obj1->SetAttribute ("Source", IntegerValue (-3));
+  NS_TEST_ASSERT_MSG_EQ (m_newValueA, 0, "Trace 1 fired unexpectedly");
+  NS_TEST_ASSERT_MSG_EQ (m_newValueB, -3, "Trace 1 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodesB/1/Source", "Trace 1 did not provide expected context");
+
+  m_newValueA = 0;
+  m_newValueB = 0;
+  obj2->SetAttribute ("Source", IntegerValue (-4));
+  NS_TEST_ASSERT_MSG_EQ (m_newValueA, -4, "Trace 2 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_newValueB, -4, "Trace 2 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodesB/2/Source", "Trace 2 did not provide expected context");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
+// ===========================================================================
+// Test for paths into an ObjectMap whose keys are not the positions of the items
+// ===========================================================================
+class ObjectMapConfigTestCase : public TestCase
+{
+public:
+  ObjectMapConfigTestCase ();
+  virtual ~ObjectMapConfigTestCase () {}
+
+  void Trace (std::string path, int16_t oldValue, int16_t newValue) { m_newValue = newValue; m_path = path; }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t m_newValue;
+  std::string m_path;
+};
+
+ObjectMapConfigTestCase::ObjectMapConfigTestCase ()
+  : TestCase ("Check ability to address items of an ObjectMap with non-contiguous keys")
+{
+}
+
+void
+ObjectMapConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+
+  //
+  // Keys 1, 5 and 9 sit at positions 0, 1 and 2 of the map
+  //
+  Ptr<ConfigTestObject> obj1 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj5 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj9 = CreateObject<ConfigTestObject> ();
+  root->AddNodeC (1, obj1);
+  root->AddNodeC (5, obj5);
+  root->AddNodeC (9, obj9);
+
+  //
+  // A key beyond the number of items
+  //
+  Config::Set ("/NodesC/5/A", IntegerValue (1));
+  obj5->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 1, "Object Attribute \"A\" not set correctly for key 5");
+  obj1->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 10, "Object Attribute \"A\" unexpectedly set for key 1");
+
+  //
+  // A key that is also the position of another item
+  //
+  Config::Set ("/NodesC/1/B", IntegerValue (2));
+  obj1->GetAttribute ("B", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 2, "Object Attribute \"B\" not set correctly for key 1");
+  obj5->GetAttribute ("B", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 9, "Object Attribute \"B\" unexpectedly set for key 5");
+
+  //
+  // Positions that are not keys do not match anything
+  //
+  Config::Set ("/NodesC/0|2/A", IntegerValue (3));
+  obj1->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 10, "Object Attribute \"A\" unexpectedly set for key 1");
+  obj9->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 10, "Object Attribute \"A\" unexpectedly set for key 9");
+
+  //
+  // Ranges and trace sources
+  //
+  Config::Set ("/NodesC/[2-9]/B", IntegerValue (4));
+  obj5->GetAttribute ("B", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 4, "Object Attribute \"B\" not set correctly for key 5");
+  obj9->GetAttribute ("B", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 4, "Object Attribute \"B\" not set correctly for key 9");
+  obj1->GetAttribute ("B", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 2, "Object Attribute \"B\" unexpectedly set for key 1");
+
+  Config::Connect ("/NodesC/9/Source", MakeCallback (&ObjectMapConfigTestCase::Trace, this));
+  m_newValue = 0;
+  m_path = "";
+  obj9->SetAttribute ("Source", IntegerValue (-5));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -5, "Trace for key 9 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodesC/9/Source", "Trace for key 9 did not provide expected context");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 // ===========================================================================
 // The Test Suite that glues all of the Test Cases together.
 // ===========================================================================
@@ -621,6 +798,8 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new RootNamespaceConfigTestCase);
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
+  AddTestCase (new ConnectAllConfigTestCase);
+  AddTestCase (new ObjectMapConfigTestCase);
 }
 
 static ConfigTestSuite configTestSuite;
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/test.h"
+#include "ns3/object.h"
+#include "ns3/log.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("ManyGetObjectCallsTest");
+
+namespace {
+
+/**
+ * \brief Object type used to build an aggregate similar to a node with
+ * the full stack installed (node, protocol, FIB, PIT, content store, ...)
+ */
+template<int N>
+class AggregatePart : public Object
+{
+public:
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId (GetName ().c_str ())
+      .SetParent<Object> ()
+      .HideFromDocumentation ()
+      ;
+    return tid;
+  }
+
+private:
+  static std::string GetName (void)
+  {
+    std::ostringstream os;
+    os << "AggregatePart" << N;
+    return os.str ();
+  }
+};
+
+} // namespace anonymous
+
+// ===========================================================================
+// Test case for many GetObject calls on one aggregate of objects
+// ===========================================================================
+
+class ManyGetObjectCallsTestCase : public TestCase
+{
+public:
+  ManyGetObjectCallsTestCase ();
+  virtual ~ManyGetObjectCallsTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  template<class T>
+  void Measure (Ptr<Object> object, const std::string &title, bool found);
+};
+
+ManyGetObjectCallsTestCase::ManyGetObjectCallsTestCase ()
+  : TestCase ("Many GetObject() calls on an aggregate of objects")
+{
+}
+
+ManyGetObjectCallsTestCase::~ManyGetObjectCallsTestCase ()
+{
+}
+
+template<class T>
+void
+ManyGetObjectCallsTestCase::Measure (Ptr<Object> object, const std::string &title, bool found)
+{
+  uint32_t count = 10000000;
+  uint32_t expected = found ? count : 0;
+  uint32_t hits = 0;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < count; i++)
+    {
+      if (object->GetObject<T> () != 0)
+        {
+          hits++;
+        }
+    }
+  int64_t ms = clock.End ();
+
+  NS_TEST_ASSERT_MSG_EQ (hits, expected, "GetObject returned unexpected result for " << title);
+  NS_LOG_INFO ("GetObject<" << title << ">: "
+               << static_cast<double> (ms) * 1000000 / count << " ns/call");
+}
+
+void
+ManyGetObjectCallsTestCase::DoRun (void)
+{
+  Ptr<Object> object = CreateObject<AggregatePart<0> > ();
+  object->AggregateObject (CreateObject<AggregatePart<1> > ());
+  object->AggregateObject (CreateObject<AggregatePart<2> > ());
+  object->AggregateObject (CreateObject<AggregatePart<3> > ());
+  object->AggregateObject (CreateObject<AggregatePart<4> > ());
+  object->AggregateObject (CreateObject<AggregatePart<5> > ());
+  object->AggregateObject (CreateObject<AggregatePart<6> > ());
+  object->AggregateObject (CreateObject<AggregatePart<7> > ());
+
+  Measure<AggregatePart<0> > (object, "first", true);
+  Measure<AggregatePart<7> > (object, "last", true);
+  Measure<AggregatePart<8> > (object, "missing", false);
+  Measure<Object> (object, "Object", true);
+}
+
+class ManyGetObjectCallsTestSuite : public TestSuite
+{
+public:
+  ManyGetObjectCallsTestSuite ();
+};
+
+ManyGetObjectCallsTestSuite::ManyGetObjectCallsTestSuite ()
+  : TestSuite ("many-get-object-calls", PERFORMANCE)
+{
+  AddTestCase (new ManyGetObjectCallsTestCase);
+}
+
+static ManyGetObjectCallsTestSuite manyGetObjectCallsTestSuite;
@@ -198,6 +198,12 @@ AggregateObjectTestCase::DoRun (void)
   Ptr<BaseB> baseBCopy = baseB;
   NS_TEST_ASSERT_MSG_NE (baseBCopy, 0, "Unable to copy BaseB");
 
+  //
+  // The objects are not aggregated yet, so we should not be able to GetObject
+  // the other part (the result of the lookup is remembered by the object).
+  //
+  NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB through unaggregated baseA");
+
   //
   // Make an aggregation of a BaseA object and a BaseB object.
   //
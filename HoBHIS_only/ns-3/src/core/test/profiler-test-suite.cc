@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/test.h"
+#include "ns3/profiler.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+
+#include <string>
+
+using namespace ns3;
+
+NS_PROFILER_STAGE_DEFINE (g_testStage, "ProfilerTest.Stage");
+
+class ProfilerTestCase : public TestCase
+{
+public:
+  ProfilerTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Event (void);
+
+  const ProfilerEntry *
+  Find (const std::vector<ProfilerEntry> &entries, uint32_t context, const std::string &stage);
+};
+
+ProfilerTestCase::ProfilerTestCase ()
+  : TestCase ("Check per-context accounting of profiled stages")
+{
+}
+
+void
+ProfilerTestCase::Event (void)
+{
+  NS_PROFILE (g_testStage);
+}
+
+const ProfilerEntry *
+ProfilerTestCase::Find (const std::vector<ProfilerEntry> &entries, uint32_t context, const std::string &stage)
+{
+  for (std::vector<ProfilerEntry>::const_iterator i = entries.begin (); i != entries.end (); i++)
+    {
+      if (i->context == context && i->stage == stage)
+        return &(*i);
+    }
+  return 0;
+}
+
+void
+ProfilerTestCase::DoRun (void)
+{
+  bool enabled = Profiler::IsEnabled ();
+  Profiler::Clear ();
+
+  // disabled profiler does not account anything
+  Profiler::Disable ();
+  Event ();
+  NS_TEST_ASSERT_MSG_EQ (Profiler::GetEntries ().size (), 0, "Disabled profiler collected statistics");
+
+  Profiler::Enable ();
+  Profiler::SetSamplingPeriod (1); // measure every execution
+  Simulator::ScheduleWithContext (7, Seconds (1.0), &ProfilerTestCase::Event, this);
+  Simulator::ScheduleWithContext (7, Seconds (2.0), &ProfilerTestCase::Event, this);
+  Simulator::ScheduleWithContext (7, Seconds (3.0), &ProfilerTestCase::Event, this);
+  Simulator::Schedule (Seconds (4.0), &ProfilerTestCase::Event, this);
+  Simulator::Run ();
+  Profiler::Disable (); // statistics are not reported and cleared by Simulator::Destroy
+  Simulator::Destroy ();
+
+  std::vector<ProfilerEntry> entries = Profiler::GetEntries ();
+  NS_TEST_ASSERT_MSG_EQ (entries.size (), 4, "Unexpected number of profiler entries");
+
+  const ProfilerEntry *stage = Find (entries, 7, "ProfilerTest.Stage");
+  NS_TEST_ASSERT_MSG_NE (stage, 0, "Stage was not accounted in context 7");
+  NS_TEST_ASSERT_MSG_EQ (stage->count, 3, "Unexpected number of executions");
+  NS_TEST_ASSERT_MSG_EQ (stage->samples, 3, "Every execution should be sampled");
+
+  const ProfilerEntry *events = Find (entries, 7, "Simulator.Event");
+  NS_TEST_ASSERT_MSG_NE (events, 0, "Events were not accounted in context 7");
+  NS_TEST_ASSERT_MSG_EQ (events->count, 3, "Unexpected number of events");
+  NS_TEST_ASSERT_MSG_EQ ((events->cycles >= stage->cycles), true, "Time of the event should include time of the stage");
+
+  stage = Find (entries, 0xffffffff, "ProfilerTest.Stage");
+  NS_TEST_ASSERT_MSG_NE (stage, 0, "Stage was not accounted without context");
+  NS_TEST_ASSERT_MSG_EQ (stage->count, 1, "Unexpected number of executions");
+
+  Profiler::SetSamplingPeriod (64);
+  Profiler::Clear ();
+  if (enabled)
+    {
+      Profiler::Enable ();
+    }
+}
+
+class ProfilerTestSuite : public TestSuite
+{
+public:
+  ProfilerTestSuite ();
+};
+
+ProfilerTestSuite::ProfilerTestSuite ()
+  : TestSuite ("profiler", UNIT)
+{
+  AddTestCase (new ProfilerTestCase);
+}
+
+static ProfilerTestSuite profilerTestSuite;
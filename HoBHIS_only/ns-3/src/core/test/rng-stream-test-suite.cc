@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/test.h"
+#include "ns3/rng-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/config.h"
+#include "ns3/enum.h"
+#include "ns3/string.h"
+#include "ns3/global-value.h"
+
+using namespace ns3;
+
+// ===========================================================================
+// Test case for selection of the RngStream engine
+// ===========================================================================
+class RngStreamEngineTestCase : public TestCase
+{
+public:
+  RngStreamEngineTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+RngStreamEngineTestCase::RngStreamEngineTestCase ()
+  : TestCase ("Selection of the RngStream engine")
+{
+}
+
+void
+RngStreamEngineTestCase::DoRun (void)
+{
+  EnumValue value;
+  GlobalValue::GetValueByName ("RngEngine", value);
+  NS_TEST_ASSERT_MSG_EQ (value.Get (), RngSeedManager::MRG32K3A, "MRG32k3a should be the default engine");
+  NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetEngine (), RngSeedManager::MRG32K3A, "MRG32k3a should be the default engine");
+
+  // first output of MRG32k3a with all components of the state set to 12345
+  RngStream mrg (12345, 0, 0);
+  NS_TEST_ASSERT_MSG_EQ_TOL (mrg.RandU01 (), 0.1270111501, 1e-10, "Unexpected MRG32k3a output");
+
+  // the global value (e.g., --RngEngine=Philox) selects the engine of streams created afterwards
+  Config::SetGlobal ("RngEngine", StringValue ("Philox"));
+  NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetEngine (), RngSeedManager::PHILOX, "RngEngine global value was not applied");
+  RngStream philox (12345, 0, 0);
+  NS_TEST_ASSERT_MSG_NE (philox.RandU01 (), 0.1270111501, "Stream created with RngEngine=Philox uses MRG32k3a");
+  NS_TEST_ASSERT_MSG_EQ_TOL (mrg.RandU01 (), 0.3185275653, 1e-10, "Existing stream should keep its engine");
+
+  Config::SetGlobal ("RngEngine", StringValue ("MRG32k3a"));
+  NS_TEST_ASSERT_MSG_EQ (RngSeedManager::GetEngine (), RngSeedManager::MRG32K3A, "RngEngine global value was not applied");
+}
+
+// ===========================================================================
+// Test case for counter-based (Philox) engine of RngStream
+// ===========================================================================
+class RngPhiloxTestCase : public TestCase
+{
+public:
+  RngPhiloxTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+RngPhiloxTestCase::RngPhiloxTestCase ()
+  : TestCase ("Philox counter-based engine")
+{
+}
+
+void
+RngPhiloxTestCase::DoRun (void)
+{
+  RngSeedManager::Engine engine = RngSeedManager::GetEngine ();
+  RngSeedManager::SetEngine (RngSeedManager::PHILOX);
+
+  // known answer of Philox4x32-10 for zero key and zero counter
+  RngStream zero (0, 0, 0);
+  const uint32_t expected[] = { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 };
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (zero.RandU01 (), (expected[i] + 0.5) / 4294967296.0, "Unexpected Philox output");
+    }
+
+  // the same seed, stream and run give the same sequence, independently of how the stream was created
+  RngStream a (12345, (1ULL<<63) + 77, 3);
+  RngStream b (12345, (1ULL<<63) + 77, 3);
+  RngStream other (12345, (1ULL<<63) + 78, 3);
+  uint32_t same = 0;
+  double sum = 0;
+  const uint32_t n = 100000;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double value = a.RandU01 ();
+      NS_TEST_ASSERT_MSG_EQ (value, b.RandU01 (), "Streams with the same parameters should be identical");
+      if (value == other.RandU01 ())
+        {
+          same++;
+        }
+      sum += value;
+    }
+  NS_TEST_ASSERT_MSG_EQ (same, 0, "Different streams should not be correlated");
+  NS_TEST_ASSERT_MSG_EQ_TOL (sum / n, 0.5, 0.01, "Mean of uniform values is out of range");
+
+  RngStream copy (a);
+  NS_TEST_ASSERT_MSG_EQ (copy.RandU01 (), a.RandU01 (), "Copy should continue the same sequence");
+
+  RngSeedManager::SetEngine (engine);
+}
+
+class RngStreamTestSuite : public TestSuite
+{
+public:
+  RngStreamTestSuite ();
+};
+
+RngStreamTestSuite::RngStreamTestSuite ()
+  : TestSuite ("rng-stream", UNIT)
+{
+  AddTestCase (new RngStreamEngineTestCase);
+  AddTestCase (new RngPhiloxTestCase);
+}
+
+static RngStreamTestSuite rngStreamTestSuite;
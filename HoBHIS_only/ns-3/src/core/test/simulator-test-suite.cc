@@ -23,6 +23,10 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/indexed-heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+
+#include <vector>
 
 using namespace ns3;
 
@@ -168,6 +172,113 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_destroy, true, "Event should have run");
 }
 
+class SimulatorRemoveTestCase : public TestCase
+{
+public:
+  SimulatorRemoveTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  void Fire (uint32_t i);
+  void RemoveSome (void);
+
+  ObjectFactory m_schedulerFactory;
+  std::vector<EventId> m_events;
+  std::vector<bool> m_removed;
+  std::vector<bool> m_fired;
+  uint64_t m_lastTs;
+  uint32_t m_seed;
+  bool m_inOrder;
+
+private:
+  uint32_t Random (uint32_t max);
+};
+
+SimulatorRemoveTestCase::SimulatorRemoveTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that many events can be removed from " + schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+uint32_t
+SimulatorRemoveTestCase::Random (uint32_t max)
+{
+  // simple deterministic generator, the test should not depend on the RNG state
+  m_seed = m_seed * 1103515245 + 12345;
+  return (m_seed >> 16) % max;
+}
+
+void
+SimulatorRemoveTestCase::Fire (uint32_t i)
+{
+  uint64_t ts = Simulator::Now ().GetTimeStep ();
+  if (ts < m_lastTs)
+    {
+      m_inOrder = false;
+    }
+  m_lastTs = ts;
+  m_fired[i] = true;
+
+  if (m_events.size () < 10000 && Random (2) == 0)
+    {
+      // events scheduled during the simulation, both in the near and in the far future
+      Time delay = Random (2) == 0 ? NanoSeconds (Random (100)) : MicroSeconds (Random (5000));
+      m_events.push_back (Simulator::Schedule (delay, &SimulatorRemoveTestCase::Fire, this, m_events.size ()));
+      m_removed.push_back (false);
+      m_fired.push_back (false);
+    }
+}
+
+void
+SimulatorRemoveTestCase::RemoveSome (void)
+{
+  for (uint32_t j = 0; j < 100; j++)
+    {
+      uint32_t i = Random (m_events.size ());
+      if (!m_events[i].IsExpired ())
+        {
+          Simulator::Remove (m_events[i]);
+          m_removed[i] = true;
+        }
+    }
+}
+
+void
+SimulatorRemoveTestCase::DoRun (void)
+{
+  Simulator::SetScheduler (m_schedulerFactory);
+
+  m_seed = 1;
+  m_lastTs = 0;
+  m_inOrder = true;
+
+  const uint32_t n = 5000;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // many events with the same timestamp
+      m_events.push_back (Simulator::Schedule (MicroSeconds (Random (1000)), &SimulatorRemoveTestCase::Fire, this, i));
+      m_removed.push_back (false);
+      m_fired.push_back (false);
+    }
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i * 100), &SimulatorRemoveTestCase::RemoveSome, this);
+    }
+  RemoveSome ();
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_inOrder, true, "Events were not executed in order");
+  uint32_t errors = 0;
+  for (uint32_t i = 0; i < m_events.size (); i++)
+    {
+      if (m_removed[i] == m_fired[i])
+        {
+          errors++;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (errors, 0, "Removed events were executed or not removed events were not executed");
+}
+
 class SimulatorTemplateTestCase : public TestCase
 {
 public:
@@ -475,5 +586,22 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory));
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory));
+    factory.SetTypeId (IndexedHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory));
+
+    factory.SetTypeId (ListScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRemoveTestCase (factory));
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRemoveTestCase (factory));
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRemoveTestCase (factory));
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRemoveTestCase (factory));
+    factory.SetTypeId (IndexedHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRemoveTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRemoveTestCase (factory));
   }
 } g_simulatorTestSuite;
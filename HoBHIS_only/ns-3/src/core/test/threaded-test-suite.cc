@@ -26,6 +26,8 @@
 #include "ns3/config.h"
 #include "ns3/string.h"
 #include "ns3/system-thread.h"
+#include "ns3/thread-exit.h"
+#include "ns3/make-event.h"
 
 #include <ctime>
 #include <list>
@@ -225,6 +227,55 @@ ThreadedSimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_a, m_d, "Bad scheduling");
 }
 
+static std::string g_threadExitOrder;
+
+static void
+ThreadExitFirst (void)
+{
+  g_threadExitOrder += "1";
+}
+
+static void
+ThreadExitSecond (void)
+{
+  g_threadExitOrder += "2";
+}
+
+static void
+ThreadExitNothing (void)
+{
+}
+
+class ThreadExitTestCase : public TestCase
+{
+public:
+  ThreadExitTestCase ()
+    : TestCase ("Check functions called at thread exit")
+  {
+  }
+
+private:
+  static void
+  Worker (void)
+  {
+    AtThreadExit (&ThreadExitFirst);
+    AtThreadExit (&ThreadExitSecond);
+    // also fills (and registers release of) the event free lists of the thread
+    EventImpl *event = MakeEvent (&ThreadExitNothing);
+    event->Unref ();
+  }
+
+  virtual void
+  DoRun (void)
+  {
+    g_threadExitOrder = "";
+    Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&ThreadExitTestCase::Worker));
+    thread->Start ();
+    thread->Join ();
+    NS_TEST_ASSERT_MSG_EQ (g_threadExitOrder, "21", "Functions should be called once, in the reverse order of registration");
+  }
+};
+
 class ThreadedSimulatorTestSuite : public TestSuite
 {
 public:
@@ -262,5 +313,6 @@ public:
               }
           }
       }
+    AddTestCase (new ThreadExitTestCase);
   }
 } g_threadedSimulatorTestSuite;
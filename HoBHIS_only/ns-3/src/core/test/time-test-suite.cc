@@ -133,6 +133,51 @@ TimesWithSignsTestCase::DoTeardown (void)
 {
 }
 
+class TimeTicksTestCase : public TestCase
+{
+public:
+  TimeTicksTestCase (enum Time::Unit resolution);
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+  enum Time::Unit m_originalResolution;
+  enum Time::Unit m_resolution;
+};
+
+TimeTicksTestCase::TimeTicksTestCase (enum Time::Unit resolution)
+  : TestCase ("Checks integer conversions to and from time units"),
+    m_resolution (resolution)
+{
+}
+
+void
+TimeTicksTestCase::DoSetup (void)
+{
+  m_originalResolution = Time::GetResolution ();
+}
+
+void
+TimeTicksTestCase::DoRun (void)
+{
+  Time::SetResolution (m_resolution);
+
+  NS_TEST_ASSERT_MSG_EQ (Time::FromTicks (1500, Time::MS), MilliSeconds (1500), "FromTicks differs from MilliSeconds");
+  NS_TEST_ASSERT_MSG_EQ (Time::FromTicks (-1500, Time::MS), MilliSeconds (-1500), "FromTicks of negative value");
+  NS_TEST_ASSERT_MSG_EQ (Time::FromTicks (2, Time::S), Seconds (2.0), "FromTicks differs from Seconds");
+  NS_TEST_ASSERT_MSG_EQ (Time::FromTicks (250000, Time::NS).ToTicks (Time::US), 250, "Round trip through microseconds");
+  NS_TEST_ASSERT_MSG_EQ (MilliSeconds (-1500).ToTicks (Time::S), -1, "ToTicks should truncate towards zero");
+  NS_TEST_ASSERT_MSG_EQ (MilliSeconds (-1500).ToTicks (Time::NS), -1500000000, "ToTicks of negative value");
+  NS_TEST_ASSERT_MSG_EQ (Time::FromTicks (1999, Time::NS).ToTicks (Time::US), 1, "Values finer than the unit are truncated");
+  NS_TEST_ASSERT_MSG_EQ (Seconds (3.0).ToTicks (Time::MS), Seconds (3.0).GetMilliSeconds (), "ToTicks differs from GetMilliSeconds");
+}
+
+void
+TimeTicksTestCase::DoTeardown (void)
+{
+  Time::SetResolution (m_originalResolution);
+}
+
 static class TimeTestSuite : public TestSuite
 {
 public:
@@ -141,5 +186,7 @@ public:
   {
     AddTestCase (new TimeSimpleTestCase (Time::US));
     AddTestCase (new TimesWithSignsTestCase ());
+    AddTestCase (new TimeTicksTestCase (Time::NS));
+    AddTestCase (new TimeTicksTestCase (Time::US));
   }
 } g_timeTestSuite;
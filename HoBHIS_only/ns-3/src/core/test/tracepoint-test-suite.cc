@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/test.h"
+#include "ns3/tracepoint.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+
+#include <sstream>
+#include <string.h>
+
+using namespace ns3;
+
+NS_TRACEPOINT_DEFINE (g_testTracepoint, "TracepointTest.Event");
+
+class TracepointTestCase : public TestCase
+{
+public:
+  TracepointTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Event (uint32_t value);
+
+  uint32_t m_evaluated;
+};
+
+TracepointTestCase::TracepointTestCase ()
+  : TestCase ("Check recording of trace points")
+{
+}
+
+void
+TracepointTestCase::Event (uint32_t value)
+{
+  NS_TRACEPOINT (g_testTracepoint, value, ++m_evaluated);
+}
+
+void
+TracepointTestCase::DoRun (void)
+{
+  TracepointClear ();
+  m_evaluated = 0;
+
+  // disabled trace point does not evaluate its arguments
+  TracepointDisable ("TracepointTest.Event");
+  Event (0);
+  NS_TEST_ASSERT_MSG_EQ (m_evaluated, 0, "Arguments of a disabled trace point were evaluated");
+
+  TracepointEnable ("TracepointTest.Event");
+  Simulator::Schedule (Seconds (2.0), &TracepointTestCase::Event, this, 20);
+  Simulator::ScheduleWithContext (7, Seconds (1.0), &TracepointTestCase::Event, this, 10);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  TracepointDisable ("TracepointTest.Event");
+
+  std::ostringstream os;
+  TracepointPrint (os);
+  std::ostringstream expected;
+  expected << Seconds (1.0).GetTimeStep () << "\t7\t0\tTracepointTest.Event\t10\t1\n"
+           << Seconds (2.0).GetTimeStep () << "\t" << 0xffffffff << "\t0\tTracepointTest.Event\t20\t2\n";
+  NS_TEST_ASSERT_MSG_EQ (os.str (), expected.str (), "Unexpected trace point records");
+
+  std::ostringstream binary;
+  TracepointDump (binary);
+  NS_TEST_ASSERT_MSG_GT (binary.str ().size (), 2 * sizeof (TracepointRecord), "Trace point records were not dumped");
+  TracepointClear ();
+
+  // records of a destroyed trace point (e.g., from an unloaded library) are still printed by name
+  char name[] = "TracepointTest.Destroyed";
+  Tracepoint *tracepoint = new Tracepoint (name);
+  tracepoint->Enable ();
+  tracepoint->Record (30, 3);
+  delete tracepoint;
+  memset (name, 'x', sizeof (name) - 1);
+  TracepointEnable ("*");
+  TracepointDisable ("*");
+
+  std::ostringstream destroyed;
+  TracepointPrint (destroyed);
+  NS_TEST_ASSERT_MSG_NE (destroyed.str ().find ("\tTracepointTest.Destroyed\t30\t3\n"), std::string::npos,
+                         "Record of a destroyed trace point was not printed with its name");
+
+  Simulator::Destroy ();
+  TracepointClear ();
+}
+
+class TracepointTestSuite : public TestSuite
+{
+public:
+  TracepointTestSuite ();
+};
+
+TracepointTestSuite::TracepointTestSuite ()
+  : TestSuite ("tracepoint", UNIT)
+{
+  AddTestCase (new TracepointTestCase);
+}
+
+static TracepointTestSuite tracepointTestSuite;
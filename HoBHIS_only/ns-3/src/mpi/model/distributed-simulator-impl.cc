@@ -28,6 +28,7 @@
 #include "ns3/pointer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/profiler.h"
 
 #include <cmath>
 
@@ -243,7 +244,10 @@ DistributedSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  {
+    ProfilerScope scope (Profiler::GetEventStage (), m_currentContext);
+    next.impl->Invoke ();
+  }
   next.impl->Unref ();
 }
 
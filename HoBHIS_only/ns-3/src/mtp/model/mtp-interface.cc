@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "mtp-interface.h"
+
+namespace ns3 {
+
+bool MtpInterface::m_enabled = false;
+uint32_t MtpInterface::m_size = 0;
+std::vector<uint32_t> MtpInterface::m_partitions;
+
+bool
+MtpInterface::IsEnabled (void)
+{
+  return m_enabled;
+}
+
+uint32_t
+MtpInterface::GetSize (void)
+{
+  return m_size;
+}
+
+uint32_t
+MtpInterface::GetPartition (uint32_t context)
+{
+  if (context < m_partitions.size ())
+    {
+      return m_partitions[context];
+    }
+  return m_size;
+}
+
+void
+MtpInterface::Enable (const std::vector<uint32_t> &partitions, uint32_t size)
+{
+  m_partitions = partitions;
+  m_size = size;
+  m_enabled = true;
+}
+
+void
+MtpInterface::Disable (void)
+{
+  m_partitions.clear ();
+  m_size = 0;
+  m_enabled = false;
+}
+
+} // namespace ns3
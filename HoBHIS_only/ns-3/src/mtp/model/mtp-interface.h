@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef MTP_INTERFACE_H
+#define MTP_INTERFACE_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \defgroup mtp Multithreaded Simulation
+ */
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Partitioning of nodes between threads of the multithreaded simulator
+ *
+ * Partitions are assigned by MultithreadedSimulatorImpl when the simulation
+ * is started.  Channels that can connect nodes of different partitions
+ * (PointToPointChannel) use this interface to detect transmissions that
+ * cross partitions.
+ */
+class MtpInterface
+{
+public:
+  /**
+   * \brief Check if nodes are partitioned between threads
+   */
+  static bool
+  IsEnabled (void);
+
+  /**
+   * \brief Get the number of partitions
+   */
+  static uint32_t
+  GetSize (void);
+
+  /**
+   * \brief Get partition of the node
+   * \param context node id (context of the events)
+   * \returns index of the partition, or GetSize () if events of the context are not
+   *          assigned to any partition (they are processed serially)
+   */
+  static uint32_t
+  GetPartition (uint32_t context);
+
+  /**
+   * \brief Set partitions of the nodes
+   * \param partitions index of the partition of each node
+   * \param size number of partitions
+   */
+  static void
+  Enable (const std::vector<uint32_t> &partitions, uint32_t size);
+
+  /**
+   * \brief Forget partitions of the nodes
+   */
+  static void
+  Disable (void);
+
+private:
+  static bool m_enabled;
+  static uint32_t m_size;
+  static std::vector<uint32_t> m_partitions;
+};
+
+} // namespace ns3
+
+#endif // MTP_INTERFACE_H
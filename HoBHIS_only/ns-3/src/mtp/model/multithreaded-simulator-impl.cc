@@ -0,0 +1,733 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "multithreaded-simulator-impl.h"
+#include "mtp-interface.h"
+#include "topology-partitioner.h"
+
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/profiler.h"
+
+#include <unistd.h>
+#include <sched.h>
+#include <algorithm>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+static const uint64_t MAX_TS = std::numeric_limits<uint64_t>::max ();
+
+// Random streams created by partition p get indexes starting from (p + 1) * STREAM_INDEX_RANGE
+// (the global counter, used outside of partitions, starts from 0)
+static const uint64_t STREAM_INDEX_RANGE = static_cast<uint64_t> (1) << 40;
+
+__thread MultithreadedSimulatorImpl::LogicalProcess *MultithreadedSimulatorImpl::m_current
+  __attribute__ ((tls_model ("initial-exec"))) = 0;
+
+static inline void
+Wait (uint32_t &spins)
+{
+  // spin for a short while, then let other threads run (there can be more threads than processors)
+  if (++spins > 1000)
+    {
+      sched_yield ();
+    }
+}
+
+static void
+ReplaceScheduler (Ptr<Scheduler> &events, ObjectFactory &factory)
+{
+  Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+  if (events != 0)
+    {
+      while (!events->IsEmpty ())
+        {
+          scheduler->Insert (events->RemoveNext ());
+        }
+    }
+  events = scheduler;
+}
+
+static void
+DisposeEvents (std::vector<Scheduler::Event> &events)
+{
+  for (std::vector<Scheduler::Event>::iterator i = events.begin (); i != events.end (); i++)
+    {
+      i->impl->Unref ();
+    }
+  events.clear ();
+}
+
+MultithreadedSimulatorImpl::LogicalProcess::LogicalProcess ()
+  : m_id (0),
+    m_uid (0),
+    m_currentUid (0),
+    m_currentTs (0),
+    m_currentContext (0xffffffff),
+    m_nextStreamIndex (0),
+    m_sense (false),
+    m_outboxTs (MAX_TS),
+    m_stopTs (MAX_TS)
+{
+}
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("ThreadCount",
+                   "Maximum number of threads (partitions), 0 to use as many threads as there are online processors",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_threadCount),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_threadCount (0),
+    m_lookahead (MAX_TS),
+    m_nextThread (0),
+    m_arrived (0),
+    m_sense (false),
+    m_stop (false),
+    m_finished (false),
+    m_parity (0),
+    m_windowEnd (0)
+{
+  NS_LOG_FUNCTION (this);
+  // uids are allocated from 4 (see DefaultSimulatorImpl)
+  m_global.m_uid = 4;
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_global.m_events != 0)
+    {
+      while (!m_global.m_events->IsEmpty ())
+        {
+          m_global.m_events->RemoveNext ().impl->Unref ();
+        }
+      m_global.m_events = 0;
+    }
+  for (std::vector<LogicalProcess *>::iterator i = m_processes.begin (); i != m_processes.end (); i++)
+    {
+      LogicalProcess *lp = *i;
+      while (!lp->m_events->IsEmpty ())
+        {
+          lp->m_events->RemoveNext ().impl->Unref ();
+        }
+      for (uint32_t parity = 0; parity < 2; parity++)
+        {
+          std::for_each (lp->m_outbox[parity].begin (), lp->m_outbox[parity].end (), DisposeEvents);
+        }
+      delete lp;
+    }
+  m_processes.clear ();
+  MtpInterface::Disable ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << &schedulerFactory);
+  m_schedulerFactory = schedulerFactory;
+  ReplaceScheduler (m_global.m_events, m_schedulerFactory);
+  for (std::vector<LogicalProcess *>::iterator i = m_processes.begin (); i != m_processes.end (); i++)
+    {
+      ReplaceScheduler ((*i)->m_events, m_schedulerFactory);
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount (void) const
+{
+  return m_processes.size ();
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead (void) const
+{
+  return TimeStep (std::min<uint64_t> (m_lookahead, GetMaximumSimulationTime ().GetTimeStep ()));
+}
+
+void
+MultithreadedSimulatorImpl::CreatePartitions (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t count = m_threadCount;
+  if (count == 0)
+    {
+      count = std::max<long> (sysconf (_SC_NPROCESSORS_ONLN), 1);
+    }
+
+  TopologyPartitioner partitioner;
+  std::vector<uint32_t> partitions = partitioner.Partition (NodeContainer::GetGlobal (), count);
+  count = partitioner.GetPartitionCount ();
+  m_lookahead = count > 1 ? partitioner.GetLookahead ().GetTimeStep () : MAX_TS;
+
+  for (uint32_t i = 0; i < count; i++)
+    {
+      LogicalProcess *lp = new LogicalProcess ();
+      lp->m_id = i;
+      lp->m_events = m_schedulerFactory.Create<Scheduler> ();
+      lp->m_uid = m_global.m_uid;
+      lp->m_currentTs = m_global.m_currentTs;
+      lp->m_nextStreamIndex = (i + 1) * STREAM_INDEX_RANGE;
+      lp->m_outbox[0].resize (count + 1);
+      lp->m_outbox[1].resize (count + 1);
+      m_processes.push_back (lp);
+    }
+  MtpInterface::Enable (partitions, count);
+
+  NS_LOG_INFO ("Nodes: " << partitions.size () << ", partitions: " << count << ", lookahead: " << GetLookahead ());
+
+  // move events scheduled for nodes to their partitions
+  std::vector<Scheduler::Event> events;
+  while (!m_global.m_events->IsEmpty ())
+    {
+      events.push_back (m_global.m_events->RemoveNext ());
+    }
+  for (std::vector<Scheduler::Event>::iterator i = events.begin (); i != events.end (); i++)
+    {
+      GetProcess (i->key.m_context)->m_events->Insert (*i);
+    }
+}
+
+MultithreadedSimulatorImpl::LogicalProcess *
+MultithreadedSimulatorImpl::GetCurrent (void) const
+{
+  if (m_current != 0)
+    {
+      return m_current;
+    }
+  return const_cast<LogicalProcess *> (&m_global);
+}
+
+MultithreadedSimulatorImpl::LogicalProcess *
+MultithreadedSimulatorImpl::GetProcess (uint32_t context) const
+{
+  uint32_t partition = MtpInterface::GetPartition (context);
+  if (partition < m_processes.size ())
+    {
+      return m_processes[partition];
+    }
+  return const_cast<LogicalProcess *> (&m_global);
+}
+
+void
+MultithreadedSimulatorImpl::Insert (LogicalProcess *lp, Scheduler::Event &ev)
+{
+  ev.key.m_uid = lp->m_uid;
+  lp->m_uid++;
+  lp->m_events->Insert (ev);
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_current == 0, "Simulator::Run cannot be called from a simulation event");
+
+  if (m_processes.empty ())
+    {
+      CreatePartitions ();
+    }
+  m_stop = false;
+  m_finished = false;
+
+  m_nextThread = 0;
+  for (uint32_t i = 1; i < m_processes.size (); i++)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&MultithreadedSimulatorImpl::Worker, this));
+      m_threads.push_back (thread);
+      thread->Start ();
+    }
+
+  // the main thread processes the first partition and events without context
+  Loop (0);
+
+  for (std::vector<Ptr<SystemThread> >::iterator i = m_threads.begin (); i != m_threads.end (); i++)
+    {
+      (*i)->Join ();
+    }
+  m_threads.clear ();
+
+  for (std::vector<LogicalProcess *>::iterator i = m_processes.begin (); i != m_processes.end (); i++)
+    {
+      m_global.m_currentTs = std::max (m_global.m_currentTs, (*i)->m_currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Worker (void)
+{
+  Loop (__sync_add_and_fetch (&m_nextThread, 1));
+}
+
+void
+MultithreadedSimulatorImpl::Loop (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  LogicalProcess *lp = m_processes[index];
+  m_current = lp;
+  uint64_t streamIndex = RngSeedManager::SetThreadStreamIndex (lp->m_nextStreamIndex);
+
+  while (true)
+    {
+      Synchronize (index, lp->m_sense);
+      if (m_finished)
+        {
+          break;
+        }
+      ProcessWindow (lp);
+    }
+
+  lp->m_nextStreamIndex = RngSeedManager::SetThreadStreamIndex (streamIndex);
+  m_current = 0;
+}
+
+void
+MultithreadedSimulatorImpl::Synchronize (uint32_t index, bool &sense)
+{
+  sense = !sense;
+  uint32_t spins = 0;
+  if (index == 0)
+    {
+      // wait for all other threads, prepare the next window, and release the threads
+      while (m_arrived != m_processes.size () - 1)
+        {
+          Wait (spins);
+        }
+      m_arrived = 0;
+      __sync_synchronize ();
+      StartWindow ();
+      __sync_synchronize ();
+      m_sense = sense;
+    }
+  else
+    {
+      __sync_fetch_and_add (&m_arrived, 1);
+      while (m_sense != sense)
+        {
+          Wait (spins);
+        }
+      __sync_synchronize ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StartWindow (void)
+{
+  uint32_t n = m_processes.size ();
+
+  // events without context sent by partitions during the last window
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (m_processes[i]->m_stopTs != MAX_TS)
+        {
+          m_stop = true;
+          m_processes[i]->m_stopTs = MAX_TS;
+        }
+
+      std::vector<Scheduler::Event> &outbox = m_processes[i]->m_outbox[m_parity][n];
+      for (std::vector<Scheduler::Event>::iterator ev = outbox.begin (); ev != outbox.end (); ev++)
+        {
+          Insert (&m_global, *ev);
+        }
+      outbox.clear ();
+    }
+  // events sent to other partitions will be delivered at the beginning of the next window
+  m_parity ^= 1;
+
+  m_current = &m_global;
+  while (true)
+    {
+      uint64_t next = MAX_TS;
+      for (uint32_t i = 0; i < n; i++)
+        {
+          LogicalProcess *lp = m_processes[i];
+          if (!lp->m_events->IsEmpty ())
+            {
+              next = std::min (next, lp->m_events->PeekNext ().key.m_ts);
+            }
+          next = std::min (next, lp->m_outboxTs);
+        }
+      uint64_t global = MAX_TS;
+      if (!m_global.m_events->IsEmpty ())
+        {
+          global = m_global.m_events->PeekNext ().key.m_ts;
+        }
+
+      if (m_stop || (next == MAX_TS && global == MAX_TS))
+        {
+          m_finished = true;
+          break;
+        }
+
+      if (global <= next)
+        {
+          // all partitions have processed events before this event
+          Scheduler::Event ev = m_global.m_events->RemoveNext ();
+          NS_ASSERT (ev.key.m_ts >= m_global.m_currentTs);
+          NS_LOG_LOGIC ("handle " << ev.key.m_ts << " without partition");
+          m_global.m_currentTs = ev.key.m_ts;
+          m_global.m_currentContext = ev.key.m_context;
+          m_global.m_currentUid = ev.key.m_uid;
+          {
+            ProfilerScope scope (Profiler::GetEventStage (), ev.key.m_context);
+            ev.impl->Invoke ();
+          }
+          ev.impl->Unref ();
+          continue;
+        }
+
+      m_windowEnd = std::min (global, next + std::min (m_lookahead, MAX_TS - next));
+      NS_LOG_LOGIC ("window [" << next << ", " << m_windowEnd << ")");
+      break;
+    }
+  m_current = m_processes[0];
+
+  if (m_finished)
+    {
+      // deliver events sent during the last window, as they will not be delivered by partitions
+      for (uint32_t src = 0; src < n; src++)
+        {
+          for (uint32_t dst = 0; dst < n; dst++)
+            {
+              std::vector<Scheduler::Event> &outbox = m_processes[src]->m_outbox[m_parity ^ 1][dst];
+              for (std::vector<Scheduler::Event>::iterator ev = outbox.begin (); ev != outbox.end (); ev++)
+                {
+                  Insert (m_processes[dst], *ev);
+                }
+              outbox.clear ();
+            }
+          m_processes[src]->m_outboxTs = MAX_TS;
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow (LogicalProcess *lp)
+{
+  // events sent to this partition during the previous window, in the order of the source partitions
+  uint32_t previous = m_parity ^ 1;
+  for (std::vector<LogicalProcess *>::iterator i = m_processes.begin (); i != m_processes.end (); i++)
+    {
+      std::vector<Scheduler::Event> &inbox = (*i)->m_outbox[previous][lp->m_id];
+      for (std::vector<Scheduler::Event>::iterator ev = inbox.begin (); ev != inbox.end (); ev++)
+        {
+          Insert (lp, *ev);
+        }
+      inbox.clear ();
+    }
+  lp->m_outboxTs = MAX_TS;
+
+  while (!lp->m_events->IsEmpty () &&
+         lp->m_events->PeekNext ().key.m_ts < m_windowEnd &&
+         lp->m_events->PeekNext ().key.m_ts <= lp->m_stopTs)
+    {
+      Scheduler::Event next = lp->m_events->RemoveNext ();
+      NS_ASSERT (next.key.m_ts >= lp->m_currentTs);
+      lp->m_currentTs = next.key.m_ts;
+      lp->m_currentContext = next.key.m_context;
+      lp->m_currentUid = next.key.m_uid;
+      {
+        ProfilerScope scope (Profiler::GetEventStage (), next.key.m_context);
+        next.impl->Invoke ();
+      }
+      next.impl->Unref ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  if (!m_global.m_events->IsEmpty ())
+    {
+      return false;
+    }
+  for (std::vector<LogicalProcess *>::const_iterator i = m_processes.begin (); i != m_processes.end (); i++)
+    {
+      if (!(*i)->m_events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  LogicalProcess *lp = GetCurrent ();
+  if (lp == &m_global)
+    {
+      // only the main thread is running (between windows or outside of Simulator::Run)
+      m_stop = true;
+    }
+  else
+    {
+      // other partitions may be in the middle of the window, so the request is applied at the barrier
+      lp->m_stopTs = std::min (lp->m_stopTs, lp->m_currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &time)
+{
+  NS_LOG_FUNCTION (this << time.GetTimeStep ());
+  Simulator::Schedule (time, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &time, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << time.GetTimeStep () << event);
+  LogicalProcess *lp = GetCurrent ();
+
+  Time tAbsolute = time + TimeStep (lp->m_currentTs);
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (lp->m_currentTs));
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+  ev.key.m_context = lp->m_currentContext;
+  Insert (lp, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << time.GetTimeStep () << event);
+  LogicalProcess *lp = GetCurrent ();
+  LogicalProcess *dst = GetProcess (context);
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = lp->m_currentTs + time.GetTimeStep ();
+  ev.key.m_context = context;
+
+  if (lp == dst || lp == &m_global)
+    {
+      // events of the same partition, or all partitions are waiting
+      Insert (dst, ev);
+      return;
+    }
+
+  if (ev.key.m_ts < m_windowEnd)
+    {
+      NS_FATAL_ERROR ("Event for context " << context << " is scheduled from context " << lp->m_currentContext
+                      << " only " << time << " in the future, which is less than lookahead "
+                      << GetLookahead () << " allows");
+    }
+  // uid will be assigned when the event is delivered
+  ev.key.m_uid = 0;
+  lp->m_outbox[m_parity][dst == &m_global ? m_processes.size () : dst->m_id].push_back (ev);
+  lp->m_outboxTs = std::min (lp->m_outboxTs, ev.key.m_ts);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+  LogicalProcess *lp = GetCurrent ();
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = lp->m_currentTs;
+  ev.key.m_context = lp->m_currentContext;
+  Insert (lp, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+  NS_ASSERT_MSG (GetCurrent () == &m_global, "Simulator::ScheduleDestroy can be called only from events without context");
+
+  EventId id (Ptr<EventImpl> (event, false), m_global.m_currentTs, 0xffffffff, 2);
+  m_destroyEvents.push_back (id);
+  m_global.m_uid++;
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  return TimeStep (GetCurrent ()->m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - GetCurrent ()->m_currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  NS_LOG_FUNCTION (this << id.GetTs () << id.GetContext () << id.GetUid ());
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  LogicalProcess *lp = GetProcess (id.GetContext ());
+  NS_ASSERT_MSG (GetCurrent () == lp || GetCurrent () == &m_global,
+                 "Event of context " << id.GetContext () << " cannot be removed from another partition");
+
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  lp->m_events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &ev) const
+{
+  if (ev.GetUid () == 2)
+    {
+      if (ev.PeekEventImpl () == 0 ||
+          ev.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == ev)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  LogicalProcess *lp = GetProcess (ev.GetContext ());
+  if (ev.PeekEventImpl () == 0 ||
+      ev.GetTs () < lp->m_currentTs ||
+      (ev.GetTs () == lp->m_currentTs &&
+       ev.GetUid () <= lp->m_currentUid) ||
+      ev.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  return GetCurrent ()->m_currentContext;
+}
+
+} // namespace ns3
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/object-factory.h"
+#include "ns3/system-thread.h"
+#include "ns3/ptr.h"
+
+#include <list>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Conservative parallel simulator, which runs partitions of the topology in several threads
+ *
+ * When the simulation is started for the first time, nodes are divided into partitions
+ * (logical processes), one per thread, using TopologyPartitioner.  Nodes connected by
+ * point-to-point links with positive delay (and without loss model) can be placed into
+ * different partitions, nodes connected by any other channel are always placed into the
+ * same partition.
+ *
+ * Partitions are synchronized using barriers: all partitions process events of the
+ * window [T, T + L), where T is time of the earliest pending event and the lookahead L
+ * is the minimum delay of the links between partitions.  Events for nodes of another
+ * partition are placed into per-partition-pair mailboxes, which are passed to the
+ * destination at the window boundary without any locking.  Events without node context
+ * (e.g., Simulator::Stop or periodic tracers) are processed serially between windows.
+ *
+ * Simulator::Stop called from an event of a node at time T is applied at the end of the
+ * current window: the partition of the node does not process events later than T, and
+ * the other partitions finish the window (i.e., they may process events that are at most
+ * lookahead later than T).
+ *
+ * The order of events does not depend on scheduling of threads, so results of
+ * simulations are repeatable for the same number of threads.
+ *
+ * Limitations:
+ * - reference counts of objects are not atomic, so objects must not be shared by nodes
+ *   of different partitions (point-to-point channels pass copies of packets between
+ *   partitions);
+ * - trace sinks connected to nodes of different partitions may be called concurrently;
+ * - an event can be scheduled for a node of another partition only through a
+ *   point-to-point link (at least lookahead time in the future).
+ *
+ * The implementation is selected with the SimulatorImplementationType global value:
+ *
+ * \code
+ * GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::MultithreadedSimulatorImpl"));
+ * Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (16));
+ * \endcode
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  static TypeId GetTypeId (void);
+
+  MultithreadedSimulatorImpl ();
+  ~MultithreadedSimulatorImpl ();
+
+  // virtual from SimulatorImpl
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &time);
+  virtual EventId Schedule (Time const &time, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &ev);
+  virtual void Cancel (const EventId &ev);
+  virtual bool IsExpired (const EventId &ev) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * \brief Get the number of partitions (0 before the simulation is started)
+   */
+  uint32_t
+  GetPartitionCount (void) const;
+
+  /**
+   * \brief Get the lookahead (minimum delay of links between partitions)
+   */
+  Time
+  GetLookahead (void) const;
+
+private:
+  /**
+   * \brief Events and the current state of one partition
+   */
+  struct LogicalProcess
+  {
+    LogicalProcess ();
+
+    uint32_t m_id;
+    Ptr<Scheduler> m_events;
+    uint32_t m_uid;
+    uint32_t m_currentUid;
+    uint64_t m_currentTs;
+    uint32_t m_currentContext;
+    uint64_t m_nextStreamIndex; ///< \brief next index of random streams created by the partition
+    bool m_sense;               ///< \brief barrier phase
+
+    /**
+     * \brief Events sent to other partitions during the current ([0] or [1]) window,
+     * indexed by the destination partition (the last one is for events without context)
+     */
+    std::vector<std::vector<Scheduler::Event> > m_outbox[2];
+    uint64_t m_outboxTs;        ///< \brief the earliest event sent during the last window
+    uint64_t m_stopTs;          ///< \brief time of Simulator::Stop called by an event of the partition
+  };
+
+  virtual void DoDispose (void);
+
+  void CreatePartitions (void);
+  LogicalProcess *GetCurrent (void) const;
+  LogicalProcess *GetProcess (uint32_t context) const;
+  void Insert (LogicalProcess *lp, Scheduler::Event &ev);
+
+  void Worker (void);
+  void Loop (uint32_t index);
+  void Synchronize (uint32_t index, bool &sense);
+  void StartWindow (void);
+  void ProcessWindow (LogicalProcess *lp);
+
+  typedef std::list<EventId> DestroyEvents;
+
+  DestroyEvents m_destroyEvents;
+  ObjectFactory m_schedulerFactory;
+  uint32_t m_threadCount;
+
+  LogicalProcess m_global;                    ///< \brief events without context (or scheduled before partitioning)
+  std::vector<LogicalProcess *> m_processes;
+  uint64_t m_lookahead;
+
+  std::vector<Ptr<SystemThread> > m_threads;
+  uint32_t m_nextThread;
+  volatile uint32_t m_arrived;                ///< \brief number of threads waiting on the barrier
+  volatile bool m_sense;                      ///< \brief barrier phase
+  bool m_stop;                                ///< \brief changed only between windows
+  bool m_finished;
+  uint32_t m_parity;                          ///< \brief mailboxes of the current window
+  uint64_t m_windowEnd;
+
+  static __thread LogicalProcess *m_current;  ///< \brief partition processed by the current thread
+};
+
+} // namespace ns3
+
+#endif // MULTITHREADED_SIMULATOR_IMPL_H
@@ -0,0 +1,706 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "topology-partitioner.h"
+
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/net-device.h"
+#include "ns3/channel.h"
+#include "ns3/pointer.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+NS_LOG_COMPONENT_DEFINE ("TopologyPartitioner");
+
+namespace ns3 {
+
+namespace {
+
+// graph is coarsened until it has about COARSEST_SIZE vertices per partition
+const uint32_t COARSEST_SIZE = 20;
+
+// maximum number of refinement passes on every level
+const uint32_t REFINE_PASSES = 8;
+
+const int64_t MAX_DELAY = std::numeric_limits<int64_t>::max ();
+
+/**
+ * \brief Graph in the compressed adjacency format (one level of the multilevel partitioning)
+ */
+struct Graph
+{
+  std::vector<double> weight;    ///< \brief weights of the vertices
+  std::vector<uint32_t> begin;   ///< \brief edges of vertex v are begin[v] .. begin[v+1]-1
+  std::vector<uint32_t> adjacent;
+  std::vector<double> edgeWeight;
+
+  uint32_t
+  GetNVertices (void) const
+  {
+    return weight.size ();
+  }
+
+  uint32_t
+  GetDegree (uint32_t v) const
+  {
+    return begin[v + 1] - begin[v];
+  }
+};
+
+struct Edge
+{
+  uint32_t from;
+  uint32_t to;
+  double weight;
+
+  bool
+  operator < (const Edge &other) const
+  {
+    return from < other.from || (from == other.from && to < other.to);
+  }
+};
+
+struct LessDegree
+{
+  LessDegree (const Graph &graph) : m_graph (graph) { }
+
+  bool
+  operator () (uint32_t a, uint32_t b) const
+  {
+    return m_graph.GetDegree (a) < m_graph.GetDegree (b);
+  }
+
+  const Graph &m_graph;
+};
+
+uint32_t
+FindRoot (std::vector<uint32_t> &parent, uint32_t v)
+{
+  while (parent[v] != v)
+    {
+      parent[v] = parent[parent[v]];
+      v = parent[v];
+    }
+  return v;
+}
+
+/**
+ * \brief Create edges of the graph (edges between the same vertices are merged)
+ *
+ * Every edge should be present in both directions
+ */
+void
+SetEdges (Graph &graph, std::vector<Edge> &edges)
+{
+  std::sort (edges.begin (), edges.end ());
+
+  uint32_t n = graph.GetNVertices ();
+  graph.begin.assign (n + 1, 0);
+  graph.adjacent.clear ();
+  graph.edgeWeight.clear ();
+
+  for (std::vector<Edge>::const_iterator i = edges.begin (); i != edges.end (); i++)
+    {
+      if (i != edges.begin () && i->from == (i - 1)->from && i->to == (i - 1)->to)
+        {
+          graph.edgeWeight.back () += i->weight;
+          continue;
+        }
+      graph.adjacent.push_back (i->to);
+      graph.edgeWeight.push_back (i->weight);
+      graph.begin[i->from + 1]++;
+    }
+
+  for (uint32_t v = 0; v < n; v++)
+    {
+      graph.begin[v + 1] += graph.begin[v];
+    }
+}
+
+/**
+ * \brief Collapse pairs of vertices connected by the heaviest edges (heavy-edge matching)
+ * \param map vertex of the coarse graph for every vertex of the graph
+ */
+void
+Coarsen (const Graph &graph, double maxWeight, Graph &coarse, std::vector<uint32_t> &map)
+{
+  uint32_t n = graph.GetNVertices ();
+
+  // vertices with fewer edges are matched first, otherwise they are likely to stay unmatched
+  std::vector<uint32_t> order (n);
+  for (uint32_t v = 0; v < n; v++)
+    {
+      order[v] = v;
+    }
+  std::stable_sort (order.begin (), order.end (), LessDegree (graph));
+
+  std::vector<uint32_t> match (n, n);
+  for (std::vector<uint32_t>::const_iterator i = order.begin (); i != order.end (); i++)
+    {
+      uint32_t v = *i;
+      if (match[v] != n)
+        continue;
+
+      uint32_t best = v;
+      double bestWeight = 0;
+      for (uint32_t e = graph.begin[v]; e < graph.begin[v + 1]; e++)
+        {
+          uint32_t u = graph.adjacent[e];
+          if (match[u] == n && graph.weight[v] + graph.weight[u] <= maxWeight &&
+              (best == v || graph.edgeWeight[e] > bestWeight))
+            {
+              best = u;
+              bestWeight = graph.edgeWeight[e];
+            }
+        }
+      match[v] = best;
+      match[best] = v;
+    }
+
+  map.assign (n, n);
+  uint32_t size = 0;
+  for (uint32_t v = 0; v < n; v++)
+    {
+      if (map[v] == n)
+        {
+          map[v] = map[match[v]] = size++;
+        }
+    }
+
+  coarse.weight.assign (size, 0);
+  for (uint32_t v = 0; v < n; v++)
+    {
+      coarse.weight[map[v]] += graph.weight[v];
+    }
+
+  std::vector<Edge> edges;
+  edges.reserve (graph.adjacent.size ());
+  for (uint32_t v = 0; v < n; v++)
+    {
+      for (uint32_t e = graph.begin[v]; e < graph.begin[v + 1]; e++)
+        {
+          Edge edge = { map[v], map[graph.adjacent[e]], graph.edgeWeight[e] };
+          if (edge.from != edge.to)
+            edges.push_back (edge);
+        }
+    }
+  SetEdges (coarse, edges);
+}
+
+/**
+ * \brief Initial partitioning: regions are grown one by one from peripheral vertices, every
+ * time adding the vertex with the heaviest connection to the region
+ */
+void
+GrowRegions (const Graph &graph, uint32_t count, std::vector<uint32_t> &part)
+{
+  uint32_t n = graph.GetNVertices ();
+  NS_ASSERT (n >= count);
+
+  double remaining = 0;
+  std::vector<std::pair<double, uint32_t> > seeds (n); // vertices with lighter edges first
+  for (uint32_t v = 0; v < n; v++)
+    {
+      remaining += graph.weight[v];
+
+      double edgeWeight = 0;
+      for (uint32_t e = graph.begin[v]; e < graph.begin[v + 1]; e++)
+        {
+          edgeWeight += graph.edgeWeight[e];
+        }
+      seeds[v] = std::make_pair (edgeWeight, v);
+    }
+  std::sort (seeds.begin (), seeds.end ());
+  std::vector<std::pair<double, uint32_t> >::const_iterator nextSeed = seeds.begin ();
+
+  part.assign (n, count); // count means not assigned yet
+  uint32_t left = n;
+
+  std::vector<double> gain (n, 0);
+  for (uint32_t p = 0; p + 1 < count; p++)
+    {
+      double target = remaining / (count - p);
+      double weight = 0;
+
+      std::set<std::pair<double, uint32_t> > frontier; // (-gain, vertex)
+      std::fill (gain.begin (), gain.end (), 0);
+
+      while (left > count - 1 - p) // at least one vertex is left for every remaining partition
+        {
+          uint32_t v;
+          if (!frontier.empty ())
+            {
+              v = frontier.begin ()->second;
+            }
+          else
+            {
+              while (part[nextSeed->second] != count)
+                {
+                  nextSeed++;
+                }
+              v = nextSeed->second;
+            }
+
+          if (weight > 0 && weight + graph.weight[v] / 2 > target)
+            break;
+
+          frontier.erase (std::make_pair (-gain[v], v));
+          part[v] = p;
+          weight += graph.weight[v];
+          left--;
+
+          for (uint32_t e = graph.begin[v]; e < graph.begin[v + 1]; e++)
+            {
+              uint32_t u = graph.adjacent[e];
+              if (part[u] != count)
+                continue;
+
+              frontier.erase (std::make_pair (-gain[u], u));
+              gain[u] += graph.edgeWeight[e];
+              frontier.insert (std::make_pair (-gain[u], u));
+            }
+        }
+
+      remaining -= weight;
+    }
+
+  for (uint32_t v = 0; v < n; v++)
+    {
+      if (part[v] == count)
+        part[v] = count - 1;
+    }
+}
+
+/**
+ * \brief Greedy k-way refinement: vertices are moved to the partitions they are connected
+ * to most, if the balance constraint allows, and from the partitions exceeding the limit
+ */
+void
+Refine (const Graph &graph, uint32_t count, double limit, std::vector<uint32_t> &part)
+{
+  uint32_t n = graph.GetNVertices ();
+
+  std::vector<double> partWeight (count, 0);
+  std::vector<uint32_t> partSize (count, 0);
+  for (uint32_t v = 0; v < n; v++)
+    {
+      partWeight[part[v]] += graph.weight[v];
+      partSize[part[v]]++;
+    }
+
+  std::vector<double> connection (count, 0);
+  std::vector<bool> connected (count, false);
+  std::vector<uint32_t> candidates;
+
+  for (uint32_t pass = 0; pass < REFINE_PASSES; pass++)
+    {
+      uint32_t moved = 0;
+      for (uint32_t v = 0; v < n; v++)
+        {
+          uint32_t own = part[v];
+          double weight = graph.weight[v];
+          if (partSize[own] == 1)
+            continue; // partitions are never left empty
+
+          candidates.clear ();
+          for (uint32_t e = graph.begin[v]; e < graph.begin[v + 1]; e++)
+            {
+              uint32_t q = part[graph.adjacent[e]];
+              if (!connected[q])
+                {
+                  connected[q] = true;
+                  candidates.push_back (q);
+                }
+              connection[q] += graph.edgeWeight[e];
+            }
+          if (candidates.empty ())
+            {
+              // isolated vertex can be placed anywhere
+              candidates.push_back (std::min_element (partWeight.begin (), partWeight.end ()) - partWeight.begin ());
+            }
+
+          bool overweight = partWeight[own] > limit;
+          uint32_t best = own;
+          double bestGain = 0;
+          for (std::vector<uint32_t>::const_iterator i = candidates.begin (); i != candidates.end (); i++)
+            {
+              uint32_t q = *i;
+              if (q == own)
+                continue;
+              if (partWeight[q] + weight > limit &&
+                  !(overweight && partWeight[q] + weight < partWeight[own]))
+                continue;
+
+              double gain = connection[q] - connection[own];
+              if (best == own || gain > bestGain || (gain == bestGain && partWeight[q] < partWeight[best]))
+                {
+                  best = q;
+                  bestGain = gain;
+                }
+            }
+
+          for (std::vector<uint32_t>::const_iterator i = candidates.begin (); i != candidates.end (); i++)
+            {
+              connection[*i] = 0;
+              connected[*i] = false;
+            }
+          connection[own] = 0;
+
+          if (best == own)
+            continue;
+
+          // moves either reduce the cut, or improve the balance
+          if (bestGain > 0 || overweight ||
+              (bestGain == 0 && partWeight[best] + weight < partWeight[own]))
+            {
+              partWeight[own] -= weight;
+              partSize[own]--;
+              partWeight[best] += weight;
+              partSize[best]++;
+              part[v] = best;
+              moved++;
+            }
+        }
+
+      if (moved == 0)
+        break;
+    }
+}
+
+} // namespace
+
+TopologyPartitioner::TopologyPartitioner ()
+  : m_imbalance (0.1)
+  , m_partitionCount (0)
+  , m_lookahead (TimeStep (MAX_DELAY))
+  , m_cutWeight (0)
+{
+}
+
+uint32_t
+TopologyPartitioner::AddNode (double weight/* = 1.0*/)
+{
+  m_nodes.push_back (weight);
+  return m_nodes.size () - 1;
+}
+
+void
+TopologyPartitioner::AddLink (uint32_t a, uint32_t b, const Time &delay, double weight/* = 1.0*/)
+{
+  NS_ASSERT (a < m_nodes.size () && b < m_nodes.size ());
+  if (a == b)
+    return;
+
+  Link link = { a, b, delay, weight };
+  m_links.push_back (link);
+}
+
+void
+TopologyPartitioner::SetImbalance (double imbalance)
+{
+  NS_ASSERT (imbalance >= 0);
+  m_imbalance = imbalance;
+}
+
+uint32_t
+TopologyPartitioner::GetNNodes (void) const
+{
+  return m_nodes.size ();
+}
+
+void
+TopologyPartitioner::Clear (void)
+{
+  m_nodes.clear ();
+  m_links.clear ();
+}
+
+uint32_t
+TopologyPartitioner::GetPartitionCount (void) const
+{
+  return m_partitionCount;
+}
+
+Time
+TopologyPartitioner::GetLookahead (void) const
+{
+  return m_lookahead;
+}
+
+double
+TopologyPartitioner::GetCutWeight (void) const
+{
+  return m_cutWeight;
+}
+
+uint32_t
+TopologyPartitioner::Group (const Time &threshold, std::vector<uint32_t> &group, double &maxWeight) const
+{
+  uint32_t n = m_nodes.size ();
+  std::vector<uint32_t> parent (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      parent[i] = i;
+    }
+
+  for (std::vector<Link>::const_iterator link = m_links.begin (); link != m_links.end (); link++)
+    {
+      if (!link->delay.IsStrictlyPositive () || link->delay < threshold)
+        {
+          parent[FindRoot (parent, link->a)] = FindRoot (parent, link->b);
+        }
+    }
+
+  std::vector<uint32_t> index (n, n);
+  std::vector<double> weight;
+  group.resize (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t root = FindRoot (parent, i);
+      if (index[root] == n)
+        {
+          index[root] = weight.size ();
+          weight.push_back (0);
+        }
+      group[i] = index[root];
+      weight[group[i]] += m_nodes[i];
+    }
+
+  maxWeight = weight.empty () ? 0 : *std::max_element (weight.begin (), weight.end ());
+  return weight.size ();
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::Partition (uint32_t count)
+{
+  NS_LOG_FUNCTION (this << count);
+
+  uint32_t n = m_nodes.size ();
+  std::vector<uint32_t> partition (n, 0);
+  m_partitionCount = 1;
+  m_lookahead = TimeStep (MAX_DELAY);
+  m_cutWeight = 0;
+
+  if (n == 0 || count <= 1)
+    return partition;
+
+  double total = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      total += m_nodes[i];
+    }
+  double limit = (1 + m_imbalance) * total / count;
+
+  // Links with delay smaller than the lookahead cannot be cut.  Select the largest lookahead,
+  // for which groups of nodes that cannot be separated still fit into balanced partitions
+  std::vector<Time> delays;
+  for (std::vector<Link>::const_iterator link = m_links.begin (); link != m_links.end (); link++)
+    {
+      if (link->delay.IsStrictlyPositive ())
+        delays.push_back (link->delay);
+    }
+  if (delays.empty ())
+    return partition;
+
+  std::sort (delays.begin (), delays.end ());
+  delays.erase (std::unique (delays.begin (), delays.end ()), delays.end ());
+
+  std::vector<uint32_t> group;
+  double maxWeight = 0;
+  uint32_t low = 0;
+  uint32_t high = delays.size () - 1;
+  while (low < high)
+    {
+      uint32_t middle = (low + high + 1) / 2;
+      if (Group (delays[middle], group, maxWeight) >= count && maxWeight <= limit)
+        low = middle;
+      else
+        high = middle - 1;
+    }
+
+  uint32_t groups = Group (delays[low], group, maxWeight);
+  count = std::min (count, groups);
+  if (count <= 1)
+    return partition;
+
+  limit = std::max (limit, maxWeight);
+  NS_LOG_DEBUG ("Lookahead " << delays[low] << ", " << groups << " groups of nodes, the largest is " << maxWeight);
+
+  std::vector<Graph> levels (1);
+  levels[0].weight.assign (groups, 0);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      levels[0].weight[group[i]] += m_nodes[i];
+    }
+
+  std::vector<Edge> edges;
+  for (std::vector<Link>::const_iterator link = m_links.begin (); link != m_links.end (); link++)
+    {
+      if (group[link->a] != group[link->b])
+        {
+          Edge forward = { group[link->a], group[link->b], link->weight };
+          Edge backward = { group[link->b], group[link->a], link->weight };
+          edges.push_back (forward);
+          edges.push_back (backward);
+        }
+    }
+  SetEdges (levels[0], edges);
+
+  // coarsening
+  uint32_t coarsestSize = COARSEST_SIZE * count;
+  double maxVertexWeight = std::max (1.5 * total / coarsestSize, maxWeight);
+  std::vector<std::vector<uint32_t> > maps;
+  while (levels.back ().GetNVertices () > coarsestSize)
+    {
+      Graph coarse;
+      std::vector<uint32_t> map;
+      Coarsen (levels.back (), maxVertexWeight, coarse, map);
+      if (coarse.GetNVertices () > 0.9 * levels.back ().GetNVertices ())
+        break; // graph cannot be coarsened anymore (e.g., star-like topology)
+
+      levels.push_back (coarse);
+      maps.push_back (map);
+    }
+  NS_LOG_DEBUG ("Coarsest graph has " << levels.back ().GetNVertices () << " vertices (" << levels.size () << " levels)");
+
+  // initial partitioning and uncoarsening
+  std::vector<uint32_t> part;
+  GrowRegions (levels.back (), count, part);
+  Refine (levels.back (), count, limit, part);
+  for (uint32_t level = levels.size () - 1; level > 0; level--)
+    {
+      const std::vector<uint32_t> &map = maps[level - 1];
+      std::vector<uint32_t> finer (map.size ());
+      for (uint32_t v = 0; v < map.size (); v++)
+        {
+          finer[v] = part[map[v]];
+        }
+      part.swap (finer);
+      Refine (levels[level - 1], count, limit, part);
+    }
+
+  // partitions are numbered in the order of their first nodes
+  std::vector<uint32_t> index (count, count);
+  m_partitionCount = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t &p = index[part[group[i]]];
+      if (p == count)
+        p = m_partitionCount++;
+      partition[i] = p;
+    }
+
+  for (std::vector<Link>::const_iterator link = m_links.begin (); link != m_links.end (); link++)
+    {
+      if (partition[link->a] != partition[link->b])
+        {
+          m_lookahead = std::min (m_lookahead, link->delay);
+          m_cutWeight += link->weight;
+        }
+    }
+
+  NS_LOG_INFO ("Nodes: " << n << ", partitions: " << m_partitionCount
+               << ", lookahead: " << m_lookahead << ", cut weight: " << m_cutWeight);
+  return partition;
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::Partition (const NodeContainer &nodes, uint32_t count)
+{
+  NS_LOG_FUNCTION (this << count);
+
+  Clear ();
+
+  uint32_t nNodes = NodeList::GetNNodes ();
+  std::vector<uint32_t> index (nNodes, nNodes);
+  for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+    {
+      index[(*node)->GetId ()] = AddNode (1 + (*node)->GetNDevices ());
+    }
+
+  TypeId pointToPoint;
+  bool hasPointToPoint = TypeId::LookupByNameFailSafe ("ns3::PointToPointChannel", &pointToPoint);
+
+  for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+    {
+      uint32_t id = (*node)->GetId ();
+      for (uint32_t i = 0; i < (*node)->GetNDevices (); i++)
+        {
+          Ptr<Channel> channel = (*node)->GetDevice (i)->GetChannel ();
+          if (channel == 0)
+            continue;
+
+          // the first node of the channel, which is partitioned
+          uint32_t first = nNodes;
+          uint32_t nDevices = 0;
+          for (uint32_t j = 0; j < channel->GetNDevices (); j++)
+            {
+              Ptr<NetDevice> device = channel->GetDevice (j);
+              if (device == 0 || device->GetNode () == 0)
+                continue;
+
+              nDevices++;
+              if (first == nNodes && index[device->GetNode ()->GetId ()] != nNodes)
+                first = device->GetNode ()->GetId ();
+            }
+
+          TimeValue delay;
+          PointerValue loss;
+          if (hasPointToPoint && channel->GetInstanceTypeId () == pointToPoint && nDevices == 2 &&
+              channel->GetAttributeFailSafe ("Delay", delay) && delay.Get ().IsStrictlyPositive () &&
+              channel->GetAttributeFailSafe ("LossModel", loss) && loss.GetObject () == 0)
+            {
+              // every link is seen from both sides
+              for (uint32_t j = 0; j < channel->GetNDevices (); j++)
+                {
+                  Ptr<NetDevice> device = channel->GetDevice (j);
+                  if (device == 0 || device->GetNode () == 0)
+                    continue;
+
+                  uint32_t peer = device->GetNode ()->GetId ();
+                  if (peer > id && index[peer] != nNodes)
+                    AddLink (index[id], index[peer], delay.Get ());
+                }
+            }
+          else if (first != id)
+            {
+              // all nodes of the channel are kept together
+              AddLink (index[id], index[first], Seconds (0));
+            }
+        }
+    }
+
+  std::vector<uint32_t> part = Partition (count);
+
+  std::vector<uint32_t> partition (nNodes, 0);
+  for (uint32_t id = 0; id < nNodes; id++)
+    {
+      if (index[id] != nNodes)
+        partition[id] = part[index[id]];
+    }
+  return partition;
+}
+
+} // namespace ns3
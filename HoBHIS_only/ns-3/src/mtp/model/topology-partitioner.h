@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef TOPOLOGY_PARTITIONER_H
+#define TOPOLOGY_PARTITIONER_H
+
+#include "ns3/nstime.h"
+#include "ns3/node-container.h"
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Partitioning of the topology for parallel (multithreaded or distributed) simulations
+ *
+ * The topology is split into the requested number of partitions, so that:
+ * - the lookahead (the minimum delay of the links between partitions) is as large as possible,
+ *   provided that the partitions can still be balanced;
+ * - the total weight of the nodes (approximate processing load) of every partition does not
+ *   exceed the average by more than the allowed imbalance;
+ * - the total weight of the links between partitions (cross-partition traffic) is minimized.
+ *
+ * Links with delay below the selected lookahead are never cut.  The remaining graph is
+ * partitioned using multilevel k-way partitioning: the graph is coarsened by collapsing
+ * heavy edges, the coarsest graph is split by greedy region growing, and the partitioning
+ * is refined on every level while the graph is uncoarsened.  The result is deterministic
+ * (the simulation random streams are not used).
+ *
+ * \code
+ * TopologyPartitioner partitioner;
+ * uint32_t a = partitioner.AddNode ();
+ * uint32_t b = partitioner.AddNode ();
+ * partitioner.AddLink (a, b, MilliSeconds (10));
+ * ...
+ * std::vector<uint32_t> partitions = partitioner.Partition (4);
+ * \endcode
+ *
+ * The topology that has been already created can be partitioned using
+ * Partition (const NodeContainer &, uint32_t).
+ */
+class TopologyPartitioner
+{
+public:
+  TopologyPartitioner ();
+
+  /**
+   * \brief Add node to the graph
+   * \param weight approximate processing load of the node (e.g., 1 + number of links)
+   * \returns index of the node
+   */
+  uint32_t
+  AddNode (double weight = 1.0);
+
+  /**
+   * \brief Add link to the graph
+   * \param a index of the first node
+   * \param b index of the second node
+   * \param delay propagation delay of the link (zero, if the link cannot connect different partitions)
+   * \param weight approximate traffic on the link (e.g., the link capacity)
+   */
+  void
+  AddLink (uint32_t a, uint32_t b, const Time &delay, double weight = 1.0);
+
+  /**
+   * \brief Set allowed imbalance of the partitions
+   * \param imbalance fraction, by which the weight of a partition can exceed the average (0.1 by default)
+   */
+  void
+  SetImbalance (double imbalance);
+
+  /**
+   * \brief Get the number of nodes in the graph
+   */
+  uint32_t
+  GetNNodes (void) const;
+
+  /**
+   * \brief Remove all nodes and links from the graph
+   */
+  void
+  Clear (void);
+
+  /**
+   * \brief Partition the graph
+   * \param count requested number of partitions
+   * \returns index of the partition of every node.  If the graph cannot be split into the
+   *          requested number of partitions (e.g., there are fewer nodes), fewer partitions
+   *          are created (see GetPartitionCount)
+   */
+  std::vector<uint32_t>
+  Partition (uint32_t count);
+
+  /**
+   * \brief Partition nodes of the topology, which has been already created
+   *
+   * Nodes connected by point-to-point links with positive delay and without loss model can
+   * be placed into different partitions.  Nodes connected by any other channel are always
+   * placed into the same partition.  Weight of a node is 1 + number of its devices.
+   *
+   * \param nodes nodes to partition (e.g., NodeContainer::GetGlobal ())
+   * \param count requested number of partitions
+   * \returns index of the partition of every node, indexed by node id (nodes, which
+   *          are not in the container, are assigned to partition 0)
+   */
+  std::vector<uint32_t>
+  Partition (const NodeContainer &nodes, uint32_t count);
+
+  /**
+   * \brief Get the number of partitions created by the last call to Partition
+   */
+  uint32_t
+  GetPartitionCount (void) const;
+
+  /**
+   * \brief Get the minimum delay of the links between partitions, created by the last call to
+   *        Partition (maximum time value, if no links have been cut)
+   */
+  Time
+  GetLookahead (void) const;
+
+  /**
+   * \brief Get the total weight of the links between partitions, created by the last call to Partition
+   */
+  double
+  GetCutWeight (void) const;
+
+private:
+  struct Link
+  {
+    uint32_t a;
+    uint32_t b;
+    Time delay;
+    double weight;
+  };
+
+  /**
+   * \brief Join nodes that are connected by links with delay below the threshold (or zero delay)
+   * \param threshold minimum delay of the links that can be cut
+   * \param group group of every node (groups are numbered from 0 in the order of their first nodes)
+   * \param maxWeight the largest total weight of the nodes of a group
+   * \returns the number of groups
+   */
+  uint32_t
+  Group (const Time &threshold, std::vector<uint32_t> &group, double &maxWeight) const;
+
+private:
+  std::vector<double> m_nodes;
+  std::vector<Link> m_links;
+  double m_imbalance;
+
+  uint32_t m_partitionCount;
+  Time m_lookahead;
+  double m_cutWeight;
+};
+
+} // namespace ns3
+
+#endif // TOPOLOGY_PARTITIONER_H
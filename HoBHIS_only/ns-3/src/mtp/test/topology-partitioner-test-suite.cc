@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/test.h"
+#include "ns3/topology-partitioner.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \brief Check balance and cut of a grid partitioned into 4 parts
+ */
+class TopologyPartitionerGridTestCase : public TestCase
+{
+public:
+  TopologyPartitionerGridTestCase ()
+    : TestCase ("Partition 8x8 grid into 4 balanced partitions")
+  {
+  }
+
+  virtual void
+  DoRun (void)
+  {
+    const uint32_t size = 8;
+
+    TopologyPartitioner partitioner;
+    for (uint32_t i = 0; i < size * size; i++)
+      {
+        partitioner.AddNode ();
+      }
+    for (uint32_t row = 0; row < size; row++)
+      {
+        for (uint32_t column = 0; column < size; column++)
+          {
+            uint32_t node = row * size + column;
+            if (column + 1 < size)
+              partitioner.AddLink (node, node + 1, MilliSeconds (1));
+            if (row + 1 < size)
+              partitioner.AddLink (node, node + size, MilliSeconds (1));
+          }
+      }
+
+    std::vector<uint32_t> partitions = partitioner.Partition (4);
+    NS_TEST_ASSERT_MSG_EQ (partitions.size (), size * size, "Partition should be assigned to every node");
+    NS_TEST_ASSERT_MSG_EQ (partitioner.GetPartitionCount (), 4, "Grid should be split into 4 partitions");
+
+    std::vector<uint32_t> nodes (4, 0);
+    for (uint32_t i = 0; i < partitions.size (); i++)
+      {
+        NS_TEST_ASSERT_MSG_LT (partitions[i], 4, "Invalid partition");
+        nodes[partitions[i]]++;
+      }
+    for (uint32_t p = 0; p < 4; p++)
+      {
+        NS_TEST_EXPECT_MSG_LT (nodes[p], 18, "Partition " << p << " is not balanced");
+      }
+
+    // 4 quadrants are cut by 16 links, 4 stripes by 24 links
+    NS_TEST_EXPECT_MSG_LT (partitioner.GetCutWeight (), 24.5, "Too many links are cut");
+    NS_TEST_EXPECT_MSG_EQ (partitioner.GetLookahead (), MilliSeconds (1), "Wrong lookahead");
+  }
+};
+
+/**
+ * \brief Check that links with small delay are not cut, if partitions can be balanced without them
+ */
+class TopologyPartitionerLookaheadTestCase : public TestCase
+{
+public:
+  TopologyPartitionerLookaheadTestCase ()
+    : TestCase ("Links with small delay are not cut")
+  {
+  }
+
+  virtual void
+  DoRun (void)
+  {
+    const uint32_t size = 16;
+
+    // ring, where every second link is slow
+    TopologyPartitioner partitioner;
+    for (uint32_t i = 0; i < size; i++)
+      {
+        partitioner.AddNode ();
+      }
+    for (uint32_t i = 0; i < size; i++)
+      {
+        partitioner.AddLink (i, (i + 1) % size, i % 2 == 0 ? MilliSeconds (1) : MilliSeconds (10));
+      }
+
+    std::vector<uint32_t> partitions = partitioner.Partition (4);
+    NS_TEST_ASSERT_MSG_EQ (partitioner.GetPartitionCount (), 4, "Ring should be split into 4 partitions");
+    NS_TEST_EXPECT_MSG_EQ (partitioner.GetLookahead (), MilliSeconds (10), "Only slow links should be cut");
+    NS_TEST_EXPECT_MSG_EQ (partitioner.GetCutWeight (), 4, "Ring should be cut into 4 arcs");
+    for (uint32_t i = 0; i < size; i += 2)
+      {
+        NS_TEST_EXPECT_MSG_EQ (partitions[i], partitions[i + 1], "Fast link " << i << " is cut");
+      }
+  }
+};
+
+/**
+ * \brief Check that nodes connected by links without delay are never separated
+ */
+class TopologyPartitionerJoinedTestCase : public TestCase
+{
+public:
+  TopologyPartitionerJoinedTestCase ()
+    : TestCase ("Links without delay are never cut")
+  {
+  }
+
+  virtual void
+  DoRun (void)
+  {
+    TopologyPartitioner partitioner;
+    for (uint32_t i = 0; i < 6; i++)
+      {
+        partitioner.AddNode ();
+      }
+    // two groups of nodes, connected by a single link
+    partitioner.AddLink (0, 1, Seconds (0));
+    partitioner.AddLink (1, 2, Seconds (0));
+    partitioner.AddLink (3, 4, Seconds (0));
+    partitioner.AddLink (4, 5, Seconds (0));
+    partitioner.AddLink (2, 3, MilliSeconds (5));
+
+    std::vector<uint32_t> partitions = partitioner.Partition (4);
+    NS_TEST_ASSERT_MSG_EQ (partitioner.GetPartitionCount (), 2, "Only two partitions can be created");
+    NS_TEST_EXPECT_MSG_EQ (partitions[0], 0, "The first node should be in the first partition");
+    NS_TEST_EXPECT_MSG_EQ (partitions[1], partitions[0], "Nodes 0 and 1 should not be separated");
+    NS_TEST_EXPECT_MSG_EQ (partitions[2], partitions[0], "Nodes 0 and 2 should not be separated");
+    NS_TEST_EXPECT_MSG_EQ (partitions[4], partitions[3], "Nodes 3 and 4 should not be separated");
+    NS_TEST_EXPECT_MSG_EQ (partitions[5], partitions[3], "Nodes 3 and 5 should not be separated");
+    NS_TEST_EXPECT_MSG_EQ (partitioner.GetLookahead (), MilliSeconds (5), "Wrong lookahead");
+  }
+};
+
+class TopologyPartitionerTestSuite : public TestSuite
+{
+public:
+  TopologyPartitionerTestSuite ()
+    : TestSuite ("topology-partitioner", UNIT)
+  {
+    AddTestCase (new TopologyPartitionerGridTestCase);
+    AddTestCase (new TopologyPartitionerLookaheadTestCase);
+    AddTestCase (new TopologyPartitionerJoinedTestCase);
+  }
+};
+
+static TopologyPartitionerTestSuite g_topologyPartitionerTestSuite;
@@ -104,7 +104,7 @@ ConsumerWindowCUBIC::AdjustWindowOnContentObject (const Ptr<const ContentObjectH
         {
           // new epoch
           m_epoch_start = Simulator::Now();
-          m_k = pow((m_last_window - m_window) / m_c, 1/3);
+          m_k = pow(static_cast<double> ((m_last_window - m_window) / m_c), 1/3);
           m_origin_point = m_last_window;
         }
 
@@ -28,6 +28,9 @@
 #include "ns3/uinteger.h"
 #include "ns3/double.h"
 
+#include <algorithm>
+#include <limits>
+
 NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerWindow");
 
 namespace ns3 {
@@ -102,6 +105,11 @@ ConsumerWindow::ScheduleNextPacket ()
     {
       // simply do nothing
     }
+  else if (m_inFlight > static_cast<uint32_t> (0) && m_retxSeqs.empty () &&
+           m_window - m_inFlight < GetMinBatchCredit ())
+    {
+      // wait until the window has room for a full batch
+    }
   else
     {
       if (m_sendEvent.IsRunning ())
@@ -113,6 +121,28 @@ ConsumerWindow::ScheduleNextPacket ()
     }
 }
 
+uint32_t
+ConsumerWindow::GetMinBatchCredit () const
+{
+  if (m_maxBatchSize <= 1 || m_randCompLenMax != 0)
+    return 1;
+
+  uint32_t credit = std::min<uint32_t> (m_maxBatchSize, m_window);
+  if (m_seqMax != std::numeric_limits<uint32_t>::max () && m_seqMax > m_seq)
+    credit = std::min (credit, m_seqMax - m_seq);
+
+  return std::max<uint32_t> (credit, 1);
+}
+
+uint32_t
+ConsumerWindow::GetBatchCredit () const
+{
+  if (m_window > m_inFlight)
+    return m_window - m_inFlight;
+  else
+    return 1;
+}
+
 void
 ConsumerWindow::WillSendOutInterest (uint32_t sequenceNumber)
 {
@@ -71,6 +71,18 @@ protected:
   virtual void
   ScheduleNextPacket ();
 
+  /**
+   * @brief Batch is limited by the free space of the window
+   */
+  virtual uint32_t
+  GetBatchCredit () const;
+
+  /**
+   * @brief Free space of the window, which is necessary to send out a new batched Interest
+   */
+  uint32_t
+  GetMinBatchCredit () const;
+
   virtual void AdjustWindowOnNack (const Ptr<const InterestHeader> &interest, Ptr<Packet> payload);
   virtual void AdjustWindowOnContentObject (const Ptr<const ContentObjectHeader> &contentObject,
                                             Ptr<Packet> payload);
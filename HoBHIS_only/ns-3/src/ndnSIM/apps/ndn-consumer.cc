@@ -76,6 +76,13 @@ Consumer::GetTypeId (void)
                    MakeTimeAccessor (&Consumer::m_interestLifeTime),
                    MakeTimeChecker ())
 
+    .AddAttribute ("MaxBatchSize",
+                   "Maximum number of new sequence numbers requested by one (batched) Interest. "
+                   "Batching is disabled if set to 1 or if RandComponentLenMax is not zero",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&Consumer::m_maxBatchSize),
+                   MakeUintegerChecker<uint32_t> (1))
+
     .AddAttribute ("RetxTimer",
                    "Timeout defining how frequent retransmission timeouts should be checked",
                    StringValue ("50ms"),
@@ -96,6 +103,7 @@ Consumer::Consumer ()
   : m_rand (0, std::numeric_limits<uint32_t>::max ())
   , m_seq (0)
   , m_seqMax (0) // don't request anything
+  , m_maxBatchSize (1) // no batching
   , m_randCompLenMax (0) // no random components to be added
   , m_randCompName () // No random components
 {
@@ -104,6 +112,12 @@ Consumer::Consumer ()
   m_rtt = CreateObject<RttMeanDeviation> ();
 }
 
+uint32_t
+Consumer::GetBatchCredit () const
+{
+  return m_maxBatchSize;
+}
+
 void
 Consumer::SetRetxTimer (Time retxTimer)
 {
@@ -183,6 +197,7 @@ Consumer::SendPacket ()
   NS_LOG_FUNCTION_NOARGS ();
 
   uint32_t seq=std::numeric_limits<uint32_t>::max (); //invalid
+  uint32_t batchSize = 1; // retransmissions are never batched
 
   while (m_retxSeqs.size ())
     {
@@ -203,6 +218,16 @@ Consumer::SendPacket ()
 
       seq = m_seq++;
 
+      if (m_maxBatchSize > 1 && m_randCompLenMax == 0)
+        {
+          batchSize = std::min (m_maxBatchSize, GetBatchCredit ());
+          if (m_seqMax != std::numeric_limits<uint32_t>::max ())
+            {
+              batchSize = std::min (batchSize, m_seqMax - seq);
+            }
+          batchSize = std::max<uint32_t> (batchSize, 1);
+          m_seq = seq + batchSize;
+        }
     }
 
   //
@@ -227,6 +252,7 @@ Consumer::SendPacket ()
   InterestHeader interestHeader;
   interestHeader.SetNonce               (m_rand.GetValue ());
   interestHeader.SetName                (nameWithSequence);
+  interestHeader.SetBatchSize           (batchSize);
 
   // NS_LOG_INFO ("Requesting Interest: \n" << interestHeader);
   NS_LOG_INFO ("> Interest for " << seq);
@@ -236,7 +262,10 @@ Consumer::SendPacket ()
   NS_LOG_DEBUG ("Interest packet size: " << packet->GetSize ());
   NS_LOG_DEBUG ("Interest packet name: " << interestHeader);
 
-  WillSendOutInterest(seq);
+  for (uint32_t i = 0; i < batchSize; i++)
+    {
+      WillSendOutInterest (seq + i);
+    }
 
   FwHopCountTag hopCountTag;
   packet->AddPacketTag (hopCountTag);
@@ -124,6 +124,15 @@ protected:
   Time
   GetRetxTimer () const;
 
+  /**
+   * \brief Returns how many new sequence numbers can be requested right now by one batched Interest
+   *
+   * The actual batch size is also limited by MaxBatchSize attribute and MaxSeq.  Default
+   * implementation does not impose any additional limit.
+   */
+  virtual uint32_t
+  GetBatchCredit () const;
+
 protected:
   UniformVariable m_rand; ///< @brief nonce generator
 
@@ -139,6 +148,7 @@ protected:
   NameComponents     m_interestName;        ///< \brief NDN Name of the Interest (use NameComponents)
   Time               m_interestLifeTime;    ///< \brief LifeTime for interest packet
 
+  uint32_t        m_maxBatchSize;     ///< @brief maximum number of sequence numbers requested by one Interest
   uint32_t        m_randCompLenMax;   ///< @brief maximum length of randomly added component
   std::string     m_randCompName;     ///< @brief string from which random component names will be built
 
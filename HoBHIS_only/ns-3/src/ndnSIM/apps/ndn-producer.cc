@@ -34,6 +34,7 @@
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
 
 #include <boost/ref.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
 namespace ll = boost::lambda;
@@ -127,15 +128,56 @@ void
 Producer::OnInterest (const Ptr<const InterestHeader> &interest, Ptr<Packet> origPacket)
 {
   App::OnInterest (interest, origPacket); // tracing inside
-  int packet_size;
 
   NS_LOG_FUNCTION (this << interest);
 
   if (!m_active) return;
     
+  // echo back FwHopCountTag if exists
+  FwHopCountTag hopCountTag;
+  bool hasHopCountTag = origPacket->RemovePacketTag (hopCountTag);
+
+  // batched Interest requests a range of sequence numbers, starting with the last component of the name
+  uint32_t first = 0;
+  uint32_t batchSize = interest->GetBatchSize ();
+  std::list<boost::reference_wrapper<const std::string> > prefix;
+  if (batchSize > 1)
+    {
+      try
+        {
+          first = boost::lexical_cast<uint32_t> (interest->GetName ().GetLastComponent ());
+          prefix = interest->GetName ().GetSubComponents (interest->GetName ().size () - 1);
+        }
+      catch (boost::bad_lexical_cast &)
+        {
+          NS_LOG_DEBUG ("Last component of batched Interest is not a sequence number, only the name is satisfied");
+          batchSize = 1;
+        }
+    }
+
+  for (uint32_t i = 0; i < batchSize; i++)
+    {
+      Ptr<NameComponents> name;
+      if (batchSize > 1)
+        {
+          name = Create<NameComponents> (prefix);
+          (*name) (first + i);
+        }
+      else
+        name = Create<NameComponents> (interest->GetName ());
+
+      SendContentObject (name, hasHopCountTag ? &hopCountTag : 0);
+    }
+}
+
+void
+Producer::SendContentObject (Ptr<NameComponents> name, const FwHopCountTag *hopCountTag)
+{
+  int packet_size;
+
   static ContentObjectTail tail;
   Ptr<ContentObjectHeader> header = Create<ContentObjectHeader> ();
-  header->SetName (Create<NameComponents> (interest->GetName ()));
+  header->SetName (name);
   header->SetFreshness (m_freshness);
 
   NS_LOG_INFO ("node("<< GetNode()->GetId() <<") respodning with ContentObject:\n" << boost::cref(*header));
@@ -151,11 +193,9 @@ Producer::OnInterest (const Ptr<const InterestHeader> &interest, Ptr<Packet> ori
   packet->AddHeader (*header);
   packet->AddTrailer (tail);
 
-  // Echo back FwHopCountTag if exists
-  FwHopCountTag hopCountTag;
-  if (origPacket->RemovePacketTag (hopCountTag))
+  if (hopCountTag != 0)
     {
-      packet->AddPacketTag (hopCountTag);
+      packet->AddPacketTag (*hopCountTag);
     }
 
 Time rtt_del = Seconds(m_rand_rtt.GetValue(m_virtualDelayMin, m_virtualDelayMax));
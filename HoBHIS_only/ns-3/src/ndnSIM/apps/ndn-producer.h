@@ -32,6 +32,8 @@
 namespace ns3 {
 namespace ndn {
 
+class FwHopCountTag;
+
 /**
  * @brief A simple Interest-sink applia simple Interest-sink application
  *
@@ -59,6 +61,14 @@ protected:
   virtual void
   StopApplication ();     // Called at time specified by Stop
 
+  /**
+   * @brief Create and send out Data packet with the specified name
+   * @param name name of the Data packet
+   * @param hopCountTag hop count tag of the Interest to echo back (0 if Interest did not have one)
+   */
+  void
+  SendContentObject (Ptr<NameComponents> name, const FwHopCountTag *hopCountTag);
+
 private:
   NameComponents m_prefix;
   uint32_t m_virtualPayloadSize;
@@ -36,6 +36,8 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/system-thread.h"
+#include "ns3/simulation-singleton.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
@@ -43,10 +45,14 @@
 // #include <boost/graph/graph_concepts.hpp>
 // #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/graph/compressed_sparse_row_graph.hpp>
 
 #include "boost-graph-ndn-global-routing-helper.h"
 
 #include <math.h>
+#include <unistd.h>
+#include <queue>
+#include <set>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingHelper");
 
@@ -56,6 +62,656 @@ using namespace boost;
 namespace ns3 {
 namespace ndn {
 
+/// @cond include_hidden
+
+/**
+ * @brief Edge of the routing graph snapshot (first hop face, routing metric, link delay)
+ */
+struct RouteEdge
+{
+  Face *face;
+  uint32_t metric;
+  double delay;
+};
+
+/**
+ * @brief Distance to a vertex (first hop face, path metric, path delay)
+ *
+ * Raw face pointers are used intentionally: shortest paths are calculated concurrently and
+ * reference counters of ns-3 objects are not thread-safe
+ */
+struct RouteDistance
+{
+  RouteDistance ()
+    : face (0), metric (0), delay (0.0)
+  {
+  }
+
+  RouteDistance (Face *f, uint32_t m, double d)
+    : face (f), metric (m), delay (d)
+  {
+  }
+
+  Face *face;
+  uint32_t metric;
+  double delay;
+};
+
+struct RouteCompare
+{
+  bool
+  operator () (const RouteDistance &a, const RouteDistance &b) const
+  {
+    return a.metric < b.metric;
+  }
+};
+
+struct RouteCombine
+{
+  RouteDistance
+  operator () (const RouteDistance &a, const RouteEdge &b) const
+  {
+    return RouteDistance (a.face == 0 ? b.face : a.face, a.metric + b.metric, a.delay + b.delay);
+  }
+};
+
+/**
+ * @brief Immutable CSR snapshot of NdnGlobalRouterGraph
+ *
+ * Edge weights (face metrics and link delays from Limits) are resolved once when the
+ * snapshot is created, so that shortest path calculation does not touch any ns-3 object
+ * and can be safely run from several threads.  Order of the vertices and of the outgoing
+ * edges is the same as in NdnGlobalRouterGraph, which makes results of Dijkstra
+ * identical to those obtained on the original graph.
+ */
+class RoutingGraphSnapshot
+{
+public:
+  typedef compressed_sparse_row_graph<directedS, no_property, RouteEdge> Graph;
+
+  RoutingGraphSnapshot ()
+  {
+    NdnGlobalRouterGraph graph;
+    std::map<Ptr<GlobalRouter>, uint32_t> index;
+
+    BOOST_FOREACH (const Ptr<GlobalRouter> &router, graph.GetVertices ())
+      {
+        index[router] = m_routers.size ();
+        m_routers.push_back (router);
+      }
+
+    std::vector< std::pair<uint32_t, uint32_t> > edges;
+    std::vector<RouteEdge> weights;
+    for (uint32_t source = 0; source < m_routers.size (); source++)
+      {
+        BOOST_FOREACH (const GlobalRouter::Incidency &incidency, m_routers[source]->GetIncidencies ())
+          {
+            RouteEdge weight = { 0, 0, 0.0 };
+            Ptr<Face> face = incidency.get<1> ();
+            if (face != 0)
+              {
+                weight.face = PeekPointer (face);
+                weight.metric = face->GetMetric ();
+
+                Ptr<Limits> limits = face->GetObject<Limits> ();
+                if (limits != 0) // valid limits object
+                  {
+                    weight.delay = limits->GetLinkDelay ();
+                  }
+              }
+
+            edges.push_back (std::make_pair (source, index[incidency.get<2> ()]));
+            weights.push_back (weight);
+          }
+      }
+
+    m_graph = Graph (edges_are_sorted, edges.begin (), edges.end (), weights.begin (), m_routers.size ());
+
+    for (uint32_t vertex = 0; vertex < m_routers.size (); vertex++)
+      {
+        m_index[PeekPointer (m_routers[vertex])] = vertex;
+      }
+  }
+
+  uint32_t
+  GetNVertices () const
+  {
+    return m_routers.size ();
+  }
+
+  Ptr<GlobalRouter>
+  GetRouter (uint32_t vertex) const
+  {
+    return m_routers[vertex];
+  }
+
+  uint32_t
+  GetVertex (Ptr<GlobalRouter> router) const
+  {
+    std::map<GlobalRouter*, uint32_t>::const_iterator i = m_index.find (PeekPointer (router));
+    NS_ASSERT (i != m_index.end ());
+    return i->second;
+  }
+
+  /**
+   * @brief Calculate shortest path tree from the source vertex (thread-safe)
+   */
+  void
+  CalculateShortestPaths (uint32_t source, std::vector<RouteDistance> &distances) const
+  {
+    distances.resize (m_routers.size ());
+
+    dijkstra_shortest_paths (m_graph, source,
+                             weight_map (get (edge_bundle, m_graph))
+                             .
+                             distance_map (make_iterator_property_map (distances.begin (), get (vertex_index, m_graph)))
+                             .
+                             distance_inf (RouteDistance (0, std::numeric_limits<uint32_t>::max (), 0.0))
+                             .
+                             distance_zero (RouteDistance ())
+                             .
+                             distance_compare (RouteCompare ())
+                             .
+                             distance_combine (RouteCombine ())
+                             );
+  }
+
+private:
+  std::vector< Ptr<GlobalRouter> > m_routers;
+  std::map<GlobalRouter*, uint32_t> m_index;
+  Graph m_graph;
+};
+
+/**
+ * @brief Calculates shortest path trees for every step-th source of the batch
+ */
+class ShortestPathWorker
+{
+public:
+  ShortestPathWorker (const RoutingGraphSnapshot &snapshot,
+                      const std::vector<uint32_t> &sources,
+                      std::vector< std::vector<RouteDistance> > &results,
+                      uint32_t first, uint32_t last, uint32_t offset, uint32_t step)
+    : m_snapshot (snapshot)
+    , m_sources (sources)
+    , m_results (results)
+    , m_first (first)
+    , m_last (last)
+    , m_offset (offset)
+    , m_step (step)
+  {
+  }
+
+  void
+  Run ()
+  {
+    for (uint32_t i = m_first + m_offset; i < m_last; i += m_step)
+      {
+        m_snapshot.CalculateShortestPaths (m_sources[i], m_results[i - m_first]);
+      }
+  }
+
+private:
+  const RoutingGraphSnapshot &m_snapshot;
+  const std::vector<uint32_t> &m_sources;
+  std::vector< std::vector<RouteDistance> > &m_results;
+  uint32_t m_first;
+  uint32_t m_last;
+  uint32_t m_offset;
+  uint32_t m_step;
+};
+
+static void
+InstallRoutes (const RoutingGraphSnapshot &snapshot, uint32_t sourceVertex, const std::vector<RouteDistance> &distances)
+{
+  Ptr<GlobalRouter> source = snapshot.GetRouter (sourceVertex);
+
+  Ptr<Fib>  fib  = source->GetObject<Fib> ();
+  NS_ASSERT (fib != 0);
+  fib->InvalidateAll ();
+
+  NS_LOG_DEBUG ("Reachability from Node: " << source->GetObject<Node> ()->GetId ());
+  for (uint32_t vertex = 0; vertex < distances.size (); vertex++)
+    {
+      if (vertex == sourceVertex)
+        continue;
+
+      const RouteDistance &distance = distances[vertex];
+      if (distance.face == 0)
+        {
+          // is unreachable
+          continue;
+        }
+
+      Ptr<Face> face = distance.face;
+      BOOST_FOREACH (const Ptr<const NameComponents> &prefix, snapshot.GetRouter (vertex)->GetLocalPrefixes ())
+        {
+          NS_LOG_DEBUG (" prefix " << prefix << " reachable via face " << *face
+                        << " with distance " << distance.metric
+                        << " with delay " << distance.delay);
+
+          fib->AddRoute (prefix, face, distance.metric, Seconds (distance.delay));
+        }
+    }
+}
+
+/**
+ * @brief Routes maintained by GlobalRoutingHelper::CalculateRoutesIncrementally
+ *
+ * For every prefix origin a shortest path tree towards the origin is kept (Dijkstra on the
+ * reversed graph): for each vertex it contains the first hop face, metric, and delay of the
+ * best path from this vertex to the origin.  When a face goes down or up, only the trees
+ * that use the face (or could be improved by it) are recalculated and only FIB entries on
+ * vertices with changed next hop, metric, or delay are patched.
+ */
+class IncrementalRoutes
+{
+public:
+  IncrementalRoutes ()
+    : m_enabled (false)
+  {
+  }
+
+  ~IncrementalRoutes ()
+  {
+    Disable ();
+  }
+
+  bool
+  IsEnabled () const
+  {
+    return m_enabled;
+  }
+
+  /**
+   * @brief Build state from the current topology and (re)install routes on all nodes
+   */
+  void
+  Enable ()
+  {
+    Disable ();
+
+    NdnGlobalRouterGraph graph;
+    BOOST_FOREACH (const Ptr<GlobalRouter> &router, graph.GetVertices ())
+      {
+        m_vertices[PeekPointer (router)] = m_routers.size ();
+        m_routers.push_back (router);
+      }
+
+    std::vector<uint32_t> nIncoming (m_routers.size (), 0);
+    for (uint32_t source = 0; source < m_routers.size (); source++)
+      {
+        BOOST_FOREACH (const GlobalRouter::Incidency &incidency, m_routers[source]->GetIncidencies ())
+          {
+            Ptr<Face> face = incidency.get<1> ();
+            if (face == 0)
+              {
+                // links through multi-access channels do not have a first-hop face on one side
+                // and are not used for route calculation
+                continue;
+              }
+
+            Edge edge;
+            edge.from = source;
+            edge.to = m_vertices[PeekPointer (incidency.get<2> ())];
+            edge.face = PeekPointer (face);
+            edge.metric = face->GetMetric ();
+            edge.delay = 0.0;
+            edge.up = face->IsUp ();
+
+            Ptr<Limits> limits = face->GetObject<Limits> ();
+            if (limits != 0) // valid limits object
+              {
+                edge.delay = limits->GetLinkDelay ();
+              }
+
+            m_faceEdges[edge.face].push_back (m_edges.size ());
+            m_edges.push_back (edge);
+            nIncoming[edge.to] ++;
+          }
+      }
+
+    // incoming edges of vertex v are m_incoming[m_incomingOffsets[v]] ... m_incoming[m_incomingOffsets[v+1]-1]
+    m_incomingOffsets.assign (m_routers.size () + 1, 0);
+    for (uint32_t vertex = 0; vertex < m_routers.size (); vertex++)
+      {
+        m_incomingOffsets[vertex + 1] = m_incomingOffsets[vertex] + nIncoming[vertex];
+      }
+    m_incoming.resize (m_edges.size ());
+    std::vector<uint32_t> position (m_incomingOffsets.begin (), m_incomingOffsets.end () - 1);
+    for (uint32_t edge = 0; edge < m_edges.size (); edge++)
+      {
+        m_incoming[position[m_edges[edge].to]++] = edge;
+      }
+
+    for (FaceEdges::iterator i = m_faceEdges.begin (); i != m_faceEdges.end (); i++)
+      {
+        Ptr<Face> face = i->first;
+        face->TraceConnectWithoutContext ("UpDown", MakeCallback (&IncrementalRoutes::FaceUpDown, this));
+        m_faces.push_back (face);
+      }
+
+    for (uint32_t vertex = 0; vertex < m_routers.size (); vertex++)
+      {
+        BOOST_FOREACH (const Ptr<const NameComponents> &prefix, m_routers[vertex]->GetLocalPrefixes ())
+          {
+            Origins &origins = m_origins[*prefix];
+            origins.prefix = prefix;
+            origins.vertices.insert (vertex);
+          }
+      }
+
+    for (OriginMap::iterator prefix = m_origins.begin (); prefix != m_origins.end (); prefix++)
+      {
+        for (std::set<uint32_t>::iterator origin = prefix->second.vertices.begin (); origin != prefix->second.vertices.end (); origin++)
+          {
+            if (m_trees.find (*origin) == m_trees.end ())
+              {
+                CalculateTree (*origin, m_trees[*origin]);
+              }
+          }
+      }
+
+    m_enabled = true;
+
+    for (uint32_t vertex = 0; vertex < m_routers.size (); vertex++)
+      {
+        Ptr<Fib> fib = m_routers[vertex]->GetObject<Fib> ();
+        if (fib == 0)
+          continue;
+
+        fib->InvalidateAll ();
+        for (OriginMap::iterator prefix = m_origins.begin (); prefix != m_origins.end (); prefix++)
+          {
+            PatchRoutes (vertex, prefix->second.prefix, true);
+          }
+      }
+  }
+
+  /**
+   * @brief Stop tracking face state and release all state
+   */
+  void
+  Disable ()
+  {
+    for (std::list< Ptr<Face> >::iterator face = m_faces.begin (); face != m_faces.end (); face++)
+      {
+        (*face)->TraceDisconnectWithoutContext ("UpDown", MakeCallback (&IncrementalRoutes::FaceUpDown, this));
+      }
+
+    m_enabled = false;
+    m_routers.clear ();
+    m_vertices.clear ();
+    m_edges.clear ();
+    m_incomingOffsets.clear ();
+    m_incoming.clear ();
+    m_faceEdges.clear ();
+    m_faces.clear ();
+    m_trees.clear ();
+    m_origins.clear ();
+  }
+
+  /**
+   * @brief Install routes to the new origin of the prefix on all nodes
+   */
+  void
+  AddOrigin (Ptr<GlobalRouter> router, const Ptr<const NameComponents> &prefix)
+  {
+    std::map<GlobalRouter*, uint32_t>::iterator vertex = m_vertices.find (PeekPointer (router));
+    if (vertex == m_vertices.end ())
+      {
+        NS_LOG_WARN ("GlobalRouter was installed after CalculateRoutesIncrementally, prefix " << *prefix << " is ignored");
+        return;
+      }
+
+    uint32_t origin = vertex->second;
+    Origins &origins = m_origins[*prefix];
+    if (origins.prefix == 0)
+      origins.prefix = prefix;
+    if (!origins.vertices.insert (origin).second)
+      return; // already known
+
+    if (m_trees.find (origin) == m_trees.end ())
+      {
+        CalculateTree (origin, m_trees[origin]);
+      }
+
+    for (uint32_t source = 0; source < m_routers.size (); source++)
+      {
+        PatchRoutes (source, prefix);
+      }
+  }
+
+private:
+  struct Edge
+  {
+    uint32_t from;
+    uint32_t to;
+    Face *face;
+    uint32_t metric;
+    double delay;
+    bool up;
+  };
+
+  struct Tree
+  {
+    std::vector<RouteDistance> distances; ///< @brief first hop, metric, and delay from the vertex to the origin
+    std::vector<uint32_t> nextEdges;      ///< @brief first edge of the path from the vertex to the origin
+  };
+
+  typedef std::map<Face*, std::vector<uint32_t> > FaceEdges;
+  typedef std::map<uint32_t, Tree> TreeMap;
+  struct Origins
+  {
+    Ptr<const NameComponents> prefix;
+    std::set<uint32_t> vertices;
+  };
+
+  typedef std::map<NameComponents, Origins> OriginMap;
+
+  static const uint32_t NoEdge = 0xffffffff;
+  static const uint32_t Unreachable = 0xffffffff;
+
+  void
+  CalculateTree (uint32_t origin, Tree &tree) const
+  {
+    tree.distances.assign (m_routers.size (), RouteDistance (0, Unreachable, 0.0));
+    tree.nextEdges.assign (m_routers.size (), NoEdge);
+    tree.distances[origin] = RouteDistance ();
+
+    typedef std::pair<uint32_t, uint32_t> QueueItem; // (metric, vertex)
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem> > queue;
+    std::vector<bool> done (m_routers.size (), false);
+
+    queue.push (std::make_pair (0, origin));
+    while (!queue.empty ())
+      {
+        uint32_t vertex = queue.top ().second;
+        queue.pop ();
+        if (done[vertex])
+          continue;
+        done[vertex] = true;
+
+        const RouteDistance &distance = tree.distances[vertex];
+        for (uint32_t i = m_incomingOffsets[vertex]; i < m_incomingOffsets[vertex + 1]; i++)
+          {
+            const Edge &edge = m_edges[m_incoming[i]];
+            if (!edge.up || done[edge.from])
+              continue;
+
+            uint32_t metric = distance.metric + edge.metric;
+            if (metric < tree.distances[edge.from].metric)
+              {
+                tree.distances[edge.from] = RouteDistance (edge.face, metric, distance.delay + edge.delay);
+                tree.nextEdges[edge.from] = m_incoming[i];
+                queue.push (std::make_pair (metric, edge.from));
+              }
+          }
+      }
+  }
+
+  void
+  FaceUpDown (Ptr<Face> face, bool up)
+  {
+    FaceEdges::iterator edges = m_faceEdges.find (PeekPointer (face));
+    if (edges == m_faceEdges.end ())
+      return;
+
+    NS_LOG_DEBUG ("Face " << *face << " is " << (up ? "up" : "down") << ", updating routes");
+
+    std::set<uint32_t> affected;
+    BOOST_FOREACH (uint32_t id, edges->second)
+      {
+        Edge &edge = m_edges[id];
+        if (edge.up == up)
+          continue;
+        edge.up = up;
+
+        for (TreeMap::iterator tree = m_trees.begin (); tree != m_trees.end (); tree++)
+          {
+            const std::vector<RouteDistance> &distances = tree->second.distances;
+            if (!up)
+              {
+                if (tree->second.nextEdges[edge.from] == id)
+                  affected.insert (tree->first);
+              }
+            else if (distances[edge.to].metric != Unreachable &&
+                     (distances[edge.from].metric == Unreachable ||
+                      distances[edge.to].metric + edge.metric < distances[edge.from].metric))
+              {
+                affected.insert (tree->first);
+              }
+          }
+      }
+
+    for (std::set<uint32_t>::iterator origin = affected.begin (); origin != affected.end (); origin++)
+      {
+        Tree &tree = m_trees[*origin];
+        std::vector<RouteDistance> old;
+        old.swap (tree.distances);
+        CalculateTree (*origin, tree);
+
+        for (uint32_t vertex = 0; vertex < m_routers.size (); vertex++)
+          {
+            const RouteDistance &before = old[vertex];
+            const RouteDistance &after = tree.distances[vertex];
+            if (before.face == after.face && before.metric == after.metric && before.delay == after.delay)
+              continue;
+
+            BOOST_FOREACH (const Ptr<const NameComponents> &prefix, m_routers[*origin]->GetLocalPrefixes ())
+              {
+                PatchRoutes (vertex, prefix);
+              }
+          }
+      }
+  }
+
+  /**
+   * @brief Bring FIB entry for the prefix on the vertex in accordance with the trees of all prefix origins
+   *
+   * If invalidated is true, FIB of the vertex was just invalidated and the existing entry
+   * does not need to be inspected (it is not requested from FIB at all)
+   */
+  void
+  PatchRoutes (uint32_t vertex, const Ptr<const NameComponents> &prefix, bool invalidated = false)
+  {
+    Ptr<Fib> fib = m_routers[vertex]->GetObject<Fib> ();
+    if (fib == 0)
+      return;
+
+    OriginMap::const_iterator origins = m_origins.find (*prefix);
+    if (origins == m_origins.end ())
+      return;
+
+    // best route through each face
+    std::map<Face*, RouteDistance> routes;
+    for (std::set<uint32_t>::const_iterator origin = origins->second.vertices.begin (); origin != origins->second.vertices.end (); origin++)
+      {
+        if (*origin == vertex)
+          continue;
+
+        const RouteDistance &distance = m_trees[*origin].distances[vertex];
+        if (distance.face == 0)
+          continue; // is unreachable
+
+        std::map<Face*, RouteDistance>::iterator route = routes.find (distance.face);
+        if (route == routes.end () || distance.metric < route->second.metric)
+          routes[distance.face] = distance;
+      }
+
+    Ptr<fib::Entry> entry = invalidated ? 0 : fib->Find (*prefix);
+    if (entry != 0)
+      {
+        std::list< Ptr<Face> > invalid;
+        for (fib::FaceMetricContainer::type::iterator record = entry->m_faces.begin ();
+             record != entry->m_faces.end ();
+             record++)
+          {
+            std::map<Face*, RouteDistance>::iterator route = routes.find (PeekPointer (record->GetFace ()));
+            if (record->m_status != fib::FaceMetric::NDN_FIB_RED &&
+                (route == routes.end () || static_cast<uint32_t> (record->m_routingCost) != route->second.metric))
+              {
+                invalid.push_back (record->GetFace ());
+              }
+          }
+
+        for (std::list< Ptr<Face> >::iterator face = invalid.begin (); face != invalid.end (); face++)
+          {
+            entry->InvalidateFace (*face);
+          }
+      }
+
+    for (std::map<Face*, RouteDistance>::iterator route = routes.begin (); route != routes.end (); route++)
+      {
+        Ptr<Face> face = route->first;
+        const RouteDistance &distance = route->second;
+
+        NS_LOG_DEBUG ("Node " << m_routers[vertex]->GetObject<Node> ()->GetId () << ": prefix " << *prefix
+                      << " reachable via face " << *face
+                      << " with distance " << distance.metric
+                      << " with delay " << distance.delay);
+
+        fib->AddRoute (prefix, face, distance.metric, Seconds (distance.delay));
+      }
+  }
+
+private:
+  bool m_enabled;
+
+  std::vector< Ptr<GlobalRouter> > m_routers;
+  std::map<GlobalRouter*, uint32_t> m_vertices;
+
+  std::vector<Edge> m_edges;
+  std::vector<uint32_t> m_incomingOffsets;
+  std::vector<uint32_t> m_incoming;
+  FaceEdges m_faceEdges;
+  std::list< Ptr<Face> > m_faces; ///< @brief faces with connected UpDown trace
+
+  TreeMap m_trees;    ///< @brief origin vertex -> shortest path tree towards it
+  OriginMap m_origins; ///< @brief prefix -> origin vertices
+};
+
+const uint32_t IncrementalRoutes::NoEdge;
+const uint32_t IncrementalRoutes::Unreachable;
+
+/// @endcond
+
+GlobalRoutingHelper::GlobalRoutingHelper ()
+  : m_nThreads (1)
+{
+  long nProcessors = sysconf (_SC_NPROCESSORS_ONLN);
+  if (nProcessors > 1)
+    {
+      m_nThreads = static_cast<uint32_t> (nProcessors);
+    }
+}
+
+void
+GlobalRoutingHelper::SetNumberOfThreads (uint32_t nThreads)
+{
+  m_nThreads = nThreads;
+}
+
 void
 GlobalRoutingHelper::Install (Ptr<Node> node)
 {
@@ -190,6 +846,12 @@ GlobalRoutingHelper::AddOrigin (const std::string &prefix, Ptr<Node> node)
 
   Ptr<NameComponents> name = Create<NameComponents> (boost::lexical_cast<NameComponents> (prefix));
   gr->AddLocalPrefix (name);
+
+  IncrementalRoutes *routes = SimulationSingleton<IncrementalRoutes>::Get ();
+  if (routes->IsEnabled ())
+    {
+      routes->AddOrigin (gr, name);
+    }
 }
 
 void
@@ -238,12 +900,11 @@ GlobalRoutingHelper::CalculateRoutes ()
   BOOST_CONCEPT_ASSERT(( VertexListGraphConcept< NdnGlobalRouterGraph > ));
   BOOST_CONCEPT_ASSERT(( IncidenceGraphConcept< NdnGlobalRouterGraph > ));
 
-  NdnGlobalRouterGraph graph;
-  typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  SimulationSingleton<IncrementalRoutes>::Get ()->Disable ();
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by the graph, which
-  // is not obviously how implement in an efficient manner
+  RoutingGraphSnapshot snapshot;
+
+  std::vector<uint32_t> sources;
   for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
     {
       Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
@@ -252,71 +913,67 @@ GlobalRoutingHelper::CalculateRoutes ()
 	  NS_LOG_DEBUG ("Node " << (*node)->GetId () << " does not export GlobalRouter interface");
 	  continue;
 	}
+      sources.push_back (snapshot.GetVertex (source));
+    }
 
-      DistancesMap    distances;
-
-      dijkstra_shortest_paths (graph, source,
-			       // predecessor_map (boost::ref(predecessors))
-			       // .
-			       distance_map (boost::ref(distances))
-			       .
-			       distance_inf (WeightInf)
-			       .
-			       distance_zero (WeightZero)
-			       .
-			       distance_compare (boost::WeightCompare ())
-			       .
-			       distance_combine (boost::WeightCombine ())
-			       );
-
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-      Ptr<Fib>  fib  = source->GetObject<Fib> ();
-      fib->InvalidateAll ();
-      NS_ASSERT (fib != 0);
-
-      NS_LOG_DEBUG ("Reachability from Node: " << source->GetObject<Node> ()->GetId ());
-      for (DistancesMap::iterator i = distances.begin ();
-	   i != distances.end ();
-	   i++)
-	{
-	  if (i->first == source)
-	    continue;
-	  else
-	    {
-	      // cout << "  Node " << i->first->GetObject<Node> ()->GetId ();
-	      if (i->second.get<0> () == 0)
-		{
-		  // cout << " is unreachable" << endl;
-		}
-	      else
-		{
-                  BOOST_FOREACH (const Ptr<const NameComponents> &prefix, i->first->GetLocalPrefixes ())
-                    {
-                      NS_LOG_DEBUG (" prefix " << prefix << " reachable via face " << *i->second.get<0> ()
-                                    << " with distance " << i->second.get<1> ()
-                                    << " with delay " << i->second.get<2> ());
-
-                      Ptr<fib::Entry> entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
-                      entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
-
-                      Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
-
-                      Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
-                      if (fibLimits != 0)
-                        {
-                          // if it was created by the forwarding strategy via DidAddFibEntry event
-                          fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
-                          NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
-                                        2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
-                        }
-                    }
-		}
-	    }
-	}
+  uint32_t nThreads = std::max<uint32_t> (1, std::min<uint32_t> (m_nThreads, sources.size ()));
+#ifndef HAVE_PTHREAD_H
+  nThreads = 1;
+#endif
+
+  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
+  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by the graph, which
+  // is not obviously how implement in an efficient manner
+  //
+  // Shortest path trees are calculated in batches (in parallel, if enabled) to keep memory usage
+  // bounded, and FIBs are updated from this thread after each batch
+  uint32_t batchSize = nThreads * 16;
+  std::vector< std::vector<RouteDistance> > results (batchSize);
+
+  for (uint32_t first = 0; first < sources.size (); first += batchSize)
+    {
+      uint32_t last = std::min<uint32_t> (first + batchSize, sources.size ());
+
+      std::vector<ShortestPathWorker> workers;
+      workers.reserve (nThreads);
+      for (uint32_t thread = 0; thread < nThreads; thread++)
+        {
+          workers.push_back (ShortestPathWorker (snapshot, sources, results, first, last, thread, nThreads));
+        }
+
+      if (nThreads == 1)
+        {
+          workers.front ().Run ();
+        }
+#ifdef HAVE_PTHREAD_H
+      else
+        {
+          std::vector< Ptr<SystemThread> > threads;
+          for (uint32_t thread = 0; thread < nThreads; thread++)
+            {
+              threads.push_back (Create<SystemThread> (MakeCallback (&ShortestPathWorker::Run, &workers[thread])));
+              threads.back ()->Start ();
+            }
+
+          for (uint32_t thread = 0; thread < nThreads; thread++)
+            {
+              threads[thread]->Join ();
+            }
+        }
+#endif
+
+      for (uint32_t i = first; i < last; i++)
+        {
+          InstallRoutes (snapshot, sources[i], results[i - first]);
+        }
     }
 }
 
+void
+GlobalRoutingHelper::CalculateRoutesIncrementally ()
+{
+  SimulationSingleton<IncrementalRoutes>::Get ()->Enable ();
+}
 
 } // namespace ndn
 } // namespace ns3
@@ -38,6 +38,25 @@ namespace ndn {
 class GlobalRoutingHelper
 {
 public:
+  /**
+   * @brief Default constructor
+   *
+   * By default, route calculation uses as many threads as there are online processors
+   */
+  GlobalRoutingHelper ();
+
+  /**
+   * @brief Set number of threads used to calculate shortest path trees in CalculateRoutes
+   *
+   * Shortest path trees are calculated on an immutable snapshot of the topology, so the
+   * result of the calculation does not depend on the number of threads.  FIB updates are
+   * always applied from the calling thread.
+   *
+   * @param nThreads number of worker threads (0 or 1 disables parallel calculation)
+   */
+  void
+  SetNumberOfThreads (uint32_t nThreads);
+
   /**
    * @brief Install GlobalRouter interface on a node
    *
@@ -101,9 +120,33 @@ public:
   void
   CalculateRoutes ();
 
+  /**
+   * @brief Calculate routes to all prefix origins and keep them up-to-date afterwards
+   *
+   * Unlike CalculateRoutes, shortest path trees towards every prefix origin are calculated
+   * (one per origin, not one per node) and kept in memory.  After this call:
+   *
+   * - AddOrigin/AddOrigins/AddOriginsForAll install routes for the new prefix on all nodes,
+   * - disabling or enabling a face (Face::SetUp) recalculates only the trees that use (or
+   *   could use) the face, and patches FIB entries only on nodes whose next hop, metric,
+   *   or delay has changed.
+   *
+   * Faces that are down when this method is called are excluded from route calculation.
+   * If nodes or links are added later, this method needs to be called again.  Calling
+   * CalculateRoutes disables incremental updates.
+   *
+   * Note that when several paths have the same cost, the selected next hop can be
+   * different from the one selected by CalculateRoutes.
+   */
+  void
+  CalculateRoutesIncrementally ();
+
 private:
   void
   Install (Ptr<Channel> channel);
+
+private:
+  uint32_t m_nThreads;
 };
 
 } // namespace ndn
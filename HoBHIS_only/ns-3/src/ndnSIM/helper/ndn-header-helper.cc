@@ -36,15 +36,16 @@ const uint8_t CONTENT_OBJECT_CCNB_BYTES[] = {0x04, 0x82};
 
 const uint8_t INTEREST_NDNSIM_BYTES[]       = {0x80, 0x00};
 const uint8_t CONTENT_OBJECT_NDNSIM_BYTES[] = {0x80, 0x01};
+const uint8_t FRAGMENT_NDNSIM_BYTES[]       = {0x80, 0x02};
 
 namespace ns3 {
 namespace ndn {
 
 HeaderHelper::Type
-HeaderHelper::GetNdnHeaderType (Ptr<const Packet> packet)
+HeaderHelper::GetNdnHeaderType (Ptr<const Packet> packet, uint32_t offset/* = 0*/)
 {
   uint8_t type[2];
-  uint32_t read=packet->CopyData (type,2);
+  uint32_t read=packet->CopyData (type,2,offset);
 
   if (read!=2) throw UnknownHeaderException();
 
@@ -65,6 +66,10 @@ HeaderHelper::GetNdnHeaderType (Ptr<const Packet> packet)
     {
       return HeaderHelper::CONTENT_OBJECT_NDNSIM;
     }
+  else if (type[0] == FRAGMENT_NDNSIM_BYTES[0] && type[1] == FRAGMENT_NDNSIM_BYTES[1])
+    {
+      return HeaderHelper::FRAGMENT_NDNSIM;
+    }
 
   NS_LOG_DEBUG (*packet);
   throw UnknownHeaderException();
@@ -73,36 +78,21 @@ HeaderHelper::GetNdnHeaderType (Ptr<const Packet> packet)
 Ptr<const Name>
 HeaderHelper::GetName (Ptr<const Packet> p)
 {
-  Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the packet
   try
     {
       HeaderHelper::Type type = HeaderHelper::GetNdnHeaderType (p);
       switch (type)
         {
         case HeaderHelper::INTEREST_NDNSIM:
-          {
-            Ptr<InterestHeader> header = Create<InterestHeader> ();
-
-            // Deserialization. Exception may be thrown
-            packet->RemoveHeader (*header);
-            NS_ASSERT_MSG (packet->GetSize () == 0, "Payload of Interests should be zero");
-
-            return header->GetNamePtr ();
-            break;
-          }
+          return Create<Name> (InterestHeaderView (p).GetName ().ToName ());
         case HeaderHelper::CONTENT_OBJECT_NDNSIM:
-          {
-            Ptr<ContentObjectHeader> header = Create<ContentObjectHeader> ();
-
-            // Deserialization. Exception may be thrown
-            packet->RemoveHeader (*header);
-            return header->GetNamePtr ();
-            break;
-          }
+          return Create<Name> (ContentObjectHeaderView (p).GetName ().ToName ());
         case HeaderHelper::INTEREST_CCNB:
         case HeaderHelper::CONTENT_OBJECT_CCNB:
           NS_FATAL_ERROR ("ccnb support is broken in this implementation");
           break;
+        case HeaderHelper::FRAGMENT_NDNSIM:
+          return 0; // name is known only after reassembly
         }
 
       // exception will be thrown if packet is not recognized
@@ -115,6 +105,33 @@ HeaderHelper::GetName (Ptr<const Packet> p)
   return 0;
 }
 
+NameView
+HeaderHelper::GetNameView (Ptr<const Packet> p, uint32_t offset/* = 0*/)
+{
+  try
+    {
+      HeaderHelper::Type type = HeaderHelper::GetNdnHeaderType (p, offset);
+      switch (type)
+        {
+        case HeaderHelper::INTEREST_NDNSIM:
+          return InterestHeaderView (p, offset).GetName ();
+        case HeaderHelper::CONTENT_OBJECT_NDNSIM:
+          return ContentObjectHeaderView (p, offset).GetName ();
+        case HeaderHelper::INTEREST_CCNB:
+        case HeaderHelper::CONTENT_OBJECT_CCNB:
+          NS_FATAL_ERROR ("ccnb support is broken in this implementation");
+          break;
+        case HeaderHelper::FRAGMENT_NDNSIM:
+          break; // name is known only after reassembly
+        }
+    }
+  catch (UnknownHeaderException)
+    {
+    }
+
+  return NameView ();
+}
+
 
 } // namespace ndn
 } // namespace ns3
@@ -22,6 +22,7 @@
 #define _NDN_HEADER_HELPER_H_
 
 #include "ns3/ptr.h"
+#include "ns3/ndn-header-view.h"
 
 namespace ns3 {
 
@@ -30,8 +31,6 @@ class Packet;
 
 namespace ndn {
 
-class Name;
-
 /**
  * \ingroup ndn-helpers
  *
@@ -51,12 +50,13 @@ public:
      @brief enum for Ndn packet types
    */
   enum Type {INTEREST_CCNB, CONTENT_OBJECT_CCNB,
-             INTEREST_NDNSIM, CONTENT_OBJECT_NDNSIM};
+             INTEREST_NDNSIM, CONTENT_OBJECT_NDNSIM,
+             FRAGMENT_NDNSIM};
 
   /**
    *	Packet ::= Version
    *		   PacketType
-   *		   (Interest | ContentObject)
+   *		   (Interest | ContentObject | Fragment)
    *
    *        0                   1
    *        0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6
@@ -69,6 +69,9 @@ public:
    * Version 0x01, PacketType 0xD2 --- ccnb-encoded ``Interest`` packet
    * Version 0x04, PacketType 0x82 --- ccnb-encoded ``ContentObject`` packet
    *
+   * Version 0x80, PacketType 0x02 denotes link-layer fragment of ``Interest`` or ``ContentObject``
+   * packet (see FragmentHeader), which never leaves NetDeviceFace
+   *
    *
    * It peeks first 2 bytes of a packet.
    *
@@ -89,15 +92,24 @@ public:
    */
 
   static Type
-  GetNdnHeaderType (Ptr<const Packet> packet);
+  GetNdnHeaderType (Ptr<const Packet> packet, uint32_t offset = 0);
 
   /**
-   * @brief A heavy-weight operation to get name of the packet
+   * @brief Get name of the packet
    *
-   * This function returns name of the packet by deserializing a copy of the packet to a right header
+   * This function decodes only the name of the packet (see GetNameView) and returns it as a Name object
    */
   static Ptr<const Name>
   GetName (Ptr<const Packet> packet);
+
+  /**
+   * @brief A light-weight operation to get name of the packet
+   *
+   * This function returns a read-only view of the name (see NameView), without deserializing
+   * the header.  An empty view is returned if the packet is a fragment or is not recognized
+   */
+  static NameView
+  GetNameView (Ptr<const Packet> packet, uint32_t offset = 0);
 };
 
   /**
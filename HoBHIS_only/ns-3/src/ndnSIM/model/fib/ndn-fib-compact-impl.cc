@@ -0,0 +1,566 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-fib-compact-impl.h"
+
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-forwarding-strategy.h"
+
+#include "ns3/node.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <boost/ref.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.fib.CompactFibImpl");
+
+namespace ns3 {
+namespace ndn {
+namespace fib {
+
+const uint32_t SharedPrefixTable::NoPrefix;
+SharedPrefixTable *SharedPrefixTable::s_table = 0;
+
+Ptr<SharedPrefixTable>
+SharedPrefixTable::Get ()
+{
+  if (s_table != 0)
+    return s_table;
+
+  // the table is owned by the FIBs, s_table is reset when the last FIB releases it
+  s_table = new SharedPrefixTable ();
+  return Ptr<SharedPrefixTable> (s_table, false);
+}
+
+SharedPrefixTable::SharedPrefixTable ()
+{
+}
+
+SharedPrefixTable::~SharedPrefixTable ()
+{
+  if (s_table == this)
+    s_table = 0;
+}
+
+uint32_t
+SharedPrefixTable::Insert (const Ptr<const NameComponents> &prefix)
+{
+  std::pair<trie::iterator, bool> item = m_trie.insert (*prefix, m_prefixes.size () + 1);
+  if (item.first == m_trie.end ())
+    return NoPrefix;
+
+  if (item.second)
+    {
+      m_prefixes.push_back (prefix);
+    }
+  else if (item.first->payload () == 0)
+    {
+      // node already existed as a part of longer prefix
+      item.first->set_payload (m_prefixes.size () + 1);
+      m_prefixes.push_back (prefix);
+    }
+
+  return item.first->payload () - 1;
+}
+
+uint32_t
+SharedPrefixTable::Insert (const NameComponents &prefix)
+{
+  uint32_t index = Find (prefix);
+  if (index != NoPrefix)
+    return index;
+
+  return Insert (Create<NameComponents> (prefix));
+}
+
+uint32_t
+SharedPrefixTable::Find (const NameComponents &prefix)
+{
+  trie::iterator item = m_trie.find_exact (prefix);
+  if (item == m_trie.end ())
+    return NoPrefix;
+
+  return item->payload () - 1;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+NS_OBJECT_ENSURE_REGISTERED (CompactFibImpl);
+
+const uint32_t CompactFibImpl::NoNextHop;
+const uint32_t CompactFibImpl::NoRoute;
+const uint32_t CompactFibImpl::Materialized;
+
+TypeId
+CompactFibImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fib::Compact") // cheating ns3 object system
+    .SetParent<Fib> ()
+    .SetGroupName ("Ndn")
+    .AddConstructor<CompactFibImpl> ()
+  ;
+  return tid;
+}
+
+CompactFibImpl::CompactFibImpl ()
+  : m_prefixes (SharedPrefixTable::Get ())
+  , m_freeNextHops (NoNextHop)
+  , m_size (0)
+{
+}
+
+void
+CompactFibImpl::NotifyNewAggregate ()
+{
+  Object::NotifyNewAggregate ();
+}
+
+void
+CompactFibImpl::DoDispose (void)
+{
+  m_entries.clear ();
+  m_routes.clear ();
+  m_nextHops.clear ();
+  m_freeNextHops = NoNextHop;
+  m_faces.clear ();
+  m_size = 0;
+  m_prefixes = 0;
+
+  Object::DoDispose ();
+}
+
+void
+CompactFibImpl::Reserve (uint32_t index)
+{
+  if (index >= m_routes.size ())
+    {
+      m_routes.resize (m_prefixes->GetSize (), NoRoute);
+    }
+}
+
+uint16_t
+CompactFibImpl::GetFaceIndex (Ptr<Face> face)
+{
+  for (uint32_t i = 0; i < m_faces.size (); i++)
+    {
+      if (m_faces[i] == face)
+        return i;
+    }
+
+  NS_ASSERT_MSG (m_faces.size () < 0xffff, "Too many faces");
+  m_faces.push_back (face);
+  return m_faces.size () - 1;
+}
+
+uint32_t
+CompactFibImpl::AllocateNextHop ()
+{
+  if (m_freeNextHops != NoNextHop)
+    {
+      uint32_t record = m_freeNextHops;
+      m_freeNextHops = m_nextHops[record].next;
+      return record;
+    }
+
+  m_nextHops.push_back (NextHop ());
+  return m_nextHops.size () - 1;
+}
+
+void
+CompactFibImpl::ReleaseNextHops (uint32_t head)
+{
+  while (head != NoNextHop)
+    {
+      uint32_t next = m_nextHops[head].next;
+      m_nextHops[head].next = m_freeNextHops;
+      m_freeNextHops = head;
+      head = next;
+    }
+}
+
+void
+CompactFibImpl::Populate (Ptr<Entry> entry, uint32_t head) const
+{
+  std::vector<uint32_t> records;
+  for (uint32_t record = head; record != NoNextHop; record = m_nextHops[record].next)
+    {
+      records.push_back (record);
+    }
+
+  // the most recent record is the first in the list
+  for (std::vector<uint32_t>::reverse_iterator record = records.rbegin (); record != records.rend (); record++)
+    {
+      const NextHop &nextHop = m_nextHops[*record];
+      Ptr<Face> face = m_faces[nextHop.face];
+
+      entry->AddOrUpdateRoutingMetric (face, nextHop.metric);
+      if (nextHop.status != FaceMetric::NDN_FIB_YELLOW)
+        {
+          entry->UpdateStatus (face, static_cast<FaceMetric::Status> (nextHop.status));
+        }
+      entry->SetRealDelayToProducer (face, nextHop.delay);
+    }
+}
+
+Ptr<Entry>
+CompactFibImpl::Materialize (uint32_t index)
+{
+  uint32_t head = m_routes[index];
+  NS_ASSERT (head != NoRoute);
+
+  if (head == Materialized)
+    return m_entries[index];
+
+  NS_LOG_FUNCTION (this << boost::cref (*m_prefixes->GetPrefix (index)));
+
+  Ptr<CompactEntryImpl> entry = Create<CompactEntryImpl> (m_prefixes->GetPrefix (index), index);
+  Populate (entry, head);
+
+  // the most recently added route defines limits, the same way as for Fib::AddRoute
+  Ptr<Face> face = m_faces[m_nextHops[head].face];
+  Time delay = m_nextHops[head].delay;
+
+  ReleaseNextHops (head);
+  m_routes[index] = Materialized;
+  m_entries[index] = entry;
+
+  // notify forwarding strategy about new FIB entry
+  NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
+  this->GetObject<ForwardingStrategy> ()->DidAddFibEntry (entry);
+
+  Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
+  if (fibLimits != 0)
+    {
+      // if it was created by the forwarding strategy via DidAddFibEntry event
+      fibLimits->SetLimits (face->GetObject<Limits> ()->GetMaxRate (), 2 * delay.ToDouble (Time::S) /*exact RTT*/);
+    }
+
+  return entry;
+}
+
+Ptr<Entry>
+CompactFibImpl::LongestPrefixMatch (const InterestHeader &interest)
+{
+  uint32_t index = m_prefixes->LongestPrefixMatch (interest.GetName (), HasRoute (m_routes));
+  // @todo use predicate to search with exclude filters
+
+  if (index == SharedPrefixTable::NoPrefix)
+    return 0;
+  else
+    return Materialize (index);
+}
+
+Ptr<Entry>
+CompactFibImpl::Find (const NameComponents &prefix)
+{
+  uint32_t index = m_prefixes->Find (prefix);
+
+  if (!HasRoute (m_routes) (index))
+    return 0;
+  else
+    return Materialize (index);
+}
+
+Ptr<Entry>
+CompactFibImpl::Add (const NameComponents &prefix, Ptr<Face> face, int32_t metric)
+{
+  uint32_t index = m_prefixes->Find (prefix);
+  if (index == SharedPrefixTable::NoPrefix)
+    return Add (Create<NameComponents> (prefix), face, metric);
+  else
+    return Add (m_prefixes->GetPrefix (index), face, metric);
+}
+
+Ptr<Entry>
+CompactFibImpl::Add (const Ptr<const NameComponents> &prefix, Ptr<Face> face, int32_t metric)
+{
+  NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix) << boost::cref(*face) << metric);
+
+  uint32_t index = m_prefixes->Insert (prefix);
+  if (index == SharedPrefixTable::NoPrefix)
+    return 0;
+  Reserve (index);
+
+  if (m_routes[index] != NoRoute)
+    {
+      Ptr<Entry> entry = Materialize (index);
+      entry->AddOrUpdateRoutingMetric (face, metric);
+      return entry;
+    }
+
+  Ptr<CompactEntryImpl> entry = Create<CompactEntryImpl> (m_prefixes->GetPrefix (index), index);
+  entry->AddOrUpdateRoutingMetric (face, metric);
+
+  m_routes[index] = Materialized;
+  m_entries[index] = entry;
+  m_size ++;
+
+  // notify forwarding strategy about new FIB entry
+  NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
+  this->GetObject<ForwardingStrategy> ()->DidAddFibEntry (entry);
+
+  return entry;
+}
+
+void
+CompactFibImpl::AddRoute (const Ptr<const NameComponents> &prefix, Ptr<Face> face, int32_t metric, const Time &delay)
+{
+  uint32_t index = m_prefixes->Insert (prefix);
+  if (index == SharedPrefixTable::NoPrefix)
+    return;
+  Reserve (index);
+
+  if (m_routes[index] == Materialized)
+    {
+      Fib::AddRoute (m_prefixes->GetPrefix (index), face, metric, delay);
+      return;
+    }
+
+  uint16_t faceIndex = GetFaceIndex (face);
+
+  uint32_t record = m_routes[index];
+  for (; record != NoNextHop; record = m_nextHops[record].next)
+    {
+      if (m_nextHops[record].face == faceIndex)
+        break;
+    }
+
+  if (record == NoNextHop)
+    {
+      if (m_routes[index] == NoRoute)
+        m_size ++;
+
+      record = AllocateNextHop ();
+      m_nextHops[record].next = m_routes[index];
+      m_nextHops[record].face = faceIndex;
+      m_nextHops[record].status = FaceMetric::NDN_FIB_YELLOW;
+      m_nextHops[record].metric = metric;
+      m_routes[index] = record;
+    }
+  else if (m_nextHops[record].metric > metric || m_nextHops[record].status == FaceMetric::NDN_FIB_RED)
+    {
+      // don't update metric to higher value (same as Entry::AddOrUpdateRoutingMetric)
+      m_nextHops[record].metric = metric;
+      m_nextHops[record].status = FaceMetric::NDN_FIB_YELLOW;
+    }
+
+  m_nextHops[record].delay = delay;
+}
+
+void
+CompactFibImpl::Remove (const Ptr<const NameComponents> &prefix)
+{
+  NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix));
+
+  uint32_t index = m_prefixes->Find (*prefix);
+  if (!HasRoute (m_routes) (index))
+    return;
+
+  if (m_routes[index] == Materialized)
+    {
+      // notify forwarding strategy about soon be removed FIB entry
+      NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
+      this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (m_entries[index]);
+
+      m_entries.erase (index);
+    }
+  else
+    {
+      ReleaseNextHops (m_routes[index]);
+    }
+
+  m_routes[index] = NoRoute;
+  m_size --;
+}
+
+void
+CompactFibImpl::InvalidateAll ()
+{
+  NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId ());
+
+  for (uint32_t index = 0; index < m_routes.size (); index++)
+    {
+      if (m_routes[index] == NoRoute)
+        continue;
+
+      if (m_routes[index] == Materialized)
+        {
+          m_entries[index]->Invalidate ();
+          continue;
+        }
+
+      for (uint32_t record = m_routes[index]; record != NoNextHop; record = m_nextHops[record].next)
+        {
+          m_nextHops[record].metric = std::numeric_limits<uint16_t>::max ();
+          m_nextHops[record].status = FaceMetric::NDN_FIB_RED;
+        }
+    }
+}
+
+void
+CompactFibImpl::RemoveFromAll (Ptr<Face> face)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t faceIndex = NoNextHop;
+  for (uint32_t i = 0; i < m_faces.size (); i++)
+    {
+      if (m_faces[i] == face)
+        faceIndex = i;
+    }
+
+  for (uint32_t index = 0; index < m_routes.size (); index++)
+    {
+      if (m_routes[index] == NoRoute)
+        continue;
+
+      if (m_routes[index] == Materialized)
+        {
+          Ptr<CompactEntryImpl> entry = m_entries[index];
+          entry->RemoveFace (face);
+          if (entry->m_faces.size () == 0)
+            {
+              // notify forwarding strategy about soon be removed FIB entry
+              NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
+              this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (entry);
+
+              m_entries.erase (index);
+              m_routes[index] = NoRoute;
+              m_size --;
+            }
+          continue;
+        }
+
+      if (faceIndex == NoNextHop)
+        continue;
+
+      uint32_t *link = &m_routes[index];
+      while (*link != NoNextHop)
+        {
+          uint32_t record = *link;
+          if (m_nextHops[record].face == faceIndex)
+            {
+              *link = m_nextHops[record].next;
+              m_nextHops[record].next = m_freeNextHops;
+              m_freeNextHops = record;
+            }
+          else
+            {
+              link = &m_nextHops[record].next;
+            }
+        }
+
+      if (m_routes[index] == NoRoute)
+        m_size --; // the last next hop has been removed
+    }
+}
+
+void
+CompactFibImpl::Print (std::ostream &os) const
+{
+  for (uint32_t index = 0; index < m_routes.size (); index++)
+    {
+      if (m_routes[index] == NoRoute)
+        continue;
+
+      if (m_routes[index] == Materialized)
+        {
+          os << m_entries.find (index)->second->GetPrefix () << "\t" << *m_entries.find (index)->second << "\n";
+        }
+      else
+        {
+          // temporary entry, not announced to the forwarding strategy
+          Ptr<Entry> entry = Create<Entry> (m_prefixes->GetPrefix (index));
+          Populate (entry, m_routes[index]);
+          os << entry->GetPrefix () << "\t" << *entry << "\n";
+        }
+    }
+}
+
+uint32_t
+CompactFibImpl::GetSize () const
+{
+  return m_size;
+}
+
+uint32_t
+CompactFibImpl::GetNMaterializedEntries () const
+{
+  return m_entries.size ();
+}
+
+Ptr<Entry>
+CompactFibImpl::FindNext (uint32_t index)
+{
+  for (; index < m_routes.size (); index++)
+    {
+      if (m_routes[index] != NoRoute)
+        return Materialize (index);
+    }
+
+  return End ();
+}
+
+// Iteration creates fib::Entry objects for all the visited prefixes, including the const version
+
+Ptr<const Entry>
+CompactFibImpl::Begin () const
+{
+  return const_cast<CompactFibImpl*> (this)->FindNext (0);
+}
+
+Ptr<const Entry>
+CompactFibImpl::End () const
+{
+  return 0;
+}
+
+Ptr<const Entry>
+CompactFibImpl::Next (Ptr<const Entry> from) const
+{
+  if (from == 0) return 0;
+
+  return const_cast<CompactFibImpl*> (this)->FindNext (StaticCast<const CompactEntryImpl> (from)->GetIndex () + 1);
+}
+
+Ptr<Entry>
+CompactFibImpl::Begin ()
+{
+  return FindNext (0);
+}
+
+Ptr<Entry>
+CompactFibImpl::End ()
+{
+  return 0;
+}
+
+Ptr<Entry>
+CompactFibImpl::Next (Ptr<Entry> from)
+{
+  if (from == 0) return 0;
+
+  return FindNext (StaticCast<CompactEntryImpl> (from)->GetIndex () + 1);
+}
+
+} // namespace fib
+} // namespace ndn
+} // namespace ns3
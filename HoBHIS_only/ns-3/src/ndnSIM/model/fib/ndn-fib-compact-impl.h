@@ -0,0 +1,330 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_FIB_COMPACT_IMPL_H_
+#define	_NDN_FIB_COMPACT_IMPL_H_
+
+#include "ns3/ndn-fib.h"
+#include "ns3/ndn-name-components.h"
+
+#include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/trie/empty-policy.h"
+
+#include <vector>
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+namespace fib {
+
+/**
+ * \ingroup ndn
+ * \brief Table of prefixes shared by all CompactFibImpl instances
+ *
+ * Every prefix added to any compact FIB is stored only once and is assigned a dense index,
+ * which is used by FIBs of individual nodes to address their per-prefix routes.  Prefixes are
+ * never removed from the table.  The table is destroyed when the last FIB referencing it is
+ * destroyed.
+ */
+class SharedPrefixTable : public SimpleRefCount<SharedPrefixTable>
+{
+public:
+  static const uint32_t NoPrefix = 0xffffffff;
+
+  /**
+   * @brief Get the table currently shared between FIBs (new one is created if necessary)
+   */
+  static Ptr<SharedPrefixTable>
+  Get ();
+
+  ~SharedPrefixTable ();
+
+  /**
+   * @brief Get index of the prefix, adding prefix to the table if necessary
+   */
+  uint32_t
+  Insert (const Ptr<const NameComponents> &prefix);
+
+  /**
+   * @brief Get index of the prefix, adding a copy of the prefix to the table if necessary
+   */
+  uint32_t
+  Insert (const NameComponents &prefix);
+
+  /**
+   * @brief Get index of the prefix
+   * @returns NoPrefix if prefix is not in the table
+   */
+  uint32_t
+  Find (const NameComponents &prefix);
+
+  /**
+   * @brief Find the longest prefix of the name for which pred (index) is true
+   * @returns NoPrefix if there is no such prefix
+   */
+  template<class Predicate>
+  uint32_t
+  LongestPrefixMatch (const NameComponents &name, Predicate pred);
+
+  const Ptr<const NameComponents> &
+  GetPrefix (uint32_t index) const
+  {
+    return m_prefixes[index];
+  }
+
+  /**
+   * @brief Get number of prefixes in the table (all indexes are less than this number)
+   */
+  uint32_t
+  GetSize () const
+  {
+    return m_prefixes.size ();
+  }
+
+private:
+  SharedPrefixTable ();
+
+private:
+  // payload of the trie node is (index + 1), 0 means that there is no prefix
+  typedef ndnSIM::trie_with_policy< NameComponents,
+                                    ndnSIM::non_pointer_traits<uint32_t>,
+                                    ndnSIM::empty_policy_traits > trie;
+
+  trie m_trie;
+  std::vector< Ptr<const NameComponents> > m_prefixes;
+
+  static SharedPrefixTable *s_table;
+};
+
+/**
+ * \ingroup ndn
+ * \brief FIB entry of CompactFibImpl, which remembers index of its prefix
+ */
+class CompactEntryImpl : public Entry
+{
+public:
+  CompactEntryImpl (const Ptr<const NameComponents> &prefix, uint32_t index)
+    : Entry (prefix)
+    , m_index (index)
+  {
+  }
+
+  uint32_t
+  GetIndex () const
+  {
+    return m_index;
+  }
+
+private:
+  uint32_t m_index;
+};
+
+/**
+ * \ingroup ndn
+ * \brief Memory-lean FIB implementation for large topologies
+ *
+ * Prefixes are stored only once in SharedPrefixTable.  Each node keeps an array indexed
+ * by the shared prefix index, pointing to a list of compact next hop records (face,
+ * metric, status, and delay to the producer).  No fib::Entry objects, per-node tries, or
+ * per-node copies of the prefix are created for routes installed with AddRoute
+ * (e.g., by GlobalRoutingHelper).
+ *
+ * fib::Entry is created (copy-on-write) only when it is requested: by LongestPrefixMatch
+ * (i.e., when forwarding strategy needs it and can modify status, RTT estimations, and limits
+ * of the entry), Find, Add, or FIB iteration.  Starting from this moment the entry is used
+ * instead of the compact records.  Forwarding strategy is notified about the new entry
+ * (DidAddFibEntry) when the entry is created.
+ *
+ * To use this implementation, select it in StackHelper:
+ *
+ *     ndnHelper.SetFib ("ns3::ndn::fib::Compact");
+ */
+class CompactFibImpl : public Fib
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Constructor
+   */
+  CompactFibImpl ();
+
+  virtual Ptr<Entry>
+  LongestPrefixMatch (const InterestHeader &interest);
+
+  virtual Ptr<Entry>
+  Find (const NameComponents &prefix);
+
+  virtual Ptr<Entry>
+  Add (const NameComponents &prefix, Ptr<Face> face, int32_t metric);
+
+  virtual Ptr<Entry>
+  Add (const Ptr<const NameComponents> &prefix, Ptr<Face> face, int32_t metric);
+
+  virtual void
+  AddRoute (const Ptr<const NameComponents> &prefix, Ptr<Face> face, int32_t metric, const Time &delay);
+
+  virtual void
+  Remove (const Ptr<const NameComponents> &prefix);
+
+  virtual void
+  InvalidateAll ();
+
+  virtual void
+  RemoveFromAll (Ptr<Face> face);
+
+  virtual void
+  Print (std::ostream &os) const;
+
+  virtual uint32_t
+  GetSize () const;
+
+  virtual Ptr<const Entry>
+  Begin () const;
+
+  virtual Ptr<Entry>
+  Begin ();
+
+  virtual Ptr<const Entry>
+  End () const;
+
+  virtual Ptr<Entry>
+  End ();
+
+  virtual Ptr<const Entry>
+  Next (Ptr<const Entry> item) const;
+
+  virtual Ptr<Entry>
+  Next (Ptr<Entry> item);
+
+  /**
+   * @brief Get number of entries that exist as fib::Entry objects
+   */
+  uint32_t
+  GetNMaterializedEntries () const;
+
+protected:
+  // inherited from Object class
+  virtual void NotifyNewAggregate (); ///< @brief Notify when object is aggregated
+  virtual void DoDispose (); ///< @brief Perform cleanup
+
+private:
+  static const uint32_t NoNextHop = 0xffffffff;
+  static const uint32_t NoRoute = NoNextHop; ///< @brief empty list of next hops
+  static const uint32_t Materialized = 0xfffffffe;
+
+  /**
+   * @brief Compact next hop record.  Records of one prefix form a singly linked list,
+   * the most recently added record is the first
+   */
+  struct NextHop
+  {
+    uint32_t next;     ///< @brief next record of the same prefix, or NoNextHop
+    uint16_t face;     ///< @brief index of the face in m_faces
+    uint8_t status;    ///< @brief FaceMetric::Status
+    int32_t metric;    ///< @brief routing cost
+    Time delay;        ///< @brief real delay to the producer
+  };
+
+  struct HasRoute
+  {
+    HasRoute (const std::vector<uint32_t> &routes) : m_routes (routes) { }
+
+    bool
+    operator () (uint32_t index) const
+    {
+      return index < m_routes.size () && m_routes[index] != NoRoute;
+    }
+
+    const std::vector<uint32_t> &m_routes;
+  };
+
+  /**
+   * @brief Make sure that route array covers the prefix index
+   */
+  void
+  Reserve (uint32_t index);
+
+  uint16_t
+  GetFaceIndex (Ptr<Face> face);
+
+  uint32_t
+  AllocateNextHop ();
+
+  void
+  ReleaseNextHops (uint32_t head);
+
+  /**
+   * @brief Fill the entry with compact next hop records of the prefix (in order they were added)
+   */
+  void
+  Populate (Ptr<Entry> entry, uint32_t head) const;
+
+  /**
+   * @brief Get (create, if necessary) fib::Entry for the prefix with existing route
+   */
+  Ptr<Entry>
+  Materialize (uint32_t index);
+
+  /**
+   * @brief Get fib::Entry for the first prefix with route, starting from index
+   */
+  Ptr<Entry>
+  FindNext (uint32_t index);
+
+private:
+  Ptr<SharedPrefixTable> m_prefixes;
+
+  std::vector<uint32_t> m_routes;  ///< @brief prefix index -> head of next hop list, NoRoute, or Materialized
+  std::vector<NextHop> m_nextHops; ///< @brief pool of next hop records
+  uint32_t m_freeNextHops;         ///< @brief head of the list of unused records in the pool
+  std::vector< Ptr<Face> > m_faces;
+
+  typedef std::map<uint32_t, Ptr<CompactEntryImpl> > EntryMap;
+  EntryMap m_entries;              ///< @brief prefix index -> materialized entry
+
+  uint32_t m_size;
+};
+
+template<class Predicate>
+uint32_t
+SharedPrefixTable::LongestPrefixMatch (const NameComponents &name, Predicate pred)
+{
+  for (trie::iterator item = m_trie.longest_prefix_match (name);
+       item != m_trie.end ();
+       item = item->parent ())
+    {
+      if (item->payload () != 0 && pred (item->payload () - 1))
+        return item->payload () - 1;
+    }
+
+  return NoPrefix;
+}
+
+} // namespace fib
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_FIB_COMPACT_IMPL_H_ */
@@ -161,6 +161,23 @@ Entry::Invalidate ()
     }
 }
 
+void
+Entry::InvalidateFace (Ptr<Face> face)
+{
+  FaceMetricByFace::type::iterator record = m_faces.get<i_face> ().find (face);
+  if (record == m_faces.get<i_face> ().end ())
+    return;
+
+  m_faces.modify (record,
+                  (&ll::_1)->*&FaceMetric::m_routingCost = std::numeric_limits<uint16_t>::max ());
+
+  m_faces.modify (record,
+                  (&ll::_1)->*&FaceMetric::m_status = FaceMetric::NDN_FIB_RED);
+
+  // reordering random access index same way as by metric index
+  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
+}
+
 const FaceMetric &
 Entry::FindBestCandidate (uint32_t skip/* = 0*/) const
 {
@@ -213,6 +213,14 @@ public:
   void
   Invalidate ();
 
+  /**
+   * @brief Invalidate only one face of the entry
+   *
+   * Face will be assigned maximum routing metric and NDN_FIB_RED status
+   */
+  void
+  InvalidateFace (Ptr<Face> face);
+
   /**
    * @brief Update RTT averages for the face
    */
@@ -83,6 +83,16 @@ FibImpl::LongestPrefixMatch (const InterestHeader &interest)
     return item->payload ();
 }
 
+Ptr<Entry>
+FibImpl::Find (const NameComponents &prefix)
+{
+  super::iterator item = super::find_exact (prefix);
+
+  if (item == super::end ())
+    return 0;
+  else
+    return item->payload ();
+}
 
 Ptr<Entry>
 FibImpl::Add (const NameComponents &prefix, Ptr<Face> face, int32_t metric)
@@ -202,7 +212,8 @@ FibImpl::RemoveFromAll (Ptr<Face> face)
           // notify forwarding strategy about soon be removed FIB entry
           NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
           this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (trieNode->payload ());
-          
+
+          super::getPolicy ().erase (&(*trieNode));
           trieNode = super::parent_trie::recursive_iterator (trieNode->erase ());
         }
     }
@@ -87,6 +87,9 @@ public:
 
   virtual Ptr<Entry>
   LongestPrefixMatch (const InterestHeader &interest);
+
+  virtual Ptr<Entry>
+  Find (const NameComponents &prefix);
   
   virtual Ptr<Entry>
   Add (const NameComponents &prefix, Ptr<Face> face, int32_t metric);
@@ -22,6 +22,9 @@
 
 #include "ns3/node.h"
 #include "ns3/names.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.Fib");
 
 namespace ns3 {
 namespace ndn {
@@ -36,6 +39,23 @@ Fib::GetTypeId (void)
   return tid;
 }
 
+void
+Fib::AddRoute (const Ptr<const NameComponents> &prefix, Ptr<Face> face, int32_t metric, const Time &delay)
+{
+  Ptr<fib::Entry> entry = Add (prefix, face, metric);
+  entry->SetRealDelayToProducer (face, delay);
+
+  Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
+  if (fibLimits != 0)
+    {
+      // if it was created by the forwarding strategy via DidAddFibEntry event
+      Ptr<Limits> faceLimits = face->GetObject<Limits> ();
+      fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * delay.ToDouble (Time::S) /*exact RTT*/);
+      NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
+                    2 * delay.ToDouble (Time::S) << "s (" << faceLimits->GetMaxRate () * 2 * delay.ToDouble (Time::S) << ")");
+    }
+}
+
 std::ostream&
 operator<< (std::ostream& os, const Fib &fib)
 {
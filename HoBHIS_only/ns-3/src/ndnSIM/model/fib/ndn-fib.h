@@ -64,6 +64,15 @@ public:
    */
   virtual Ptr<fib::Entry>
   LongestPrefixMatch (const InterestHeader &interest) = 0;
+
+  /**
+   * \brief Find FIB entry for exactly the same prefix
+   *
+   * \param prefix Prefix
+   * \returns If entry is not found, 0 is returned
+   */
+  virtual Ptr<fib::Entry>
+  Find (const NameComponents &prefix) = 0;
   
   /**
    * \brief Add or update FIB entry
@@ -93,6 +102,24 @@ public:
   virtual Ptr<fib::Entry>
   Add (const Ptr<const NameComponents> &prefix, Ptr<Face> face, int32_t metric) = 0;
 
+  /**
+   * \brief Add or update route calculated by a routing protocol (e.g., GlobalRoutingHelper)
+   *
+   * Unlike Add, the FIB entry is not returned, which allows implementations to keep routes
+   * in a compact form until the entry is actually requested (e.g., by the forwarding strategy).
+   *
+   * Default implementation calls Add, sets real delay to the producer and, if the forwarding
+   * strategy aggregated Limits object to the FIB entry, sets limits based on maximum rate of
+   * the face and the round-trip delay (2 * delay)
+   *
+   * @param prefix	Smart pointer to prefix
+   * @param face	Forwarding face
+   * @param metric	Routing metric
+   * @param delay	Real propagation delay to the producer
+   */
+  virtual void
+  AddRoute (const Ptr<const NameComponents> &prefix, Ptr<Face> face, int32_t metric, const Time &delay);
+
   /**
    * @brief Remove FIB entry
    *
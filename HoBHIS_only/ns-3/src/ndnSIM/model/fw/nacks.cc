@@ -143,6 +143,7 @@ Nacks::DidExhaustForwardingOptions (Ptr<Face> inFace,
       Ptr<Packet> packet = Create<Packet> ();
       Ptr<InterestHeader> nackHeader = Create<InterestHeader> (*header);
       nackHeader->SetNack (InterestHeader::NACK_GIVEUP_PIT);
+      nackHeader->SetBatchSize (1); // the rest of a batch is NACKed separately
       packet->AddHeader (*nackHeader);
 
       BOOST_FOREACH (const pit::IncomingFace &incoming, pitEntry->GetIncoming ())
@@ -38,6 +38,8 @@
 #include "ns3/assert.h"
 #include "ns3/ptr.h"
 #include "ns3/log.h"
+#include "ns3/tracepoint.h"
+#include "ns3/profiler.h"
 #include "ns3/simulator.h"
 #include "ns3/boolean.h"
 #include "ns3/string.h"
@@ -58,6 +60,7 @@
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
 #include <boost/tuple/tuple.hpp>
+#include <boost/lexical_cast.hpp>
 namespace ll = boost::lambda;
 
 namespace ns3 {
@@ -67,6 +70,13 @@ NS_OBJECT_ENSURE_REGISTERED (ForwardingStrategy);
 
 NS_LOG_COMPONENT_DEFINE (ForwardingStrategy::GetLogName ().c_str ());
 
+NS_TRACEPOINT_DEFINE (g_tpInterest, "ndn.ForwardingStrategy.Interest"); // face id, packet size
+NS_TRACEPOINT_DEFINE (g_tpData, "ndn.ForwardingStrategy.Data"); // face id, packet size
+
+NS_PROFILER_STAGE_DEFINE (g_profileInterest, "ndn.ForwardingStrategy.OnInterest");
+NS_PROFILER_STAGE_DEFINE (g_profileData, "ndn.ForwardingStrategy.OnData");
+NS_PROFILER_STAGE_DEFINE (g_profileCsLookup, "ndn.ContentStore.Lookup");
+
 std::string
 ForwardingStrategy::GetLogName ()
 {
@@ -149,8 +159,16 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
                                 Ptr<const InterestHeader> header,
                                 Ptr<const Packet> origPacket)
 {
+  NS_PROFILE (g_profileInterest);
+  NS_TRACEPOINT (g_tpInterest, inFace->GetId (), origPacket->GetSize ());
   m_inInterests (header, inFace);
 
+  if (header->GetBatchSize () > 1)
+    {
+      OnInterestBatch (inFace, header, origPacket);
+      return;
+    }
+
   Ptr<pit::Entry> pitEntry = m_pit->Lookup (*header);
   bool similarInterest = true;
   if (pitEntry == 0)
@@ -184,7 +202,10 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
   Ptr<Packet> contentObject;
   Ptr<const ContentObjectHeader> contentObjectHeader; // used for tracing
   Ptr<const Packet> payload; // used for tracing
-  boost::tie (contentObject, contentObjectHeader, payload) = m_contentStore->Lookup (header);
+  {
+    NS_PROFILE (g_profileCsLookup);
+    boost::tie (contentObject, contentObjectHeader, payload) = m_contentStore->Lookup (header);
+  }
   if (contentObject != 0)
     {
       NS_ASSERT (contentObjectHeader != 0);
@@ -227,6 +248,171 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
   PropagateInterest (inFace, header, origPacket, pitEntry);
 }
 
+namespace {
+/// @brief Interest of the batch that should be propagated
+struct BatchItem
+{
+  BatchItem (uint32_t seq, Ptr<InterestHeader> header, Ptr<pit::Entry> pitEntry)
+    : m_seq (seq), m_header (header), m_pitEntry (pitEntry) { }
+
+  uint32_t m_seq;
+  Ptr<InterestHeader> m_header;
+  Ptr<pit::Entry> m_pitEntry;
+};
+}
+
+void
+ForwardingStrategy::OnInterestBatch (Ptr<Face> inFace,
+                                     Ptr<const InterestHeader> header,
+                                     Ptr<const Packet> origPacket)
+{
+  NS_LOG_FUNCTION (inFace << header->GetName () << header->GetBatchSize ());
+
+  uint32_t first = 0;
+  try
+    {
+      first = boost::lexical_cast<uint32_t> (header->GetName ().GetLastComponent ());
+    }
+  catch (boost::bad_lexical_cast &)
+    {
+      NS_LOG_DEBUG ("Last component of batched Interest is not a sequence number");
+      m_dropInterests (header, inFace);
+      return;
+    }
+
+  // the same FIB entry for all Interests of the batch
+  Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatch (*header);
+
+  std::list<boost::reference_wrapper<const std::string> > prefix =
+    header->GetName ().GetSubComponents (header->GetName ().size () - 1);
+
+  std::vector<BatchItem> pending;
+  pending.reserve (header->GetBatchSize ());
+  for (uint32_t seq = first; seq - first < header->GetBatchSize (); seq++)
+    {
+      Ptr<NameComponents> name = Create<NameComponents> (prefix);
+      (*name) (seq);
+
+      Ptr<InterestHeader> interest = Create<InterestHeader> (*header);
+      interest->SetName (name);
+      interest->SetBatchSize (1);
+
+      Ptr<pit::Entry> pitEntry = m_pit->Lookup (*interest);
+      bool similarInterest = true;
+      if (pitEntry == 0)
+        {
+          similarInterest = false;
+          pitEntry = m_pit->Create (interest, fibEntry);
+          if (pitEntry != 0)
+            {
+              DidCreatePitEntry (inFace, interest, origPacket, pitEntry);
+            }
+          else
+            {
+              FailedToCreatePitEntry (inFace, interest, origPacket);
+              continue;
+            }
+        }
+
+      if (pitEntry->IsNonceSeen (interest->GetNonce ()))
+        {
+          DidReceiveDuplicateInterest (inFace, interest, origPacket, pitEntry);
+          continue;
+        }
+      pitEntry->AddSeenNonce (interest->GetNonce ());
+
+      Ptr<Packet> contentObject;
+      Ptr<const ContentObjectHeader> contentObjectHeader; // used for tracing
+      Ptr<const Packet> payload; // used for tracing
+      {
+        NS_PROFILE (g_profileCsLookup);
+        boost::tie (contentObject, contentObjectHeader, payload) = m_contentStore->Lookup (interest);
+      }
+      if (contentObject != 0)
+        {
+          FwHopCountTag hopCountTag;
+          if (origPacket->PeekPacketTag (hopCountTag))
+            {
+              contentObject->AddPacketTag (hopCountTag);
+            }
+
+          pitEntry->AddIncoming (inFace);
+          WillSatisfyPendingInterest (0, pitEntry);
+          SatisfyPendingInterest (0, contentObjectHeader, payload, contentObject, pitEntry);
+          continue;
+        }
+
+      if (similarInterest && ShouldSuppressIncomingInterest (inFace, interest, origPacket, pitEntry))
+        {
+          pitEntry->AddIncoming (inFace);
+          pitEntry->UpdateLifetime (interest->GetInterestLifetime ());
+
+          NS_LOG_DEBUG ("Suppress interests");
+          m_dropInterests (interest, inFace);
+
+          DidSuppressSimilarInterest (inFace, interest, origPacket, pitEntry);
+          continue;
+        }
+
+      if (similarInterest)
+        {
+          DidForwardSimilarInterest (inFace, interest, origPacket, pitEntry);
+        }
+
+      pending.push_back (BatchItem (seq, interest, pitEntry));
+    }
+
+  // propagate contiguous ranges of sequence numbers
+  for (size_t begin = 0, end = 0; begin < pending.size (); begin = end)
+    {
+      for (end = begin + 1; end < pending.size () && pending[end].m_seq == pending[end - 1].m_seq + 1; end++)
+        ;
+
+      Ptr<const InterestHeader> rangeHeader = pending[begin].m_header;
+      Ptr<const Packet> rangePacket = origPacket;
+      if (end - begin > 1)
+        {
+          Ptr<InterestHeader> batch = Create<InterestHeader> (*pending[begin].m_header);
+          batch->SetBatchSize (end - begin);
+          rangeHeader = batch;
+        }
+
+      if (end - begin != header->GetBatchSize ())
+        {
+          Ptr<Packet> packet = Create<Packet> ();
+          packet->AddHeader (*rangeHeader);
+
+          FwHopCountTag hopCountTag;
+          if (origPacket->PeekPacketTag (hopCountTag))
+            {
+              packet->AddPacketTag (hopCountTag);
+            }
+          rangePacket = packet;
+        }
+
+      Ptr<pit::Entry> leader = pending[begin].m_pitEntry;
+      PropagateInterest (inFace, rangeHeader, rangePacket, leader);
+
+      // the rest of the range follows the first Interest
+      for (size_t i = begin + 1; i < end; i++)
+        {
+          Ptr<pit::Entry> pitEntry = pending[i].m_pitEntry;
+          pitEntry->AddIncoming (inFace);
+          pitEntry->UpdateLifetime (pending[i].m_header->GetInterestLifetime ());
+
+          BOOST_FOREACH (const pit::OutgoingFace &outgoing, leader->GetOutgoing ())
+            {
+              pitEntry->AddOutgoing (outgoing.m_face);
+            }
+
+          if (pitEntry->AreAllOutgoingInVain ())
+            {
+              DidExhaustForwardingOptions (inFace, pending[i].m_header, rangePacket, pitEntry);
+            }
+        }
+    }
+}
+
 void
 ForwardingStrategy::OnData (Ptr<Face> inFace,
                             Ptr<const ContentObjectHeader> header,
@@ -234,6 +420,8 @@ ForwardingStrategy::OnData (Ptr<Face> inFace,
                             Ptr<const Packet> origPacket)
 {
 	NS_LOG_FUNCTION (inFace << header->GetName () << payload << origPacket);
+	NS_PROFILE (g_profileData);
+	NS_TRACEPOINT (g_tpData, inFace->GetId (), origPacket->GetSize ());
 	m_inData (header, payload, inFace);
 
 	// Lookup PIT entry
@@ -284,7 +472,8 @@ ForwardingStrategy::NDNComputeRTT(Ptr<Face> inFace,
 							   Ptr<Packet> payload,
 							   Ptr<const Packet> origPacket)
 {
-	double rtt_old, rtt_next, rtt_curr, sendtime;
+	double rtt_old, rtt_next, rtt_curr;
+	int64_t sendtime;
 
 	ndn::Name prefix = header->GetName ();
 
@@ -313,7 +502,7 @@ ForwardingStrategy::NDNComputeRTT(Ptr<Face> inFace,
 	}
 	//++++++++++++++++++++++++++++++++++++++++++++
 
-	rtt_curr = Simulator::Now().GetSeconds() - sendtime;
+	rtt_curr = (Simulator::Now().ToTicks (Time::NS) - sendtime) * 1e-9;
 	error = double(rtt_curr)/double(rtt_old); //0.8* error + 0.2 * rtt_curr/rtt_old;
 	if(rtt_old < rtt_curr) A_max = rtt_curr;
 	if(rtt_old != -1.0)
@@ -656,20 +845,19 @@ ForwardingStrategy::TrySendOutInterest (Ptr<Face> inFace,
 	//transmission
 	Ptr<Packet> packetToSend = origPacket->Copy ();
 
-	Ptr<Packet> copy = origPacket->Copy ();
-
 	Ptr<InterestHeader> interest = Create<InterestHeader> (*header);
 	ndn::Name prefix = interest->GetName ().cut(1);
 
-	Ptr<NetDeviceFace> ndf_in = StaticCast<NetDeviceFace>(inFace);
-	Ptr<NetDevice> nd_in = ndf_in->GetNetDevice();
-	Ptr<PointToPointNetDevice> p2pnd_in = StaticCast<PointToPointNetDevice> (nd_in);
-	Ptr<Queue> queue = p2pnd_in->GetQueue();
-	uint32_t qlen = queue->GetNPackets();
+	// interests from applications (AppFace) have no incoming queue to sample
+	Ptr<NetDeviceFace> ndf_in = DynamicCast<NetDeviceFace>(inFace);
+	Ptr<PointToPointNetDevice> p2pnd_in = ndf_in != 0 ? DynamicCast<PointToPointNetDevice> (ndf_in->GetNetDevice()) : 0;
+	Ptr<Queue> queue = p2pnd_in != 0 ? p2pnd_in->GetQueue() : 0;
+	bool hobhis_in = queue != 0 && ndf_in->HobhisEnabled()==true && ndf_in->ClientServer() == false;
+	uint32_t qlen = queue != 0 ? queue->GetNPackets() : 0;
 	uint32_t qlen_flow=0;
-	uint32_t max_chunks = queue->GetNPackets();
+	uint32_t max_chunks = qlen;
 
-	if(ndf_in->HobhisEnabled()==true && ndf_in->ClientServer() == false)
+	if(hobhis_in)
 	{
 		outFace->SetInFaceBW(prefix, inFace->GetCapacity());
 	}
@@ -683,7 +871,7 @@ ForwardingStrategy::TrySendOutInterest (Ptr<Face> inFace,
 
 	uint64_t dRate = inFace->GetCapacity();
 
-	if(ndf_in->HobhisEnabled()==true && ndf_in->ClientServer() == false)
+	if(hobhis_in)
 	{
 		Ptr<NDNDropTailQueue> ndnqueue = StaticCast<NDNDropTailQueue> (queue);
 		if(ndnqueue != NULL)
@@ -771,7 +959,7 @@ void ForwardingStrategy::UpdateShRQLen(Ptr<Face> inFace, Ptr<Face> outFace, ndn:
 	 * PrintShapingTable(outFace);
 	 */
 
-	Simulator::Schedule (Seconds(0.0001), &ForwardingStrategy::UpdateShRQLen, this, inFace, outFace, prefix);
+	Simulator::Schedule (MicroSeconds (100), &ForwardingStrategy::UpdateShRQLen, this, inFace, outFace, prefix);
 }
 
 void
@@ -76,6 +76,25 @@ public:
               Ptr<const InterestHeader> header,
               Ptr<const Packet> origPacket);
 
+  /**
+   * \brief Processing of batched Interests (Interests with batch size larger than 1, see InterestHeader::SetBatchSize)
+   *
+   * Batch is expanded into separate PIT entries in one pass: FIB lookup is done once for the
+   * whole batch (all names of the batch share the prefix; FIB is not expected to contain entries
+   * for individual sequence numbers), Content Store is probed for each name, and names that need
+   * to be forwarded are propagated as batched Interests for contiguous ranges of sequence numbers.
+   * Forwarding decision is made for the first Interest of each range, the rest of the range
+   * follows it.
+   *
+   * @param face    incoming face
+   * @param header  deserialized batched Interest header
+   * @param origPacket  original packet
+   */
+  virtual void
+  OnInterestBatch (Ptr<Face> face,
+                   Ptr<const InterestHeader> header,
+                   Ptr<const Packet> origPacket);
+
   /**
    * \brief Actual processing of incoming Ndn content objects
    * 
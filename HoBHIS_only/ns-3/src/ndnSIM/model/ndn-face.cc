@@ -61,6 +61,8 @@ Face::GetTypeId ()
                      MakeTraceSourceAccessor (&Face::m_rxTrace))
     .AddTraceSource ("NdnDrop", "Dropped packet trace",
                      MakeTraceSourceAccessor (&Face::m_dropTrace))
+    .AddTraceSource ("UpDown", "Face has been enabled (true) or disabled (false)",
+                     MakeTraceSourceAccessor (&Face::m_upDownTrace))
     ;
   return tid;
 }
@@ -197,7 +199,11 @@ void
 Face::SetUp (bool up/* = true*/)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  if (m_ifup == up)
+    return;
+
   m_ifup = up;
+  m_upDownTrace (this, up);
 }
 
 bool
@@ -245,6 +245,7 @@ private:
   TracedCallback<Ptr<const Packet> > m_txTrace;
   TracedCallback<Ptr<const Packet> > m_rxTrace;
   TracedCallback<Ptr<const Packet> > m_dropTrace;
+  TracedCallback<Ptr<Face>, bool> m_upDownTrace;
 
   std::map<ndn::Name, ShrEntry> m_shaping_table;
   std::map<ndn::Name, STimeEntry> m_send_time_table;
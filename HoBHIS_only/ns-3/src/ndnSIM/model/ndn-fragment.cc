@@ -0,0 +1,141 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-fragment.h"
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (FragmentHeader);
+
+const uint32_t FragmentHeader::SIZE;
+
+TypeId
+FragmentHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::FragmentHeader")
+    .SetGroupName ("Ndn")
+    .SetParent<Header> ()
+    .AddConstructor<FragmentHeader> ()
+    ;
+  return tid;
+}
+
+FragmentHeader::FragmentHeader ()
+  : m_sequence (0)
+  , m_index (0)
+  , m_count (1)
+{
+}
+
+FragmentHeader::FragmentHeader (uint32_t sequence, uint16_t index, uint16_t count)
+  : m_sequence (sequence)
+  , m_index (index)
+  , m_count (count)
+{
+}
+
+void
+FragmentHeader::SetSequence (uint32_t sequence)
+{
+  m_sequence = sequence;
+}
+
+uint32_t
+FragmentHeader::GetSequence () const
+{
+  return m_sequence;
+}
+
+void
+FragmentHeader::SetIndex (uint16_t index)
+{
+  m_index = index;
+}
+
+uint16_t
+FragmentHeader::GetIndex () const
+{
+  return m_index;
+}
+
+void
+FragmentHeader::SetCount (uint16_t count)
+{
+  m_count = count;
+}
+
+uint16_t
+FragmentHeader::GetCount () const
+{
+  return m_count;
+}
+
+TypeId
+FragmentHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+void
+FragmentHeader::Print (std::ostream &os) const
+{
+  os << "Fragment " << m_sequence << " " << m_index << "/" << m_count;
+}
+
+uint32_t
+FragmentHeader::GetSerializedSize (void) const
+{
+  return SIZE;
+}
+
+void
+FragmentHeader::Serialize (Buffer::Iterator start) const
+{
+  start.WriteU8 (0x80); // version
+  start.WriteU8 (0x02); // packet type
+  start.WriteHtonU32 (m_sequence);
+  start.WriteHtonU16 (m_index);
+  start.WriteHtonU16 (m_count);
+}
+
+uint32_t
+FragmentHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+
+  if (i.ReadU8 () != 0x80)
+    throw FragmentHeaderException ();
+
+  if (i.ReadU8 () != 0x02)
+    throw FragmentHeaderException ();
+
+  m_sequence = i.ReadNtohU32 ();
+  m_index = i.ReadNtohU16 ();
+  m_count = i.ReadNtohU16 ();
+
+  if (m_count == 0 || m_index >= m_count)
+    throw FragmentHeaderException ();
+
+  return i.GetDistanceFrom (start);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,133 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_FRAGMENT_HEADER_H_
+#define _NDN_FRAGMENT_HEADER_H_
+
+#include "ns3/header.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Header of a link-layer (hop-by-hop) fragment of Interest or ContentObject packet
+ *
+ * Packets that do not fit into MTU of the device are split by NetDeviceFace into
+ * several fragments, which are reassembled by the NetDeviceFace on the other side
+ * of the link (see NetDeviceFace).  Fragment payload is a piece of the original
+ * packet.  All fields are in network byte order:
+ *
+ *        0                   1                   2                   3
+ *        0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+ *       +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *       |  Version 0x80 |  Type 0x02    |       Sequence                |
+ *       +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *       |       Sequence (cont.)        |        Fragment index         |
+ *       +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *       |       Fragment count          |
+ *       +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *
+ * Sequence identifies the fragmented packet (all fragments of the packet share the
+ * same sequence number), fragment index is the position of the fragment in the
+ * packet, and fragment count is the total number of fragments of the packet.
+ */
+class FragmentHeader : public Header
+{
+public:
+  /**
+   * @brief Constructor
+   */
+  FragmentHeader ();
+
+  /**
+   * @brief Constructor
+   * @param sequence sequence number of the fragmented packet
+   * @param index index of the fragment
+   * @param count total number of fragments of the packet
+   */
+  FragmentHeader (uint32_t sequence, uint16_t index, uint16_t count);
+
+  /**
+   * @brief Set sequence number of the fragmented packet
+   */
+  void
+  SetSequence (uint32_t sequence);
+
+  /**
+   * @brief Get sequence number of the fragmented packet
+   */
+  uint32_t
+  GetSequence () const;
+
+  /**
+   * @brief Set index of the fragment
+   */
+  void
+  SetIndex (uint16_t index);
+
+  /**
+   * @brief Get index of the fragment
+   */
+  uint16_t
+  GetIndex () const;
+
+  /**
+   * @brief Set total number of fragments of the packet
+   */
+  void
+  SetCount (uint16_t count);
+
+  /**
+   * @brief Get total number of fragments of the packet
+   */
+  uint16_t
+  GetCount () const;
+
+  //////////////////////////////////////////////////////////////////
+
+  static TypeId GetTypeId (void); ///< @brief Get TypeId
+  virtual TypeId GetInstanceTypeId (void) const; ///< @brief Get TypeId of the instance
+  virtual void Print (std::ostream &os) const; ///< @brief Print out information about the header into the stream
+  virtual uint32_t GetSerializedSize (void) const; ///< @brief Get size necessary to serialize the header
+  virtual void Serialize (Buffer::Iterator start) const; ///< @brief Serialize the header
+  virtual uint32_t Deserialize (Buffer::Iterator start); ///< @brief Deserialize the header
+
+  /**
+   * @brief Size of the serialized header
+   */
+  static const uint32_t SIZE = 2 + 4 + 2 + 2;
+
+private:
+  uint32_t m_sequence;
+  uint16_t m_index;
+  uint16_t m_count;
+};
+
+/**
+ * @ingroup ndn-exceptions
+ * @brief Class for fragment header parsing exception
+ */
+class FragmentHeaderException {};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_FRAGMENT_HEADER_H_
@@ -0,0 +1,392 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-header-view.h"
+
+#include "ns3/packet.h"
+#include "ns3/log.h"
+
+#include "ns3/ndn-header-helper.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-content-object.h"
+
+#include <cstring>
+#include <boost/ref.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.HeaderView");
+
+namespace ns3 {
+namespace ndn {
+
+NameComponentView::NameComponentView (const uint8_t *data, uint16_t size)
+  : m_data (data)
+  , m_size (size)
+{
+}
+
+std::string
+NameComponentView::ToString () const
+{
+  return std::string (reinterpret_cast<const char*> (m_data), m_size);
+}
+
+bool
+NameComponentView::operator== (const std::string &value) const
+{
+  return value.size () == m_size &&
+    std::memcmp (value.data (), m_data, m_size) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+NameView::NameView ()
+  : m_length (0)
+  , m_size (0)
+{
+}
+
+NameView::NameView (Ptr<const Packet> packet, uint32_t offset)
+  : m_length (0)
+  , m_size (-1)
+{
+  uint8_t length[2];
+  if (packet->CopyData (length, 2, offset) != 2)
+    throw UnknownHeaderException ();
+
+  m_length = length[0] | (static_cast<uint16_t> (length[1]) << 8);
+
+  uint8_t *data = m_inline;
+  if (m_length > INLINE_SIZE)
+    {
+      m_heap.resize (m_length);
+      data = &m_heap[0];
+    }
+
+  if (packet->CopyData (data, m_length, offset + 2) != m_length)
+    throw UnknownHeaderException ();
+}
+
+NameView::NameView (const NameView &other)
+  : m_length (0)
+  , m_size (other.m_size)
+{
+  Assign (other.GetData (), other.m_length);
+}
+
+NameView &
+NameView::operator= (const NameView &other)
+{
+  if (this != &other)
+    {
+      Assign (other.GetData (), other.m_length);
+      m_size = other.m_size;
+    }
+  return *this;
+}
+
+void
+NameView::Assign (const uint8_t *data, uint16_t length)
+{
+  m_length = length;
+  if (m_length > INLINE_SIZE)
+    {
+      m_heap.assign (data, data + m_length);
+    }
+  else
+    {
+      m_heap.clear ();
+      std::memcpy (m_inline, data, m_length);
+    }
+}
+
+const uint8_t *
+NameView::GetData () const
+{
+  return m_length > INLINE_SIZE ? &m_heap[0] : m_inline;
+}
+
+size_t
+NameView::size () const
+{
+  if (m_size < 0)
+    {
+      const uint8_t *data = GetData ();
+      int32_t size = 0;
+      uint32_t position = 0;
+      while (position + 2 <= m_length)
+        {
+          position += 2 + (data[position] | (static_cast<uint16_t> (data[position + 1]) << 8));
+          size ++;
+        }
+      if (position != m_length)
+        throw UnknownHeaderException (); // malformed name
+
+      m_size = size;
+    }
+  return m_size;
+}
+
+NameComponentView
+NameView::Get (size_t index) const
+{
+  NS_ASSERT_MSG (index < size (), "Invalid component index requested");
+
+  const uint8_t *data = GetData ();
+  uint32_t position = 0;
+  for (;;)
+    {
+      uint16_t length = data[position] | (static_cast<uint16_t> (data[position + 1]) << 8);
+      if (index == 0)
+        return NameComponentView (data + position + 2, length);
+
+      position += 2 + length;
+      index --;
+    }
+}
+
+NameComponentView
+NameView::GetLastComponent () const
+{
+  if (size () == 0)
+    return NameComponentView (GetData (), 0);
+
+  return Get (size () - 1);
+}
+
+Name
+NameView::ToName () const
+{
+  return cut (0);
+}
+
+Name
+NameView::cut (size_t minusComponents) const
+{
+  NS_ASSERT_MSG (minusComponents <= size (), "Invalid number of components requested");
+
+  size_t count = size () - minusComponents;
+
+  std::vector<std::string> components;
+  components.reserve (count);
+  std::list<boost::reference_wrapper<const std::string> > references;
+
+  const uint8_t *data = GetData ();
+  uint32_t position = 0;
+  for (size_t i = 0; i < count; i++)
+    {
+      uint16_t length = data[position] | (static_cast<uint16_t> (data[position + 1]) << 8);
+      components.push_back (std::string (reinterpret_cast<const char*> (data + position + 2), length));
+      references.push_back (boost::cref (components.back ()));
+      position += 2 + length;
+    }
+
+  return Name (references);
+}
+
+bool
+NameView::operator== (const Name &name) const
+{
+  if (size () != name.size ())
+    return false;
+
+  const uint8_t *data = GetData ();
+  uint32_t position = 0;
+  for (Name::const_iterator component = name.begin (); component != name.end (); component++)
+    {
+      uint16_t length = data[position] | (static_cast<uint16_t> (data[position + 1]) << 8);
+      if (!(NameComponentView (data + position + 2, length) == *component))
+        return false;
+
+      position += 2 + length;
+    }
+  return true;
+}
+
+void
+NameView::Print (std::ostream &os) const
+{
+  for (size_t i = 0; i < size (); i++)
+    {
+      os << "/" << Get (i).ToString ();
+    }
+  if (size () == 0) os << "/";
+}
+
+std::ostream &
+operator << (std::ostream &os, const NameView &name)
+{
+  name.Print (os);
+  return os;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+HeaderView::HeaderView (Ptr<const Packet> packet, uint32_t offset, uint32_t nameOffset)
+  : m_packet (packet)
+  , m_offset (offset)
+  , m_nameOffset (nameOffset)
+  , m_nameDecoded (false)
+{
+}
+
+Ptr<const Packet>
+HeaderView::GetPacket () const
+{
+  return m_packet;
+}
+
+uint32_t
+HeaderView::GetOffset () const
+{
+  return m_offset;
+}
+
+const NameView &
+HeaderView::GetName () const
+{
+  if (!m_nameDecoded)
+    {
+      NS_LOG_DEBUG ("Decoding name at offset " << m_offset + m_nameOffset);
+      m_name = NameView (m_packet, m_offset + m_nameOffset);
+      m_nameDecoded = true;
+    }
+  return m_name;
+}
+
+uint32_t
+HeaderView::GetNameEnd () const
+{
+  return m_nameOffset + GetName ().GetSerializedSize ();
+}
+
+// ndnSIM encoding uses the same byte order as Buffer::Iterator::WriteU16/WriteU32
+
+uint8_t
+HeaderView::ReadU8 (uint32_t position) const
+{
+  uint8_t value;
+  if (m_packet->CopyData (&value, 1, m_offset + position) != 1)
+    throw UnknownHeaderException ();
+  return value;
+}
+
+uint16_t
+HeaderView::ReadU16 (uint32_t position) const
+{
+  uint8_t value[2];
+  if (m_packet->CopyData (value, 2, m_offset + position) != 2)
+    throw UnknownHeaderException ();
+  return value[0] | (static_cast<uint16_t> (value[1]) << 8);
+}
+
+uint32_t
+HeaderView::ReadU32 (uint32_t position) const
+{
+  uint8_t value[4];
+  if (m_packet->CopyData (value, 4, m_offset + position) != 4)
+    throw UnknownHeaderException ();
+  return value[0] |
+    (static_cast<uint32_t> (value[1]) << 8) |
+    (static_cast<uint32_t> (value[2]) << 16) |
+    (static_cast<uint32_t> (value[3]) << 24);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Interest: Version(1) PacketType(1) Nonce(4) Scope(1) NackType(1) InterestLifetime(2) Name Selectors Options
+InterestHeaderView::InterestHeaderView (Ptr<const Packet> packet, uint32_t offset/* = 0*/)
+  : HeaderView (packet, offset, 10)
+{
+  uint8_t type[2];
+  if (packet->CopyData (type, 2, offset) != 2 ||
+      type[0] != 0x80 || type[1] != 0x00)
+    throw InterestHeaderException ();
+}
+
+uint32_t
+InterestHeaderView::GetNonce () const
+{
+  return ReadU32 (2);
+}
+
+int8_t
+InterestHeaderView::GetScope () const
+{
+  return static_cast<int8_t> (ReadU8 (6));
+}
+
+uint8_t
+InterestHeaderView::GetNack () const
+{
+  return ReadU8 (7);
+}
+
+Time
+InterestHeaderView::GetInterestLifetime () const
+{
+  return Seconds (ReadU16 (8));
+}
+
+uint32_t
+InterestHeaderView::GetBatchSize () const
+{
+  uint32_t position = GetNameEnd () + 2; // selectors are not supported (see InterestHeader::Deserialize)
+
+  uint16_t options = ReadU16 (position);
+  position += 2;
+  while (options >= 1 + 4)
+    {
+      uint8_t type = ReadU8 (position);
+      uint32_t value = ReadU32 (position + 1);
+      if (type == 0x01 && value > 0) // BatchSize option
+        return value;
+
+      options -= 1 + 4;
+      position += 1 + 4;
+    }
+  return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ContentObject: Version(1) PacketType(1) Signature(2+2) Name ContentLength(2) ContentInfoLength(2) Timestamp(4) Freshness(2) ...
+ContentObjectHeaderView::ContentObjectHeaderView (Ptr<const Packet> packet, uint32_t offset/* = 0*/)
+  : HeaderView (packet, offset, 6)
+{
+  uint8_t type[2];
+  if (packet->CopyData (type, 2, offset) != 2 ||
+      type[0] != 0x80 || type[1] != 0x01)
+    throw ContentObjectHeaderException ();
+}
+
+Time
+ContentObjectHeaderView::GetTimestamp () const
+{
+  return Seconds (ReadU32 (GetNameEnd () + 4));
+}
+
+Time
+ContentObjectHeaderView::GetFreshness () const
+{
+  return Seconds (ReadU16 (GetNameEnd () + 8));
+}
+
+} // namespace ndn
+} // namespace ns3
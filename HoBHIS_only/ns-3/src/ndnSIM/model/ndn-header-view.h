@@ -0,0 +1,323 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_HEADER_VIEW_H_
+#define _NDN_HEADER_VIEW_H_
+
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/ndn-name.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class Packet;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Read-only view of one name component inside NameView
+ *
+ * The view is valid as long as the NameView it was obtained from exists
+ */
+class NameComponentView
+{
+public:
+  /**
+   * @brief Constructor
+   * @param data pointer to the first byte of the component
+   * @param size size of the component in bytes
+   */
+  NameComponentView (const uint8_t *data, uint16_t size);
+
+  /**
+   * @brief Get pointer to the first byte of the component
+   */
+  inline const uint8_t *
+  data () const;
+
+  /**
+   * @brief Get size of the component in bytes
+   */
+  inline size_t
+  size () const;
+
+  /**
+   * @brief Get a copy of the component as a string
+   */
+  std::string
+  ToString () const;
+
+  /**
+   * @brief Compare component with a string, without making a copy
+   */
+  bool
+  operator== (const std::string &value) const;
+
+private:
+  const uint8_t *m_data;
+  uint16_t m_size;
+};
+
+/**
+ * @ingroup ndn
+ * @brief Read-only view of a name in ndnSIM packet encoding (see Name::Serialize)
+ *
+ * Encoded name is copied with a single Packet::CopyData call into the view (names
+ * shorter than INLINE_SIZE bytes do not require any heap allocation), and components
+ * are decoded only when accessed.  ns-3 packets do not guarantee that packet bytes are
+ * stored contiguously, therefore the view cannot point directly to the packet buffer.
+ *
+ * Name object (std::list of std::strings) is created only if explicitly requested
+ * using ToName or cut methods.
+ */
+class NameView
+{
+public:
+  /**
+   * @brief Constructor of an empty view (name without components)
+   */
+  NameView ();
+
+  /**
+   * @brief Constructor
+   * @param packet packet that contains name
+   * @param offset offset of the encoded name (i.e., of the Length field of the name) in the packet
+   *
+   * Throws UnknownHeaderException if the packet is truncated
+   */
+  NameView (Ptr<const Packet> packet, uint32_t offset);
+
+  NameView (const NameView &other);
+
+  NameView &
+  operator= (const NameView &other);
+
+  /**
+   * @brief Get number of components in the name
+   */
+  size_t
+  size () const;
+
+  /**
+   * @brief Get component of the name
+   * @param index index of the component, valid value is in range [0, size ())
+   */
+  NameComponentView
+  Get (size_t index) const;
+
+  /**
+   * @brief Get the last component of the name
+   */
+  NameComponentView
+  GetLastComponent () const;
+
+  /**
+   * @brief Create Name object with all components of the name
+   */
+  Name
+  ToName () const;
+
+  /**
+   * @brief Create Name object, containing less minusComponents right components (see Name::cut)
+   */
+  Name
+  cut (size_t minusComponents) const;
+
+  /**
+   * @brief Compare with a name, without creating Name object
+   */
+  bool
+  operator== (const Name &name) const;
+
+  /**
+   * @brief Get size of the encoded name in bytes (including the Length field)
+   */
+  inline uint32_t
+  GetSerializedSize () const;
+
+  /**
+   * @brief Print name, the same way as Name is printed
+   */
+  void
+  Print (std::ostream &os) const;
+
+  static const uint32_t INLINE_SIZE = 128; ///< @brief Names up to this size are stored inside the view
+
+private:
+  const uint8_t *
+  GetData () const;
+
+  void
+  Assign (const uint8_t *data, uint16_t length);
+
+private:
+  uint16_t m_length; // length of components, excluding the Length field
+  uint8_t m_inline[INLINE_SIZE];
+  std::vector<uint8_t> m_heap;
+  mutable int32_t m_size; // number of components, -1 if not counted yet
+};
+
+/**
+ * @brief Print out name view components separated by slashes, e.g., /first/second/third
+ */
+std::ostream &
+operator << (std::ostream &os, const NameView &name);
+
+/**
+ * @ingroup ndn
+ * @brief Base class for lazy read-only views of ndnSIM-encoded packet headers
+ *
+ * Unlike InterestHeader and ContentObjectHeader, views do not deserialize the whole
+ * header.  Fixed-position fields are read directly from the packet when requested,
+ * and the name is decoded (see NameView) only on the first access.  Views are intended
+ * for the code that needs only one or two fields of the header (e.g., to detect NACKs
+ * or to get the name prefix for per-flow accounting in queues).
+ */
+class HeaderView
+{
+public:
+  /**
+   * @brief Get packet, the view is attached to
+   */
+  Ptr<const Packet>
+  GetPacket () const;
+
+  /**
+   * @brief Get offset of the header in the packet
+   */
+  uint32_t
+  GetOffset () const;
+
+  /**
+   * @brief Get name (decoded only on the first call)
+   */
+  const NameView &
+  GetName () const;
+
+protected:
+  HeaderView (Ptr<const Packet> packet, uint32_t offset, uint32_t nameOffset);
+
+  uint8_t
+  ReadU8 (uint32_t position) const;
+
+  uint16_t
+  ReadU16 (uint32_t position) const;
+
+  uint32_t
+  ReadU32 (uint32_t position) const;
+
+  /**
+   * @brief Get position of the first byte after the name (relative to the header offset)
+   */
+  uint32_t
+  GetNameEnd () const;
+
+private:
+  Ptr<const Packet> m_packet;
+  uint32_t m_offset;
+  uint32_t m_nameOffset;
+
+  mutable NameView m_name;
+  mutable bool m_nameDecoded;
+};
+
+/**
+ * @ingroup ndn
+ * @brief Lazy read-only view of ndnSIM-encoded Interest packet (see InterestHeader)
+ *
+ * Throws InterestHeaderException if packet is not an Interest, and UnknownHeaderException
+ * if a requested field is outside the packet
+ */
+class InterestHeaderView : public HeaderView
+{
+public:
+  /**
+   * @brief Constructor
+   * @param packet packet with Interest
+   * @param offset offset of the Interest header in the packet (e.g., after the link-layer header)
+   */
+  InterestHeaderView (Ptr<const Packet> packet, uint32_t offset = 0);
+
+  uint32_t
+  GetNonce () const; ///< @brief Get Nonce (see InterestHeader::GetNonce)
+
+  int8_t
+  GetScope () const; ///< @brief Get Scope (see InterestHeader::GetScope)
+
+  uint8_t
+  GetNack () const; ///< @brief Get NACK type (see InterestHeader::GetNack)
+
+  Time
+  GetInterestLifetime () const; ///< @brief Get InterestLifetime (see InterestHeader::GetInterestLifetime)
+
+  uint32_t
+  GetBatchSize () const; ///< @brief Get batch size (see InterestHeader::GetBatchSize)
+};
+
+/**
+ * @ingroup ndn
+ * @brief Lazy read-only view of ndnSIM-encoded ContentObject packet (see ContentObjectHeader)
+ *
+ * Throws ContentObjectHeaderException if packet is not a ContentObject, and UnknownHeaderException
+ * if a requested field is outside the packet
+ */
+class ContentObjectHeaderView : public HeaderView
+{
+public:
+  /**
+   * @brief Constructor
+   * @param packet packet with ContentObject
+   * @param offset offset of the ContentObject header in the packet (e.g., after the link-layer header)
+   */
+  ContentObjectHeaderView (Ptr<const Packet> packet, uint32_t offset = 0);
+
+  Time
+  GetTimestamp () const; ///< @brief Get timestamp (see ContentObjectHeader::GetTimestamp)
+
+  Time
+  GetFreshness () const; ///< @brief Get freshness (see ContentObjectHeader::GetFreshness)
+};
+
+const uint8_t *
+NameComponentView::data () const
+{
+  return m_data;
+}
+
+size_t
+NameComponentView::size () const
+{
+  return m_size;
+}
+
+uint32_t
+NameView::GetSerializedSize () const
+{
+  return 2 + m_length;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_HEADER_VIEW_H_
@@ -21,6 +21,8 @@
 
 #include "ns3/net-device.h"
 #include "ns3/log.h"
+#include "ns3/tracepoint.h"
+#include "ns3/profiler.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
@@ -33,15 +35,23 @@
 #include "ns3/ndn-name-components.h"
 #include "ns3/ndn-header-helper.h"
 #include "ns3/ndn-interest.h"
+#include "ns3/ndn-header-view.h"
 #include "ns3/simulator.h"
 
 #include <map>
+#include <algorithm>
 #include <utility>
+#include <cmath>
 #include "ns3/ndn_shr_entry.h"
 #include "ns3/ndn_send_time_entry.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.HobhisNetDeviceFace");
 
+NS_TRACEPOINT_DEFINE (g_tpShaperEnqueue, "ndn.HobhisNetDeviceFace.ShaperEnqueue"); // face id, shaper queue length
+NS_TRACEPOINT_DEFINE (g_tpShaperDrop, "ndn.HobhisNetDeviceFace.ShaperDrop"); // face id, shaper queue length
+
+NS_PROFILER_STAGE_DEFINE (g_profileComputeGap, "ndn.HobhisNetDeviceFace.ComputeGap");
+
 namespace ns3 {
 namespace ndn {
 
@@ -54,7 +64,8 @@ HobhisNetDeviceFace::GetTypeId ()
     		.SetParent<NetDeviceFace> ()
     		.SetGroupName ("Ndn")
     		.AddAttribute ("MaxInterest",
-    					   "Size of the shaper interest queue.",
+    					   "Size of the shaper interest queue.  Batched Interest counts as its batch size; "
+    					   "a batch larger than the queue is accepted only into an empty queue.",
     					   UintegerValue (100),
     					   MakeUintegerAccessor (&HobhisNetDeviceFace::m_maxInterest),
     					   MakeUintegerChecker<uint32_t> ())
@@ -86,6 +97,7 @@ HobhisNetDeviceFace::GetTypeId ()
 
 HobhisNetDeviceFace::HobhisNetDeviceFace (Ptr<Node> node, const Ptr<NetDevice> &netDevice)
 : NetDeviceFace (node, netDevice)
+, m_interestQueueWeight(0)
 , m_outContentFirst(true)
 , m_outContentSize(1000)
 , m_outInterestFirst(true)
@@ -126,51 +138,48 @@ HobhisNetDeviceFace::SendImpl (Ptr<Packet> p)
 	{
 
 		uint8_t nack;
-		Ptr<ndn::InterestHeader> header = Create<ndn::InterestHeader> ();
-		Ptr<Packet> nack_p = p->Copy();
-		nack_p->RemoveHeader (*header);
-		nack = header->GetNack();
+		InterestHeaderView header (p); // fields are decoded only when needed
+		nack = header.GetNack();
 
 		if(this->HobhisEnabled() && ! this->ClientServer() && nack == 0)
 		{
-			Ptr<Packet> packet = p->Copy ();
-			Ptr<InterestHeader> header = Create<InterestHeader> ();
-			packet->RemoveHeader (*header);
 			NS_LOG_DEBUG("Interest packet, router");
-			NS_LOG_LOGIC(this << " shaper qlen: " << m_interestQueue.size());
-			ndn::Name prefix = header->GetName ().cut(1);
+			NS_LOG_LOGIC(this << " shaper qlen: " << m_interestQueueWeight);
+			ndn::Name prefix = header.GetName ().cut(1);
+			uint32_t weight = header.GetBatchSize (); // batched Interest is shaped as batch size Interests
 
-			if(m_interestQueue.size() + 1 <= m_maxInterest)
+			// a batch larger than the whole queue would never fit, so it is admitted into an empty queue
+			if(m_interestQueueWeight + std::min (weight, m_maxInterest) <= m_maxInterest)
 			{
 				// Enqueue success
 				m_interestQueue.push(p);
+				m_interestQueueWeight += weight;
+				NS_TRACEPOINT (g_tpShaperEnqueue, GetId (), m_interestQueueWeight);
 
 				std::map<ndn::Name, uint32_t>::iterator
 				iqit(m_nIntQueueSizePerFlow.find(prefix)),
 				iqend(m_nIntQueueSizePerFlow.end());
 				if (iqit == iqend)
 				{
-					m_nIntQueueSizePerFlow.insert(std::pair<ndn::Name, uint32_t>(prefix, 1));
+					m_nIntQueueSizePerFlow.insert(std::pair<ndn::Name, uint32_t>(prefix, weight));
 				}
 				else
 				{
 					uint32_t & queue_size = iqit->second;
-					uint32_t qs = queue_size;
-					if(qs + 1 <= m_maxInterest)
-						queue_size++;
+					queue_size += weight; // the same weight is subtracted in ShaperSend
 				}
 
 				if (m_shaperState == OPEN)
 				{
 					if (m_outInterestFirst)
 						{
-							m_outInterestSize = p->GetSize(); // first sample
+							m_outInterestSize = double (p->GetSize()) / weight; // first sample (per requested Data packet)
 							m_outInterestFirst = false;
 							ShaperSend();
 						}
 						else
 						{
-							m_outInterestSize += (p->GetSize() - m_outInterestSize) / 8.0; // smoothing
+							m_outInterestSize += (double (p->GetSize()) / weight - m_outInterestSize) / 8.0; // smoothing
 							ShaperDequeue();
 						}
 
@@ -182,6 +191,7 @@ HobhisNetDeviceFace::SendImpl (Ptr<Packet> p)
 			else
 			{
 				NS_LOG_LOGIC(this << " Tail drop");
+				NS_TRACEPOINT (g_tpShaperDrop, GetId (), m_interestQueueWeight);
 				return false;
 			}
 		}
@@ -193,18 +203,14 @@ HobhisNetDeviceFace::SendImpl (Ptr<Packet> p)
 	case HeaderHelper::CONTENT_OBJECT_NDNSIM:
 	{
 		NS_LOG_DEBUG("Data packet, router");
-		Ptr<Packet> packet = p->Copy ();
-		Ptr<ContentObjectHeader> header = Create<ContentObjectHeader> ();
-		packet->RemoveHeader (*header);
-		ndn::Name prefix = header->GetName();
 		if (m_outContentFirst)
 		{
-			m_outContentSize = p->GetSize(); // first sample
+			m_outContentSize = GetWireSize (p->GetSize()); // first sample
 			m_outContentFirst = false;
 		}
 		else
 		{
-			m_outContentSize += (p->GetSize() - m_outContentSize) / 8.0; // smoothing
+			m_outContentSize += (GetWireSize (p->GetSize()) - m_outContentSize) / 8.0; // smoothing
 		}
 
 		return NetDeviceFace::SendImpl (p); // no shaping for content packets
@@ -237,17 +243,17 @@ void
 HobhisNetDeviceFace::ShaperDequeue ()
 {
 	NS_LOG_FUNCTION (this);
-	NS_LOG_LOGIC(this << " shaper qlen: " << m_interestQueue.size());
+	NS_LOG_LOGIC(this << " shaper qlen: " << m_interestQueueWeight);
 
 	Time gap = ComputeGap();
 
-	if(gap.GetSeconds() >= 0.0)
+	if(!gap.IsStrictlyNegative ())
 	{
 		Simulator::Schedule (gap, &HobhisNetDeviceFace::ShaperSend, this);
 	}
 	else
 	{
-		Simulator::Schedule (Seconds(0.0001), &HobhisNetDeviceFace::ShaperOpen, this);
+		Simulator::Schedule (MicroSeconds (100), &HobhisNetDeviceFace::ShaperOpen, this);
 	}
 
 }
@@ -256,10 +262,10 @@ void HobhisNetDeviceFace::ShaperSend()
 {
 	Ptr<Packet> p = m_interestQueue.front ();
 	m_interestQueue.pop ();
-	Ptr<Packet> packet = p->Copy();
-	Ptr<InterestHeader> header = Create<InterestHeader> ();
-	packet->RemoveHeader (*header);
-	ndn::Name prefix = header->GetName ();
+	InterestHeaderView header (p);
+	ndn::Name prefix = header.GetName ().ToName ();
+	uint32_t weight = header.GetBatchSize ();
+	m_interestQueueWeight -= std::min (weight, m_interestQueueWeight);
 
 	std::map<ndn::Name, uint32_t>::iterator
 	iqit(m_nIntQueueSizePerFlow.find(prefix.cut(1))),
@@ -267,8 +273,7 @@ void HobhisNetDeviceFace::ShaperSend()
 	if (iqit != iqend)
 	{
 		uint32_t & queue_size = iqit->second;
-		if(queue_size != 0)
-			queue_size--;
+		queue_size -= std::min (weight, queue_size);
 	}
 
 	std::map <ndn::Name, STimeEntry> & sendtable = GetSendingTable();
@@ -278,7 +283,7 @@ void HobhisNetDeviceFace::ShaperSend()
 	fend(sendtable.end());
 	if (fit == fend)
 	{
-		sendtable.insert(std::pair<ndn::Name, STimeEntry>(prefix, STimeEntry(Simulator::Now().GetSeconds())));
+		sendtable.insert(std::pair<ndn::Name, STimeEntry>(prefix, STimeEntry(Simulator::Now().ToTicks (Time::NS))));
 	}
 	// send out the interest
 	NetDeviceFace::SendImpl (p);
@@ -287,19 +292,18 @@ void HobhisNetDeviceFace::ShaperSend()
 
 Time HobhisNetDeviceFace::ComputeGap()
 {
+	NS_PROFILE (g_profileComputeGap);
 
-	Ptr<Packet> p = m_interestQueue.front ()->Copy();
+	Ptr<const Packet> p = m_interestQueue.front ();
 
 	m_shaperState = BLOCKED;
 
-	Ptr<Packet> packet = p->Copy ();
-	Ptr<InterestHeader> header = Create<InterestHeader> ();
-	packet->RemoveHeader (*header);
-	ndn::Name prefix = header->GetName ();
+	InterestHeaderView header (p);
+	ndn::Name flow = header.GetName ().cut(1);
 
 	double rtt = -1.0;
 	double buf_part = 0;
-	uint64_t bw = GetInFaceBW(prefix.cut(1));
+	uint64_t bw = GetInFaceBW(flow);
 	double qlen = 0.0;
 	double qlen_flow = 0.0;
 	double queue_rel = 1.0;
@@ -317,7 +321,7 @@ Time HobhisNetDeviceFace::ComputeGap()
 	}
 	 */
 	std::map<ndn::Name, ShrEntry>::iterator
-	fit(shtable.find(prefix.cut(1))),
+	fit(shtable.find(flow)),
 	fend(shtable.end());
 	if (fit != fend) {
 		ShrEntry & values = fit->second;
@@ -348,21 +352,20 @@ Time HobhisNetDeviceFace::ComputeGap()
 
 	double out_rate_in_interests = double(m_outBitRate)/(8.0 * m_outInterestSize);
 
-	Time gap = Seconds(0.0);
+	Time gap;
 
 	if(m_shapingRate >= out_rate_in_interests)
 	{
 		m_shapingRate = out_rate_in_interests/fl_num;
-
-		gap = Seconds(0.0);
 	}
 	else
 	{
 		double del = 0.0;
 
-		del = double(1.0 / m_shapingRate);
+		del = double(header.GetBatchSize ()) / m_shapingRate; // batch of Interests takes the time of all its Interests
 
-		gap = Seconds(del);
+		// integer nanoseconds instead of Seconds (double), rounded down as Seconds () does
+		gap = Time::FromTicks (static_cast<int64_t> (std::floor (del * 1e9)), Time::NS);
 
 	}
 /*
@@ -381,7 +384,7 @@ Time HobhisNetDeviceFace::ComputeGap()
 			<<this<<"\t\t\tqueue_rel = "<<queue_rel<<std::endl
 			<<this<<"\t\t\t"<<Simulator::Now().GetSeconds()<<"\tqlen_flow = "<<qlen_flow<<std::endl
 			<<this<<"\t\t\tqlen = "<<qlen<<std::endl
-			<<this<<"\t\t\t IQueue = "<<m_interestQueue.size()<<std::endl
+			<<this<<"\t\t\t IQueue = "<<m_interestQueueWeight<<std::endl
 			<<this<<"\t\t\tgap = "<<gap.GetSeconds()<<std::endl
 			<<"*************************************************************"<<std::endl;
 */
@@ -398,14 +401,9 @@ Time HobhisNetDeviceFace::ComputeGap()
 }
 
 void
-HobhisNetDeviceFace::ReceiveFromNetDevice (Ptr<NetDevice> device,
-		Ptr<const Packet> p,
-		uint16_t protocol,
-		const Address &from,
-		const Address &to,
-		NetDevice::PacketType packetType)
+HobhisNetDeviceFace::ReceivePacket (Ptr<const Packet> p, uint32_t wireSize)
 {
-	NS_LOG_FUNCTION (device << p << protocol << from << to << packetType);
+	NS_LOG_FUNCTION (this << p << wireSize);
 
 	HeaderHelper::Type type = HeaderHelper::GetNdnHeaderType (p);
 	switch (type)
@@ -415,13 +413,13 @@ HobhisNetDeviceFace::ReceiveFromNetDevice (Ptr<NetDevice> device,
 		NS_LOG_DEBUG("Receive Data from netdevice");
 		if (m_inContentFirst)
 		{
-			m_inContentSize = p->GetSize(); // first sample
+			m_inContentSize = wireSize; // first sample (in link bytes, including fragment headers)
 			m_inContentFirst = false;
 		}
 		else
 		{
-			m_inContentSize = p->GetSize();
-			m_inContentSize += (p->GetSize() - m_inContentSize) / 8.0; // smoothing
+			m_inContentSize = wireSize;
+			m_inContentSize += (wireSize - m_inContentSize) / 8.0; // smoothing
 		}
 		break;
 	}
@@ -429,7 +427,7 @@ HobhisNetDeviceFace::ReceiveFromNetDevice (Ptr<NetDevice> device,
 		break;
 	}
 
-	Receive (p);
+	NetDeviceFace::ReceivePacket (p, wireSize);
 }
 
 void
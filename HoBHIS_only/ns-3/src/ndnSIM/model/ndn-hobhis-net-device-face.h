@@ -59,7 +59,9 @@ public:
    */
   virtual ~HobhisNetDeviceFace();
 
-  uint32_t GetQueueLength() {return m_interestQueue.size();};
+  uint32_t GetQueueLength() {return m_interestQueueWeight;};
+
+  double GetInContentSize() {return m_inContentSize;}; ///< size of received Data on the link (including fragment headers)
 
   bool SetSendingTime(ndn::NameComponents prefix,
 		  	  	   	  double stime);
@@ -83,6 +85,9 @@ protected:
   virtual bool
   SendImpl (Ptr<Packet> p);
 
+  virtual void
+  ReceivePacket (Ptr<const Packet> p, uint32_t wireSize);
+
   Ptr<Face> inFace;
 private:
   HobhisNetDeviceFace (const HobhisNetDeviceFace &); ///< \brief Disabled copy constructor
@@ -91,17 +96,11 @@ private:
   void ShaperOpen ();
   void ShaperDequeue ();
 
-  virtual void ReceiveFromNetDevice (Ptr<NetDevice> device,
-                             Ptr<const Packet> p,
-                             uint16_t protocol,
-                             const Address &from,
-                             const Address &to,
-                             NetDevice::PacketType packetType);
-
   void ShaperSend();
   Time ComputeGap();
 
   std::queue<Ptr<Packet> > m_interestQueue;
+  uint32_t m_interestQueueWeight; ///< number of Interests in the shaper queue, batched Interest counts as its batch size
   uint32_t m_maxInterest;
 
   double m_shapingRate;
@@ -49,6 +49,7 @@ InterestHeader::InterestHeader ()
   , m_interestLifetime (Seconds (0))
   , m_nonce (0)
   , m_nackType (NORMAL_INTEREST)
+  , m_batchSize (1)
 {
 }
 
@@ -58,6 +59,7 @@ InterestHeader::InterestHeader (const InterestHeader &interest)
   , m_interestLifetime    (interest.m_interestLifetime)
   , m_nonce               (interest.m_nonce)
   , m_nackType            (interest.m_nackType)
+  , m_batchSize           (interest.m_batchSize)
 {
 }
 
@@ -137,10 +139,23 @@ InterestHeader::GetNack () const
   return m_nackType;
 }
 
+void
+InterestHeader::SetBatchSize (uint32_t batchSize)
+{
+  NS_ASSERT_MSG (batchSize > 0, "Batch size should be positive");
+  m_batchSize = batchSize;
+}
+
+uint32_t
+InterestHeader::GetBatchSize () const
+{
+  return m_batchSize;
+}
+
 uint32_t
 InterestHeader::GetSerializedSize (void) const
 {
-	size_t size = 2 + (1 + 4 + 2 + 1 + (m_name->GetSerializedSize ()) + (2 + 0) + (2 + 0));
+	size_t size = 2 + (1 + 4 + 2 + 1 + (m_name->GetSerializedSize ()) + (2 + 0) + (2 + (m_batchSize > 1 ? 1 + 4 : 0)));
 	NS_LOG_INFO ("Serialize size = " << size);
 
   return size;
@@ -166,7 +181,14 @@ InterestHeader::Serialize (Buffer::Iterator start) const
   start.Next (offset);
   
   start.WriteU16 (0); // no selectors
-  start.WriteU16 (0); // no options
+  if (m_batchSize > 1)
+    {
+      start.WriteU16 (1 + 4);
+      start.WriteU8 (0x01); // BatchSize option
+      start.WriteU32 (m_batchSize);
+    }
+  else
+    start.WriteU16 (0); // no options
 }
 
 uint32_t
@@ -191,7 +213,20 @@ InterestHeader::Deserialize (Buffer::Iterator start)
   i.Next (offset);
   
   i.ReadU16 ();
-  i.ReadU16 ();
+
+  m_batchSize = 1;
+  uint16_t options = i.ReadU16 ();
+  while (options >= 1 + 4)
+    {
+      uint8_t type = i.ReadU8 ();
+      uint32_t value = i.ReadU32 ();
+      options -= 1 + 4;
+
+      if (type == 0x01 && value > 0)
+        m_batchSize = value;
+    }
+  if (options > 0)
+    throw new InterestHeaderException ();
 
   NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
 
@@ -208,6 +243,8 @@ void
 InterestHeader::Print (std::ostream &os) const
 {
   os << "I: " << GetName ();
+  if (m_batchSize > 1)
+    os << " x" << m_batchSize;
   
   return;
   os << "<Interest>\n  <Name>" << GetName () << "</Name>\n";
@@ -82,6 +82,11 @@ namespace ndn {
   *        ~                          Options                              ~
   *        |							           |	
   *        +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  *
+  * The only defined option is BatchSize (type 0x01, followed by uint32_t value), which is present
+  * only if the batch size is larger than 1.  Batched Interest requests a contiguous range of
+  * sequence numbers under one prefix: the last component of the Name is the first sequence number
+  * of the range (see SetBatchSize).
   * **/
 class InterestHeader : public SimpleRefCount<InterestHeader, Header>
 {
@@ -212,6 +217,25 @@ public:
   uint8_t
   GetNack () const;
 
+  /**
+   * @brief Set number of Data packets requested by the Interest
+   *
+   * Batched Interest (batch size larger than 1) requests Data packets for names
+   * prefix/seq, prefix/(seq+1), ... prefix/(seq+batchSize-1), where prefix/seq is
+   * the name of the Interest.  Routers expand batched Interests into separate PIT
+   * entries (see ForwardingStrategy::OnInterest), each satisfied by a separate Data packet.
+   *
+   * @param[in] batchSize number of requested sequence numbers, 1 for a normal Interest
+   */
+  void
+  SetBatchSize (uint32_t batchSize);
+
+  /**
+   * @brief Get number of Data packets requested by the Interest (1 for a normal Interest)
+   */
+  uint32_t
+  GetBatchSize () const;
+
   //////////////////////////////////////////////////////////////////
 
   static TypeId GetTypeId (void); ///< @brief Get TypeId of the class
@@ -256,6 +280,7 @@ private:
   Time  m_interestLifetime;      ///< InterestLifetime
   uint32_t m_nonce;              ///< Nonce. not used if zero
   uint8_t  m_nackType;           ///< Negative Acknowledgement type
+  uint32_t m_batchSize;          ///< Number of requested sequence numbers (BatchSize option)
 };
 
 /**
@@ -252,7 +252,6 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
   
   NS_LOG_LOGIC ("Packet from face " << *face << " received on node " <<  m_node->GetId ());
 
-  Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the packet
   try
     {
       HeaderHelper::Type type = HeaderHelper::GetNdnHeaderType (p);
@@ -260,12 +259,14 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
         {
         case HeaderHelper::INTEREST_NDNSIM:
           {
-            s_interestCounter ++;
+            __sync_fetch_and_add (&s_interestCounter, 1); // may be called from several threads
             Ptr<InterestHeader> header = Create<InterestHeader> ();
 
             // Deserialization. Exception may be thrown
-            packet->RemoveHeader (*header);
-            NS_ASSERT_MSG (packet->GetSize () == 0, "Payload of Interests should be zero");
+            // (Interests have no payload, so the header is read without copying the packet)
+            uint32_t read = p->PeekHeader (*header);
+            NS_ASSERT_MSG (p->GetSize () == read, "Payload of Interests should be zero");
+            (void)read;
 
             m_forwardingStrategy->OnInterest (face, header, p/*original packet*/);
             // if (header->GetNack () > 0)
@@ -276,11 +277,13 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
           }
         case HeaderHelper::CONTENT_OBJECT_NDNSIM:
           {
-            s_dataCounter ++;
+            __sync_fetch_and_add (&s_dataCounter, 1);
             Ptr<ContentObjectHeader> header = Create<ContentObjectHeader> ();
             
             static ContentObjectTail contentObjectTrailer; //there is no data in this object
 
+            Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the payload
+
             // Deserialization. Exception may be thrown
             packet->RemoveHeader (*header);
             packet->RemoveTrailer (contentObjectTrailer);
@@ -292,6 +295,9 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
         case HeaderHelper::CONTENT_OBJECT_CCNB:
           NS_FATAL_ERROR ("ccnb support is broken in this implementation");
           break;
+        case HeaderHelper::FRAGMENT_NDNSIM:
+          NS_FATAL_ERROR ("Fragments should be reassembled by the face");
+          break;
         }
       
       // exception will be thrown if packet is not recognized
@@ -21,18 +21,25 @@
 
 #include "ndn-net-device-face.h"
 #include "ndn-l3-protocol.h"
+#include "ndn-fragment.h"
 
 #include "ns3/net-device.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/ndn-header-helper.h"
 
 // #include "ns3/address.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
 #include "ns3/ndn-name-components.h"
 
+#include <algorithm>
+#include <limits>
+
 NS_LOG_COMPONENT_DEFINE ("ndn.NetDeviceFace");
 
 namespace ns3 {
@@ -46,6 +53,15 @@ NetDeviceFace::GetTypeId ()
   static TypeId tid = TypeId ("ns3::ndn::NetDeviceFace")
     .SetParent<Face> ()
     .SetGroupName ("Ndn")
+
+    .AddAttribute ("ReassemblyTimeout", "Time to wait for the remaining fragments of the partially received packet",
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&NetDeviceFace::m_reassemblyTimeout),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxReassemblyBuffers", "Maximum number of partially received packets",
+                   UintegerValue (64),
+                   MakeUintegerAccessor (&NetDeviceFace::m_maxReassemblyBuffers),
+                   MakeUintegerChecker<uint32_t> (1))
     ;
   return tid;
 }
@@ -57,6 +73,9 @@ NetDeviceFace::GetTypeId ()
 NetDeviceFace::NetDeviceFace (Ptr<Node> node, const Ptr<NetDevice> &netDevice)
   : Face (node)
   , m_netDevice (netDevice)
+  , m_fragmentSequence (0)
+  , m_reassemblyTimeout (Seconds (1.0))
+  , m_maxReassemblyBuffers (64)
 {
   NS_LOG_FUNCTION (this << netDevice);
 
@@ -68,6 +87,11 @@ NetDeviceFace::NetDeviceFace (Ptr<Node> node, const Ptr<NetDevice> &netDevice)
 NetDeviceFace::~NetDeviceFace ()
 {
   NS_LOG_FUNCTION_NOARGS ();
+
+  for (ReassemblyMap::iterator i = m_reassembly.begin (); i != m_reassembly.end (); i++)
+    {
+      i->second.m_timeout.Cancel ();
+    }
 }
 
 NetDeviceFace& NetDeviceFace::operator= (const NetDeviceFace &)
@@ -81,6 +105,12 @@ NetDeviceFace::GetNetDevice () const
   return m_netDevice;
 }
 
+uint32_t
+NetDeviceFace::GetReassemblyBufferCount () const
+{
+  return m_reassembly.size ();
+}
+
 void
 NetDeviceFace::RegisterProtocolHandler (ProtocolHandler handler)
 {
@@ -92,20 +122,54 @@ NetDeviceFace::RegisterProtocolHandler (ProtocolHandler handler)
                                    L3Protocol::ETHERNET_FRAME_TYPE, m_netDevice, true/*promiscuous mode*/);
 }
 
+uint32_t
+NetDeviceFace::GetWireSize (uint32_t size) const
+{
+  uint32_t mtu = m_netDevice->GetMtu ();
+  if (size <= mtu)
+    return size;
+
+  uint32_t fragmentSize = mtu - FragmentHeader::SIZE;
+  uint32_t count = (size + fragmentSize - 1) / fragmentSize;
+  return size + count * FragmentHeader::SIZE;
+}
+
 bool
 NetDeviceFace::SendImpl (Ptr<Packet> packet)
 {
   NS_LOG_FUNCTION (this << packet);
 
-  NS_ASSERT_MSG (packet->GetSize () <= m_netDevice->GetMtu (),
-                 "Packet size " << packet->GetSize () << " exceeds device MTU "
-                 << m_netDevice->GetMtu ()
-                 << " for Ndn; fragmentation not supported");
+  uint32_t mtu = m_netDevice->GetMtu ();
+  if (packet->GetSize () <= mtu)
+    {
+      return m_netDevice->Send (packet, m_netDevice->GetBroadcast (),
+                                L3Protocol::ETHERNET_FRAME_TYPE);
+    }
+
+  NS_ASSERT_MSG (mtu > FragmentHeader::SIZE,
+                 "Device MTU " << mtu << " is too small for Ndn fragmentation");
 
-  bool ok = m_netDevice->Send (packet, m_netDevice->GetBroadcast (),
-                               L3Protocol::ETHERNET_FRAME_TYPE);
+  uint32_t fragmentSize = mtu - FragmentHeader::SIZE;
+  uint32_t count = (packet->GetSize () + fragmentSize - 1) / fragmentSize;
+  NS_ASSERT_MSG (count <= std::numeric_limits<uint16_t>::max (),
+                 "Packet size " << packet->GetSize () << " requires too many fragments for device MTU " << mtu);
 
-  return ok;
+  NS_LOG_LOGIC ("Packet of size " << packet->GetSize () << " is split into " << count << " fragments");
+
+  FragmentHeader header (m_fragmentSequence++, 0, count);
+  for (uint32_t index = 0, offset = 0; index < count; index++, offset += fragmentSize)
+    {
+      Ptr<Packet> fragment = packet->CreateFragment (offset, std::min (fragmentSize, packet->GetSize () - offset));
+      header.SetIndex (index);
+      fragment->AddHeader (header);
+
+      // the rest of the fragments is useless if one of them is lost
+      if (!m_netDevice->Send (fragment, m_netDevice->GetBroadcast (),
+                              L3Protocol::ETHERNET_FRAME_TYPE))
+        return false;
+    }
+
+  return true;
 }
 
 // callback
@@ -118,9 +182,113 @@ NetDeviceFace::ReceiveFromNetDevice (Ptr<NetDevice> device,
                                      NetDevice::PacketType packetType)
 {
   NS_LOG_FUNCTION (device << p << protocol << from << to << packetType);
+
+  try
+    {
+      if (HeaderHelper::GetNdnHeaderType (p) == HeaderHelper::FRAGMENT_NDNSIM)
+        {
+          ReceiveFragment (p, from);
+          return;
+        }
+    }
+  catch (UnknownHeaderException)
+    {
+      // Ndn stack will deal with it
+    }
+
+  ReceivePacket (p, p->GetSize ());
+}
+
+void
+NetDeviceFace::ReceivePacket (Ptr<const Packet> p, uint32_t wireSize)
+{
+  NS_LOG_FUNCTION (this << p << wireSize);
   Receive (p);
 }
 
+void
+NetDeviceFace::ReceiveFragment (Ptr<const Packet> p, const Address &from)
+{
+  FragmentHeader header;
+  Ptr<Packet> fragment = p->Copy ();
+  try
+    {
+      fragment->RemoveHeader (header);
+    }
+  catch (FragmentHeaderException)
+    {
+      NS_LOG_ERROR ("Malformed fragment header");
+      return;
+    }
+
+  NS_LOG_LOGIC ("Fragment " << header.GetIndex () << "/" << header.GetCount ()
+                << " of packet " << header.GetSequence () << " from " << from);
+
+  std::pair<Address, uint32_t> key (from, header.GetSequence ());
+  ReassemblyMap::iterator entry = m_reassembly.find (key);
+  if (entry == m_reassembly.end ())
+    {
+      if (m_reassembly.size () >= m_maxReassemblyBuffers)
+        {
+          // all reassembly buffers are busy, discard the oldest partially received packet
+          ReassemblyMap::iterator oldest = m_reassembly.begin ();
+          for (ReassemblyMap::iterator i = m_reassembly.begin (); i != m_reassembly.end (); i++)
+            {
+              if (i->second.m_start < oldest->second.m_start)
+                oldest = i;
+            }
+
+          NS_LOG_DEBUG ("Reassembly buffers are full, discarding packet " << oldest->first.second);
+          oldest->second.m_timeout.Cancel ();
+          m_reassembly.erase (oldest);
+        }
+
+      entry = m_reassembly.insert (std::make_pair (key, Reassembly ())).first;
+      entry->second.m_fragments.resize (header.GetCount ());
+      entry->second.m_received = 0;
+      entry->second.m_wireSize = 0;
+      entry->second.m_start = Simulator::Now ();
+      entry->second.m_timeout = Simulator::Schedule (m_reassemblyTimeout, &NetDeviceFace::ReassemblyTimeout,
+                                                     this, from, header.GetSequence ());
+    }
+
+  Reassembly &reassembly = entry->second;
+  if (reassembly.m_fragments.size () != header.GetCount () ||
+      reassembly.m_fragments[header.GetIndex ()] != 0)
+    {
+      NS_LOG_DEBUG ("Duplicate or inconsistent fragment, ignoring");
+      return;
+    }
+
+  reassembly.m_fragments[header.GetIndex ()] = fragment;
+  reassembly.m_received ++;
+  reassembly.m_wireSize += p->GetSize ();
+
+  if (reassembly.m_received < header.GetCount ())
+    return;
+
+  Ptr<Packet> packet = reassembly.m_fragments[0];
+  for (uint16_t index = 1; index < header.GetCount (); index++)
+    {
+      packet->AddAtEnd (reassembly.m_fragments[index]);
+    }
+  uint32_t wireSize = reassembly.m_wireSize;
+
+  reassembly.m_timeout.Cancel ();
+  m_reassembly.erase (entry);
+
+  ReceivePacket (packet, wireSize);
+}
+
+void
+NetDeviceFace::ReassemblyTimeout (Address from, uint32_t sequence)
+{
+  NS_LOG_FUNCTION (this << from << sequence);
+
+  NS_LOG_DEBUG ("Packet " << sequence << " from " << from << " has not been fully received, discarding");
+  m_reassembly.erase (std::make_pair (from, sequence));
+}
+
 
 std::ostream&
 NetDeviceFace::Print (std::ostream& os) const
@@ -24,6 +24,12 @@
 #include "ndn-face.h"
 #include "ns3/net-device.h"
 #include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/address.h"
+
+#include <map>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -40,6 +46,14 @@ namespace ndn {
  * object and this object cannot be changed for the lifetime of the
  * face
  *
+ * Packets that exceed MTU of the NetDevice are split into
+ * hop-by-hop fragments (see FragmentHeader), which are reassembled by
+ * the face on the receiving side before the packet is passed to the
+ * Ndn stack.  At most MaxReassemblyBuffers partially received packets
+ * are kept (the oldest one is discarded when the limit is reached),
+ * and a partially received packet is discarded if its remaining
+ * fragments are not received within ReassemblyTimeout.
+ *
  * \see NdnAppFace, NdnNetDeviceFace, NdnIpv4Face, NdnUdpFace
  */
 class NetDeviceFace  : public Face
@@ -72,6 +86,21 @@ protected:
   virtual bool
   SendImpl (Ptr<Packet> p);
 
+  /**
+   * @brief Pass complete (unfragmented or reassembled) packet received from the NetDevice to the Ndn stack
+   *
+   * @param p packet received from the NetDevice
+   * @param wireSize number of bytes the packet took on the link, including headers of all its fragments
+   */
+  virtual void
+  ReceivePacket (Ptr<const Packet> p, uint32_t wireSize);
+
+  /**
+   * @brief Get number of bytes a packet of the specified size takes on the link, including headers of all its fragments
+   */
+  uint32_t
+  GetWireSize (uint32_t size) const;
+
 //  uint64_t DRate;
 public:
   /**
@@ -88,6 +117,11 @@ public:
    */
   Ptr<NetDevice> GetNetDevice () const;
 
+  /**
+   * \brief Get number of partially received packets waiting for the remaining fragments
+   */
+  uint32_t GetReassemblyBufferCount () const;
+
 private:
   NetDeviceFace (const NetDeviceFace &); ///< \brief Disabled copy constructor
   NetDeviceFace& operator= (const NetDeviceFace &); ///< \brief Disabled copy operator
@@ -100,8 +134,35 @@ private:
                              const Address &to,
                              NetDevice::PacketType packetType);
 
+  /// \brief Reassemble fragment received from the NetDevice
+  void
+  ReceiveFragment (Ptr<const Packet> p, const Address &from);
+
+  /// \brief Discard partially received packet after ReassemblyTimeout
+  void
+  ReassemblyTimeout (Address from, uint32_t sequence);
+
 private:
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
+
+  /**
+   * \brief Fragments of the partially received packet
+   */
+  struct Reassembly
+  {
+    std::vector< Ptr<Packet> > m_fragments; ///< \brief received fragments, indexed by fragment index
+    uint16_t m_received; ///< \brief number of received fragments
+    uint32_t m_wireSize; ///< \brief number of received bytes, including fragment headers
+    Time m_start; ///< \brief time when the first fragment has been received
+    EventId m_timeout; ///< \brief event to discard the packet after ReassemblyTimeout
+  };
+  typedef std::map<std::pair<Address, uint32_t>, Reassembly> ReassemblyMap;
+
+  ReassemblyMap m_reassembly; ///< \brief partially received packets, indexed by sender address and sequence number
+  uint32_t m_fragmentSequence; ///< \brief sequence number of the next fragmented packet
+
+  Time m_reassemblyTimeout;
+  uint32_t m_maxReassemblyBuffers;
 };
 
 } // namespace ndn
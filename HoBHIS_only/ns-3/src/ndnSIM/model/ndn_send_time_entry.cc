@@ -23,7 +23,7 @@ namespace ns3 {
     namespace ndn {
 
 
-    	STimeEntry::STimeEntry(double stime):
+    	STimeEntry::STimeEntry(int64_t stime):
     			m_stime(stime)
         	{}
 
@@ -23,6 +23,7 @@
 
 
 #include <ostream>
+#include <stdint.h>
 
 #include "ns3/ndn-name.h"
 
@@ -35,7 +36,7 @@ class STimeEntry
 
 private:
 
-	double m_stime;		// packet sending time
+	int64_t m_stime;		// packet sending time, in nanoseconds (Time::ToTicks (Time::NS))
 
 
 public:
@@ -44,19 +45,19 @@ public:
 	/**
 	 * \brief Constructor.
 	 * \param prefix The prefix.
-	 * \param stime The Interest sending time
+	 * \param stime The Interest sending time in nanoseconds
 	 * ...
 	 */
 
-	STimeEntry(double stime);
+	STimeEntry(int64_t stime);
 
 	// Getters/Setters
 
-	inline double get_send_time() const {
+	inline int64_t get_send_time() const {
 		return this->m_stime;
 	}
 
-	inline void set_send_time(double stime) {
+	inline void set_send_time(int64_t stime) {
 		this->m_stime = stime;
 	}
 
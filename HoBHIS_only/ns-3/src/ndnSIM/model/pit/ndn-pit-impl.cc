@@ -33,12 +33,15 @@
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
 #include "ns3/simulator.h"
+#include "ns3/profiler.h"
 
 #include <boost/lambda/bind.hpp>
 #include <boost/lambda/lambda.hpp>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.pit.PitImpl");
 
+NS_PROFILER_STAGE_DEFINE (g_profileCleanExpired, "ndn.Pit.CleanExpired");
+
 using namespace boost::tuples;
 using namespace boost;
 namespace ll = boost::lambda;
@@ -194,6 +197,7 @@ template<class Policy>
 void
 PitImpl<Policy>::CleanExpired ()
 {
+  NS_PROFILE (g_profileCleanExpired);
   NS_LOG_LOGIC ("Cleaning PIT. Total: " << i_time.size ());
   Time now = Simulator::Now ();
 
@@ -253,9 +257,15 @@ PitImpl<Policy>::Lookup (const InterestHeader &header)
 template<class Policy>
 Ptr<Entry>
 PitImpl<Policy>::Create (Ptr<const InterestHeader> header)
+{
+  return Create (header, m_fib->LongestPrefixMatch (*header));
+}
+
+template<class Policy>
+Ptr<Entry>
+PitImpl<Policy>::Create (Ptr<const InterestHeader> header, Ptr<fib::Entry> fibEntry)
 {
   NS_LOG_DEBUG (header->GetName ());
-  Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatch (*header);
   if (fibEntry == 0)
     return 0;
   
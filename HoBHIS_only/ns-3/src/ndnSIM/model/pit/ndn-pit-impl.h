@@ -82,6 +82,9 @@ public:
 
   virtual Ptr<Entry>
   Create (Ptr<const InterestHeader> header);
+
+  virtual Ptr<Entry>
+  Create (Ptr<const InterestHeader> header, Ptr<fib::Entry> fibEntry);
   
   virtual void
   MarkErased (Ptr<Entry> entry);
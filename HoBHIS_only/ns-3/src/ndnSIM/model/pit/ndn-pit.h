@@ -95,6 +95,17 @@ public:
    */
   virtual Ptr<pit::Entry>
   Create (Ptr<const InterestHeader> header) = 0;
+
+  /**
+   * @brief Creates a PIT entry for the given interest using already known FIB entry
+   * @param header parsed interest header
+   * @param fibEntry result of FIB longest prefix match for the interest (e.g., shared by all
+   *        interests of a batch)
+   *
+   * Note. This call assumes that the entry does not exist (i.e., there was a Lookup call before)
+   */
+  virtual Ptr<pit::Entry>
+  Create (Ptr<const InterestHeader> header, Ptr<fib::Entry> fibEntry) = 0;
   
   /**
    * @brief Mark PIT entry deleted
@@ -19,6 +19,7 @@
  */
 
 #include "annotated-topology-reader.h"
+#include "topology-tokenizer.h"
 
 #include "ns3/nstime.h"
 #include "ns3/log.h"
@@ -36,17 +37,25 @@
 #include "ns3/string.h"
 #include "ns3/pointer.h"
 #include "ns3/uinteger.h"
+#include "ns3/data-rate.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ndn-l3-protocol.h"
 #include "ns3/ndn-face.h"
 #include "ns3/random-variable.h"
+#include "ns3/topology-partitioner.h"
 
 #include "ns3/constant-position-mobility-model.h"
 
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
 
 #include <set>
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+#include <sys/stat.h>
 
 #ifdef NS3_MPI
 #include <ns3/mpi-interface.h>
@@ -60,10 +69,12 @@ NS_LOG_COMPONENT_DEFINE ("AnnotatedTopologyReader");
     
 AnnotatedTopologyReader::AnnotatedTopologyReader (const std::string &path, double scale/*=1.0*/)
   : m_path (path)
+  , m_partitionCount (0)
   , m_randX (0, 100.0)
   , m_randY (0, 100.0)
   , m_scale (scale)
   , m_requiredPartitions (1)
+  , m_cacheEnabled (false)
 {
   NS_LOG_FUNCTION (this);
 
@@ -79,6 +90,18 @@ AnnotatedTopologyReader::SetBoundingBox (double ulx, double uly, double lrx, dou
   m_randY = UniformVariable (uly, lry);
 }
 
+void
+AnnotatedTopologyReader::SetCacheEnabled (bool enabled)
+{
+  m_cacheEnabled = enabled;
+}
+
+void
+AnnotatedTopologyReader::SetPartitionCount (uint32_t count)
+{
+  m_partitionCount = count;
+}
+
 void
 AnnotatedTopologyReader::SetMobilityModel (const std::string &model)
 {
@@ -101,6 +124,7 @@ AnnotatedTopologyReader::CreateNode (const std::string name, uint32_t systemId)
 
   Names::Add (m_path, name, node);
   m_nodes.Add (node);
+  m_nodeNames[name] = node;
 
   return node;
 }
@@ -119,10 +143,21 @@ AnnotatedTopologyReader::CreateNode (const std::string name, double posX, double
 
   Names::Add (m_path, name, node);
   m_nodes.Add (node);
+  m_nodeNames[name] = node;
 
   return node;
 }
 
+Ptr<Node>
+AnnotatedTopologyReader::FindNode (const std::string &name) const
+{
+  std::map<std::string, Ptr<Node> >::const_iterator node = m_nodeNames.find (name);
+  if (node == m_nodeNames.end ())
+    return 0;
+
+  return node->second;
+}
+
 NodeContainer
 AnnotatedTopologyReader::GetNodes () const
 {
@@ -138,113 +173,400 @@ AnnotatedTopologyReader::GetLinks () const
 NodeContainer
 AnnotatedTopologyReader::Read (void)
 {
-  ifstream topgen;
-  topgen.open (GetFileName ().c_str ());
-        
-  if ( !topgen.is_open () || !topgen.good () )
+  std::vector<NodeRecord> nodes;
+  std::list<LinkRecord> links;
+
+  if (!m_cacheEnabled || !LoadCache (nodes, links))
     {
-      NS_FATAL_ERROR ("Cannot open file " << GetFileName () << " for reading");
-      return m_nodes;
+      if (!ParseFile (nodes, links))
+        return m_nodes;
+
+      if (m_cacheEnabled)
+        SaveCache (nodes, links);
     }
 
-  while (!topgen.eof ())
+  if (m_partitionCount > 0)
+    AssignSystemIds (nodes, links);
+
+  std::vector< Ptr<Node> > nodePtrs;
+  nodePtrs.reserve (nodes.size ());
+  BOOST_FOREACH (const NodeRecord &record, nodes)
     {
-      string line;
-      getline (topgen, line);
+      if (std::abs (record.latitude) > 0.001)
+        nodePtrs.push_back (CreateNode (record.name, m_scale*record.longitude, -m_scale*record.latitude, record.systemId));
+      else
+        {
+          UniformVariable var (0,200);
+          nodePtrs.push_back (CreateNode (record.name, var.GetValue (), var.GetValue (), record.systemId));
+        }
+    }
+
+  BOOST_FOREACH (const LinkRecord &record, links)
+    {
+      Link link (nodePtrs[record.from], nodes[record.from].name, nodePtrs[record.to], nodes[record.to].name);
 
-      if (line == "router") break;
+      link.SetAttribute ("DataRate", record.capacity);
+      link.SetAttribute ("OSPF", record.metric);
+
+      if (!record.delay.empty ())
+        link.SetAttribute ("Delay", record.delay);
+      if (!record.maxPackets.empty ())
+        link.SetAttribute ("MaxPackets", record.maxPackets);
+
+      AddLink (link);
+      NS_LOG_DEBUG ("New link " << nodes[record.from].name << " <==> " << nodes[record.to].name << " / " << record.capacity
+                    << " with " << record.metric << " metric (" << record.delay << ", " << record.maxPackets << ")");
     }
 
-  if (topgen.eof ())
+  NS_LOG_INFO ("Annotated topology created with " << m_nodes.GetN () << " nodes and " << LinksSize () << " links");
+
+  ApplySettings ();
+
+  return m_nodes;
+}
+
+bool
+AnnotatedTopologyReader::ParseFile (std::vector<NodeRecord> &nodes, std::list<LinkRecord> &links) const
+{
+  TopologyTokenizer topgen;
+  if (!topgen.Open (GetFileName ()))
+    {
+      NS_FATAL_ERROR ("Cannot open file " << GetFileName () << " for reading");
+      return false;
+    }
+
+  bool found = false;
+  while (topgen.NextLine ())
+    {
+      if (topgen.GetLine () == "router")
+        {
+          found = true;
+          break;
+        }
+    }
+
+  if (!found)
     {
       NS_FATAL_ERROR ("Topology file " << GetFileName () << " does not have \"router\" section");
-      return m_nodes;
+      return false;
     }
 
-  while (!topgen.eof ())
+  std::map<std::string, uint32_t> nodeIndex;
+
+  found = false;
+  while (topgen.NextLine ())
     {
-      string line;
-      getline (topgen,line);
-      if (line[0] == '#') continue; // comments
-      if (line=="link") break; // stop reading nodes
-      
-      istringstream lineBuffer (line);
-      string name, city;
-      double latitude = 0, longitude = 0;
-      uint32_t systemId = 0;
-
-      lineBuffer >> name >> city >> latitude >> longitude >> systemId;
-      if (name.empty ()) continue;
-
-      Ptr<Node> node;
-      
-      if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-        node = CreateNode (name, m_scale*longitude, -m_scale*latitude, systemId);
-      else
+      const TopologyTokenizer::Token &line = topgen.GetLine ();
+      if (!line.empty () && *line.begin == '#') continue; // comments
+      if (line == "link") // stop reading nodes
         {
-          UniformVariable var (0,200);
-          node = CreateNode (name, var.GetValue (), var.GetValue (), systemId);
-          // node = CreateNode (name, systemId);
+          found = true;
+          break;
         }
+
+      TopologyTokenizer::Token name, city, latitude, longitude, systemId;
+      if (!topgen.NextToken (name)) continue;
+      topgen.NextToken (city);
+      topgen.NextToken (latitude);
+      topgen.NextToken (longitude);
+      topgen.NextToken (systemId);
+
+      NodeRecord record;
+      record.name = name.str ();
+      record.latitude = latitude.ToDouble ();
+      record.longitude = longitude.ToDouble ();
+      record.systemId = systemId.ToUint32 ();
+
+      nodeIndex[record.name] = nodes.size ();
+      nodes.push_back (record);
     }
 
-  map<string, set<string> > processedLinks; // to eliminate duplications
-  
-  if (topgen.eof ())
+  if (!found)
     {
       NS_FATAL_ERROR ("Topology file " << GetFileName () << " does not have \"link\" section");
-      return m_nodes;
+      return false;
     }
 
-  // SeekToSection ("link"); 
-  while (!topgen.eof ())
+  std::set< std::pair<uint32_t, uint32_t> > processedLinks; // to eliminate duplications
+
+  while (topgen.NextLine ())
     {
-      string line;
-      getline (topgen,line);
-      if (line == "") continue;
-      if (line[0] == '#') continue; // comments
+      const TopologyTokenizer::Token &line = topgen.GetLine ();
+      if (line.empty ()) continue;
+      if (*line.begin == '#') continue; // comments
+
+      TopologyTokenizer::Token from, to, capacity, metric, delay, maxPackets;
+      topgen.NextToken (from);
+      topgen.NextToken (to);
+      topgen.NextToken (capacity);
+      topgen.NextToken (metric);
+      topgen.NextToken (delay);
+      topgen.NextToken (maxPackets);
+
+      std::map<std::string, uint32_t>::const_iterator fromNode = nodeIndex.find (from.str ());
+      if (fromNode == nodeIndex.end ())
+        {
+          NS_FATAL_ERROR (GetFileName () << ":" << topgen.GetLineNumber () << ": " << from.str () << " node not found");
+          return false;
+        }
+      std::map<std::string, uint32_t>::const_iterator toNode = nodeIndex.find (to.str ());
+      if (toNode == nodeIndex.end ())
+        {
+          NS_FATAL_ERROR (GetFileName () << ":" << topgen.GetLineNumber () << ": " << to.str () << " node not found");
+          return false;
+        }
+
+      if (processedLinks.find (std::make_pair (toNode->second, fromNode->second)) != processedLinks.end ())
+        {
+          continue; // duplicated link
+        }
+      processedLinks.insert (std::make_pair (fromNode->second, toNode->second));
+
+      LinkRecord record;
+      record.from = fromNode->second;
+      record.to = toNode->second;
+      record.capacity = capacity.str ();
+      record.metric = metric.str ();
+      record.delay = delay.str ();
+      record.maxPackets = maxPackets.str ();
+      links.push_back (record);
+    }
+
+  return true;
+}
+
+// Binary cache of the parsed topology.  All values are in the host byte order:
+//
+//   "ndnTOPO1" | uint64 topology file size | int64 topology file mtime | uint32 #nodes | uint32 #links
+//   #nodes x (string name | double latitude | double longitude | uint32 systemId)
+//   #links x (uint32 from | uint32 to | string capacity | string metric | string delay | string maxPackets)
+//
+// where string is uint32 length followed by the characters
+static const char CacheMagic[8] = { 'n', 'd', 'n', 'T', 'O', 'P', 'O', '1' };
 
-      // NS_LOG_DEBUG ("Input: [" << line << "]");
-      
-      istringstream lineBuffer (line);
-      string from, to, capacity, metric, delay, maxPackets;
+namespace {
 
-      lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets;
+class CacheReader
+{
+public:
+  CacheReader (const char *data, size_t size) : m_pos (data), m_end (data + size) { }
+
+  template<class T>
+  bool
+  Read (T &value)
+  {
+    if (static_cast<size_t> (m_end - m_pos) < sizeof (T))
+      return false;
+    memcpy (&value, m_pos, sizeof (T));
+    m_pos += sizeof (T);
+    return true;
+  }
+
+  bool
+  Read (std::string &value)
+  {
+    uint32_t size = 0;
+    if (!Read (size) || static_cast<size_t> (m_end - m_pos) < size)
+      return false;
+    value.assign (m_pos, size);
+    m_pos += size;
+    return true;
+  }
+
+private:
+  const char *m_pos;
+  const char *m_end;
+};
+
+template<class T>
+void
+WriteValue (std::ostream &os, const T &value)
+{
+  os.write (reinterpret_cast<const char *> (&value), sizeof (T));
+}
 
-      if (processedLinks[to].size () != 0 &&
-          processedLinks[to].find (from) != processedLinks[to].end ())
+void
+WriteValue (std::ostream &os, const std::string &value)
+{
+  WriteValue (os, static_cast<uint32_t> (value.size ()));
+  os.write (value.c_str (), value.size ());
+}
+
+}
+
+std::string
+AnnotatedTopologyReader::GetCacheFileName () const
+{
+  return GetFileName () + ".cache";
+}
+
+bool
+AnnotatedTopologyReader::LoadCache (std::vector<NodeRecord> &nodes, std::list<LinkRecord> &links) const
+{
+  struct stat st;
+  if (stat (GetFileName ().c_str (), &st) != 0)
+    return false;
+
+  TopologyTokenizer cache;
+  if (!cache.Open (GetCacheFileName ()))
+    return false;
+
+  CacheReader is (cache.GetData (), cache.GetSize ());
+
+  char magic[sizeof (CacheMagic)];
+  uint64_t size = 0;
+  int64_t mtime = 0;
+  uint32_t nodesCount = 0, linksCount = 0;
+  for (uint32_t i = 0; i < sizeof (CacheMagic); i++)
+    {
+      if (!is.Read (magic[i]))
+        return false;
+    }
+  if (memcmp (magic, CacheMagic, sizeof (CacheMagic)) != 0 ||
+      !is.Read (size) || !is.Read (mtime) || !is.Read (nodesCount) || !is.Read (linksCount))
+    {
+      NS_LOG_WARN ("Invalid topology cache " << GetCacheFileName ());
+      return false;
+    }
+
+  if (size != static_cast<uint64_t> (st.st_size) || mtime != static_cast<int64_t> (st.st_mtime))
+    {
+      NS_LOG_INFO ("Topology cache " << GetCacheFileName () << " is outdated");
+      return false;
+    }
+
+  nodes.resize (nodesCount);
+  for (uint32_t i = 0; i < nodesCount; i++)
+    {
+      NodeRecord &record = nodes[i];
+      if (!is.Read (record.name) || !is.Read (record.latitude) || !is.Read (record.longitude) || !is.Read (record.systemId))
         {
-          continue; // duplicated link
+          NS_LOG_WARN ("Invalid topology cache " << GetCacheFileName ());
+          nodes.clear ();
+          return false;
         }
-      processedLinks[from].insert (to);
-      
-      Ptr<Node> fromNode = Names::Find<Node> (m_path, from);
-      NS_ASSERT_MSG (fromNode != 0, from << " node not found");
-      Ptr<Node> toNode   = Names::Find<Node> (m_path, to);
-      NS_ASSERT_MSG (toNode != 0, to << " node not found");
-
-      Link link (fromNode, from, toNode, to);
-      
-      link.SetAttribute ("DataRate", capacity);
-      link.SetAttribute ("OSPF", metric);
-
-      if (!delay.empty ())
-          link.SetAttribute ("Delay", delay);
-      if (!maxPackets.empty ())
-        link.SetAttribute ("MaxPackets", maxPackets);
-      
-      AddLink (link);
-      NS_LOG_DEBUG ("New link " << from << " <==> " << to << " / " << capacity << " with " << metric << " metric (" << delay << ", " << maxPackets << ")");
     }
-        
-  NS_LOG_INFO ("Annotated topology created with " << m_nodes.GetN () << " nodes and " << LinksSize () << " links");
-  topgen.close ();
-        
-  ApplySettings ();
-  
-  return m_nodes;
+
+  for (uint32_t i = 0; i < linksCount; i++)
+    {
+      LinkRecord record;
+      if (!is.Read (record.from) || !is.Read (record.to) ||
+          record.from >= nodesCount || record.to >= nodesCount ||
+          !is.Read (record.capacity) || !is.Read (record.metric) || !is.Read (record.delay) || !is.Read (record.maxPackets))
+        {
+          NS_LOG_WARN ("Invalid topology cache " << GetCacheFileName ());
+          nodes.clear ();
+          links.clear ();
+          return false;
+        }
+      links.push_back (record);
+    }
+
+  NS_LOG_INFO ("Topology loaded from cache " << GetCacheFileName ());
+  return true;
 }
-    
+
+void
+AnnotatedTopologyReader::SaveCache (const std::vector<NodeRecord> &nodes, const std::list<LinkRecord> &links) const
+{
+  struct stat st;
+  if (stat (GetFileName ().c_str (), &st) != 0)
+    return;
+
+  // write to a temporary file first, so other processes never see partially written cache
+  std::string tmpFileName = GetCacheFileName () + ".tmp";
+  {
+    ofstream os (tmpFileName.c_str (), ios::out | ios::trunc | ios::binary);
+    if (!os.is_open ())
+      {
+        NS_LOG_WARN ("Cannot create topology cache " << tmpFileName);
+        return;
+      }
+
+    os.write (CacheMagic, sizeof (CacheMagic));
+    WriteValue (os, static_cast<uint64_t> (st.st_size));
+    WriteValue (os, static_cast<int64_t> (st.st_mtime));
+    WriteValue (os, static_cast<uint32_t> (nodes.size ()));
+    WriteValue (os, static_cast<uint32_t> (links.size ()));
+
+    BOOST_FOREACH (const NodeRecord &record, nodes)
+      {
+        WriteValue (os, record.name);
+        WriteValue (os, record.latitude);
+        WriteValue (os, record.longitude);
+        WriteValue (os, record.systemId);
+      }
+
+    BOOST_FOREACH (const LinkRecord &record, links)
+      {
+        WriteValue (os, record.from);
+        WriteValue (os, record.to);
+        WriteValue (os, record.capacity);
+        WriteValue (os, record.metric);
+        WriteValue (os, record.delay);
+        WriteValue (os, record.maxPackets);
+      }
+
+    if (!os.good ())
+      {
+        NS_LOG_WARN ("Cannot write topology cache " << tmpFileName);
+        os.close ();
+        remove (tmpFileName.c_str ());
+        return;
+      }
+  }
+
+  if (rename (tmpFileName.c_str (), GetCacheFileName ().c_str ()) != 0)
+    {
+      NS_LOG_WARN ("Cannot create topology cache " << GetCacheFileName ());
+      remove (tmpFileName.c_str ());
+    }
+}
+
+void
+AnnotatedTopologyReader::AssignSystemIds (std::vector<NodeRecord> &nodes, const std::list<LinkRecord> &links) const
+{
+  TopologyPartitioner partitioner;
+
+  std::vector<uint32_t> degree (nodes.size (), 0);
+  BOOST_FOREACH (const LinkRecord &record, links)
+    {
+      degree[record.from]++;
+      degree[record.to]++;
+    }
+  for (uint32_t i = 0; i < nodes.size (); i++)
+    {
+      partitioner.AddNode (1 + degree[i]);
+    }
+
+  // DataRate and Delay, if not specified for a link, are inherited from the previous link (see ApplySettings)
+  std::string dataRate, delay;
+  BOOST_FOREACH (const LinkRecord &record, links)
+    {
+      if (!record.capacity.empty ())
+        dataRate = record.capacity;
+      if (!record.delay.empty ())
+        delay = record.delay;
+
+      partitioner.AddLink (record.from, record.to,
+                           delay.empty () ? Seconds (0) : Time (delay),
+                           dataRate.empty () ? 1.0 : DataRate (dataRate).GetBitRate () / 1e6); // Mbps
+    }
+
+  std::vector<uint32_t> partitions = partitioner.Partition (m_partitionCount);
+  if (partitioner.GetPartitionCount () != m_partitionCount)
+    {
+      NS_LOG_WARN ("Topology can be split only into " << partitioner.GetPartitionCount () << " partitions");
+    }
+  NS_LOG_INFO ("Topology is split into " << partitioner.GetPartitionCount () << " partitions, lookahead "
+               << partitioner.GetLookahead ().ToDouble (Time::MS) << "ms");
+
+  for (uint32_t i = 0; i < nodes.size (); i++)
+    {
+      nodes[i].systemId = partitions[i];
+    }
+}
+
 void
 AnnotatedTopologyReader::AssignIpv4Addresses (Ipv4Address base)
 {
@@ -323,43 +645,53 @@ AnnotatedTopologyReader::ApplySettings ()
     }
 #endif
   
-  PointToPointHelper p2p;
+  // Links with the same parameters share a helper with already resolved attribute values.
+  // DataRate and Delay, if not specified for a link, are inherited from the previous link
+  typedef boost::tuple<std::string, std::string, std::string> LinkType; // DataRate, Delay, MaxPackets
+  std::map<LinkType, PointToPointHelper> helpers;
+
+  std::string dataRate, delay;
+  bool hasDataRate = false, hasDelay = false;
 
   BOOST_FOREACH (Link &link, m_linksList)
     {
-      // cout << "Link: " << Findlink.GetFromNode () << ", " << link.GetToNode () << endl;
-      string tmp;
+      std::string maxPackets;
 
-      if (link.GetAttributeFailSafe ("DataRate", tmp))
+      if (link.GetAttributeFailSafe ("DataRate", dataRate))
         {
-          NS_LOG_INFO ("DataRate = " + link.GetAttribute("DataRate"));
-          p2p.SetDeviceAttribute ("DataRate", StringValue (link.GetAttribute ("DataRate")));
+          NS_LOG_INFO ("DataRate = " + dataRate);
+          hasDataRate = true;
         }
 
-      if (link.GetAttributeFailSafe ("Delay", tmp))
+      if (link.GetAttributeFailSafe ("Delay", delay))
         {
-          NS_LOG_INFO ("Delay = " + link.GetAttribute("Delay"));
-          p2p.SetChannelAttribute ("Delay", StringValue (link.GetAttribute ("Delay")));
+          NS_LOG_INFO ("Delay = " + delay);
+          hasDelay = true;
         }
 
-      NetDeviceContainer nd = p2p.Install(link.GetFromNode (), link.GetToNode ());
-      link.SetNetDevices (nd.Get (0), nd.Get (1));
-
-      if (link.GetAttributeFailSafe ("MaxPackets", tmp))
+      bool hasMaxPackets = link.GetAttributeFailSafe ("MaxPackets", maxPackets);
+      if (hasMaxPackets)
         {
-          NS_LOG_INFO ("MaxPackets = " + link.GetAttribute ("MaxPackets"));
-
-          PointerValue txQueue;
-
-          link.GetToNetDevice ()->GetAttribute ("TxQueue", txQueue);
-          NS_ASSERT (txQueue.Get<DropTailQueue> () != 0);       
-          txQueue.Get<DropTailQueue> ()->SetAttribute ("MaxPackets", StringValue (link.GetAttribute ("MaxPackets")));
+          NS_LOG_INFO ("MaxPackets = " + maxPackets);
+        }
 
-          link.GetFromNetDevice ()->GetAttribute ("TxQueue", txQueue);
-          NS_ASSERT (txQueue.Get<DropTailQueue> () != 0);
-          txQueue.Get<DropTailQueue> ()->SetAttribute ("MaxPackets", StringValue (link.GetAttribute ("MaxPackets")));
+      LinkType type (hasDataRate ? dataRate : "", hasDelay ? delay : "", maxPackets);
+      std::map<LinkType, PointToPointHelper>::iterator helper = helpers.find (type);
+      if (helper == helpers.end ())
+        {
+          helper = helpers.insert (std::make_pair (type, PointToPointHelper ())).first;
+
+          if (hasDataRate)
+            helper->second.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (dataRate)));
+          if (hasDelay)
+            helper->second.SetChannelAttribute ("Delay", TimeValue (Time (delay)));
+          if (hasMaxPackets)
+            helper->second.SetQueue ("ns3::DropTailQueue",
+                                     "MaxPackets", UintegerValue (boost::lexical_cast<uint32_t> (maxPackets)));
         }
-        
+
+      NetDeviceContainer nd = helper->second.Install (link.GetFromNode (), link.GetToNode ());
+      link.SetNetDevices (nd.Get (0), nd.Get (1));
     }
 }
 
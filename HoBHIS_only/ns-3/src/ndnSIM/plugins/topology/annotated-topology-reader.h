@@ -25,6 +25,9 @@
 #include "ns3/random-variable.h"
 #include "ns3/object-factory.h"
 
+#include <map>
+#include <vector>
+
 namespace ns3 
 {
     
@@ -49,7 +52,9 @@ public:
   /**
    * \brief Main annotated topology reading function.
    *
-   * This method opens an input stream and reads topology file with annotations.
+   * This method maps topology file with annotations into memory, parses it, and creates all nodes
+   * and links.  If cache is enabled (see SetCacheEnabled), the parsed topology is
+   * loaded from (or saved to) the binary cache file.
    *
    * \return the container of the nodes created (or empty container if there was an error)
    */
@@ -102,6 +107,35 @@ public:
    */
   void ApplyOspfMetric ();
 
+  /**
+   * \brief Enable or disable binary cache of the parsed topology
+   *
+   * When enabled, Read saves the parsed topology into a binary file next to the topology file
+   * (topology file name with ".cache" suffix).  During subsequent runs the topology is loaded from
+   * this file without parsing the text, as long as size and modification time of the topology
+   * file did not change.  The cache file is not portable between platforms.
+   *
+   * \param enabled Whether cache should be used (disabled by default)
+   */
+  void
+  SetCacheEnabled (bool enabled);
+
+  /**
+   * \brief Automatically assign system ids of the nodes for distributed simulation
+   *
+   * When enabled, system ids specified in the topology file are ignored.  Instead, nodes are
+   * split into the requested number of partitions using TopologyPartitioner, so that links
+   * between partitions have as large delay as possible (lookahead of the distributed
+   * simulator), partitions have approximately the same number of nodes and links, and links
+   * with the smallest total capacity are cut.  Links between nodes with different system ids
+   * are created by PointToPointHelper as remote channels.
+   *
+   * \param count Number of partitions (e.g., MpiInterface::GetSize ()), 0 to use system ids
+   *              from the topology file (default)
+   */
+  void
+  SetPartitionCount (uint32_t count);
+
   /**
    * \brief Save positions (e.g., after manual modification using visualizer)
    */
@@ -114,6 +148,13 @@ protected:
 
   Ptr<Node>
   CreateNode (const std::string name, double posX, double posY, uint32_t systemId);
+
+  /**
+   * \brief Find node, created by this reader, using its name in the topology file
+   * \returns 0 if node does not exist
+   */
+  Ptr<Node>
+  FindNode (const std::string &name) const;
   
 protected:
   /**
@@ -126,11 +167,59 @@ protected:
 protected:
   std::string m_path;
   NodeContainer m_nodes;
+  uint32_t m_partitionCount; ///< \brief number of partitions requested by SetPartitionCount
 
 private:
   AnnotatedTopologyReader (const AnnotatedTopologyReader&);
   AnnotatedTopologyReader& operator= (const AnnotatedTopologyReader&);
 
+  struct NodeRecord
+  {
+    std::string name;
+    double latitude;
+    double longitude;
+    uint32_t systemId;
+  };
+
+  struct LinkRecord
+  {
+    uint32_t from; ///< \brief index of the node in the node list
+    uint32_t to;   ///< \brief index of the node in the node list
+    std::string capacity;
+    std::string metric;
+    std::string delay;
+    std::string maxPackets;
+  };
+
+  /**
+   * \brief Parse text topology file
+   */
+  bool
+  ParseFile (std::vector<NodeRecord> &nodes, std::list<LinkRecord> &links) const;
+
+  /**
+   * \brief Load the parsed topology from the cache
+   * \returns false if cache does not exist, is invalid or outdated
+   */
+  bool
+  LoadCache (std::vector<NodeRecord> &nodes, std::list<LinkRecord> &links) const;
+
+  /**
+   * \brief Save the parsed topology to the cache
+   */
+  void
+  SaveCache (const std::vector<NodeRecord> &nodes, const std::list<LinkRecord> &links) const;
+
+  std::string
+  GetCacheFileName () const;
+
+  /**
+   * \brief Replace system ids of the nodes with automatically calculated partitions
+   */
+  void
+  AssignSystemIds (std::vector<NodeRecord> &nodes, const std::list<LinkRecord> &links) const;
+
+
   UniformVariable m_randX;
   UniformVariable m_randY;
 
@@ -138,6 +227,9 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+
+  bool m_cacheEnabled;
+  std::map<std::string, Ptr<Node> > m_nodeNames;
 };
 
 }
@@ -22,6 +22,7 @@
  */
 
 #include "rocketfuel-map-reader.h"
+#include "topology-tokenizer.h"
 
 #include "ns3/nstime.h"
 #include "ns3/log.h"
@@ -43,11 +44,10 @@
 #include "ns3/ipv4-address.h"
 #include "ns3/node-list.h"
 #include "ns3/random-variable.h"
+#include "ns3/topology-partitioner.h"
 
 #include "ns3/mobility-model.h"
 
-#include <regex.h>
-
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 
@@ -83,41 +83,169 @@ RocketfuelMapReader::Read ()
 
 /* uid @loc [+] [bb] (num_neigh) [&ext] -> <nuid-1> <nuid-2> ... {-euid} ... =name[!] rn */
 
-#define REGMATCH_MAX 16
+namespace {
+
+struct MapsLine
+{
+  std::string uid;
+  uint32_t numNeighbors;
+  std::vector<std::string> neighbors;
+  std::string name;
+};
 
-#define START "^"
-#define END "$"
-#define SPACE "[ \t]+"
-#define MAYSPACE "[ \t]*"
+class MapsLineParser
+{
+public:
+  MapsLineParser (const TopologyTokenizer::Token &line) : m_pos (line.begin), m_end (line.end) { }
+
+  /**
+   * Hand-written equivalent of the regular expression
+   *
+   * ^(-*[0-9]+)[ \t]+(@[?A-Za-z0-9,+]+)[ \t]+(\+)*[ \t]*(bb)*[ \t]*\(([0-9]+)\)[ \t]+(&[0-9]+)*[ \t]*
+   * ->[ \t]*(<[0-9 \t<>]+>)*[ \t]*(\{-[0-9\{\} \t-]+\})*[ \t]+=([A-Za-z0-9.!-]+)[ \t]+r([0-9])[ \t]*$
+   */
+  bool
+  Parse (MapsLine &line)
+  {
+    const char *begin = m_pos;
+    while (Skip ('-'))
+      ;
+    if (!SkipDigits ())
+      return false;
+    line.uid.assign (begin, m_pos);
+
+    if (!SkipSpaces ())
+      return false;
+
+    if (!Skip ('@') || !SkipWhile (IsLocationChar))
+      return false;
+
+    if (!SkipSpaces ())
+      return false;
+
+    while (Skip ('+'))
+      ;
+    SkipSpaces ();
+    while (m_end - m_pos >= 2 && m_pos[0] == 'b' && m_pos[1] == 'b')
+      m_pos += 2;
+    SkipSpaces ();
+
+    if (!Skip ('('))
+      return false;
+    begin = m_pos;
+    if (!SkipDigits ())
+      return false;
+    line.numNeighbors = TopologyTokenizer::Token (begin, m_pos).ToUint32 ();
+    if (!Skip (')'))
+      return false;
+
+    if (!SkipSpaces ())
+      return false;
+
+    while (Skip ('&'))
+      {
+        if (!SkipDigits ())
+          return false;
+      }
+    SkipSpaces ();
+
+    if (!Skip ('-') || !Skip ('>'))
+      return false;
+    SkipSpaces ();
+
+    line.neighbors.clear ();
+    while (Skip ('<'))
+      {
+        begin = m_pos;
+        SkipDigits ();
+        line.neighbors.push_back (std::string (begin, m_pos));
+        if (!Skip ('>'))
+          return false;
+        SkipSpaces ();
+      }
+
+    // external links are ignored
+    while (m_pos != m_end && *m_pos == '{')
+      {
+        if (!SkipWhile (IsExternalChar))
+          return false;
+      }
+
+    if (m_pos == m_end || *m_pos != '=' || !IsSpace (m_pos[-1]))
+      return false;
+    m_pos ++;
+
+    begin = m_pos;
+    if (!SkipWhile (IsNameChar))
+      return false;
+    line.name.assign (begin, m_pos);
+
+    if (!SkipSpaces ())
+      return false;
+
+    // routers of all radii are used
+    if (!Skip ('r') || m_pos == m_end || !IsDigit (*m_pos))
+      return false;
+    m_pos ++;
+
+    SkipSpaces ();
+    return m_pos == m_end;
+  }
+
+private:
+  static bool IsSpace (char c) { return c == ' ' || c == '\t'; }
+  static bool IsDigit (char c) { return c >= '0' && c <= '9'; }
+  static bool IsAlnum (char c) { return IsDigit (c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+  static bool IsLocationChar (char c) { return IsAlnum (c) || c == '?' || c == ',' || c == '+'; }
+  static bool IsExternalChar (char c) { return IsDigit (c) || IsSpace (c) || c == '{' || c == '}' || c == '-'; }
+  static bool IsNameChar (char c) { return IsAlnum (c) || c == '.' || c == '!' || c == '-'; }
+
+  bool
+  Skip (char c)
+  {
+    if (m_pos == m_end || *m_pos != c)
+      return false;
+    m_pos ++;
+    return true;
+  }
+
+  // returns true if at least one character was skipped
+  bool
+  SkipWhile (bool (*pred) (char))
+  {
+    const char *begin = m_pos;
+    while (m_pos != m_end && pred (*m_pos))
+      m_pos ++;
+    return m_pos != begin;
+  }
 
-#define ROCKETFUEL_MAPS_LINE \
-START "(-*[0-9]+)" SPACE "(@[?A-Za-z0-9,+]+)" SPACE \
-"(\\+)*" MAYSPACE "(bb)*" MAYSPACE \
-"\\(([0-9]+)\\)" SPACE "(&[0-9]+)*" MAYSPACE \
-"->" MAYSPACE "(<[0-9 \t<>]+>)*" MAYSPACE \
-"(\\{-[0-9\\{\\} \t-]+\\})*" SPACE \
-"=([A-Za-z0-9.!-]+)" SPACE "r([0-9])" \
-MAYSPACE END
+  bool SkipSpaces () { return SkipWhile (IsSpace); }
+  bool SkipDigits () { return SkipWhile (IsDigit); }
+
+private:
+  const char *m_pos;
+  const char *m_end;
+};
+
+}
 
 void
-RocketfuelMapReader::CreateLink (string nodeName1, string nodeName2,
+RocketfuelMapReader::CreateLink (Ptr<Node> node1, const string &nodeName1, Ptr<Node> node2, const string &nodeName2,
                                  double averageRtt,
-                                 const string &minBw, const string &maxBw,
-                                 const string &minDelay, const string &maxDelay)
+                                 const DataRate &minBw, const DataRate &maxBw,
+                                 const Time &minDelay, const Time &maxDelay)
 {
-  Ptr<Node> node1 = Names::Find<Node> (m_path, nodeName1);
-  Ptr<Node> node2 = Names::Find<Node> (m_path, nodeName2);
   Link link (node1, nodeName1, node2, nodeName2);
 
   DataRate randBandwidth
-    (m_randVar.GetInteger (static_cast<uint32_t> (lexical_cast<DataRate> (minBw).GetBitRate ()),
-                           static_cast<uint32_t> (lexical_cast<DataRate> (maxBw).GetBitRate ())));
+    (m_randVar.GetInteger (static_cast<uint32_t> (minBw.GetBitRate ()),
+                           static_cast<uint32_t> (maxBw.GetBitRate ())));
 
   int32_t metric = std::max (1, static_cast<int32_t> (1.0 * m_referenceOspfRate.GetBitRate () / randBandwidth.GetBitRate ()));
 
   Time randDelay =
-    Time::FromDouble ((m_randVar.GetValue (lexical_cast<Time> (minDelay).ToDouble (Time::US),
-                                           lexical_cast<Time> (maxDelay).ToDouble (Time::US))),
+    Time::FromDouble ((m_randVar.GetValue (minDelay.ToDouble (Time::US),
+                                           maxDelay.ToDouble (Time::US))),
                       Time::US);
 
   uint32_t queue = ceil (averageRtt * (randBandwidth.GetBitRate () / 8.0 / 1100.0));
@@ -130,86 +258,18 @@ RocketfuelMapReader::CreateLink (string nodeName1, string nodeName2,
   AddLink (link);
 }
 
-// NodeContainer
 void
-RocketfuelMapReader::GenerateFromMapsFile (int argc, char *argv[])
+RocketfuelMapReader::GenerateFromMapsFile (const string &uid, uint32_t numNeighbors, const vector<string> &neighbors)
 {
-  string uid;
-  string loc;
-  string ptr;
-  string name;
-  string nuid;
-  // bool dns = false;
-  // bool bb = false;
-  int num_neigh_s = 0;
-  unsigned int num_neigh = 0;
-  int radius = 0;
-  vector <string> neigh_list;
-
-  uid = argv[0];
-  loc = argv[1];
-
-  // if (argv[2])
-  // {
-  //   dns = true;
-  // }
-
-  // if (argv[3])
-  // {
-  //   bb = true;
-  // }
-
-  num_neigh_s = ::atoi (argv[4]);
-  if (num_neigh_s < 0)
-  {
-    num_neigh = 0;
-    NS_LOG_WARN ("Negative number of neighbors given");
-  }
-  else
-  {
-    num_neigh = num_neigh_s;
-  }
-
-  /* neighbors */
-  if (argv[6])
-  {
-    char *nbr;
-    char *stringp = argv[6];
-    while ((nbr = strsep (&stringp, " \t")) != NULL)
-    {
-      nbr[strlen (nbr) - 1] = '\0';
-      neigh_list.push_back (nbr + 1);
-    }
-  }
-
-  if (num_neigh != neigh_list.size ())
-  {
-    NS_LOG_WARN ("Given number of neighbors = " << num_neigh << " != size of neighbors list = " << neigh_list.size ());
-  }
-
-  /* externs */
-  if (argv[7])
-  {
-    //      euid = argv[7];
-  }
-
-  /* name */
-  if (argv[8])
+  if (numNeighbors != neighbors.size ())
   {
-    name = argv[8];
-  }
-
-  radius = ::atoi (&argv[9][1]);
-  if (radius > 0)
-  {
-    return;
+    NS_LOG_WARN ("Given number of neighbors = " << numNeighbors << " != size of neighbors list = " << neighbors.size ());
   }
 
   // Create node and link
   if (uid.empty ())
     return;
 
-
   node_map_t::iterator node = m_graphNodes.find (uid);
   if (node == m_graphNodes.end ())
     {
@@ -221,9 +281,9 @@ RocketfuelMapReader::GenerateFromMapsFile (int argc, char *argv[])
       m_maxNodeId ++;
     }
 
-  for (uint32_t i = 0; i < neigh_list.size (); ++i)
+  for (uint32_t i = 0; i < neighbors.size (); ++i)
     {
-      nuid = neigh_list[i];
+      const string &nuid = neighbors[i];
 
       if (nuid.empty ())
         {
@@ -286,75 +346,23 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
 {
   m_maxNodeId = 0;
 
-  ifstream topgen;
-  topgen.open (GetFileName ().c_str ());
-  //NodeContainer nodes;
-  UniformVariable var;
-
-  istringstream lineBuffer;
-  string line;
-  int lineNumber = 0;
-  char errbuf[512];
-
-  if (!topgen.is_open ())
+  TopologyTokenizer topgen;
+  if (!topgen.Open (GetFileName ()))
   {
     NS_LOG_WARN ("Couldn't open the file " << GetFileName ());
     return m_nodes;
   }
 
-  while (!topgen.eof ())
+  MapsLine mapsLine;
+  while (topgen.NextLine ())
   {
-    int ret;
-    int argc;
-    char *argv[REGMATCH_MAX];
-    char *buf;
-
-    lineNumber++;
-    line.clear ();
-    lineBuffer.clear ();
-
-    getline (topgen, line);
-    buf = (char *)line.c_str ();
-
-    regmatch_t regmatch[REGMATCH_MAX];
-    regex_t regex;
-
-    ret = regcomp (&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
-    if (ret != 0)
-    {
-      regerror (ret, &regex, errbuf, sizeof (errbuf));
-      regfree (&regex);
-      continue;
-    }
-
-    ret = regexec (&regex, buf, REGMATCH_MAX, regmatch, 0);
-    if (ret == REG_NOMATCH)
+    if (!MapsLineParser (topgen.GetLine ()).Parse (mapsLine))
     {
-      NS_LOG_WARN ("match failed (maps file): %s" << buf);
-      regfree (&regex);
+      NS_LOG_WARN ("match failed (maps file): " << topgen.GetLine ().str ());
       continue;
     }
 
-    line = buf;
-    argc = 0;
-
-    /* regmatch[0] is the entire strings that matched */
-    for (int i = 1; i < REGMATCH_MAX; i++)
-    {
-      if (regmatch[i].rm_so == -1)
-      {
-        argv[i - 1] = NULL;
-      }
-      else
-      {
-        line[regmatch[i].rm_eo] = '\0';
-        argv[i - 1] = &line[regmatch[i].rm_so];
-        argc = i;
-      }
-    }
-
-    GenerateFromMapsFile (argc, argv);
-    regfree (&regex);
+    GenerateFromMapsFile (mapsLine.uid, mapsLine.numNeighbors, mapsLine.neighbors);
   }
 
   if (keepOneComponent)
@@ -436,10 +444,16 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
       NS_LOG_DEBUG ("After 2 eliminating disconnected nodes:  " << num_vertices(m_graph));
     }
 
+  map<Traits::vertex_descriptor, uint32_t> systemIds;
+  if (m_partitionCount > 0)
+    AssignSystemIds (params, systemIds);
+
+  map<Traits::vertex_descriptor, Ptr<Node> > vertexNodes;
   for (tie(v, endv) = vertices(m_graph); v != endv; v++)
     {
       string nodeName = get (vertex_name, m_graph, *v);
-      Ptr<Node> node = CreateNode (nodeName, 0);
+      Ptr<Node> node = CreateNode (nodeName, m_partitionCount > 0 ? systemIds[*v] : 0);
+      vertexNodes[*v] = node;
 
       node_type_t type = get (vertex_rank, m_graph, *v);
       switch (type)
@@ -465,12 +479,24 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
         }
     }
 
+  // link parameters are converted only once
+  DataRate minb2bBandwidth (params.minb2bBandwidth), maxb2bBandwidth (params.maxb2bBandwidth);
+  DataRate minb2gBandwidth (params.minb2gBandwidth), maxb2gBandwidth (params.maxb2gBandwidth);
+  DataRate ming2cBandwidth (params.ming2cBandwidth), maxg2cBandwidth (params.maxg2cBandwidth);
+  Time minb2bDelay (params.minb2bDelay), maxb2bDelay (params.maxb2bDelay);
+  Time minb2gDelay (params.minb2gDelay), maxb2gDelay (params.maxb2gDelay);
+  Time ming2cDelay (params.ming2cDelay), maxg2cDelay (params.maxg2cDelay);
+
   for (tie (e, ende) = edges (m_graph); e != ende; e++)
     {
       Traits::vertex_descriptor
         u = source (*e, m_graph),
         v = target (*e, m_graph);
 
+      Ptr<Node>
+        u_node = vertexNodes[u],
+        v_node = vertexNodes[v];
+
       node_type_t
         u_type = get (vertex_rank, m_graph, u),
         v_type = get (vertex_rank, m_graph, v);
@@ -481,33 +507,33 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
 
       if (u_type == BACKBONE && v_type == BACKBONE)
         {
-          CreateLink (u_name, v_name,
+          CreateLink (u_node, u_name, v_node, v_name,
                       params.averageRtt,
-                      params.minb2bBandwidth, params.maxb2bBandwidth,
-                      params.minb2bDelay,     params.maxb2bDelay);
+                      minb2bBandwidth, maxb2bBandwidth,
+                      minb2bDelay,     maxb2bDelay);
         }
       else if ((u_type == GATEWAY  && v_type == BACKBONE) ||
                (u_type == BACKBONE && v_type == GATEWAY ))
         {
-          CreateLink (u_name, v_name,
+          CreateLink (u_node, u_name, v_node, v_name,
                       params.averageRtt,
-                      params.minb2gBandwidth, params.maxb2gBandwidth,
-                      params.minb2gDelay,     params.maxb2gDelay);
+                      minb2gBandwidth, maxb2gBandwidth,
+                      minb2gDelay,     maxb2gDelay);
         }
       else if (u_type == GATEWAY  && v_type == GATEWAY)
         {
-          CreateLink (u_name, v_name,
+          CreateLink (u_node, u_name, v_node, v_name,
                       params.averageRtt,
-                      params.minb2gBandwidth, params.maxb2gBandwidth,
-                      params.minb2gDelay,     params.maxb2gDelay);
+                      minb2gBandwidth, maxb2gBandwidth,
+                      minb2gDelay,     maxb2gDelay);
         }
       else if ((u_type == GATEWAY  && v_type == CLIENT) ||
                (u_type == CLIENT   && v_type == GATEWAY ))
         {
-          CreateLink (u_name, v_name,
+          CreateLink (u_node, u_name, v_node, v_name,
                       params.averageRtt,
-                      params.ming2cBandwidth, params.maxg2cBandwidth,
-                      params.ming2cDelay,     params.maxg2cDelay);
+                      ming2cBandwidth, maxg2cBandwidth,
+                      ming2cDelay,     maxg2cDelay);
         }
       else
         {
@@ -525,6 +551,69 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
   return m_nodes;
 }
 
+void
+RocketfuelMapReader::AssignSystemIds (const RocketfuelParams &params, map<Traits::vertex_descriptor, uint32_t> &systemIds)
+{
+  TopologyPartitioner partitioner;
+
+  map<Traits::vertex_descriptor, uint32_t> index;
+  graph_traits<Graph>::vertex_iterator v, endv;
+  for (tie (v, endv) = vertices (m_graph); v != endv; v++)
+    {
+      index[*v] = partitioner.AddNode (1 + degree (*v, m_graph));
+    }
+
+  // actual delays of the links are randomly chosen later, but cannot be smaller than the minimum
+  // delay of the link type.  Weight of a link is its average capacity in Mbps
+  graph_traits<Graph>::edge_iterator e, ende;
+  for (tie (e, ende) = edges (m_graph); e != ende; e++)
+    {
+      Traits::vertex_descriptor
+        u = source (*e, m_graph),
+        v = target (*e, m_graph);
+
+      node_type_t
+        u_type = get (vertex_rank, m_graph, u),
+        v_type = get (vertex_rank, m_graph, v);
+
+      string minDelay, minBandwidth, maxBandwidth;
+      if (u_type == BACKBONE && v_type == BACKBONE)
+        {
+          minDelay = params.minb2bDelay;
+          minBandwidth = params.minb2bBandwidth;
+          maxBandwidth = params.maxb2bBandwidth;
+        }
+      else if (u_type == CLIENT || v_type == CLIENT)
+        {
+          minDelay = params.ming2cDelay;
+          minBandwidth = params.ming2cBandwidth;
+          maxBandwidth = params.maxg2cBandwidth;
+        }
+      else
+        {
+          minDelay = params.minb2gDelay;
+          minBandwidth = params.minb2gBandwidth;
+          maxBandwidth = params.maxb2gBandwidth;
+        }
+
+      partitioner.AddLink (index[u], index[v], Time (minDelay),
+                           (DataRate (minBandwidth).GetBitRate () + DataRate (maxBandwidth).GetBitRate ()) / 2e6);
+    }
+
+  vector<uint32_t> partitions = partitioner.Partition (m_partitionCount);
+  if (partitioner.GetPartitionCount () != m_partitionCount)
+    {
+      NS_LOG_WARN ("Topology can be split only into " << partitioner.GetPartitionCount () << " partitions");
+    }
+  NS_LOG_INFO ("Topology is split into " << partitioner.GetPartitionCount () << " partitions, lookahead is at least "
+               << partitioner.GetLookahead ().ToDouble (Time::MS) << "ms");
+
+  for (map<Traits::vertex_descriptor, uint32_t>::const_iterator i = index.begin (); i != index.end (); i++)
+    {
+      systemIds[i->first] = partitions[i->second];
+    }
+}
+
 const NodeContainer &
 RocketfuelMapReader::GetBackboneRouters () const
 {
@@ -28,6 +28,7 @@
 #include "ns3/random-variable.h"
 #include <set>
 #include "ns3/data-rate.h"
+#include "ns3/nstime.h"
 
 #include <boost/graph/adjacency_list.hpp>
 
@@ -128,13 +129,13 @@ private:
 
   // NodeContainer
   void
-  GenerateFromMapsFile (int argc, char *argv[]);
+  GenerateFromMapsFile (const string &uid, uint32_t numNeighbors, const vector<string> &neighbors);
 
   void
-  CreateLink (string nodeName1, string nodeName2,
+  CreateLink (Ptr<Node> node1, const string &nodeName1, Ptr<Node> node2, const string &nodeName2,
               double averageRtt,
-              const string &minBw, const string &maxBw,
-              const string &minDelay, const string &maxDelay);
+              const DataRate &minBw, const DataRate &maxBw,
+              const Time &minDelay, const Time &maxDelay);
   void
   KeepOnlyBiggestConnectedComponent ();
 
@@ -176,6 +177,12 @@ private:
 private:
   void
   assignGw (Traits::vertex_descriptor vertex, uint32_t degree, node_type_t nodeType);
+
+  /**
+   * \brief Calculate system ids of the nodes (see AnnotatedTopologyReader::SetPartitionCount)
+   */
+  void
+  AssignSystemIds (const RocketfuelParams &params, map<Traits::vertex_descriptor, uint32_t> &systemIds);
 }; // end class RocketfuelMapReader
 
 }; // end namespace ns3
@@ -20,6 +20,7 @@
  */
 
 #include "rocketfuel-weights-reader.h"
+#include "topology-tokenizer.h"
 
 #include "ns3/nstime.h"
 #include "ns3/log.h"
@@ -85,51 +86,54 @@ RocketfuelWeightsReader::Read ()
   if (m_inputType == POSITIONS)
     return AnnotatedTopologyReader::Read ();
   
-  ifstream topgen;
-  topgen.open (GetFileName ().c_str ());
-        
-  if ( !topgen.is_open () )
+  TopologyTokenizer topgen;
+  if (!topgen.Open (GetFileName ()))
     {
       NS_LOG_ERROR ("Cannot open file " << GetFileName () << " for reading");
       return m_nodes;
     }
 
-  map<string, set<string> > processedLinks; // to eliminate duplications
+  set< pair<uint32_t, uint32_t> > processedLinks; // to eliminate duplications
   bool repeatedRun = LinksSize () > 0;
   std::list<Link>::iterator linkIterator = m_linksList.begin ();
   
-  while (!topgen.eof ())
+  while (topgen.NextLine ())
     {
-      string line;
-      getline (topgen,line);
-      if (line == "") continue;
-      if (line[0] == '#') continue; // comments
+      const TopologyTokenizer::Token &line = topgen.GetLine ();
+      if (line.empty ()) continue;
+      if (*line.begin == '#') continue; // comments
 
-      // NS_LOG_DEBUG ("Input: [" << line << "]");
-      
-      istringstream lineBuffer (line);
-      string from, to, attribute;
+      TopologyTokenizer::Token fromToken, toToken, attributeToken;
+      topgen.NextToken (fromToken);
+      topgen.NextToken (toToken);
+      topgen.NextToken (attributeToken);
 
-      lineBuffer >> from >> to >> attribute;
+      string from = fromToken.str (), to = toToken.str (), attribute = attributeToken.str ();
 
-      if (processedLinks[to].size () != 0 &&
-          processedLinks[to].find (from) != processedLinks[to].end ())
+      Ptr<Node> fromNode = FindNode (from);
+      if (fromNode == 0)
+        fromNode = Names::Find<Node> (m_path, from); // node could have been created outside the reader
+
+      Ptr<Node> toNode   = FindNode (to);
+      if (toNode == 0)
+        toNode = Names::Find<Node> (m_path, to);
+
+      if (fromNode != 0 && toNode != 0 &&
+          processedLinks.find (make_pair (toNode->GetId (), fromNode->GetId ())) != processedLinks.end ())
         {
           continue; // duplicated link
         }
-      processedLinks[from].insert (to);
-      
-      Ptr<Node> fromNode = Names::Find<Node> (m_path, from);
+
       if (fromNode == 0)
         {
           fromNode = CreateNode (from, 0);
         }
 
-      Ptr<Node> toNode   = Names::Find<Node> (m_path, to);
       if (toNode == 0)
         {
           toNode = CreateNode (to, 0);
         }
+      processedLinks.insert (make_pair (fromNode->GetId (), toNode->GetId ()));
 
       Link *link;
       if (!repeatedRun)
@@ -175,8 +179,6 @@ RocketfuelWeightsReader::Read ()
           delete link;
         }
     }
-        
-  topgen.close ();
 
   if (!repeatedRun)
     {
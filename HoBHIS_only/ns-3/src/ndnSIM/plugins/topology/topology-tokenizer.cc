@@ -0,0 +1,189 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "topology-tokenizer.h"
+
+#include "ns3/log.h"
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+NS_LOG_COMPONENT_DEFINE ("TopologyTokenizer");
+
+namespace ns3 {
+
+static inline bool
+IsSpace (char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+double
+TopologyTokenizer::Token::ToDouble () const
+{
+  char buf[64];
+  if (empty () || size () >= sizeof (buf))
+    return 0;
+
+  memcpy (buf, begin, size ());
+  buf[size ()] = 0;
+  return strtod (buf, 0);
+}
+
+uint32_t
+TopologyTokenizer::Token::ToUint32 () const
+{
+  uint32_t value = 0;
+  for (const char *i = begin; i != end && *i >= '0' && *i <= '9'; i++)
+    {
+      value = value * 10 + (*i - '0');
+    }
+  return value;
+}
+
+TopologyTokenizer::TopologyTokenizer ()
+  : m_data (0)
+  , m_size (0)
+  , m_mapped (false)
+  , m_pos (0)
+  , m_tokenPos (0)
+  , m_lineNumber (0)
+{
+}
+
+TopologyTokenizer::~TopologyTokenizer ()
+{
+  Close ();
+}
+
+bool
+TopologyTokenizer::Open (const std::string &fileName)
+{
+  Close ();
+
+  int fd = open (fileName.c_str (), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat (fd, &st) != 0)
+    {
+      close (fd);
+      return false;
+    }
+  m_size = st.st_size;
+
+  if (m_size > 0)
+    {
+      void *data = mmap (0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED)
+        {
+          madvise (data, m_size, MADV_SEQUENTIAL);
+          m_data = static_cast<const char *> (data);
+          m_mapped = true;
+        }
+      else
+        {
+          NS_LOG_DEBUG ("Cannot map " << fileName << ", reading it into memory");
+
+          m_buffer.resize (m_size);
+          size_t done = 0;
+          while (done < m_size)
+            {
+              ssize_t ret = read (fd, &m_buffer[done], m_size - done);
+              if (ret <= 0)
+                break;
+              done += ret;
+            }
+          m_size = done;
+          m_data = m_size > 0 ? &m_buffer[0] : 0;
+        }
+    }
+
+  close (fd);
+
+  m_pos = m_data;
+  m_lineNumber = 0;
+  return true;
+}
+
+void
+TopologyTokenizer::Close ()
+{
+  if (m_mapped)
+    munmap (const_cast<char *> (m_data), m_size);
+
+  m_buffer.clear ();
+  m_data = 0;
+  m_size = 0;
+  m_mapped = false;
+  m_pos = 0;
+  m_line = Token ();
+  m_tokenPos = 0;
+}
+
+bool
+TopologyTokenizer::NextLine ()
+{
+  const char *fileEnd = m_data + m_size;
+  if (m_pos == 0 || m_pos >= fileEnd)
+    return false;
+
+  const char *eol = static_cast<const char *> (memchr (m_pos, '\n', fileEnd - m_pos));
+  if (eol == 0)
+    eol = fileEnd;
+
+  m_line.begin = m_pos;
+  m_line.end = eol;
+  if (m_line.end != m_line.begin && *(m_line.end - 1) == '\r')
+    m_line.end --;
+
+  m_tokenPos = m_line.begin;
+  m_pos = eol + 1;
+  m_lineNumber ++;
+  return true;
+}
+
+bool
+TopologyTokenizer::NextToken (Token &token)
+{
+  const char *pos = m_tokenPos;
+  while (pos != m_line.end && IsSpace (*pos))
+    pos ++;
+
+  if (pos == m_line.end)
+    {
+      m_tokenPos = pos;
+      return false;
+    }
+
+  token.begin = pos;
+  while (pos != m_line.end && !IsSpace (*pos))
+    pos ++;
+  token.end = pos;
+
+  m_tokenPos = pos;
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,187 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef TOPOLOGY_TOKENIZER_H
+#define TOPOLOGY_TOKENIZER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace ns3 {
+
+/**
+ * \brief Fast reader of text topology files
+ *
+ * The whole file is memory-mapped (or, if mapping is not possible, read into memory with a
+ * single call) and is split into lines and whitespace-separated tokens without copying and
+ * without iostreams.
+ *
+ * \code
+ * TopologyTokenizer file;
+ * if (!file.Open (fileName))
+ *   ...
+ * while (file.NextLine ())
+ *   {
+ *     TopologyTokenizer::Token name, value;
+ *     if (!file.NextToken (name))
+ *       continue; // empty line
+ *     file.NextToken (value);
+ *     ...
+ *   }
+ * \endcode
+ */
+class TopologyTokenizer
+{
+public:
+  /**
+   * \brief Part of the file (not null-terminated)
+   */
+  struct Token
+  {
+    Token () : begin (0), end (0) { }
+    Token (const char *b, const char *e) : begin (b), end (e) { }
+
+    bool
+    empty () const
+    {
+      return begin == end;
+    }
+
+    size_t
+    size () const
+    {
+      return end - begin;
+    }
+
+    std::string
+    str () const
+    {
+      return std::string (begin, end);
+    }
+
+    bool
+    operator == (const char *value) const
+    {
+      return size () == strlen (value) && memcmp (begin, value, size ()) == 0;
+    }
+
+    /**
+     * \brief Convert token to double (same as operator>> of std::istream, 0 on error)
+     */
+    double
+    ToDouble () const;
+
+    /**
+     * \brief Convert token to unsigned integer (0 on error)
+     */
+    uint32_t
+    ToUint32 () const;
+
+    const char *begin;
+    const char *end;
+  };
+
+  TopologyTokenizer ();
+  ~TopologyTokenizer ();
+
+  /**
+   * \brief Map (or load) the file into memory
+   * \returns false if file cannot be opened
+   */
+  bool
+  Open (const std::string &fileName);
+
+  /**
+   * \brief Unmap (or release) the file
+   */
+  void
+  Close ();
+
+  /**
+   * \brief Get the whole content of the file
+   */
+  const char *
+  GetData () const
+  {
+    return m_data;
+  }
+
+  /**
+   * \brief Get size of the file
+   */
+  size_t
+  GetSize () const
+  {
+    return m_size;
+  }
+
+  /**
+   * \brief Move to the next line of the file
+   * \returns false if there are no more lines
+   */
+  bool
+  NextLine ();
+
+  /**
+   * \brief Get the current line (without end-of-line characters)
+   */
+  const Token &
+  GetLine () const
+  {
+    return m_line;
+  }
+
+  /**
+   * \brief Get the number of the current line (starting from 1)
+   */
+  uint32_t
+  GetLineNumber () const
+  {
+    return m_lineNumber;
+  }
+
+  /**
+   * \brief Get the next whitespace-separated token of the current line
+   * \returns false if there are no more tokens on the line
+   */
+  bool
+  NextToken (Token &token);
+
+private:
+  TopologyTokenizer (const TopologyTokenizer &);
+  TopologyTokenizer& operator= (const TopologyTokenizer &);
+
+private:
+  const char *m_data;
+  size_t m_size;
+  bool m_mapped;
+  std::vector<char> m_buffer; ///< \brief file content, if the file is not memory-mapped
+
+  const char *m_pos;          ///< \brief beginning of the next line
+  Token m_line;
+  const char *m_tokenPos;     ///< \brief position of the next token within the current line
+  uint32_t m_lineNumber;
+};
+
+} // namespace ns3
+
+#endif // TOPOLOGY_TOKENIZER_H
@@ -0,0 +1,107 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ndnSIM-batch.h"
+
+namespace ns3 {
+
+using namespace ndn;
+
+NS_LOG_COMPONENT_DEFINE ("ndn.InterestBatchTest");
+
+void
+InterestBatchTest::OnContentObject (std::string context, Ptr<const ContentObjectHeader> header, Ptr<const Packet> payload,
+                                    Ptr<App> app, Ptr<Face> face)
+{
+  m_received ++;
+}
+
+void
+InterestBatchTest::OnInterest (std::string context, Ptr<const InterestHeader> header,
+                               Ptr<App> app, Ptr<Face> face)
+{
+  m_interests ++;
+  m_interestWeight += header->GetBatchSize ();
+}
+
+void
+InterestBatchTest::DoRun ()
+{
+  // consumer -- router -- producer
+  NodeContainer nodes;
+  nodes.Create (3);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.Install (nodes.Get (1), nodes.Get (2));
+
+  StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes (true);
+  ndnHelper.InstallAll ();
+
+  // 8 sequence numbers are requested by two batches, [0..3] and [4..7]
+  AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("10"));
+  consumerHelper.SetAttribute ("MaxSeq", IntegerValue (8));
+  consumerHelper.SetAttribute ("MaxBatchSize", UintegerValue (4));
+  consumerHelper.Install (nodes.Get (0));
+
+  AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producerHelper.Install (nodes.Get (2));
+
+  // sequence numbers 1, 2, and 5 are cached by the router, so the batches are split into
+  // ranges [0], [3], [4], and [6..7]
+  Ptr<ContentStore> cs = nodes.Get (1)->GetObject<ContentStore> ();
+  uint32_t cached[] = { 1, 2, 5 };
+  for (uint32_t i = 0; i < sizeof (cached) / sizeof (cached[0]); i++)
+    {
+      Ptr<NameComponents> name = Create<NameComponents> ();
+      name->Add ("prefix");
+      (*name) (cached[i]);
+
+      Ptr<ContentObjectHeader> header = Create<ContentObjectHeader> ();
+      header->SetName (name);
+      cs->Add (header, Create<Packet> (1024));
+    }
+
+  Config::Connect ("/NodeList/0/ApplicationList/*/ReceivedContentObjects",
+                   MakeCallback (&InterestBatchTest::OnContentObject, this));
+  Config::Connect ("/NodeList/2/ApplicationList/*/ReceivedInterests",
+                   MakeCallback (&InterestBatchTest::OnInterest, this));
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_received, 8, "every requested Data packet should be delivered once");
+  NS_TEST_ASSERT_MSG_EQ (m_interestWeight, 5, "cached sequence numbers should not reach the producer");
+  NS_TEST_ASSERT_MSG_EQ (m_interests, 4, "batches should be split into 4 ranges around cached Data");
+}
+
+}
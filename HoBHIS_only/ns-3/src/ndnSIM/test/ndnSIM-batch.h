@@ -0,0 +1,69 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_BATCH_H
+#define NDNSIM_BATCH_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+namespace ns3
+{
+
+namespace ndn {
+class InterestHeader;
+class ContentObjectHeader;
+class App;
+class Face;
+}
+
+class Packet;
+
+class InterestBatchTest : public TestCase
+{
+public:
+  InterestBatchTest ()
+    : TestCase ("Batched Interests with partial ContentStore hit")
+    , m_received (0)
+    , m_interests (0)
+    , m_interestWeight (0)
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  OnContentObject (std::string context, Ptr<const ndn::ContentObjectHeader> header, Ptr<const Packet> payload,
+                   Ptr<ndn::App> app, Ptr<ndn::Face> face);
+
+  void
+  OnInterest (std::string context, Ptr<const ndn::InterestHeader> header,
+              Ptr<ndn::App> app, Ptr<ndn::Face> face);
+
+private:
+  uint32_t m_received;
+  uint32_t m_interests;
+  uint32_t m_interestWeight;
+};
+
+}
+
+#endif // NDNSIM_BATCH_H
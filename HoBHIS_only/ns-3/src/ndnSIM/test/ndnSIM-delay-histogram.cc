@@ -0,0 +1,86 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/core-module.h"
+#include "ndnSIM-delay-histogram.h"
+
+#include "../utils/tracers/ndn-delay-histogram.h"
+
+#include <sstream>
+
+using namespace std;
+
+namespace ns3 {
+
+using namespace ndn;
+
+void
+DelayHistogramTest::DoRun ()
+{
+  // bucket boundaries must be contiguous and cover every value exactly once
+  for (uint32_t index = 1; index < 40 * DelayHistogram::SubBucketCount; index++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (DelayHistogram::GetBucketLowerBound (index),
+                             DelayHistogram::GetBucketUpperBound (index - 1) + 1,
+                             "buckets are not contiguous");
+      NS_TEST_ASSERT_MSG_EQ (DelayHistogram::GetBucketIndex (DelayHistogram::GetBucketLowerBound (index)), index,
+                             "lower bound maps to a wrong bucket");
+      NS_TEST_ASSERT_MSG_EQ (DelayHistogram::GetBucketIndex (DelayHistogram::GetBucketUpperBound (index)), index,
+                             "upper bound maps to a wrong bucket");
+    }
+
+  DelayHistogram odd, even;
+  for (int64_t value = 1; value <= 10000; value++)
+    {
+      if (value % 2)
+        odd.Add (value);
+      else
+        even.Add (value);
+    }
+
+  DelayHistogram all = odd;
+  all.Merge (even);
+
+  NS_TEST_ASSERT_MSG_EQ (all.GetCount (), 10000, "merge lost samples");
+  NS_TEST_ASSERT_MSG_EQ (all.GetMin (), 1, "wrong min");
+  NS_TEST_ASSERT_MSG_EQ (all.GetMax (), 10000, "wrong max");
+  NS_TEST_ASSERT_MSG_EQ_TOL (all.GetMean (), 5000.5, 1e-9, "wrong mean");
+
+  double quantiles[] = { 0.5, 0.9, 0.99 };
+  for (uint32_t i = 0; i < sizeof (quantiles) / sizeof (quantiles[0]); i++)
+    {
+      double exact = quantiles[i] * 10000;
+      NS_TEST_ASSERT_MSG_EQ_TOL (static_cast<double> (all.GetQuantile (quantiles[i])), exact,
+                                 exact / DelayHistogram::SubBucketCount, "quantile estimate is off");
+    }
+
+  ostringstream os;
+  os << all;
+
+  DelayHistogram restored;
+  NS_TEST_ASSERT_MSG_EQ (restored.Deserialize (os.str ()), true, "cannot parse serialized histogram");
+  NS_TEST_ASSERT_MSG_EQ (restored.GetCount (), all.GetCount (), "deserialization lost samples");
+  NS_TEST_ASSERT_MSG_EQ (restored.GetQuantile (0.99), all.GetQuantile (0.99), "deserialization changed buckets");
+
+  NS_TEST_ASSERT_MSG_EQ (restored.Deserialize ("10;1;1;1;0:5"), false, "inconsistent counts accepted");
+  NS_TEST_ASSERT_MSG_EQ (restored.GetCount (), 0, "failed deserialization must leave histogram empty");
+}
+
+}
@@ -0,0 +1,152 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ndnSIM-fib.h"
+
+#include "../model/fib/ndn-fib-compact-impl.h"
+
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+
+namespace ns3 {
+
+using namespace ndn;
+
+static void
+PrintFibs (NodeContainer &nodes, const string &stage, vector<string> &lines)
+{
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      ostringstream os;
+      nodes.Get (i)->GetObject<Fib> ()->Print (os);
+
+      vector<string> node;
+      istringstream is (os.str ());
+      string line;
+      while (getline (is, line))
+        {
+          node.push_back (stage + " " + boost::lexical_cast<string> (i) + " " + line);
+        }
+
+      // order of entries is implementation specific
+      sort (node.begin (), node.end ());
+      node.push_back (stage + " " + boost::lexical_cast<string> (i) + " size " +
+                      boost::lexical_cast<string> (nodes.Get (i)->GetObject<Fib> ()->GetSize ()));
+      lines.insert (lines.end (), node.begin (), node.end ());
+    }
+}
+
+static Ptr<const NameComponents>
+LongestPrefixMatch (Ptr<Node> node, const string &name)
+{
+  InterestHeader interest;
+  interest.SetName (Create<NameComponents> (boost::lexical_cast<NameComponents> (name)));
+
+  Ptr<fib::Entry> entry = node->GetObject<Fib> ()->LongestPrefixMatch (interest);
+  if (entry == 0)
+    return Create<NameComponents> (boost::lexical_cast<NameComponents> ("/none"));
+  return Create<NameComponents> (entry->GetPrefix ());
+}
+
+vector<string>
+CompactFibTest::RunScenario (const string &fibClass)
+{
+  //        0 ---- 1
+  //        |      |
+  //        3 ---- 2 ---- 4
+  NodeContainer nodes;
+  nodes.Create (5);
+
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.Install (nodes.Get (1), nodes.Get (2));
+  p2p.Install (nodes.Get (2), nodes.Get (3));
+  p2p.Install (nodes.Get (3), nodes.Get (0));
+  p2p.Install (nodes.Get (2), nodes.Get (4));
+
+  StackHelper ndnHelper;
+  ndnHelper.SetFib (fibClass);
+  ndnHelper.Install (nodes);
+
+  GlobalRoutingHelper routingHelper;
+  routingHelper.Install (nodes);
+  routingHelper.AddOrigin ("/a", nodes.Get (4));
+  routingHelper.AddOrigin ("/a/b/c", nodes.Get (1));
+  routingHelper.AddOrigin ("/b", nodes.Get (0));
+  routingHelper.AddOrigin ("/b", nodes.Get (2));
+  routingHelper.CalculateRoutes ();
+
+  vector<string> lines;
+  PrintFibs (nodes, "routes", lines);
+
+  Ptr<fib::CompactFibImpl> compact = nodes.Get (3)->GetObject<fib::CompactFibImpl> ();
+  if (compact != 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (compact->GetSize (), 3, "Node 3 should have routes to /a, /a/b/c, and /b");
+      NS_TEST_EXPECT_MSG_EQ (compact->GetNMaterializedEntries (), 0, "No FIB entries should be created by routing helper");
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (*LongestPrefixMatch (nodes.Get (3), "/a/b/x"), NameComponents ("/a"), "");
+  NS_TEST_EXPECT_MSG_EQ (*LongestPrefixMatch (nodes.Get (3), "/a/b/c/d"), NameComponents ("/a/b/c"), "");
+  NS_TEST_EXPECT_MSG_EQ (*LongestPrefixMatch (nodes.Get (3), "/c"), NameComponents ("/none"), "");
+  // node 1 is the origin of /a/b/c and doesn't have a route for it
+  NS_TEST_EXPECT_MSG_EQ (*LongestPrefixMatch (nodes.Get (1), "/a/b/c/d"), NameComponents ("/a"), "");
+
+  if (compact != 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (compact->GetNMaterializedEntries (), 2, "FIB entries should be created on lookup");
+    }
+
+  // mixture of materialized and compact entries
+  nodes.Get (3)->GetObject<Fib> ()->InvalidateAll ();
+  routingHelper.CalculateRoutes ();
+  PrintFibs (nodes, "recalculated", lines);
+
+  nodes.Get (2)->GetObject<Fib> ()->InvalidateAll ();
+  nodes.Get (3)->GetObject<Fib> ()->Remove (Create<NameComponents> (boost::lexical_cast<NameComponents> ("/b")));
+  nodes.Get (3)->GetObject<Fib> ()->RemoveFromAll (nodes.Get (3)->GetObject<L3Protocol> ()->GetFace (0));
+  nodes.Get (1)->GetObject<Fib> ()->Add (NameComponents ("/a"), nodes.Get (1)->GetObject<L3Protocol> ()->GetFace (0), 100);
+  PrintFibs (nodes, "modified", lines);
+
+  Simulator::Destroy ();
+  return lines;
+}
+
+void
+CompactFibTest::DoRun ()
+{
+  vector<string> expected = RunScenario ("ns3::ndn::fib::Default");
+  vector<string> compact = RunScenario ("ns3::ndn::fib::Compact");
+
+  NS_TEST_ASSERT_MSG_EQ (compact.size (), expected.size (), "Both FIB implementations should have the same number of entries");
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (compact[i], expected[i], "FIB entries should be identical");
+    }
+}
+
+}
@@ -0,0 +1,234 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ndnSIM-fragmentation.h"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ns3 {
+
+using namespace ndn;
+
+NS_LOG_COMPONENT_DEFINE ("ndn.FragmentationTest");
+
+void
+FragmentHeaderSerializationTest::DoRun ()
+{
+  FragmentHeader source (100, 2, 3);
+
+  Packet packet (10);
+  packet.AddHeader (source);
+  NS_TEST_ASSERT_MSG_EQ (packet.GetSize (), 10 + FragmentHeader::SIZE, "wrong size of fragment header");
+  NS_TEST_ASSERT_MSG_EQ (HeaderHelper::GetNdnHeaderType (&packet), HeaderHelper::FRAGMENT_NDNSIM, "fragment is not recognized");
+
+  FragmentHeader target;
+  packet.RemoveHeader (target);
+
+  NS_TEST_ASSERT_MSG_EQ (source.GetSequence (), target.GetSequence (), "source/target sequence failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetIndex ()   , target.GetIndex ()   , "source/target index failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetCount ()   , target.GetCount ()   , "source/target count failed");
+}
+
+void
+FragmentationTest::OnContentObject (std::string context, Ptr<const ContentObjectHeader> header, Ptr<const Packet> payload,
+                                    Ptr<App> app, Ptr<Face> face)
+{
+  NS_TEST_ASSERT_MSG_EQ (payload->GetSize (), 1024, "payload is corrupted during reassembly");
+  m_received ++;
+}
+
+void
+FragmentationTest::DoRun ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  // 1024-byte payload is split into 4 or 5 fragments
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("Mtu", UintegerValue (300));
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes (true);
+  ndnHelper.InstallAll ();
+
+  AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("10"));
+  consumerHelper.SetAttribute ("MaxSeq", IntegerValue (5));
+  consumerHelper.Install (nodes.Get (0));
+
+  AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producerHelper.Install (nodes.Get (1));
+
+  Config::Connect ("/NodeList/0/ApplicationList/*/ReceivedContentObjects",
+                   MakeCallback (&FragmentationTest::OnContentObject, this));
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_received, 5, "not all Data packets have been reassembled");
+}
+
+void
+ReassemblyBuffersTest::SendFragments (Ptr<NetDevice> device, uint32_t sequence, uint16_t first, uint16_t last)
+{
+  // the same split as done by NetDeviceFace for the device MTU
+  uint32_t fragmentSize = device->GetMtu () - FragmentHeader::SIZE;
+  uint16_t count = (m_packet->GetSize () + fragmentSize - 1) / fragmentSize;
+  for (uint16_t index = first; index <= last; index++)
+    {
+      uint32_t offset = index * fragmentSize;
+      Ptr<Packet> fragment = m_packet->CreateFragment (offset, std::min (fragmentSize, m_packet->GetSize () - offset));
+      fragment->AddHeader (FragmentHeader (sequence, index, count));
+      device->Send (fragment, device->GetBroadcast (), L3Protocol::ETHERNET_FRAME_TYPE);
+    }
+}
+
+void
+ReassemblyBuffersTest::CheckBuffers (Ptr<Face> face, uint32_t expectedBuffers, uint32_t expectedReceived)
+{
+  NS_TEST_ASSERT_MSG_EQ (DynamicCast<NetDeviceFace> (face)->GetReassemblyBufferCount (), expectedBuffers,
+                         "unexpected number of reassembly buffers at " << Simulator::Now ().GetSeconds () << "s");
+  NS_TEST_ASSERT_MSG_EQ (m_received, expectedReceived,
+                         "unexpected number of reassembled packets at " << Simulator::Now ().GetSeconds () << "s");
+}
+
+void
+ReassemblyBuffersTest::OnInterest (Ptr<const InterestHeader> header, Ptr<const Face> face)
+{
+  m_received ++;
+}
+
+void
+ReassemblyBuffersTest::DoRun ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  // Interest with 600-byte name is split into 3 fragments
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("Mtu", UintegerValue (300));
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1ms"));
+  NetDeviceContainer devices = p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  // fragments are sent directly from the device of node 0, only node 1 runs the Ndn stack
+  Config::SetDefault ("ns3::ndn::NetDeviceFace::ReassemblyTimeout", TimeValue (Seconds (1.0)));
+  Config::SetDefault ("ns3::ndn::NetDeviceFace::MaxReassemblyBuffers", UintegerValue (2));
+  StackHelper ndnHelper;
+  ndnHelper.Install (nodes.Get (1));
+  Ptr<Face> face = nodes.Get (1)->GetObject<L3Protocol> ()->GetFace (0);
+
+  InterestHeader interest;
+  interest.SetName (Create<NameComponents> (boost::lexical_cast<NameComponents> ("/prefix/" + std::string (600, 'x'))));
+  m_packet = Create<Packet> ();
+  m_packet->AddHeader (interest);
+
+  Config::ConnectWithoutContext ("/NodeList/1/$ns3::ndn::ForwardingStrategy/InInterests",
+                                 MakeCallback (&ReassemblyBuffersTest::OnInterest, this));
+
+  Ptr<NetDevice> device = devices.Get (0);
+
+  // lost fragment: the partially received packet is discarded after ReassemblyTimeout
+  Simulator::Schedule (Seconds (0.1), &ReassemblyBuffersTest::SendFragments, this, device, 0, 0, 1);
+  Simulator::Schedule (Seconds (0.5), &ReassemblyBuffersTest::CheckBuffers, this, face, 1, 0);
+  Simulator::Schedule (Seconds (1.5), &ReassemblyBuffersTest::CheckBuffers, this, face, 0, 0);
+  // late fragment cannot complete the discarded packet
+  Simulator::Schedule (Seconds (1.6), &ReassemblyBuffersTest::SendFragments, this, device, 0, 2, 2);
+  Simulator::Schedule (Seconds (1.7), &ReassemblyBuffersTest::CheckBuffers, this, face, 1, 0);
+  Simulator::Schedule (Seconds (2.7), &ReassemblyBuffersTest::CheckBuffers, this, face, 0, 0);
+  Simulator::Schedule (Seconds (3.0), &ReassemblyBuffersTest::SendFragments, this, device, 1, 0, 2);
+  Simulator::Schedule (Seconds (3.1), &ReassemblyBuffersTest::CheckBuffers, this, face, 0, 1);
+
+  // MaxReassemblyBuffers: the oldest partially received packet is evicted
+  Simulator::Schedule (Seconds (4.0), &ReassemblyBuffersTest::SendFragments, this, device, 10, 0, 0);
+  Simulator::Schedule (Seconds (4.1), &ReassemblyBuffersTest::SendFragments, this, device, 11, 0, 0);
+  Simulator::Schedule (Seconds (4.2), &ReassemblyBuffersTest::SendFragments, this, device, 12, 0, 0);
+  Simulator::Schedule (Seconds (4.3), &ReassemblyBuffersTest::CheckBuffers, this, face, 2, 1);
+  Simulator::Schedule (Seconds (4.4), &ReassemblyBuffersTest::SendFragments, this, device, 12, 1, 2);
+  Simulator::Schedule (Seconds (4.5), &ReassemblyBuffersTest::SendFragments, this, device, 11, 1, 2);
+  Simulator::Schedule (Seconds (4.6), &ReassemblyBuffersTest::CheckBuffers, this, face, 0, 3);
+  Simulator::Schedule (Seconds (4.7), &ReassemblyBuffersTest::SendFragments, this, device, 10, 1, 2);
+  Simulator::Schedule (Seconds (4.8), &ReassemblyBuffersTest::CheckBuffers, this, face, 1, 3);
+
+  Simulator::Stop (Seconds (6.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  Config::Reset ();
+  m_packet = 0;
+}
+
+void
+HobhisWireSizeTest::OnMacRx (Ptr<const Packet> packet)
+{
+  // fragments of the Data packet, including fragment headers
+  m_wireSize += packet->GetSize ();
+}
+
+void
+HobhisWireSizeTest::DoRun ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("Mtu", UintegerValue (300));
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes (true);
+  ndnHelper.EnableHobhis (true, true);
+  ndnHelper.InstallAll ();
+
+  AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("10"));
+  consumerHelper.SetAttribute ("MaxSeq", IntegerValue (1));
+  consumerHelper.Install (nodes.Get (0));
+
+  AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producerHelper.Install (nodes.Get (1));
+
+  Config::ConnectWithoutContext ("/NodeList/0/DeviceList/0/$ns3::PointToPointNetDevice/MacRx",
+                                 MakeCallback (&HobhisWireSizeTest::OnMacRx, this));
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+
+  Ptr<HobhisNetDeviceFace> face = DynamicCast<HobhisNetDeviceFace> (nodes.Get (0)->GetObject<L3Protocol> ()->GetFace (0));
+  NS_TEST_ASSERT_MSG_NE (face, 0, "HobhisNetDeviceFace is not installed");
+  NS_TEST_ASSERT_MSG_GT (m_wireSize, 1024 + 4 * FragmentHeader::SIZE, "Data packet has not been fragmented");
+  NS_TEST_ASSERT_MSG_EQ (face->GetInContentSize (), m_wireSize, "Data size should be accounted in link bytes");
+
+  Simulator::Destroy ();
+}
+
+}
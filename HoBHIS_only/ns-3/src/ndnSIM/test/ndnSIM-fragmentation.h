@@ -0,0 +1,119 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_FRAGMENTATION_H
+#define NDNSIM_FRAGMENTATION_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/packet.h"
+
+namespace ns3
+{
+
+class NetDevice;
+
+namespace ndn {
+class InterestHeader;
+class ContentObjectHeader;
+class App;
+class Face;
+}
+
+class FragmentHeaderSerializationTest : public TestCase
+{
+public:
+  FragmentHeaderSerializationTest ()
+    : TestCase ("Fragment header Serialization Test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+class FragmentationTest : public TestCase
+{
+public:
+  FragmentationTest ()
+    : TestCase ("NetDeviceFace Fragmentation Test")
+    , m_received (0)
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  OnContentObject (std::string context, Ptr<const ndn::ContentObjectHeader> header, Ptr<const Packet> payload,
+                   Ptr<ndn::App> app, Ptr<ndn::Face> face);
+
+private:
+  uint32_t m_received;
+};
+
+class ReassemblyBuffersTest : public TestCase
+{
+public:
+  ReassemblyBuffersTest ()
+    : TestCase ("NetDeviceFace reassembly timeout and buffer limit")
+    , m_received (0)
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  SendFragments (Ptr<NetDevice> device, uint32_t sequence, uint16_t first, uint16_t last);
+
+  void
+  CheckBuffers (Ptr<ndn::Face> face, uint32_t expectedBuffers, uint32_t expectedReceived);
+
+  void
+  OnInterest (Ptr<const ndn::InterestHeader> header, Ptr<const ndn::Face> face);
+
+private:
+  Ptr<Packet> m_packet;
+  uint32_t m_received;
+};
+
+class HobhisWireSizeTest : public TestCase
+{
+public:
+  HobhisWireSizeTest ()
+    : TestCase ("HobhisNetDeviceFace accounts Data size on the link")
+    , m_wireSize (0)
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  OnMacRx (Ptr<const Packet> packet);
+
+private:
+  uint32_t m_wireSize;
+};
+
+}
+
+#endif // NDNSIM_FRAGMENTATION_H
@@ -0,0 +1,172 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ndnSIM-global-routing.h"
+
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+
+namespace ns3 {
+
+using namespace ndn;
+
+/**
+ * Best metric of every usable prefix on every node.  When several paths have the same
+ * cost, incremental and full calculation may select different next hops, so the
+ * faces themselves are not compared
+ */
+static void
+PrintBestRoutes (NodeContainer &nodes, const string &stage, vector<string> &lines)
+{
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<Fib> fib = nodes.Get (i)->GetObject<Fib> ();
+
+      vector<string> node;
+      for (Ptr<fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+        {
+          int32_t best = -1;
+          for (fib::FaceMetricContainer::type::iterator record = entry->m_faces.begin ();
+               record != entry->m_faces.end ();
+               record++)
+            {
+              if (record->m_status != fib::FaceMetric::NDN_FIB_RED &&
+                  (best < 0 || record->m_routingCost < best))
+                {
+                  best = record->m_routingCost;
+                }
+            }
+
+          if (best >= 0)
+            {
+              ostringstream os;
+              os << stage << " " << i << " " << entry->GetPrefix () << " " << best;
+              node.push_back (os.str ());
+            }
+        }
+
+      // order of entries is implementation specific
+      sort (node.begin (), node.end ());
+      lines.insert (lines.end (), node.begin (), node.end ());
+    }
+}
+
+static void
+SetUp (const vector< Ptr<Face> > &faces, bool up)
+{
+  for (vector< Ptr<Face> >::const_iterator face = faces.begin (); face != faces.end (); face++)
+    {
+      (*face)->SetUp (up);
+    }
+}
+
+vector<string>
+GlobalRoutingIncrementalTest::RunScenario (bool incremental)
+{
+  //        0 ---- 1 ---- 2
+  //        |      |      |
+  //        3 ---- 4 ---- 5 ---- 6
+  NodeContainer nodes;
+  nodes.Create (7);
+
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.Install (nodes.Get (1), nodes.Get (2));
+  p2p.Install (nodes.Get (0), nodes.Get (3));
+  NetDeviceContainer middle = p2p.Install (nodes.Get (1), nodes.Get (4));
+  p2p.Install (nodes.Get (2), nodes.Get (5));
+  p2p.Install (nodes.Get (3), nodes.Get (4));
+  p2p.Install (nodes.Get (4), nodes.Get (5));
+  NetDeviceContainer tail = p2p.Install (nodes.Get (5), nodes.Get (6));
+
+  StackHelper ndnHelper;
+  ndnHelper.Install (nodes);
+
+  GlobalRoutingHelper routingHelper;
+  routingHelper.Install (nodes);
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      routingHelper.AddOrigin ("/node" + boost::lexical_cast<string> (i), nodes.Get (i));
+    }
+  routingHelper.AddOrigin ("/shared", nodes.Get (0));
+  routingHelper.AddOrigin ("/shared", nodes.Get (6));
+
+  // faces that go down: one direction of the 1-4 link, and 5 -> 6, which leaves node 6 unreachable
+  vector< Ptr<Face> > faces;
+  faces.push_back (nodes.Get (1)->GetObject<L3Protocol> ()->GetFaceByNetDevice (middle.Get (0)));
+  faces.push_back (nodes.Get (5)->GetObject<L3Protocol> ()->GetFaceByNetDevice (tail.Get (0)));
+
+  vector<string> lines;
+  if (incremental)
+    {
+      routingHelper.CalculateRoutesIncrementally ();
+      // new origin while incremental updates are active
+      routingHelper.AddOrigin ("/late", nodes.Get (2));
+
+      SetUp (faces, false);
+      PrintBestRoutes (nodes, "down", lines);
+
+      SetUp (faces, true);
+      PrintBestRoutes (nodes, "up", lines);
+    }
+  else
+    {
+      routingHelper.AddOrigin ("/late", nodes.Get (2));
+
+      // only the incremental calculation excludes faces that are down
+      SetUp (faces, false);
+      routingHelper.CalculateRoutesIncrementally ();
+      PrintBestRoutes (nodes, "down", lines);
+
+      routingHelper.CalculateRoutes ();
+      SetUp (faces, true);
+      PrintBestRoutes (nodes, "up", lines);
+    }
+
+  Simulator::Destroy ();
+  return lines;
+}
+
+void
+GlobalRoutingIncrementalTest::DoRun ()
+{
+  vector<string> expected = RunScenario (false);
+  vector<string> updated = RunScenario (true);
+
+  NS_TEST_ASSERT_MSG_EQ (count (expected.begin (), expected.end (), string ("up 0 /node6 4")), 1,
+                         "Node 6 should be reachable from node 0 when all faces are up");
+  NS_TEST_ASSERT_MSG_EQ (count (expected.begin (), expected.end (), string ("down 0 /node6 4")), 0,
+                         "Node 6 should be unreachable while face 5 -> 6 is down");
+
+  NS_TEST_ASSERT_MSG_EQ (updated.size (), expected.size (), "Incremental and full calculation should install the same number of routes");
+  for (uint32_t i = 0; i < std::min (expected.size (), updated.size ()); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (updated[i], expected[i], "Best routes should be identical");
+    }
+}
+
+}
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/utils/ndn-limits-rate.h"
+#include "ndnSIM-limits.h"
+
+namespace ns3 {
+
+using namespace ndn;
+
+NS_LOG_COMPONENT_DEFINE ("ndn.LimitsTest");
+
+void
+LimitsRateTest::Exhaust (Ptr<Limits> limits, uint32_t expected)
+{
+  uint32_t borrowed = 0;
+  while (limits->IsBelowLimit ())
+    {
+      limits->BorrowLimit ();
+      borrowed ++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (borrowed, expected, "unexpected number of tokens in the bucket");
+}
+
+void
+LimitsRateTest::OnAvailableSlot ()
+{
+  m_slots ++;
+  m_slotTime = Simulator::Now ();
+}
+
+void
+LimitsRateTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+
+  // 100 Interests per second, burst of 5 Interests
+  Ptr<LimitsRate> limits = CreateObject<LimitsRate> ();
+  limits->SetLimits (100, 0.05);
+  limits->RegisterAvailableSlotCallback (MakeCallback (&LimitsRateTest::OnAvailableSlot, this));
+
+  // limits without callback never use the timer
+  std::vector< Ptr<LimitsRate> > passive;
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      passive.push_back (CreateObject<LimitsRate> ());
+      passive.back ()->SetLimits (100, 0.05);
+      Simulator::ScheduleWithContext (node->GetId (), Seconds (1.0), &LimitsRateTest::Exhaust, this, passive.back (), 5);
+    }
+
+  Simulator::ScheduleWithContext (node->GetId (), Seconds (1.0), &LimitsRateTest::Exhaust, this, limits, 5);
+  // bucket is leaked lazily: after 2 seconds it is empty again, and after 20ms more only two tokens are available
+  Simulator::ScheduleWithContext (node->GetId (), Seconds (3.0), &LimitsRateTest::Exhaust, this, limits, 5);
+  Simulator::ScheduleWithContext (node->GetId (), Seconds (3.02), &LimitsRateTest::Exhaust, this, limits, 2);
+
+  Simulator::Stop (Seconds (4.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_slots, 3, "available slot callback should be called once after every exhaustion");
+  // one token leaks in 10ms
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_slotTime.ToDouble (Time::S), 3.03, 0.0011, "available slot callback is called at a wrong time");
+
+  Ptr<LimitsRateWheel> wheel = node->GetObject<LimitsRateWheel> ();
+  NS_TEST_ASSERT_MSG_NE (wheel, 0, "node-wide wheel should be created");
+  NS_TEST_ASSERT_MSG_EQ (wheel->GetSize (), 0, "all wake-ups should be processed");
+  NS_TEST_ASSERT_MSG_LT (wheel->GetEventCount (), 10, "wheel should not depend on number of configured limits");
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_LIMITS_H
+#define NDNSIM_LIMITS_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+
+namespace ns3
+{
+
+namespace ndn {
+class Limits;
+}
+
+class LimitsRateTest : public TestCase
+{
+public:
+  LimitsRateTest ()
+    : TestCase ("Limits::Rate Test")
+    , m_slots (0)
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  Exhaust (Ptr<ndn::Limits> limits, uint32_t expected);
+
+  void
+  OnAvailableSlot ();
+
+private:
+  uint32_t m_slots;
+  Time m_slotTime;
+};
+
+}
+
+#endif // NDNSIM_LIMITS_H
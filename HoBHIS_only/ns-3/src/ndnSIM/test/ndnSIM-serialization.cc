@@ -53,9 +53,40 @@ InterestSerializationTest::DoRun ()
   source.SetNack (10);
   NS_TEST_ASSERT_MSG_EQ (source.GetNack (), 10, "set/get NACK failed");
 
+  source.SetBatchSize (16);
+  NS_TEST_ASSERT_MSG_EQ (source.GetBatchSize (), 16, "set/get batch size failed");
+
   Packet packet (0);
   //serialization
   packet.AddHeader (source);
+
+  //lazy decoding
+  Ptr<Packet> wire = packet.Copy ();
+  InterestHeaderView view (wire);
+  NS_TEST_ASSERT_MSG_EQ (view.GetNack ()               , source.GetNack ()            , "view NACK failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetNonce ()              , source.GetNonce ()           , "view nonce failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetScope ()              , source.GetScope ()           , "view scope failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetInterestLifetime ()   , source.GetInterestLifetime (), "view interest lifetime failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetBatchSize ()          , source.GetBatchSize ()       , "view batch size failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetName ().size ()       , 2                            , "view name size failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetName ().ToName ()     , source.GetName ()            , "view name failed");
+  NS_TEST_ASSERT_MSG_EQ ((view.GetName () == source.GetName ()), true                 , "view name comparison failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetName ().cut (1)       , source.GetName ().cut (1)    , "view name prefix failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetName ().GetLastComponent ().ToString (), "test2"     , "view last component failed");
+  NS_TEST_ASSERT_MSG_EQ (*HeaderHelper::GetName (wire) , source.GetName ()            , "HeaderHelper::GetName failed");
+  NS_TEST_ASSERT_MSG_EQ (HeaderHelper::GetNameView (wire).ToName (), source.GetName (), "HeaderHelper::GetNameView failed");
+
+  // view of a header after another header, and of a name that does not fit into the view
+  InterestHeader longSource;
+  longSource.SetName (Create<NameComponents> (boost::lexical_cast<NameComponents> ("/" + std::string (NameView::INLINE_SIZE, 'x') + "/1")));
+  longSource.SetNonce (300);
+  Ptr<Packet> shifted = Create<Packet> ();
+  shifted->AddHeader (longSource);
+  shifted->AddHeader (FragmentHeader (1, 0, 1));
+  InterestHeaderView shiftedView (shifted, FragmentHeader::SIZE);
+  NS_TEST_ASSERT_MSG_EQ (shiftedView.GetName ().ToName (), longSource.GetName ()      , "long name view failed");
+  NS_TEST_ASSERT_MSG_EQ (shiftedView.GetBatchSize ()     , 1                          , "view default batch size failed");
+  NS_TEST_ASSERT_MSG_EQ (shiftedView.GetNonce ()         , longSource.GetNonce ()     , "shifted view nonce failed");
 	
   //deserialization
   InterestHeader target;
@@ -66,6 +97,7 @@ InterestSerializationTest::DoRun ()
   NS_TEST_ASSERT_MSG_EQ (source.GetInterestLifetime (), target.GetInterestLifetime (), "source/target interest lifetime failed");
   NS_TEST_ASSERT_MSG_EQ (source.GetNonce ()           , target.GetNonce ()           , "source/target nonce failed");
   NS_TEST_ASSERT_MSG_EQ (source.GetNack ()            , target.GetNack ()            , "source/target NACK failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetBatchSize ()       , target.GetBatchSize ()       , "source/target batch size failed");
 }
 
 void
@@ -85,6 +117,27 @@ ContentObjectSerializationTest::DoRun ()
   Packet packet (0);
   //serialization
   packet.AddHeader (source);
+
+  //lazy decoding
+  Ptr<Packet> wire = packet.Copy ();
+  ContentObjectHeaderView view (wire);
+  NS_TEST_ASSERT_MSG_EQ (view.GetFreshness ()      , source.GetFreshness ()    , "view freshness failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetTimestamp ()      , source.GetTimestamp ()    , "view timestamp failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetName ().ToName () , source.GetName ()         , "view name failed");
+  NS_TEST_ASSERT_MSG_EQ (view.GetName ().cut (1)   , source.GetName ().cut (1) , "view name prefix failed");
+  NS_TEST_ASSERT_MSG_EQ ((view.GetName ().Get (1) == "test2"), true            , "view component comparison failed");
+  NS_TEST_ASSERT_MSG_EQ (boost::lexical_cast<std::string> (view.GetName ()), "/test/test2/1", "view name printing failed");
+
+  bool thrown = false;
+  try
+    {
+      InterestHeaderView wrongView (wire);
+    }
+  catch (InterestHeaderException)
+    {
+      thrown = true;
+    }
+  NS_TEST_ASSERT_MSG_EQ (thrown, true, "Interest view of ContentObject should fail");
 	
   //deserialization
   ContentObjectHeader target;
@@ -23,6 +23,12 @@
 
 #include "ndnSIM-serialization.h"
 #include "ndnSIM-pit.h"
+#include "ndnSIM-delay-histogram.h"
+#include "ndnSIM-fib.h"
+#include "ndnSIM-global-routing.h"
+#include "ndnSIM-fragmentation.h"
+#include "ndnSIM-limits.h"
+#include "ndnSIM-batch.h"
 
 namespace ns3
 {
@@ -38,6 +44,15 @@ public:
     AddTestCase (new InterestSerializationTest ());
     AddTestCase (new ContentObjectSerializationTest ());
     // AddTestCase (new PitTest ());
+    AddTestCase (new DelayHistogramTest ());
+    AddTestCase (new CompactFibTest ());
+    AddTestCase (new GlobalRoutingIncrementalTest ());
+    AddTestCase (new FragmentHeaderSerializationTest ());
+    AddTestCase (new FragmentationTest ());
+    AddTestCase (new ReassemblyBuffersTest ());
+    AddTestCase (new HobhisWireSizeTest ());
+    AddTestCase (new LimitsRateTest ());
+    AddTestCase (new InterestBatchTest ());
   }
 };
 
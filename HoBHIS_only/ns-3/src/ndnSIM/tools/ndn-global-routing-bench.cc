@@ -0,0 +1,236 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Benchmark of ndn::GlobalRoutingHelper::CalculateRoutes and CalculateRoutesIncrementally
+//
+// Loads annotated (--topology) or Rocketfuel (--rocketfuel, .cch) topology, exports each node's name
+// as a prefix and calculates routes using 1, 2, 4, ... --threads threads.  For each run the time
+// spent and a checksum of all FIBs are reported (checksums must be equal for all thread counts).
+//
+// After that, routes are calculated incrementally and --updates randomly selected faces are
+// disabled and enabled again, one at a time.  Average time to update routes after a single
+// face state change is reported.
+//
+// FIB implementation can be selected with --fib (e.g., --fib=ns3::ndn::fib::Compact).  Memory used
+// by the FIBs is reported as the change of the process' resident set size.
+//
+// Example:
+//
+//     ./waf --run "ndn-global-routing-bench --rocketfuel=maps/1239.r0.cch --threads=16"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include "ns3/ndnSIM/plugins/topology/rocketfuel-map-reader.h"
+
+#include <boost/functional/hash.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+using namespace ns3;
+using namespace std;
+
+static size_t
+FibChecksum ()
+{
+  vector<string> lines;
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<ndn::Fib> fib = (*node)->GetObject<ndn::Fib> ();
+      if (fib == 0)
+        continue;
+
+      ostringstream os;
+      fib->Print (os);
+
+      istringstream is (os.str ());
+      string line;
+      while (getline (is, line))
+        {
+          lines.push_back (boost::lexical_cast<string> ((*node)->GetId ()) + "\t" + line);
+        }
+    }
+
+  // FIB does not guarantee any order of entries on the same level of the trie
+  sort (lines.begin (), lines.end ());
+
+  size_t seed = 0;
+  for (vector<string>::iterator line = lines.begin (); line != lines.end (); line++)
+    {
+      boost::hash_combine (seed, *line);
+    }
+  return seed;
+}
+
+// resident set size of the process in kB (0 if unknown)
+static uint64_t
+GetRss ()
+{
+  ifstream status ("/proc/self/status");
+  string line;
+  while (getline (status, line))
+    {
+      if (line.compare (0, 6, "VmRSS:") == 0)
+        {
+          istringstream is (line.substr (6));
+          uint64_t rss = 0;
+          is >> rss;
+          return rss;
+        }
+    }
+  return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+  string topology = "src/ndnSIM/examples/topologies/topo-grid-3x3.txt";
+  string rocketfuel = "";
+  uint32_t maxThreads = std::max<long> (1, sysconf (_SC_NPROCESSORS_ONLN));
+  uint32_t updates = 20;
+  string fib = "ns3::ndn::fib::Default";
+
+  CommandLine cmd;
+  cmd.AddValue ("topology", "Annotated topology file", topology);
+  cmd.AddValue ("rocketfuel", "Rocketfuel map file (.cch), takes precedence over topology", rocketfuel);
+  cmd.AddValue ("threads", "Maximum number of threads to use", maxThreads);
+  cmd.AddValue ("updates", "Number of face state changes to apply after incremental route calculation", updates);
+  cmd.AddValue ("fib", "FIB implementation", fib);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  if (!rocketfuel.empty ())
+    {
+      RocketfuelParams params;
+      params.clientNodeDegrees = 2;
+      params.averageRtt = 0.25; // 250ms
+      params.minb2bBandwidth = "40Mbps";
+      params.minb2bDelay = "5ms";
+      params.maxb2bBandwidth = "100Mbps";
+      params.maxb2bDelay = "10ms";
+      params.minb2gBandwidth = "10Mbps";
+      params.minb2gDelay = "5ms";
+      params.maxb2gBandwidth = "20Mbps";
+      params.maxb2gDelay = "10ms";
+      params.ming2cBandwidth = "1Mbps";
+      params.ming2cDelay = "70ms";
+      params.maxg2cBandwidth = "3Mbps";
+      params.maxg2cDelay = "10ms";
+
+      RocketfuelMapReader reader ("/", 1.0);
+      reader.SetFileName (rocketfuel);
+      nodes = reader.Read (params, true, true);
+    }
+  else
+    {
+      AnnotatedTopologyReader reader ("", 1.0);
+      reader.SetFileName (topology);
+      nodes = reader.Read ();
+    }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetFib (fib);
+  ndnHelper.InstallAll ();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll ();
+  ndnGlobalRoutingHelper.AddOriginsForAll ();
+
+  cout << "Nodes: " << nodes.GetN () << ", channels: " << ChannelList::GetNChannels () << endl;
+  uint64_t rssBefore = GetRss ();
+
+  cout << "Threads" << "\t" << "TimeMs" << "\t" << "Speedup" << "\t" << "FibChecksum" << endl;
+
+  int64_t serialTime = 0;
+  for (uint32_t threads = 1; ; threads = std::min (threads * 2, maxThreads))
+    {
+      ndnGlobalRoutingHelper.SetNumberOfThreads (threads);
+
+      SystemWallClockMs clock;
+      clock.Start ();
+      ndnGlobalRoutingHelper.CalculateRoutes ();
+      int64_t time = clock.End ();
+
+      if (threads == 1)
+        serialTime = time;
+
+      cout << threads << "\t" << time << "\t"
+           << (time > 0 ? static_cast<double> (serialTime) / time : 1.0) << "\t"
+           << FibChecksum () << endl;
+
+      if (threads >= maxThreads)
+        break;
+    }
+
+  cout << "FIB memory (" << fib << "): " << (GetRss () - rssBefore) / 1024 << " MB" << endl;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  ndnGlobalRoutingHelper.CalculateRoutesIncrementally ();
+  int64_t incrementalTime = clock.End ();
+  size_t checksum = FibChecksum ();
+
+  cout << "Incremental" << "\t" << incrementalTime << "\t" << "-" << "\t" << checksum << endl;
+
+  vector< Ptr<ndn::Face> > faces;
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<ndn::L3Protocol> ndn = (*node)->GetObject<ndn::L3Protocol> ();
+      for (uint32_t faceId = 0; ndn != 0 && faceId < ndn->GetNFaces (); faceId++)
+        {
+          Ptr<ndn::NetDeviceFace> face = DynamicCast<ndn::NetDeviceFace> (ndn->GetFace (faceId));
+          if (face != 0)
+            faces.push_back (face);
+        }
+    }
+
+  if (updates > 0 && !faces.empty ())
+    {
+      UniformVariable rand (0, faces.size ());
+
+      int64_t downTime = 0;
+      int64_t upTime = 0;
+      for (uint32_t update = 0; update < updates; update++)
+        {
+          Ptr<ndn::Face> face = faces[rand.GetInteger (0, faces.size () - 1)];
+
+          clock.Start ();
+          face->SetUp (false);
+          downTime += clock.End ();
+
+          clock.Start ();
+          face->SetUp (true);
+          upTime += clock.End ();
+        }
+
+      cout << "FaceDown" << "\t" << static_cast<double> (downTime) / updates << "\t"
+           << (downTime > 0 ? static_cast<double> (serialTime) * updates / downTime : 0.0) << "\t" << "-" << endl;
+      cout << "FaceUp" << "\t" << static_cast<double> (upTime) / updates << "\t"
+           << (upTime > 0 ? static_cast<double> (serialTime) * updates / upTime : 0.0) << "\t" << FibChecksum () << endl;
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,204 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Benchmark of Interest/ContentObject header parsing
+//
+// Compares full deserialization of InterestHeader/ContentObjectHeader with lazy decoding
+// using InterestHeaderView/ContentObjectHeaderView for the typical accesses in faces and
+// queues: NACK type of an Interest, prefix (name without the last component) of an Interest
+// and a ContentObject, and the complete name.  Packets carry name /prefix/.../<seq> with
+// --components components.  Every operation is repeated --iterations times and the average
+// time per operation is reported in nanoseconds.
+//
+// Example:
+//
+//     ./waf --run "ndn-header-parse-bench --iterations=1000000 --components=4"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndn-header-view.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <boost/lexical_cast.hpp>
+
+using namespace ns3;
+using namespace ns3::ndn;
+using namespace std;
+
+static uint32_t g_iterations = 1000000;
+static volatile size_t g_sink = 0; // prevents compiler from optimizing away the decoding
+
+static void
+Report (const string &operation, const string &decoder, int64_t ms)
+{
+  cout << operation << "\t" << decoder << "\t"
+       << static_cast<double> (ms) * 1000000.0 / g_iterations << endl;
+}
+
+static int64_t
+InterestNackFull (Ptr<const Packet> p)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < g_iterations; i++)
+    {
+      InterestHeader header;
+      p->PeekHeader (header);
+      g_sink += header.GetNack ();
+    }
+  return clock.End ();
+}
+
+static int64_t
+InterestNackView (Ptr<const Packet> p)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < g_iterations; i++)
+    {
+      g_sink += InterestHeaderView (p).GetNack ();
+    }
+  return clock.End ();
+}
+
+static int64_t
+InterestPrefixFull (Ptr<const Packet> p)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < g_iterations; i++)
+    {
+      InterestHeader header;
+      p->PeekHeader (header);
+      g_sink += header.GetName ().cut (1).size ();
+    }
+  return clock.End ();
+}
+
+static int64_t
+InterestPrefixView (Ptr<const Packet> p)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < g_iterations; i++)
+    {
+      g_sink += InterestHeaderView (p).GetName ().cut (1).size ();
+    }
+  return clock.End ();
+}
+
+static int64_t
+DataPrefixFull (Ptr<const Packet> p)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < g_iterations; i++)
+    {
+      ContentObjectHeader header;
+      p->PeekHeader (header);
+      g_sink += header.GetName ().cut (1).size ();
+    }
+  return clock.End ();
+}
+
+static int64_t
+DataPrefixView (Ptr<const Packet> p)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < g_iterations; i++)
+    {
+      g_sink += ContentObjectHeaderView (p).GetName ().cut (1).size ();
+    }
+  return clock.End ();
+}
+
+static int64_t
+DataLastComponentView (Ptr<const Packet> p)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < g_iterations; i++)
+    {
+      g_sink += HeaderHelper::GetNameView (p).GetLastComponent ().size ();
+    }
+  return clock.End ();
+}
+
+static int64_t
+DataLastComponentFull (Ptr<const Packet> p)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < g_iterations; i++)
+    {
+      ContentObjectHeader header;
+      p->PeekHeader (header);
+      g_sink += header.GetName ().GetLastComponent ().size ();
+    }
+  return clock.End ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t components = 3;
+
+  CommandLine cmd;
+  cmd.AddValue ("iterations", "Number of times every operation is repeated", g_iterations);
+  cmd.AddValue ("components", "Number of name components (including sequence number)", components);
+  cmd.Parse (argc, argv);
+
+  g_iterations = std::max<uint32_t> (g_iterations, 1);
+
+  Ptr<NameComponents> name = Create<NameComponents> ();
+  for (uint32_t i = 1; i < components; i++)
+    {
+      name->Add ("component" + boost::lexical_cast<string> (i));
+    }
+  name->Add (123456);
+
+  InterestHeader interestHeader;
+  interestHeader.SetName (name);
+  interestHeader.SetNonce (12345);
+  Ptr<Packet> interest = Create<Packet> ();
+  interest->AddHeader (interestHeader);
+
+  ContentObjectHeader dataHeader;
+  dataHeader.SetName (name);
+  static ContentObjectTail tail;
+  Ptr<Packet> data = Create<Packet> (1024);
+  data->AddHeader (dataHeader);
+  data->AddTrailer (tail);
+
+  cout << "Operation" << "\t" << "Decoder" << "\t" << "NsPerOp" << endl;
+
+  Report ("InterestNack", "Full", InterestNackFull (interest));
+  Report ("InterestNack", "View", InterestNackView (interest));
+  Report ("InterestPrefix", "Full", InterestPrefixFull (interest));
+  Report ("InterestPrefix", "View", InterestPrefixView (interest));
+  Report ("DataPrefix", "Full", DataPrefixFull (data));
+  Report ("DataPrefix", "View", DataPrefixView (data));
+  Report ("DataLastComponent", "Full", DataLastComponentFull (data));
+  Report ("DataLastComponent", "View", DataLastComponentView (data));
+
+  return 0;
+}
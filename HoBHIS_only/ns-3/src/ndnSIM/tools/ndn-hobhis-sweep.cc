@@ -0,0 +1,544 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Parameter sweep of HoBHIS scenarios
+//
+// Runs hobhis-chain or hobhis-fairness scenario (--scenario=chain|fairness) for every
+// combination of HoBHIS parameters from the comma-separated lists --maxInterest (size of
+// the Interest shaper buffer), --queueTarget (target Data queue length), --design
+// (convergence speed) and --seeds (RngRun), see StackHelper::EnableHobhis.
+//
+// Simulator and NodeList are process-wide singletons, therefore runs cannot share one
+// process.  Instead, the topology is read once, and every run is executed in a forked
+// worker process, which inherits the already created topology (copy-on-write) and only
+// installs NDN stack and applications with the run's parameters.  At most --workers runs
+// are executed at the same time (by default, number of online processors).
+//
+// With --warmup=<seconds> the warm-up phase (populating PIT and CS and convergence of
+// HoBHIS RTT and rate estimates) is simulated only once for every seed, with the first
+// values of the parameter lists.  The warmed-up process serves as a checkpoint: every
+// parameter combination is executed in a process forked from it, which inherits the whole
+// simulation state (event queue, PIT, FIB, CS, shaper tables, positions of random streams,
+// sequence numbers of applications), changes HoBHIS parameters of the router faces, and
+// continues the simulation for --duration seconds.  Statistics of warm-up are not included
+// in the summary.
+//
+// For every run one line with the summary is written to --output (by default, stdout):
+// received Data packets, throughput, mean delay between the last Interest and Data,
+// number of packets dropped in device queues, Jain's fairness index of per-flow
+// throughputs, wall clock time of the run, and per-flow received Data packets.
+//
+// Example:
+//
+//     ./waf --run "ndn-hobhis-sweep --scenario=fairness --maxInterest=1000,1000000 --queueTarget=30,60 --design=0.1,0.7 --workers=32"
+//     ./waf --run "ndn-hobhis-sweep --scenario=fairness --warmup=200 --duration=50 --maxInterest=1000,1000000 --seeds=1,2,3"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndn-drop-tail-queue.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include <fstream>
+#include <map>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+using namespace ns3;
+using namespace std;
+
+struct Flow
+{
+  const char *consumer;
+  const char *producer;
+  const char *prefix;
+  const char *frequency;
+  const char *randomDelayMax;
+};
+
+struct RouterQueue
+{
+  const char *router;
+  uint32_t face;
+};
+
+struct Scenario
+{
+  const char *name;
+  const char *topology;
+  const char *routers[4];  // null-terminated
+  const char *clients[7];  // null-terminated
+  RouterQueue queues[6];         // terminated by null router
+  Flow flows[4];           // terminated by null consumer
+};
+
+// the same setup as in examples/hobhis-chain.cc and examples/hobhis-fairness.cc
+static const Scenario SCENARIOS[] =
+  {
+    {
+      "chain", "src/ndnSIM/examples/topologies/hobhis-baseline.txt",
+      { "R1", 0 },
+      { "C1", "P1", 0 },
+      { { "R1", 0 }, { 0, 0 } },
+      { { "C1", "P1", "/c1", "10000.0", "0" }, { 0, 0, 0, 0, 0 } }
+    },
+    {
+      "fairness", "src/ndnSIM/examples/topologies/hobhis-fairness.txt",
+      { "R1", "R2", "R3", 0 },
+      { "C1", "P1", "C2", "P2", "C3", "P3", 0 },
+      { { "R1", 0 }, { "R1", 1 }, { "R1", 2 }, { "R2", 0 }, { "R3", 0 }, { 0, 0 } },
+      { { "C1", "P1", "/c1", "100.0", "0.1" },
+        { "C2", "P2", "/c2", "25.0", "0.1" },
+        { "C3", "P3", "/c3", "100.0", "0.1" },
+        { 0, 0, 0, 0, 0 } }
+    }
+  };
+
+struct Parameters
+{
+  uint32_t maxInterest;
+  uint32_t queueTarget;
+  double design;
+  uint32_t seed;
+};
+
+static const Scenario *g_scenario = 0;
+static vector<Parameters> g_grid;
+static vector< vector<uint32_t> > g_groups; // runs sharing the same warm-up phase
+static double g_warmup = 0.0;
+static double g_duration = 50.0;
+static uint32_t g_workers = 1;
+
+// statistics of the run (collected in the worker process)
+static map<Ptr<ndn::App>, uint32_t> g_data;
+static map<Ptr<ndn::App>, double> g_delay;
+static uint64_t g_drops = 0;
+
+static void
+OnData (Ptr<ndn::App> app, uint32_t seqno, Time delay, int32_t hopCount)
+{
+  g_data[app] ++;
+  g_delay[app] += delay.ToDouble (Time::S);
+}
+
+static void
+OnDrop (Ptr<const Packet>)
+{
+  g_drops ++;
+}
+
+static void
+Install (const Scenario &scenario, const Parameters &parameters)
+{
+  RngSeedManager::SetRun (parameters.seed);
+
+  ndn::StackHelper routerHelper;
+  routerHelper.SetForwardingStrategy ("ns3::ndn::fw::BestRoute");
+  routerHelper.EnableHobhis (true, false, parameters.maxInterest, parameters.queueTarget, parameters.design);
+  routerHelper.SetContentStore ("ns3::ndn::cs::Lru", "MaxSize", "1"); // almost no caching
+  for (const char * const *router = scenario.routers; *router != 0; router++)
+    {
+      routerHelper.Install (Names::Find<Node> (*router));
+    }
+
+  // Data queues on router interfaces
+  Config::SetDefault ("ns3::NDNDropTailQueue::MaxPackets", UintegerValue (100));
+  for (const RouterQueue *queue = scenario.queues; queue->router != 0; queue++)
+    {
+      Ptr<ndn::L3Protocol> ndn = Names::Find<Node> (queue->router)->GetObject<ndn::L3Protocol> ();
+      Ptr<ndn::NetDeviceFace> face = DynamicCast<ndn::NetDeviceFace> (ndn->GetFace (queue->face));
+      Ptr<PointToPointNetDevice> device = StaticCast<PointToPointNetDevice> (face->GetNetDevice ());
+
+      Ptr<ndn::NDNDropTailQueue> ndnQueue = CreateObject<ndn::NDNDropTailQueue> ();
+      ndnQueue->SetMode (ndn::NDNDropTailQueue::QUEUE_MODE_PACKETS);
+      device->SetQueue (ndnQueue);
+    }
+
+  ndn::StackHelper clientHelper;
+  clientHelper.SetForwardingStrategy ("ns3::ndn::fw::BestRoute");
+  clientHelper.EnableHobhis (true, true);
+  clientHelper.SetContentStore ("ns3::ndn::cs::Lru", "MaxSize", "1");
+  for (const char * const *client = scenario.clients; *client != 0; client++)
+    {
+      clientHelper.Install (Names::Find<Node> (*client));
+    }
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll ();
+
+  for (const Flow *flow = scenario.flows; flow->consumer != 0; flow++)
+    {
+      ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+      consumerHelper.SetAttribute ("Frequency", StringValue (flow->frequency));
+      consumerHelper.SetPrefix (flow->prefix);
+      consumerHelper.Install (Names::Find<Node> (flow->consumer));
+
+      routingHelper.AddOrigins (flow->prefix, Names::Find<Node> (flow->producer));
+
+      ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+      producerHelper.SetAttribute ("PayloadSize", StringValue ("1000"));
+      producerHelper.SetAttribute ("RandomDelayMin", StringValue ("0"));
+      producerHelper.SetAttribute ("RandomDelayMax", StringValue (flow->randomDelayMax));
+      producerHelper.SetPrefix (flow->prefix);
+      producerHelper.Install (Names::Find<Node> (flow->producer));
+    }
+
+  routingHelper.CalculateRoutes ();
+
+  Config::ConnectWithoutContext ("/NodeList/*/ApplicationList/*/LastRetransmittedInterestDataDelay", MakeCallback (&OnData));
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice/TxQueue/Drop", MakeCallback (&OnDrop));
+}
+
+// Changes HoBHIS parameters of the router faces of already running simulation
+static void
+Apply (const Scenario &scenario, const Parameters &parameters)
+{
+  for (const char * const *router = scenario.routers; *router != 0; router++)
+    {
+      Ptr<ndn::L3Protocol> ndn = Names::Find<Node> (*router)->GetObject<ndn::L3Protocol> ();
+      for (uint32_t i = 0; i < ndn->GetNFaces (); i++)
+        {
+          Ptr<ndn::HobhisNetDeviceFace> face = DynamicCast<ndn::HobhisNetDeviceFace> (ndn->GetFace (i));
+          if (face == 0)
+            continue;
+
+          face->SetAttribute ("MaxInterest", UintegerValue (parameters.maxInterest));
+          face->SetAttribute ("QueueTarget", UintegerValue (parameters.queueTarget));
+          face->SetAttribute ("Design", DoubleValue (parameters.design));
+        }
+    }
+}
+
+// Continues the simulation for duration seconds and returns summary of this period
+static string
+Simulate (const Scenario &scenario, double duration)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  g_data.clear ();
+  g_delay.clear ();
+  g_drops = 0;
+
+  Simulator::Stop (Seconds (duration));
+  Simulator::Run ();
+
+  uint64_t data = 0;
+  double delay = 0;
+  double sum = 0;
+  double squares = 0;
+  uint32_t nFlows = 0;
+  ostringstream flows;
+  for (const Flow *flow = scenario.flows; flow->consumer != 0; flow++)
+    {
+      Ptr<ndn::App> app = DynamicCast<ndn::App> (Names::Find<Node> (flow->consumer)->GetApplication (0));
+      data += g_data[app];
+      delay += g_delay[app];
+
+      double throughput = g_data[app] / duration;
+      sum += throughput;
+      squares += throughput * throughput;
+      nFlows ++;
+
+      flows << (flow == scenario.flows ? "" : ",") << flow->prefix << ":" << g_data[app];
+    }
+
+  ostringstream os;
+  os << data << "\t"
+     << data / duration << "\t"
+     << (data > 0 ? delay * 1000.0 / data : 0.0) << "\t"
+     << g_drops << "\t"
+     << (squares > 0 ? sum * sum / (nFlows * squares) : 0.0) << "\t"
+     << clock.End () << "\t"
+     << flows.str ();
+  return os.str ();
+}
+
+typedef string (*Job) (uint32_t item);
+
+struct Worker
+{
+  pid_t pid;
+  uint32_t item;
+  string output;
+};
+
+// Executes job for items [0, count) in forked processes, at most workers at the same time.
+// Output of the job is returned in results ("failed" if the worker did not succeed)
+static void
+Fork (Job job, uint32_t count, uint32_t workers, vector<string> &results)
+{
+  results.assign (count, "");
+
+  map<int, Worker> active; // pipe fd -> worker
+  uint32_t next = 0;
+  while (next < count || !active.empty ())
+    {
+      if (next < count && active.size () < workers)
+        {
+          int fds[2];
+          if (pipe (fds) != 0)
+            NS_FATAL_ERROR ("Cannot create pipe for the worker");
+
+          cout.flush (); // do not duplicate buffered output in the worker
+          cerr.flush ();
+
+          pid_t pid = fork ();
+          if (pid < 0)
+            NS_FATAL_ERROR ("Cannot fork the worker");
+
+          if (pid == 0)
+            {
+              close (fds[0]);
+              string output = job (next);
+
+              const char *data = output.c_str ();
+              size_t left = output.size ();
+              while (left > 0)
+                {
+                  ssize_t written = write (fds[1], data, left);
+                  if (written <= 0)
+                    _exit (1);
+                  data += written;
+                  left -= written;
+                }
+              close (fds[1]);
+              _exit (0); // skip destruction of the inherited state
+            }
+
+          close (fds[1]);
+          Worker worker;
+          worker.pid = pid;
+          worker.item = next;
+          active[fds[0]] = worker;
+          next ++;
+          continue;
+        }
+
+      // read output of workers as it comes, so they never block on the full pipe
+      vector<pollfd> fds;
+      for (map<int, Worker>::iterator i = active.begin (); i != active.end (); i++)
+        {
+          pollfd fd = { i->first, POLLIN, 0 };
+          fds.push_back (fd);
+        }
+      if (poll (&fds[0], fds.size (), -1) < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          NS_FATAL_ERROR ("poll failed");
+        }
+
+      for (vector<pollfd>::iterator fd = fds.begin (); fd != fds.end (); fd++)
+        {
+          if (fd->revents == 0)
+            continue;
+
+          Worker &worker = active[fd->fd];
+          char buffer[4096];
+          ssize_t size = read (fd->fd, buffer, sizeof (buffer));
+          if (size > 0)
+            {
+              worker.output.append (buffer, size);
+              continue;
+            }
+
+          // worker closed the pipe
+          close (fd->fd);
+          int status = 0;
+          waitpid (worker.pid, &status, 0);
+          bool ok = WIFEXITED (status) && WEXITSTATUS (status) == 0 && !worker.output.empty ();
+          results[worker.item] = ok ? worker.output : "failed";
+          active.erase (fd->fd);
+        }
+    }
+}
+
+// Executes one run from the start
+static string
+RunFromStart (uint32_t run)
+{
+  Install (*g_scenario, g_grid[run]);
+  string summary = Simulate (*g_scenario, g_duration);
+
+  cerr << "Run " << run << " finished" << endl;
+  return summary;
+}
+
+static uint32_t g_group = 0;
+
+// Executes one run of the current group, continuing from the checkpoint
+static string
+RunFromCheckpoint (uint32_t item)
+{
+  uint32_t run = g_groups[g_group][item];
+  Apply (*g_scenario, g_grid[run]);
+  string summary = Simulate (*g_scenario, g_duration);
+
+  cerr << "Run " << run << " finished" << endl;
+  return summary;
+}
+
+// Simulates warm-up of the group, then executes all runs of the group from this checkpoint
+static string
+RunGroup (uint32_t group)
+{
+  g_group = group;
+
+  Install (*g_scenario, g_grid[g_groups[group].front ()]);
+  Simulator::Stop (Seconds (g_warmup));
+  Simulator::Run ();
+  cerr << "Warm-up " << group << " finished" << endl;
+
+  uint32_t parallelGroups = std::min<uint32_t> (g_groups.size (), g_workers);
+  vector<string> results;
+  Fork (&RunFromCheckpoint, g_groups[group].size (), std::max<uint32_t> (g_workers / parallelGroups, 1), results);
+
+  ostringstream os;
+  for (uint32_t item = 0; item < results.size (); item++)
+    {
+      os << g_groups[group][item] << "\t" << results[item] << "\n";
+    }
+  return os.str ();
+}
+
+template<class T>
+static vector<T>
+ParseList (const string &list)
+{
+  vector<string> items;
+  boost::split (items, list, boost::is_any_of (","));
+
+  vector<T> values;
+  for (vector<string>::const_iterator item = items.begin (); item != items.end (); item++)
+    {
+      values.push_back (boost::lexical_cast<T> (boost::trim_copy (*item)));
+    }
+  return values;
+}
+
+int
+main (int argc, char *argv[])
+{
+  string scenarioName = "fairness";
+  string maxInterests = "1000000";
+  string queueTargets = "60";
+  string designs = "0.7";
+  string seeds = "1";
+  uint32_t workers = std::max<long> (sysconf (_SC_NPROCESSORS_ONLN), 1);
+  string output = "";
+
+  CommandLine cmd;
+  cmd.AddValue ("scenario", "Scenario (chain or fairness)", scenarioName);
+  cmd.AddValue ("maxInterest", "Comma-separated list of Interest buffer sizes", maxInterests);
+  cmd.AddValue ("queueTarget", "Comma-separated list of target Data queue lengths", queueTargets);
+  cmd.AddValue ("design", "Comma-separated list of design parameters (convergence speed)", designs);
+  cmd.AddValue ("seeds", "Comma-separated list of RngRun values", seeds);
+  cmd.AddValue ("warmup", "Simulated time of the shared warm-up phase, seconds (0 to disable)", g_warmup);
+  cmd.AddValue ("duration", "Simulated time of every run, seconds", g_duration);
+  cmd.AddValue ("workers", "Maximum number of runs executed in parallel", workers);
+  cmd.AddValue ("output", "File for run summaries (stdout if empty)", output);
+  cmd.Parse (argc, argv);
+
+  g_workers = std::max<uint32_t> (workers, 1);
+
+  for (uint32_t i = 0; i < sizeof (SCENARIOS) / sizeof (SCENARIOS[0]); i++)
+    {
+      if (scenarioName == SCENARIOS[i].name)
+        g_scenario = &SCENARIOS[i];
+    }
+  if (g_scenario == 0)
+    {
+      cerr << "Unknown scenario: " << scenarioName << endl;
+      return 1;
+    }
+
+  vector<uint32_t> maxInterestList = ParseList<uint32_t> (maxInterests);
+  vector<uint32_t> queueTargetList = ParseList<uint32_t> (queueTargets);
+  vector<double> designList = ParseList<double> (designs);
+  vector<uint32_t> seedList = ParseList<uint32_t> (seeds);
+  g_groups.resize (seedList.size ());
+  for (uint32_t a = 0; a < maxInterestList.size (); a++)
+    for (uint32_t b = 0; b < queueTargetList.size (); b++)
+      for (uint32_t c = 0; c < designList.size (); c++)
+        for (uint32_t d = 0; d < seedList.size (); d++)
+          {
+            Parameters parameters = { maxInterestList[a], queueTargetList[b], designList[c], seedList[d] };
+            g_groups[d].push_back (g_grid.size ());
+            g_grid.push_back (parameters);
+          }
+
+  // topology is read only once and inherited by all workers
+  AnnotatedTopologyReader topologyReader ("", 25);
+  topologyReader.SetFileName (g_scenario->topology);
+  topologyReader.Read ();
+
+  vector<string> results (g_grid.size (), "failed");
+  if (g_warmup > 0)
+    {
+      vector<string> groupResults;
+      Fork (&RunGroup, g_groups.size (), g_workers, groupResults);
+
+      // every group reports "<run>\t<summary>" lines
+      for (uint32_t group = 0; group < groupResults.size (); group++)
+        {
+          istringstream is (groupResults[group]);
+          string line;
+          while (getline (is, line))
+            {
+              size_t tab = line.find ('\t');
+              if (tab == string::npos)
+                continue;
+
+              uint32_t run = boost::lexical_cast<uint32_t> (line.substr (0, tab));
+              if (run < results.size ())
+                results[run] = line.substr (tab + 1);
+            }
+        }
+    }
+  else
+    {
+      Fork (&RunFromStart, g_grid.size (), g_workers, results);
+    }
+
+  ofstream file;
+  if (!output.empty ())
+    file.open (output.c_str (), ios::out | ios::trunc);
+  ostream &os = output.empty () ? cout : file;
+
+  os << "Run" << "\t" << "Scenario" << "\t" << "MaxInterest" << "\t" << "QueueTarget" << "\t"
+     << "Design" << "\t" << "Seed" << "\t" << "Data" << "\t" << "DataPerSec" << "\t" << "DelayMs" << "\t"
+     << "Drops" << "\t" << "Fairness" << "\t" << "WallMs" << "\t" << "Flows" << endl;
+
+  for (uint32_t run = 0; run < g_grid.size (); run++)
+    {
+      os << run << "\t" << g_scenario->name << "\t" << g_grid[run].maxInterest << "\t" << g_grid[run].queueTarget << "\t"
+         << g_grid[run].design << "\t" << g_grid[run].seed << "\t" << results[run] << endl;
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
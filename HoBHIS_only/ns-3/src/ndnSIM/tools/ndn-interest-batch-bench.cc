@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Benchmark of per-packet vs. batched Interest forwarding
+//
+// Consumer requests --interests Data packets from the producer over a chain of --routers
+// routers (fast point-to-point links), keeping --window Interests in flight.  The run is
+// repeated for every batch size from --batches (MaxBatchSize attribute of the consumer,
+// 1 means one Interest packet per Data packet).  For every run the number of Interest
+// packets sent by the consumer, the number of received Data packets, wall clock time of
+// the simulation, and the forwarding throughput (received Data packets per wall clock
+// second) are reported.
+//
+// Example:
+//
+//     ./waf --run "ndn-interest-batch-bench --interests=100000 --batches=1,4,16,64"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+
+using namespace ns3;
+using namespace std;
+
+static uint32_t g_interests = 0;
+static uint32_t g_data = 0;
+static uint32_t g_expected = 0;
+
+static void
+OnInterest (Ptr<const ndn::InterestHeader>, Ptr<ndn::App>, Ptr<ndn::Face>)
+{
+  g_interests ++;
+}
+
+static void
+OnData (Ptr<const ndn::ContentObjectHeader>, Ptr<const Packet>, Ptr<ndn::App>, Ptr<ndn::Face>)
+{
+  g_data ++;
+  if (g_data == g_expected)
+    Simulator::Stop (); // consumer keeps checking retransmission timeouts forever
+}
+
+static void
+Run (uint32_t batch, uint32_t interests, uint32_t routers, uint32_t window)
+{
+  g_interests = 0;
+  g_data = 0;
+  g_expected = interests;
+
+  NodeContainer nodes;
+  nodes.Create (routers + 2);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Gbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1ms"));
+  p2p.SetQueue ("ns3::DropTailQueue", "MaxPackets", UintegerValue (10000));
+  for (uint32_t i = 1; i < nodes.GetN (); i++)
+    {
+      p2p.Install (nodes.Get (i - 1), nodes.Get (i));
+    }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes (true);
+  ndnHelper.SetContentStore ("ns3::ndn::cs::Lru", "MaxSize", "1");
+  ndnHelper.InstallAll ();
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerWindow");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Window", StringValue (boost::lexical_cast<string> (window)));
+  consumerHelper.SetAttribute ("MaxSeq", IntegerValue (interests));
+  consumerHelper.SetAttribute ("MaxBatchSize", UintegerValue (batch));
+  consumerHelper.Install (nodes.Get (0));
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producerHelper.Install (nodes.Get (nodes.GetN () - 1));
+
+  Config::ConnectWithoutContext ("/NodeList/0/ApplicationList/*/TransmittedInterests", MakeCallback (&OnInterest));
+  Config::ConnectWithoutContext ("/NodeList/0/ApplicationList/*/ReceivedContentObjects", MakeCallback (&OnData));
+
+  Simulator::Stop (Seconds (3600.0)); // in case some Data packets are lost
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t ms = std::max<int64_t> (clock.End (), 1);
+
+  cout << batch << "\t" << g_interests << "\t" << g_data << "\t" << ms << "\t"
+       << static_cast<uint64_t> (g_data * 1000.0 / ms) << endl;
+
+  Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t interests = 100000;
+  uint32_t routers = 3;
+  uint32_t window = 64;
+  string batches = "1,4,16,64";
+
+  CommandLine cmd;
+  cmd.AddValue ("interests", "Number of Data packets requested by the consumer", interests);
+  cmd.AddValue ("routers", "Number of routers between the consumer and the producer", routers);
+  cmd.AddValue ("window", "Number of Interests in flight", window);
+  cmd.AddValue ("batches", "Comma-separated list of batch sizes", batches);
+  cmd.Parse (argc, argv);
+
+  vector<string> sizes;
+  boost::split (sizes, batches, boost::is_any_of (","));
+
+  cout << "Batch" << "\t" << "Interests" << "\t" << "Data" << "\t" << "WallMs" << "\t" << "DataPerSec" << endl;
+  for (vector<string>::const_iterator size = sizes.begin (); size != sizes.end (); size++)
+    {
+      Run (std::max<uint32_t> (boost::lexical_cast<uint32_t> (*size), 1), interests, routers, window);
+    }
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Benchmark of simulation setup (object creation and attribute lookups)
+//
+// Creates --nodes nodes connected into a chain with point-to-point links, installs the NDN
+// stack and a consumer and a producer application on every node, and connects L3 rate and
+// content store tracers to every node.  Time spent on every phase is reported.  Setup of
+// large topologies is dominated by ObjectFactory / attribute lookups (TypeId names,
+// attribute names, and initial values) and Config path resolution.
+//
+// Example:
+//
+//     ./waf --run "ndn-stack-install-bench --nodes=10000"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.h"
+#include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.h"
+
+#include <algorithm>
+
+using namespace ns3;
+using namespace std;
+
+static void
+Report (const string &phase, SystemWallClockMs &clock)
+{
+  cout << phase << "\t" << clock.End () << endl;
+  clock.Start ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nodeCount = 10000;
+  uint32_t attributes = 1000;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes", nodeCount);
+  cmd.AddValue ("attributes", "Number of Config::SetDefault calls", attributes);
+  cmd.Parse (argc, argv);
+
+  nodeCount = std::max<uint32_t> (nodeCount, 2);
+
+  cout << "Phase" << "\t" << "Ms" << endl;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  for (uint32_t i = 0; i < attributes; i++)
+    {
+      Config::SetDefault ("ns3::PointToPointNetDevice::DataRate", StringValue ("1Mbps"));
+      Config::SetDefault ("ns3::PointToPointChannel::Delay", StringValue ("10ms"));
+      Config::SetDefault ("ns3::DropTailQueue::MaxPackets", StringValue ("20"));
+    }
+  Report ("SetDefault", clock);
+
+  NodeContainer nodes;
+  nodes.Create (nodeCount);
+  Report ("Nodes", clock);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 1; i < nodeCount; i++)
+    {
+      p2p.Install (nodes.Get (i - 1), nodes.Get (i));
+    }
+  Report ("Links", clock);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes (true);
+  ndnHelper.Install (nodes);
+  Report ("Stack", clock);
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("10"));
+  consumerHelper.Install (nodes);
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producerHelper.Install (nodes);
+  Report ("Apps", clock);
+
+  boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<ndn::L3RateTracer> > >
+    l3Tracers = ndn::L3RateTracer::InstallAll ("/dev/null");
+  boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<ndn::CsTracer> > >
+    csTracers = ndn::CsTracer::InstallAll ("/dev/null");
+  Report ("Tracers", clock);
+
+  Simulator::Destroy ();
+  Report ("Destroy", clock);
+
+  return 0;
+}
@@ -0,0 +1,173 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Benchmark of topology loading (simulation startup time)
+//
+// Loads the bundled Rocketfuel-format topology (--weights, links with OSPF weights, read with
+// RocketfuelWeightsReader), annotated topology (--topology, AnnotatedTopologyReader), and,
+// if specified, Rocketfuel map file (--rocketfuel, .cch, RocketfuelMapReader) --runs times
+// each.  For every file the minimum and the average time to create all nodes and links is
+// reported.
+//
+// With --cache=1 annotated topologies are read through the binary cache (sidecar file next
+// to the topology file), which is created during the first run.  With --partitions=N system
+// ids of the nodes of annotated and Rocketfuel map topologies are calculated by the
+// automatic partitioner (NS_LOG=TopologyPartitioner=info shows the lookahead and the cut).
+//
+// Example:
+//
+//     ./waf --run "ndn-topology-load-bench --topology=large-topology.txt --runs=10 --cache=1"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include "ns3/ndnSIM/plugins/topology/rocketfuel-map-reader.h"
+#include "ns3/ndnSIM/plugins/topology/rocketfuel-weights-reader.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace ns3;
+using namespace std;
+
+enum ReaderType
+  {
+    ANNOTATED,
+    WEIGHTS,
+    ROCKETFUEL
+  };
+
+static uint32_t
+Load (ReaderType type, const string &file, bool cache, uint32_t partitions, uint32_t &links)
+{
+  NodeContainer nodes;
+  switch (type)
+    {
+    case ANNOTATED:
+      {
+        AnnotatedTopologyReader reader ("", 1.0);
+        reader.SetFileName (file);
+        reader.SetCacheEnabled (cache);
+        reader.SetPartitionCount (partitions);
+        nodes = reader.Read ();
+        links = reader.LinksSize ();
+        break;
+      }
+    case WEIGHTS:
+      {
+        RocketfuelWeightsReader reader ("", 1.0);
+        reader.SetFileName (file);
+        reader.SetFileType (RocketfuelWeightsReader::LATENCIES); // bundled file has fractional values
+        nodes = reader.Read ();
+        reader.Commit ();
+        links = reader.LinksSize ();
+        break;
+      }
+    case ROCKETFUEL:
+      {
+        RocketfuelParams params;
+        params.clientNodeDegrees = 2;
+        params.averageRtt = 0.25; // 250ms
+        params.minb2bBandwidth = "40Mbps";
+        params.minb2bDelay = "5ms";
+        params.maxb2bBandwidth = "100Mbps";
+        params.maxb2bDelay = "10ms";
+        params.minb2gBandwidth = "10Mbps";
+        params.minb2gDelay = "5ms";
+        params.maxb2gBandwidth = "20Mbps";
+        params.maxb2gDelay = "10ms";
+        params.ming2cBandwidth = "1Mbps";
+        params.ming2cDelay = "70ms";
+        params.maxg2cBandwidth = "3Mbps";
+        params.maxg2cDelay = "10ms";
+
+        RocketfuelMapReader reader ("/", 1.0);
+        reader.SetFileName (file);
+        reader.SetPartitionCount (partitions);
+        nodes = reader.Read (params, true, true);
+        links = reader.LinksSize ();
+        break;
+      }
+    }
+
+  return nodes.GetN ();
+}
+
+static void
+Run (const string &title, ReaderType type, const string &file, bool cache, uint32_t partitions, uint32_t runs)
+{
+  if (file.empty ())
+    return;
+
+  int64_t total = 0;
+  int64_t best = numeric_limits<int64_t>::max ();
+  uint32_t nodes = 0;
+  uint32_t links = 0;
+  for (uint32_t run = 0; run < runs; run++)
+    {
+      SystemWallClockMs clock;
+      clock.Start ();
+      nodes = Load (type, file, cache, partitions, links);
+      int64_t time = clock.End ();
+
+      total += time;
+      best = std::min (best, time);
+
+      // start every run from scratch
+      Simulator::Destroy ();
+      Names::Clear ();
+    }
+
+  cout << title << "\t" << nodes << "\t" << links << "\t"
+       << best << "\t" << static_cast<double> (total) / runs << "\t" << file << endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  string topology = "src/ndnSIM/examples/topologies/topo-grid-3x3.txt";
+  string weights = "src/topology-read/examples/RocketFuel_toposample_1239_weights.txt";
+  string rocketfuel = "";
+  uint32_t runs = 5;
+  bool cache = false;
+  uint32_t partitions = 0;
+
+  CommandLine cmd;
+  cmd.AddValue ("topology", "Annotated topology file", topology);
+  cmd.AddValue ("weights", "Rocketfuel weights file", weights);
+  cmd.AddValue ("rocketfuel", "Rocketfuel map file (.cch)", rocketfuel);
+  cmd.AddValue ("runs", "Number of times to load each topology", runs);
+  cmd.AddValue ("cache", "Use binary cache for annotated topologies", cache);
+  cmd.AddValue ("partitions", "Automatically split topologies into the number of partitions (0 to disable)", partitions);
+  cmd.Parse (argc, argv);
+
+  runs = std::max<uint32_t> (runs, 1);
+
+  cout << "Reader" << "\t" << "Nodes" << "\t" << "Links" << "\t"
+       << "MinMs" << "\t" << "AvgMs" << "\t" << "File" << endl;
+
+  Run ("Weights", WEIGHTS, weights, cache, partitions, runs);
+  Run ("Annotated", ANNOTATED, topology, cache, partitions, runs);
+  Run ("Rocketfuel", ROCKETFUEL, rocketfuel, cache, partitions, runs);
+
+  return 0;
+}
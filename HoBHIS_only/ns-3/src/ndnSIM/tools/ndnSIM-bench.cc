@@ -0,0 +1,595 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Benchmark suite of ndnSIM
+//
+// Runs a fixed set of reproducible scenarios (fixed topologies, traffic, durations, and
+// RngRun):
+//
+//   chain          consumer - router - producer, 1000 Interests per second
+//   grid-10x10     100-node grid, consumers in the first row, producer in the opposite corner
+//   rocketfuel     Rocketfuel AS 1239 topology sample, 32 consumers, one producer
+//   hobhis-on      hobhis-fairness scenario with HoBHIS shaping enabled
+//   hobhis-off     the same scenario with plain NetDeviceFaces
+//   cs-lru-zipf    tree topology, Zipf-Mandelbrot consumers, LRU content stores
+//   pit-stress     10000 unsatisfied Interests per second, PIT filled until Interest lifetime
+//
+// Every scenario is executed --runs times in a separate (forked) process, so runs do not
+// affect each other and peak RSS is measured per scenario.  For the fastest run the
+// following is reported: number of processed events (counted with ns3::Profiler), wall
+// clock time, events per second, simulated seconds per wall clock second, peak RSS, number of
+// NDN packets processed by the forwarding, and number of memory allocations per packet
+// (allocations are counted during Simulator::Run only).
+//
+// Results are written as JSON (to --output or stdout), one scenario per line.  If a previous
+// result is given as --baseline, metrics are compared with it, and the program exits with
+// status 1 if any of them became worse by more than --tolerance (events per second,
+// simulated seconds per wall clock second, allocations per packet, or peak RSS).
+//
+// Example:
+//
+//     ./waf --run "ndnSIM-bench --output=bench.json"
+//     ./waf --run "ndnSIM-bench --scenarios=chain,pit-stress --baseline=bench.json"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/profiler.h"
+
+#include "ns3/ndnSIM/plugins/topology/rocketfuel-weights-reader.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+using namespace ns3;
+using namespace std;
+
+// counting of memory allocations (replaces global operator new for the whole program)
+static bool g_countAllocations = false;
+static uint64_t g_allocations = 0;
+
+void *
+operator new (size_t size) throw (std::bad_alloc)
+{
+  if (g_countAllocations)
+    g_allocations ++;
+
+  void *p = malloc (size > 0 ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void
+operator delete (void *p) throw ()
+{
+  free (p);
+}
+
+struct Result
+{
+  uint32_t nodes;
+  double simulated;
+  uint64_t events;
+  double wallMs;
+  uint64_t peakRssKb;
+  uint64_t packets;
+  uint64_t allocations;
+};
+
+static void
+InstallConsumer (const string &type, Ptr<Node> node, const string &prefix, const string &frequency)
+{
+  ndn::AppHelper consumerHelper (type);
+  consumerHelper.SetPrefix (prefix);
+  consumerHelper.SetAttribute ("Frequency", StringValue (frequency));
+  consumerHelper.Install (node);
+}
+
+static void
+InstallProducer (Ptr<Node> node, const string &prefix)
+{
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix (prefix);
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producerHelper.Install (node);
+}
+
+static NodeContainer
+CreateChain (uint32_t n, const string &dataRate, const string &delay)
+{
+  NodeContainer nodes;
+  nodes.Create (n);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue (dataRate));
+  p2p.SetChannelAttribute ("Delay", StringValue (delay));
+  for (uint32_t i = 0; i + 1 < n; i++)
+    {
+      p2p.Install (nodes.Get (i), nodes.Get (i + 1));
+    }
+  return nodes;
+}
+
+// Scenarios: create topology and applications, return the simulated time
+
+static double
+Chain ()
+{
+  NodeContainer nodes = CreateChain (3, "10Mbps", "10ms");
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes (true);
+  ndnHelper.InstallAll ();
+
+  InstallConsumer ("ns3::ndn::ConsumerCbr", nodes.Get (0), "/prefix", "1000");
+  InstallProducer (nodes.Get (2), "/prefix");
+  return 20.0;
+}
+
+static double
+Grid ()
+{
+  const uint32_t size = 10;
+  NodeContainer nodes;
+  nodes.Create (size * size);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("1Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  for (uint32_t row = 0; row < size; row++)
+    for (uint32_t column = 0; column < size; column++)
+      {
+        if (column + 1 < size)
+          p2p.Install (nodes.Get (row * size + column), nodes.Get (row * size + column + 1));
+        if (row + 1 < size)
+          p2p.Install (nodes.Get (row * size + column), nodes.Get ((row + 1) * size + column));
+      }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll ();
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll ();
+
+  for (uint32_t column = 0; column < size; column++)
+    {
+      InstallConsumer ("ns3::ndn::ConsumerCbr", nodes.Get (column), "/prefix", "100");
+    }
+  InstallProducer (nodes.Get (size * size - 1), "/prefix");
+  routingHelper.AddOrigins ("/prefix", nodes.Get (size * size - 1));
+  routingHelper.CalculateRoutes ();
+  return 20.0;
+}
+
+static double
+Rocketfuel ()
+{
+  RocketfuelWeightsReader reader ("", 1.0);
+  reader.SetFileName ("src/topology-read/examples/RocketFuel_toposample_1239_weights.txt");
+  reader.SetFileType (RocketfuelWeightsReader::LATENCIES);
+  NodeContainer nodes = reader.Read ();
+  reader.Commit ();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll ();
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll ();
+
+  uint32_t step = std::max<uint32_t> (nodes.GetN () / 32, 1);
+  for (uint32_t i = step; i < nodes.GetN (); i += step)
+    {
+      InstallConsumer ("ns3::ndn::ConsumerCbr", nodes.Get (i), "/prefix", "100");
+    }
+  InstallProducer (nodes.Get (0), "/prefix");
+  routingHelper.AddOrigins ("/prefix", nodes.Get (0));
+  routingHelper.CalculateRoutes ();
+  return 10.0;
+}
+
+static double
+Hobhis (bool enable)
+{
+  AnnotatedTopologyReader reader ("", 25);
+  reader.SetFileName ("src/ndnSIM/examples/topologies/hobhis-fairness.txt");
+  reader.Read ();
+
+  ndn::StackHelper routerHelper;
+  routerHelper.SetForwardingStrategy ("ns3::ndn::fw::BestRoute");
+  routerHelper.SetContentStore ("ns3::ndn::cs::Lru", "MaxSize", "1");
+  if (enable)
+    routerHelper.EnableHobhis (true, false, 1000000, 60, 0.7);
+  routerHelper.Install (Names::Find<Node> ("R1"));
+  routerHelper.Install (Names::Find<Node> ("R2"));
+  routerHelper.Install (Names::Find<Node> ("R3"));
+
+  ndn::StackHelper clientHelper;
+  clientHelper.SetForwardingStrategy ("ns3::ndn::fw::BestRoute");
+  clientHelper.SetContentStore ("ns3::ndn::cs::Lru", "MaxSize", "1");
+  if (enable)
+    clientHelper.EnableHobhis (true, true);
+
+  ndn::GlobalRoutingHelper routingHelper;
+  const char *flows[3][3] = { { "C1", "P1", "/c1" }, { "C2", "P2", "/c2" }, { "C3", "P3", "/c3" } };
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      clientHelper.Install (Names::Find<Node> (flows[i][0]));
+      clientHelper.Install (Names::Find<Node> (flows[i][1]));
+    }
+  routingHelper.InstallAll ();
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      InstallConsumer ("ns3::ndn::ConsumerCbr", Names::Find<Node> (flows[i][0]), flows[i][2], "100");
+      InstallProducer (Names::Find<Node> (flows[i][1]), flows[i][2]);
+      routingHelper.AddOrigins (flows[i][2], Names::Find<Node> (flows[i][1]));
+    }
+  routingHelper.CalculateRoutes ();
+  return 20.0;
+}
+
+static double
+HobhisOn ()
+{
+  return Hobhis (true);
+}
+
+static double
+HobhisOff ()
+{
+  return Hobhis (false);
+}
+
+static double
+CsLruZipf ()
+{
+  AnnotatedTopologyReader reader ("", 25);
+  reader.SetFileName ("src/ndnSIM/examples/topologies/topo-tree.txt");
+  reader.Read ();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetContentStore ("ns3::ndn::cs::Lru", "MaxSize", "100");
+  ndnHelper.InstallAll ();
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll ();
+
+  const char *leaves[] = { "leaf-1", "leaf-2", "leaf-3", "leaf-4" };
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerZipfMandelbrot");
+      consumerHelper.SetPrefix ("/root");
+      consumerHelper.SetAttribute ("Frequency", StringValue ("500"));
+      consumerHelper.SetAttribute ("NumberOfContents", StringValue ("1000"));
+      consumerHelper.Install (Names::Find<Node> (leaves[i]));
+    }
+  InstallProducer (Names::Find<Node> ("root"), "/root");
+  routingHelper.AddOrigins ("/root", Names::Find<Node> ("root"));
+  routingHelper.CalculateRoutes ();
+  return 20.0;
+}
+
+static double
+PitStress ()
+{
+  NodeContainer nodes = CreateChain (3, "100Mbps", "10ms");
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes (true);
+  ndnHelper.InstallAll ();
+
+  // nobody answers Interests, they stay in PITs until they expire
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/unanswered");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("10000"));
+  consumerHelper.SetAttribute ("LifeTime", StringValue ("4s"));
+  consumerHelper.Install (nodes.Get (0));
+  return 6.0;
+}
+
+typedef double (*ScenarioFunction) ();
+
+struct Scenario
+{
+  const char *name;
+  ScenarioFunction function;
+};
+
+static const Scenario SCENARIOS[] =
+  {
+    { "chain", &Chain },
+    { "grid-10x10", &Grid },
+    { "rocketfuel", &Rocketfuel },
+    { "hobhis-on", &HobhisOn },
+    { "hobhis-off", &HobhisOff },
+    { "cs-lru-zipf", &CsLruZipf },
+    { "pit-stress", &PitStress }
+  };
+
+static Result
+Execute (const Scenario &scenario)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  Result result;
+  result.simulated = scenario.function ();
+  result.nodes = NodeList::GetNNodes ();
+
+  Profiler::SetSamplingPeriod (1 << 30); // only count events
+  Profiler::Clear ();
+  Profiler::Enable ();
+  uint64_t packets = ndn::L3Protocol::GetInterestCounter () + ndn::L3Protocol::GetDataCounter ();
+  g_allocations = 0;
+  g_countAllocations = true;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (result.simulated));
+  Simulator::Run ();
+  result.wallMs = clock.End ();
+
+  g_countAllocations = false;
+  result.allocations = g_allocations;
+  result.packets = ndn::L3Protocol::GetInterestCounter () + ndn::L3Protocol::GetDataCounter () - packets;
+  Profiler::Disable ();
+
+  result.events = 0;
+  std::vector<ProfilerEntry> entries = Profiler::GetEntries ();
+  for (std::vector<ProfilerEntry>::iterator entry = entries.begin (); entry != entries.end (); entry++)
+    {
+      if (entry->stage == Profiler::GetEventStage ().GetName ())
+        result.events += entry->count;
+    }
+
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+  result.peakRssKb = usage.ru_maxrss;
+  return result;
+}
+
+// Executes scenario in a forked process (returns false if the process failed)
+static bool
+ExecuteInChild (const Scenario &scenario, Result &result)
+{
+  int fds[2];
+  if (pipe (fds) != 0)
+    NS_FATAL_ERROR ("Cannot create pipe");
+
+  cout.flush ();
+  cerr.flush ();
+
+  pid_t pid = fork ();
+  if (pid < 0)
+    NS_FATAL_ERROR ("Cannot fork");
+
+  if (pid == 0)
+    {
+      close (fds[0]);
+
+      // scenarios print to stdout, keep it for the JSON report
+      int null = open ("/dev/null", O_WRONLY);
+      dup2 (null, STDOUT_FILENO);
+
+      Result childResult = Execute (scenario);
+      ssize_t written = write (fds[1], &childResult, sizeof (childResult));
+      _exit (written == sizeof (childResult) ? 0 : 1); // skip destruction of the simulation
+    }
+
+  close (fds[1]);
+  ssize_t size = 0;
+  ssize_t bytes;
+  while (size < static_cast<ssize_t> (sizeof (result)) &&
+         (bytes = read (fds[0], reinterpret_cast<char *> (&result) + size, sizeof (result) - size)) > 0)
+    {
+      size += bytes;
+    }
+  close (fds[0]);
+
+  int status = 0;
+  waitpid (pid, &status, 0);
+  return size == sizeof (result) && WIFEXITED (status) && WEXITSTATUS (status) == 0;
+}
+
+static string
+ToJson (const string &name, const Result &result)
+{
+  double seconds = std::max (result.wallMs, 1.0) / 1000.0;
+
+  ostringstream os;
+  os << "{ \"name\": \"" << name << "\""
+     << ", \"nodes\": " << result.nodes
+     << ", \"simulated_s\": " << result.simulated
+     << ", \"events\": " << result.events
+     << ", \"wall_ms\": " << result.wallMs
+     << ", \"events_per_s\": " << result.events / seconds
+     << ", \"sim_s_per_wall_s\": " << result.simulated / seconds
+     << ", \"peak_rss_kb\": " << result.peakRssKb
+     << ", \"packets\": " << result.packets
+     << ", \"allocations\": " << result.allocations
+     << ", \"allocations_per_packet\": " << (result.packets > 0 ? static_cast<double> (result.allocations) / result.packets : 0.0)
+     << " }";
+  return os.str ();
+}
+
+// Extracts value of the numeric field from the JSON line (as written by ToJson)
+static bool
+GetField (const string &line, const string &field, double &value)
+{
+  string key = "\"" + field + "\": ";
+  size_t pos = line.find (key);
+  if (pos == string::npos)
+    return false;
+
+  value = atof (line.c_str () + pos + key.size ());
+  return true;
+}
+
+// Compares the result with the baseline, returns false if there are regressions
+static bool
+Compare (const string &baselineFile, const vector<string> &lines, double tolerance)
+{
+  ifstream is (baselineFile.c_str ());
+  if (!is.is_open ())
+    {
+      cerr << "Cannot open baseline " << baselineFile << endl;
+      return false;
+    }
+
+  map<string, string> baseline;
+  string line;
+  while (getline (is, line))
+    {
+      size_t begin = line.find ("\"name\": \"");
+      if (begin == string::npos)
+        continue;
+      begin += 9;
+      baseline[line.substr (begin, line.find ('"', begin) - begin)] = line;
+    }
+
+  // metric, true if larger is better
+  const char *metrics[] = { "events_per_s", "sim_s_per_wall_s", "allocations_per_packet", "peak_rss_kb" };
+  const bool larger[] = { true, true, false, false };
+
+  bool ok = true;
+  for (vector<string>::const_iterator current = lines.begin (); current != lines.end (); current++)
+    {
+      size_t begin = current->find ("\"name\": \"") + 9;
+      string name = current->substr (begin, current->find ('"', begin) - begin);
+      map<string, string>::iterator old = baseline.find (name);
+      if (old == baseline.end ())
+        continue;
+
+      double oldEvents = 0, newEvents = 0;
+      if (GetField (old->second, "events", oldEvents) && GetField (*current, "events", newEvents) && oldEvents != newEvents)
+        {
+          cerr << name << ": number of events changed (" << oldEvents << " -> " << newEvents << "), results are not directly comparable" << endl;
+        }
+
+      for (uint32_t i = 0; i < sizeof (metrics) / sizeof (metrics[0]); i++)
+        {
+          double oldValue = 0, newValue = 0;
+          if (!GetField (old->second, metrics[i], oldValue) || !GetField (*current, metrics[i], newValue) || oldValue <= 0)
+            continue;
+
+          double change = (newValue - oldValue) / oldValue;
+          bool regression = larger[i] ? change < -tolerance : change > tolerance;
+          cerr << name << "\t" << metrics[i] << "\t" << oldValue << " -> " << newValue
+               << "\t(" << (change >= 0 ? "+" : "") << change * 100 << "%)"
+               << (regression ? "\tREGRESSION" : "") << endl;
+          ok = ok && !regression;
+        }
+    }
+  return ok;
+}
+
+int
+main (int argc, char *argv[])
+{
+  string scenarios = "all";
+  uint32_t runs = 3;
+  string output = "";
+  string baseline = "";
+  double tolerance = 0.1;
+
+  CommandLine cmd;
+  cmd.AddValue ("scenarios", "Comma-separated list of scenarios (or all)", scenarios);
+  cmd.AddValue ("runs", "Number of runs of each scenario (the fastest is reported)", runs);
+  cmd.AddValue ("output", "File for JSON results (stdout if empty)", output);
+  cmd.AddValue ("baseline", "JSON results of a previous run to compare with", baseline);
+  cmd.AddValue ("tolerance", "Relative change of metrics considered as regression", tolerance);
+  cmd.Parse (argc, argv);
+
+  runs = std::max<uint32_t> (runs, 1);
+
+  vector<string> selected;
+  boost::split (selected, scenarios, boost::is_any_of (","));
+
+  vector<string> lines;
+  bool failed = false;
+  for (uint32_t i = 0; i < sizeof (SCENARIOS) / sizeof (SCENARIOS[0]); i++)
+    {
+      if (scenarios != "all" && find (selected.begin (), selected.end (), SCENARIOS[i].name) == selected.end ())
+        continue;
+
+      Result best;
+      bool ok = false;
+      for (uint32_t run = 0; run < runs; run++)
+        {
+          Result result;
+          if (!ExecuteInChild (SCENARIOS[i], result))
+            {
+              cerr << SCENARIOS[i].name << ": run " << run << " failed" << endl;
+              continue;
+            }
+
+          if (!ok || result.wallMs < best.wallMs)
+            best = result;
+          ok = true;
+        }
+
+      if (!ok)
+        {
+          failed = true;
+          continue;
+        }
+      lines.push_back (ToJson (SCENARIOS[i].name, best));
+      cerr << SCENARIOS[i].name << ": " << best.wallMs << " ms" << endl;
+    }
+
+  ofstream file;
+  if (!output.empty ())
+    file.open (output.c_str (), ios::out | ios::trunc);
+  ostream &os = output.empty () ? cout : file;
+
+  os << "{\n"
+     << "\"build\": \""
+#ifdef NS3_ASSERT_ENABLE
+     << "debug"
+#else
+     << "optimized"
+#endif
+     << "\",\n"
+     << "\"runs\": " << runs << ",\n"
+     << "\"scenarios\": [\n";
+  for (uint32_t i = 0; i < lines.size (); i++)
+    {
+      os << lines[i] << (i + 1 < lines.size () ? "," : "") << "\n";
+    }
+  os << "]\n"
+     << "}" << endl;
+
+  if (!baseline.empty () && !Compare (baseline, lines, tolerance))
+    failed = true;
+
+  return failed ? 1 : 0;
+}
@@ -19,21 +19,45 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/tracepoint.h"
 #include "ns3/enum.h"
 #include "ns3/uinteger.h"
 #include "ndn-drop-tail-queue.h"
 #include "ns3/ndn-header-helper.h"
 #include "ns3/ppp-header.h"
-#include "ns3/ndn-content-object.h"
-#include "ns3/ndn-interest.h"
+#include "ns3/ndn-header-view.h"
+#include "ns3/ndn-fragment.h"
 
 NS_LOG_COMPONENT_DEFINE ("NDNDropTailQueue");
 
+NS_TRACEPOINT_DEFINE (g_tpEnqueue, "ndn.DropTailQueue.Enqueue"); // queue length, packet size
+NS_TRACEPOINT_DEFINE (g_tpDrop, "ndn.DropTailQueue.Drop"); // queue length, packet size
+
 namespace ns3 {
 namespace ndn{
 
 NS_OBJECT_ENSURE_REGISTERED (NDNDropTailQueue);
 
+/**
+ * Skip link-layer fragment header (see NetDeviceFace).  Only the first fragment is accounted in
+ * per-flow queue lengths: it is assumed to carry the complete header of the fragmented packet,
+ * which is true for any sane MTU.  Other fragments are reported as FRAGMENT_NDNSIM.
+ */
+static ndn::HeaderHelper::Type
+SkipFragmentHeader (Ptr<const Packet> p, ndn::HeaderHelper::Type type, uint32_t &offset)
+{
+	if (type != ndn::HeaderHelper::FRAGMENT_NDNSIM)
+		return type;
+
+	ndn::FragmentHeader fragmentHeader;
+	p->PeekHeader (fragmentHeader, offset);
+	if (fragmentHeader.GetIndex () != 0)
+		return type;
+
+	offset += fragmentHeader.GetSerializedSize ();
+	return ndn::HeaderHelper::GetNdnHeaderType (p, offset);
+}
+
 TypeId NDNDropTailQueue::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::NDNDropTailQueue")
@@ -94,23 +118,21 @@ NDNDropTailQueue::DoEnqueue (Ptr<Packet> p)
 	NS_LOG_FUNCTION (this << p);
 
 	PppHeader pppHeader;
-	Ptr<Packet> copy = p->Copy ();
-	copy->RemoveHeader(pppHeader);
-	ndn::HeaderHelper::Type type = ndn::HeaderHelper::GetNdnHeaderType (copy);
+	uint32_t offset = p->PeekHeader (pppHeader); // NDN header follows PPP header
+	ndn::HeaderHelper::Type type = ndn::HeaderHelper::GetNdnHeaderType (p, offset);
+	bool fragment = (type == ndn::HeaderHelper::FRAGMENT_NDNSIM);
+	type = SkipFragmentHeader (p, type, offset);
 
-	uint8_t nack;
+	uint8_t nack = 0;
 
 
-	if(type ==ndn::HeaderHelper::INTEREST_NDNSIM ||
-			type == ndn::HeaderHelper::INTEREST_CCNB)
+	if(!fragment && (type ==ndn::HeaderHelper::INTEREST_NDNSIM ||
+			type == ndn::HeaderHelper::INTEREST_CCNB))
 	{
-		Ptr<ndn::InterestHeader> header = Create<ndn::InterestHeader> ();
-		Ptr<Packet> nack_p = copy->Copy();
-		nack_p->RemoveHeader (*header);
-		nack = header->GetNack();
+		nack = ndn::InterestHeaderView (p, offset).GetNack ();
 	}
 
-	if(type == ndn::HeaderHelper::CONTENT_OBJECT_NDNSIM ||
+	if(fragment || type == ndn::HeaderHelper::CONTENT_OBJECT_NDNSIM ||
 			type == ndn::HeaderHelper::CONTENT_OBJECT_CCNB ||
 			((type ==ndn::HeaderHelper::INTEREST_NDNSIM ||
 					type == ndn::HeaderHelper::INTEREST_CCNB) && nack == 0))
@@ -118,6 +140,7 @@ NDNDropTailQueue::DoEnqueue (Ptr<Packet> p)
 		if (m_mode == QUEUE_MODE_PACKETS &&(m_packets.size () >= m_maxPackets))
 		{
 			NS_LOG_LOGIC ("Queue full (at max packets) -- droppping pkt");
+			NS_TRACEPOINT (g_tpDrop, m_packets.size (), p->GetSize ());
 			Drop (p);
 			return false;
 		}
@@ -125,6 +148,7 @@ NDNDropTailQueue::DoEnqueue (Ptr<Packet> p)
 		if (m_mode == QUEUE_MODE_BYTES && (m_bytesInQueue + p->GetSize () >= m_maxBytes))
 		{
 			NS_LOG_LOGIC ("Queue full (packet would exceed max bytes) -- droppping pkt");
+			NS_TRACEPOINT (g_tpDrop, m_packets.size (), p->GetSize ());
 			Drop (p);
 			return false;
 		}
@@ -133,14 +157,16 @@ NDNDropTailQueue::DoEnqueue (Ptr<Packet> p)
 		NS_LOG_LOGIC ("Number bytes " << m_bytesInQueue);
 	}
 
-	if(type == ndn::HeaderHelper::CONTENT_OBJECT_NDNSIM || type == ndn::HeaderHelper::CONTENT_OBJECT_CCNB)
+	if(fragment || type == ndn::HeaderHelper::CONTENT_OBJECT_NDNSIM || type == ndn::HeaderHelper::CONTENT_OBJECT_CCNB)
 	{
 		m_bytesInQueue += p->GetSize ();
 		m_packets.push (p);
+		NS_TRACEPOINT (g_tpEnqueue, m_packets.size (), p->GetSize ());
+	}
 
-		Ptr<ndn::ContentObjectHeader> header = Create<ndn::ContentObjectHeader> ();
-		copy->RemoveHeader (*header);
-		ndn::Name prefix = header->GetName ().cut(1);
+	if(type == ndn::HeaderHelper::CONTENT_OBJECT_NDNSIM || type == ndn::HeaderHelper::CONTENT_OBJECT_CCNB)
+	{
+		ndn::Name prefix = ndn::ContentObjectHeaderView (p, offset).GetName ().cut(1);
 
 		std::map<ndn::Name, uint32_t>::iterator
 		fit(m_nQueueSizePerFlow.find(prefix)),
@@ -186,16 +212,14 @@ NDNDropTailQueue::DoDequeue (void)
 		  std::map <ndn::Name, uint32_t> & QueueSizePerFlow = GetQLengthPerFlow ();
 
 		  PppHeader pppHeader;
-		  Ptr<Packet> copy = p->Copy ();
-		  copy->RemoveHeader(pppHeader);
+		  uint32_t offset = p->PeekHeader (pppHeader);
 
-		  ndn::HeaderHelper::Type type = ndn::HeaderHelper::GetNdnHeaderType (copy);
+		  ndn::HeaderHelper::Type type = ndn::HeaderHelper::GetNdnHeaderType (p, offset);
+		  type = SkipFragmentHeader (p, type, offset);
 
 		  if(type == ndn::HeaderHelper::CONTENT_OBJECT_NDNSIM || type == ndn::HeaderHelper::CONTENT_OBJECT_CCNB)
 		  {
-			  Ptr<ndn::ContentObjectHeader> header = Create<ndn::ContentObjectHeader> ();
-			  copy->RemoveHeader (*header);
-			  ndn::Name prefix = header->GetName ().cut(1);
+			  ndn::Name prefix = ndn::ContentObjectHeaderView (p, offset).GetName ().cut(1);
 
 			  std::map<ndn::Name, uint32_t>::iterator
 			  fit(QueueSizePerFlow.find(prefix)),
@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-limits-rate-wheel.h"
+#include "ndn-limits-rate.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/node.h"
+
+#include <algorithm>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.Limits.RateWheel");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (LimitsRateWheel);
+
+TypeId
+LimitsRateWheel::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::Limits::RateWheel")
+    .SetGroupName ("Ndn")
+    .SetParent <Object> ()
+    .AddConstructor <LimitsRateWheel> ()
+
+    .AddAttribute ("Resolution", "Duration of one slot of the wheel (wake-ups are rounded up to the resolution)",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&LimitsRateWheel::m_resolution),
+                   MakeTimeChecker ())
+    .AddAttribute ("Slots", "Number of slots in the wheel",
+                   UintegerValue (256),
+                   MakeUintegerAccessor (&LimitsRateWheel::m_nSlots),
+                   MakeUintegerChecker<uint32_t> (1))
+    ;
+  return tid;
+}
+
+LimitsRateWheel::LimitsRateWheel ()
+  : m_nSlots (256)
+  , m_size (0)
+  , m_currentTick (0)
+  , m_isTickScheduled (false)
+  , m_eventTick (0)
+  , m_eventCount (0)
+  , m_context (0xffffffff)
+{
+}
+
+Ptr<LimitsRateWheel>
+LimitsRateWheel::GetWheel (Ptr<Node> node)
+{
+  Ptr<LimitsRateWheel> wheel = node->GetObject<LimitsRateWheel> ();
+  if (wheel == 0)
+    {
+      wheel = CreateObject<LimitsRateWheel> ();
+      node->AggregateObject (wheel);
+    }
+  return wheel;
+}
+
+void
+LimitsRateWheel::NotifyNewAggregate ()
+{
+  if (m_context == 0xffffffff)
+    {
+      Ptr<Node> node = GetObject<Node> ();
+      if (node != 0)
+        {
+          m_context = node->GetId ();
+        }
+    }
+
+  Object::NotifyNewAggregate ();
+}
+
+void
+LimitsRateWheel::DoDispose ()
+{
+  m_isTickScheduled = false;
+  m_slots.clear (); // break reference cycles with LimitsRate objects
+  m_size = 0;
+
+  Object::DoDispose ();
+}
+
+uint32_t
+LimitsRateWheel::GetSize () const
+{
+  return m_size;
+}
+
+uint64_t
+LimitsRateWheel::GetEventCount () const
+{
+  return m_eventCount;
+}
+
+void
+LimitsRateWheel::Schedule (Ptr<LimitsRate> limits, const Time &when)
+{
+  if (m_slots.empty ())
+    {
+      m_slots.resize (m_nSlots);
+    }
+
+  int64_t resolution = m_resolution.GetTimeStep ();
+  if (m_size == 0)
+    {
+      m_currentTick = Simulator::Now ().GetTimeStep () / resolution;
+    }
+
+  // round up, so the wake-up never fires before the requested time
+  uint64_t tick = std::max<int64_t> (0, (when.GetTimeStep () + resolution - 1) / resolution);
+  tick = std::max (tick, m_currentTick + 1);
+
+  NS_LOG_FUNCTION (this << when << tick);
+
+  m_slots[tick % m_slots.size ()].push_back (Timer (limits, tick));
+  m_size ++;
+
+  if (!m_isTickScheduled || tick < m_eventTick)
+    {
+      m_eventTick = tick;
+      ScheduleTick ();
+    }
+}
+
+void
+LimitsRateWheel::ScheduleTick ()
+{
+  Time delay = TimeStep (m_eventTick * m_resolution.GetTimeStep ()) - Simulator::Now ();
+  m_eventCount ++;
+  m_isTickScheduled = true;
+  // ScheduleWithContext does not return EventId: rescheduled ticks are not cancelled, but ignored
+  if (m_context != 0xffffffff)
+    Simulator::ScheduleWithContext (m_context, delay, &LimitsRateWheel::Tick, Ptr<LimitsRateWheel> (this), m_eventTick);
+  else
+    Simulator::Schedule (delay, &LimitsRateWheel::Tick, Ptr<LimitsRateWheel> (this), m_eventTick);
+}
+
+void
+LimitsRateWheel::Tick (uint64_t tick)
+{
+  if (!m_isTickScheduled || tick != m_eventTick)
+    return; // tick has been rescheduled
+
+  m_isTickScheduled = false;
+  m_currentTick = m_eventTick;
+  NS_LOG_FUNCTION (this << m_currentTick);
+
+  std::list<Timer> &slot = m_slots[m_currentTick % m_slots.size ()];
+  std::list< Ptr<LimitsRate> > expired;
+  for (std::list<Timer>::iterator timer = slot.begin (); timer != slot.end (); )
+    {
+      if (timer->m_tick <= m_currentTick)
+        {
+          expired.push_back (timer->m_limits);
+          timer = slot.erase (timer);
+          m_size --;
+        }
+      else
+        timer ++;
+    }
+
+  // wake-ups may schedule new wake-ups, therefore the slot should not be touched after this point
+  for (std::list< Ptr<LimitsRate> >::iterator limits = expired.begin (); limits != expired.end (); limits ++)
+    {
+      (*limits)->Wakeup ();
+    }
+
+  if (m_size == 0 || m_isTickScheduled)
+    return;
+
+  // find the nearest non-empty slot within one revolution of the wheel
+  uint64_t next = 0;
+  for (uint64_t tick = m_currentTick + 1; tick <= m_currentTick + m_slots.size () && next == 0; tick ++)
+    {
+      const std::list<Timer> &nextSlot = m_slots[tick % m_slots.size ()];
+      for (std::list<Timer>::const_iterator timer = nextSlot.begin (); timer != nextSlot.end (); timer ++)
+        {
+          if (timer->m_tick == tick)
+            {
+              next = tick;
+              break;
+            }
+        }
+    }
+
+  if (next == 0)
+    {
+      // all wake-ups are further than one revolution, find the nearest one
+      next = std::numeric_limits<uint64_t>::max ();
+      for (std::vector< std::list<Timer> >::const_iterator slot = m_slots.begin (); slot != m_slots.end (); slot ++)
+        {
+          for (std::list<Timer>::const_iterator timer = slot->begin (); timer != slot->end (); timer ++)
+            {
+              next = std::min (next, timer->m_tick);
+            }
+        }
+    }
+
+  m_eventTick = next;
+  ScheduleTick ();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_LIMITS_RATE_WHEEL_H_
+#define	_NDN_LIMITS_RATE_WHEEL_H_
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+
+#include <vector>
+#include <list>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+class LimitsRate;
+
+/**
+ * \ingroup ndn
+ * \brief Node-wide timer wheel for wake-ups of exhausted LimitsRate token buckets
+ *
+ * LimitsRate objects do not leak their buckets periodically.  Bucket level is calculated
+ * from the elapsed time whenever the limit is checked, and the timer is needed only to
+ * notify (see Limits::RegisterAvailableSlotCallback) that an exhausted bucket has a free
+ * slot again.  All such wake-ups on a node share one wheel, which has at most one pending
+ * simulator event, scheduled for the nearest non-empty slot.  Therefore, the number of
+ * simulator events depends on the number of exhausted limits, not on the number of
+ * configured limits (e.g., per-FIB entry limits, see fw::PerFibLimits).
+ *
+ * Wake-ups are rounded up to the wheel resolution (never fire earlier than requested).
+ */
+class LimitsRateWheel : public Object
+{
+public:
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * @brief Default constructor
+   */
+  LimitsRateWheel ();
+
+  /**
+   * @brief Get the wheel of the node (wheel is created and aggregated to the node on the first call)
+   */
+  static Ptr<LimitsRateWheel>
+  GetWheel (Ptr<Node> node);
+
+  /**
+   * @brief Schedule wake-up of the limits object (LimitsRate::Wakeup) at the specified absolute time
+   */
+  void
+  Schedule (Ptr<LimitsRate> limits, const Time &when);
+
+  /**
+   * @brief Get number of scheduled wake-ups
+   */
+  uint32_t
+  GetSize () const;
+
+  /**
+   * @brief Get total number of simulator events, used by the wheel so far
+   */
+  uint64_t
+  GetEventCount () const;
+
+protected:
+  // from Object
+  virtual void
+  NotifyNewAggregate ();
+
+  virtual void
+  DoDispose ();
+
+private:
+  void
+  Tick (uint64_t tick);
+
+  void
+  ScheduleTick ();
+
+private:
+  struct Timer
+  {
+    Timer (Ptr<LimitsRate> limits, uint64_t tick)
+      : m_limits (limits)
+      , m_tick (tick)
+    { }
+
+    Ptr<LimitsRate> m_limits;
+    uint64_t m_tick;
+  };
+
+  Time m_resolution;
+  uint32_t m_nSlots;
+  std::vector< std::list<Timer> > m_slots;
+  uint32_t m_size;
+
+  uint64_t m_currentTick; // last processed tick
+  bool m_isTickScheduled;
+  uint64_t m_eventTick;
+  uint64_t m_eventCount;
+
+  uint32_t m_context; // node ID (0xffffffff if the wheel is not aggregated to a node)
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_LIMITS_RATE_WHEEL_H_
@@ -22,9 +22,9 @@
 
 #include "ns3/log.h"
 #include "ns3/simulator.h"
-#include "ns3/random-variable.h"
 #include "ns3/ndn-face.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.Limits.Rate");
 
@@ -46,27 +46,18 @@ LimitsRate::GetTypeId ()
 }
 
 void
-LimitsRate::NotifyNewAggregate ()
+LimitsRate::DoDispose ()
 {
-  super::NotifyNewAggregate ();
+  m_wheel = 0;
 
-  if (!m_isLeakScheduled)
-    {
-      if (GetObject<Face> () != 0)
-        {
-          NS_ASSERT_MSG (GetObject<Face> ()->GetNode () != 0, "Node object should exist on the face");
-          
-          m_isLeakScheduled = true;
-          UniformVariable r (0.0, 1.0);
-          Simulator::ScheduleWithContext (GetObject<Face> ()->GetNode ()->GetId (),
-                                          Seconds (r.GetValue ()), &LimitsRate::LeakBucket, this, 0.0);
-        }
-    }
+  super::DoDispose ();
 }
 
 void
 LimitsRate::SetLimits (double rate, double delay)
 {
+  LeakBucket ();
+
   super::SetLimits (rate, delay);
 
   // maximum allowed burst
@@ -81,9 +72,16 @@ void
 LimitsRate::UpdateCurrentLimit (double limit)
 {
   NS_ASSERT_MSG (limit >= 0.0, "Limit should be greater or equal to zero");
+
+  LeakBucket (); // leak with the old rate
   
   m_bucketLeak = std::min (limit, GetMaxRate ());
   m_bucketMax  = m_bucketLeak * GetMaxDelay ();
+
+  if (IsEnabled () && m_bucketMax - m_bucket < 1.0)
+    {
+      ScheduleWakeup (); // wake-up time depends on the leak rate
+    }
 }
 
 bool
@@ -91,7 +89,13 @@ LimitsRate::IsBelowLimit ()
 {
   if (!IsEnabled ()) return true;
 
-  return (m_bucketMax - m_bucket >= 1.0);
+  LeakBucket ();
+
+  if (m_bucketMax - m_bucket >= 1.0)
+    return true;
+
+  ScheduleWakeup ();
+  return false;
 }
 
 void
@@ -99,8 +103,15 @@ LimitsRate::BorrowLimit ()
 {
   if (!IsEnabled ()) return; 
 
+  LeakBucket ();
+
   NS_ASSERT_MSG (m_bucketMax - m_bucket >= 1.0, "Should not be possible, unless we IsBelowLimit was not checked correctly");
   m_bucket += 1; 
+
+  if (m_bucketMax - m_bucket < 1.0)
+    {
+      ScheduleWakeup ();
+    }
 }
 
 void
@@ -110,9 +121,14 @@ LimitsRate::ReturnLimit ()
 }
 
 void
-LimitsRate::LeakBucket (double interval)
+LimitsRate::LeakBucket ()
 {
-  const double leak = m_bucketLeak * interval;
+  Time now = Simulator::Now ();
+  if (now == m_lastLeak)
+    return;
+
+  const double leak = m_bucketLeak * (now - m_lastLeak).ToDouble (Time::S);
+  m_lastLeak = now;
 
 #ifdef NS3_LOG_ENABLE  
   if (m_bucket>1)
@@ -121,24 +137,74 @@ LimitsRate::LeakBucket (double interval)
     }
 #endif
 
-  double bucketOld = m_bucket;
-  
   m_bucket = std::max (0.0, m_bucket - leak);
+}
+
+void
+LimitsRate::ScheduleWakeup ()
+{
+  // nobody is waiting for the slot, level will be calculated during the next check
+  if (!IsAvailableSlotCallbackRegistered () || m_bucketLeak <= 0.0)
+    return;
+
+  Time when = Simulator::Now () + Seconds (std::max (0.0, m_bucket - (m_bucketMax - 1.0)) / m_bucketLeak);
+  if (m_isWakeupScheduled && m_wakeup <= when)
+    return; // the earlier wake-up will reschedule, if necessary
 
-  // calculate interval so next time we will leak by 1.001, unless such interval would be more than 1 second
-  double newInterval = 1.0;
-  if (m_bucketLeak > 1.0)
+  Ptr<LimitsRateWheel> wheel = GetWheel ();
+  if (wheel == 0)
     {
-      newInterval = 1.001 / m_bucketLeak;
+      NS_LOG_ERROR ("Limits are not associated with any node, wake-up cannot be scheduled");
+      return;
     }
 
-  if (m_bucketMax - bucketOld < 1.0 &&
-      m_bucketMax - m_bucket >= 1.0) // limit number of times this stuff is called
+  m_isWakeupScheduled = true;
+  m_wakeup = when;
+  wheel->Schedule (this, when);
+}
+
+void
+LimitsRate::Wakeup ()
+{
+  if (!m_isWakeupScheduled || Simulator::Now () < m_wakeup)
+    return; // wake-up has been rescheduled
+
+  m_isWakeupScheduled = false;
+  LeakBucket ();
+
+  if (m_bucketMax - m_bucket >= 1.0)
     {
       this->FireAvailableSlotCallback ();
     }
-  
-  Simulator::Schedule (Seconds (newInterval), &LimitsRate::LeakBucket, this, newInterval);
+  else
+    {
+      ScheduleWakeup ();
+    }
+}
+
+Ptr<LimitsRateWheel>
+LimitsRate::GetWheel ()
+{
+  if (m_wheel != 0)
+    return m_wheel;
+
+  Ptr<Node> node;
+  Ptr<Face> face = GetObject<Face> ();
+  if (face != 0)
+    {
+      node = face->GetNode ();
+    }
+  else if (Simulator::GetContext () < NodeList::GetNNodes ())
+    {
+      // limits are not aggregated to a face (e.g., per-FIB entry limits), use the node that is checking the limit
+      node = NodeList::GetNode (Simulator::GetContext ());
+    }
+
+  if (node != 0)
+    {
+      m_wheel = LimitsRateWheel::GetWheel (node);
+    }
+  return m_wheel;
 }
 
 } // namespace ndn
@@ -22,6 +22,7 @@
 #define	_NDN_LIMITS_RATE_H_
 
 #include "ndn-limits.h"
+#include "ndn-limits-rate-wheel.h"
 
 namespace ns3 {
 namespace ndn {
@@ -29,6 +30,11 @@ namespace ndn {
 /**
  * \ingroup ndn
  * \brief Structure to manage limits for outstanding interests
+ *
+ * Token bucket is not leaked periodically.  Instead, the bucket level is calculated
+ * from the time elapsed since the last check.  If the bucket is exhausted and the
+ * available slot callback is registered, the wake-up is scheduled in the node-wide
+ * LimitsRateWheel
  */
 class LimitsRate :
     public Limits
@@ -44,10 +50,10 @@ public:
    * \param prefix smart pointer to the prefix for the FIB entry
    */
   LimitsRate ()
-    : m_isLeakScheduled (false)
-    , m_bucketMax (0)
+    : m_bucketMax (0)
     , m_bucketLeak (1)
     , m_bucket (0)
+    , m_isWakeupScheduled (false)
   { }
 
   virtual
@@ -101,27 +107,46 @@ public:
   {
     return m_bucketLeak;
   }
+
+  /**
+   * @brief Called by LimitsRateWheel when the scheduled wake-up time comes
+   */
+  void
+  Wakeup ();
   
 protected:
-  // from Node
-  void
-  NotifyNewAggregate ();
+  // from Object
+  virtual void
+  DoDispose ();
     
 private:
   /**
-   * @brief Leak bucket, assuming `interval' seconds between leakages
-   *
-   * @param interval Time interval for leakage. Used to calculate size of the leak
+   * @brief Leak bucket by the amount accumulated since the last leak
+   */
+  void
+  LeakBucket ();
+
+  /**
+   * @brief Schedule wake-up at the time the exhausted bucket will have a free slot
    */
   void
-  LeakBucket (double interval);
+  ScheduleWakeup ();
+
+  /**
+   * @brief Get wheel of the node (face node or node in whose context the simulator currently runs)
+   */
+  Ptr<LimitsRateWheel>
+  GetWheel ();
 
 private:
-  bool m_isLeakScheduled;
-  
   double m_bucketMax;   ///< \brief Maximum Interest allowance for this face (maximum tokens that can be issued at the same time)
   double m_bucketLeak;  ///< \brief Normalized amount that should be leaked every second (token bucket leak rate)
   double m_bucket;      ///< \brief Value representing current size of the Interest allowance for this face (current size of token bucket)
+  Time m_lastLeak;      ///< \brief Time when bucket was leaked last time
+
+  bool m_isWakeupScheduled;
+  Time m_wakeup;
+  Ptr<LimitsRateWheel> m_wheel;
 };
   
 
@@ -62,6 +62,12 @@ Limits::FireAvailableSlotCallback ()
     m_handler ();
 }
 
+bool
+Limits::IsAvailableSlotCallbackRegistered () const
+{
+  return !m_handler.IsNull ();
+}
+
 
 } // namespace ndn
 } // namespace ns3
@@ -184,6 +184,12 @@ public:
 protected:
   void
   FireAvailableSlotCallback ();
+
+  /**
+   * @brief Check whether callback for available slots is registered
+   */
+  bool
+  IsAvailableSlotCallbackRegistered () const;
   
 private:
   double m_maxRate;
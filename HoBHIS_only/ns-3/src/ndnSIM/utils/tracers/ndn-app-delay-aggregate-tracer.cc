@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-app-delay-aggregate-tracer.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/config.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+
+#include "ns3/ndn-app.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.AppDelayAggregateTracer");
+
+using namespace std;
+
+namespace ns3 {
+namespace ndn {
+
+boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<AppDelayAggregateTracer> > >
+AppDelayAggregateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
+{
+  std::list<Ptr<AppDelayAggregateTracer> > tracers;
+  boost::shared_ptr<std::ofstream> outputStream (new std::ofstream ());
+  outputStream->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+
+  if (!outputStream->is_open ())
+    return boost::make_tuple (outputStream, tracers);
+
+  for (NodeList::Iterator node = NodeList::Begin ();
+       node != NodeList::End ();
+       node++)
+    {
+      NS_LOG_DEBUG ("Node: " << (*node)->GetId ());
+
+      Ptr<AppDelayAggregateTracer> trace = Create<AppDelayAggregateTracer> (outputStream, *node);
+      trace->SetAveragingPeriod (averagingPeriod);
+      tracers.push_back (trace);
+    }
+
+  if (tracers.size () > 0)
+    {
+      tracers.front ()->PrintHeader (*outputStream);
+      *outputStream << "\n";
+    }
+
+  return boost::make_tuple (outputStream, tracers);
+}
+
+AppDelayAggregateTracer::AppDelayAggregateTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr (node)
+  , m_os (os)
+{
+  m_node = boost::lexical_cast<string> (m_nodePtr->GetId ());
+
+  Connect ();
+
+  string name = Names::FindName (node);
+  if (!name.empty ())
+    {
+      m_node = name;
+    }
+
+  SetAveragingPeriod (Seconds (1.0));
+}
+
+AppDelayAggregateTracer::AppDelayAggregateTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
+  : m_node (node)
+  , m_os (os)
+{
+  Connect ();
+
+  SetAveragingPeriod (Seconds (1.0));
+}
+
+AppDelayAggregateTracer::~AppDelayAggregateTracer ()
+{
+  m_printEvent.Cancel ();
+}
+
+void
+AppDelayAggregateTracer::Connect ()
+{
+  Config::ConnectWithoutContext ("/NodeList/"+m_node+"/ApplicationList/*/LastRetransmittedInterestDataDelay",
+                                 MakeCallback (&AppDelayAggregateTracer::LastRetransmittedInterestDataDelay, this));
+
+  Config::ConnectWithoutContext ("/NodeList/"+m_node+"/ApplicationList/*/FirstInterestDataDelay",
+                                 MakeCallback (&AppDelayAggregateTracer::FirstInterestDataDelay, this));
+}
+
+void
+AppDelayAggregateTracer::SetAveragingPeriod (const Time &period)
+{
+  m_period = period;
+  m_printEvent.Cancel ();
+  m_printEvent = Simulator::Schedule (m_period, &AppDelayAggregateTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayAggregateTracer::PeriodicPrinter ()
+{
+  Print (*m_os);
+  Reset ();
+
+  m_printEvent = Simulator::Schedule (m_period, &AppDelayAggregateTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayAggregateTracer::Reset ()
+{
+  for (StatsMap::iterator stats = m_stats.begin ();
+       stats != m_stats.end ();
+       stats++)
+    {
+      stats->second.get<1> ().Merge (stats->second.get<0> ().m_delay);
+      stats->second.get<0> ().Reset ();
+    }
+}
+
+void
+AppDelayAggregateTracer::PrintHeader (std::ostream &os) const
+{
+  os << "Time" << "\t"
+     << "Node" << "\t"
+     << "AppId" << "\t"
+
+     << "Type" << "\t"
+     << "Samples" << "\t"
+     << "MeanUS" << "\t"
+     << "MinUS" << "\t"
+     << "P50US" << "\t"
+     << "P90US" << "\t"
+     << "P99US" << "\t"
+     << "MaxUS" << "\t"
+     << "RetxCount" << "\t"
+     << "HopCount" << "\t"
+     << "Histogram";
+}
+
+void
+AppDelayAggregateTracer::Print (std::ostream &os) const
+{
+  Time time = Simulator::Now ();
+
+  for (StatsMap::const_iterator stats = m_stats.begin ();
+       stats != m_stats.end ();
+       stats++)
+    {
+      const Stats &period = stats->second.get<0> ();
+      const DelayHistogram &delay = period.m_delay;
+      if (delay.GetCount () == 0)
+        continue;
+
+      os << time.ToDouble (Time::S) << "\t"
+         << m_node << "\t"
+         << stats->first.first << "\t"
+         << stats->first.second << "\t"
+         << delay.GetCount () << "\t"
+         << delay.GetMean () << "\t"
+         << delay.GetMin () << "\t"
+         << delay.GetQuantile (0.5) << "\t"
+         << delay.GetQuantile (0.9) << "\t"
+         << delay.GetQuantile (0.99) << "\t"
+         << delay.GetMax () << "\t"
+         << period.m_retxCount / delay.GetCount () << "\t"
+         << period.m_hopCount / delay.GetCount () << "\t"
+         << delay << "\n";
+    }
+}
+
+DelayHistogram
+AppDelayAggregateTracer::GetTotal (uint32_t appId, const std::string &type) const
+{
+  StatsMap::const_iterator stats = m_stats.find (std::make_pair (appId, type));
+  if (stats == m_stats.end ())
+    return DelayHistogram ();
+
+  DelayHistogram total = stats->second.get<1> ();
+  total.Merge (stats->second.get<0> ().m_delay);
+  return total;
+}
+
+void
+AppDelayAggregateTracer::LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount)
+{
+  boost::tuple<Stats, DelayHistogram> &stats = m_stats[std::make_pair (app->GetId (), std::string ("LastDelay"))];
+  stats.get<0> ().m_delay.Add (delay.GetMicroSeconds ());
+  stats.get<0> ().m_retxCount += 1;
+  stats.get<0> ().m_hopCount += hopCount;
+}
+
+void
+AppDelayAggregateTracer::FirstInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount)
+{
+  boost::tuple<Stats, DelayHistogram> &stats = m_stats[std::make_pair (app->GetId (), std::string ("FullDelay"))];
+  stats.get<0> ().m_delay.Add (delay.GetMicroSeconds ());
+  stats.get<0> ().m_retxCount += retxCount;
+  stats.get<0> ().m_hopCount += hopCount;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_APP_DELAY_AGGREGATE_TRACER_H
+#define NDN_APP_DELAY_AGGREGATE_TRACER_H
+
+#include "ndn-delay-histogram.h"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/shared_ptr.hpp>
+#include <map>
+#include <list>
+
+namespace ns3 {
+
+class Node;
+class Packet;
+
+namespace ndn {
+
+class App;
+
+/**
+ * @ingroup ndn
+ * @brief Application-level tracer for per-period Interest-Data delay statistics
+ *
+ * Unlike AppDelayTracer, which writes one line per received Data packet, this tracer
+ * keeps a DelayHistogram per application and delay type and writes one line per
+ * averaging period, containing sample count, mean, min, max, several percentiles and
+ * the serialized histogram itself.  The size of the trace file is therefore
+ * proportional to the number of periods, not the number of packets, and histograms
+ * from several periods, nodes, or replicated runs can be merged afterwards.
+ */
+class AppDelayAggregateTracer : public SimpleRefCount<AppDelayAggregateTracer>
+{
+public:
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * @param file File to which traces will be written
+   * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+   *
+   * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
+   *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
+   *
+   */
+  static boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<AppDelayAggregateTracer> > >
+  InstallAll (const std::string &file, Time averagingPeriod = Seconds (0.5));
+
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's pointer
+   * @param os    reference to the output stream
+   * @param node  pointer to the node
+   */
+  AppDelayAggregateTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's name
+   * @param os        reference to the output stream
+   * @param nodeName  name of the node registered using Names::Add
+   */
+  AppDelayAggregateTracer (boost::shared_ptr<std::ostream> os, const std::string &node);
+
+  /**
+   * @brief Destructor
+   */
+  ~AppDelayAggregateTracer ();
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader (std::ostream &os) const;
+
+  /**
+   * @brief Print current trace data
+   *
+   * @param os reference to output stream
+   */
+  void
+  Print (std::ostream &os) const;
+
+  /**
+   * @brief Get delay histogram (in microseconds) accumulated over the whole simulation
+   * @param appId  application id, local unique on the node
+   * @param type   "LastDelay" or "FullDelay"
+   */
+  DelayHistogram
+  GetTotal (uint32_t appId, const std::string &type) const;
+
+private:
+  void
+  Connect ();
+
+  void
+  LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
+
+  void
+  FirstInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount, int32_t hopCount);
+
+  void
+  SetAveragingPeriod (const Time &period);
+
+  void
+  PeriodicPrinter ();
+
+  void
+  Reset ();
+
+private:
+  std::string m_node;
+  Ptr<Node> m_nodePtr;
+
+  boost::shared_ptr<std::ostream> m_os;
+
+  Time m_period;
+  EventId m_printEvent;
+
+  struct Stats
+  {
+    Stats ()
+      : m_hopCount (0)
+      , m_retxCount (0)
+    {
+    }
+
+    inline void Reset ()
+    {
+      m_delay.Reset ();
+      m_hopCount = 0;
+      m_retxCount = 0;
+    }
+
+    DelayHistogram m_delay; ///< @brief delays in microseconds
+    double m_hopCount;      ///< @brief sum of hop counts
+    double m_retxCount;     ///< @brief sum of retransmission counts
+  };
+
+  typedef std::map<std::pair<uint32_t, std::string>, boost::tuple<Stats, DelayHistogram> > StatsMap;
+  StatsMap m_stats; ///< @brief (app id, type) -> (current period stats, total histogram)
+};
+
+/**
+ * @brief Helper to dump the trace to an output stream
+ */
+inline std::ostream&
+operator << (std::ostream &os, const AppDelayAggregateTracer &tracer)
+{
+  os << "# ";
+  tracer.PrintHeader (os);
+  os << "\n";
+  tracer.Print (os);
+  return os;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_APP_DELAY_AGGREGATE_TRACER_H
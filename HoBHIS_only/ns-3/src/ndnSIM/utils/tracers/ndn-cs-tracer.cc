@@ -113,10 +113,13 @@ CsTracer::~CsTracer ()
 void
 CsTracer::Connect ()
 {
-  Config::ConnectWithoutContext ("/NodeList/"+m_node+"/$ns3::ndn::ContentStore/CacheHits",
-                                 MakeCallback (&CsTracer::CacheHits, this));
-  Config::ConnectWithoutContext ("/NodeList/"+m_node+"/$ns3::ndn::ContentStore/CacheMisses",
-                                 MakeCallback (&CsTracer::CacheMisses, this));
+  vector<string> paths;
+  vector<CallbackBase> cbs;
+  paths.push_back ("/NodeList/"+m_node+"/$ns3::ndn::ContentStore/CacheHits");
+  cbs.push_back (MakeCallback (&CsTracer::CacheHits, this));
+  paths.push_back ("/NodeList/"+m_node+"/$ns3::ndn::ContentStore/CacheMisses");
+  cbs.push_back (MakeCallback (&CsTracer::CacheMisses, this));
+  Config::ConnectAllWithoutContext (paths, cbs);
 
   Reset ();  
 }
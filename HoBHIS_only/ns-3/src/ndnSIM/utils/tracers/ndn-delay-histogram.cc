@@ -0,0 +1,264 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-delay-histogram.h"
+
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t DelayHistogram::SubBucketBits;
+const uint32_t DelayHistogram::SubBucketCount;
+
+static inline uint32_t
+MostSignificantBit (uint64_t value)
+{
+  uint32_t msb = 0;
+  for (uint32_t shift = 32; shift > 0; shift >>= 1)
+    {
+      if (value >> shift)
+        {
+          value >>= shift;
+          msb += shift;
+        }
+    }
+  return msb;
+}
+
+DelayHistogram::DelayHistogram ()
+{
+  Reset ();
+}
+
+uint32_t
+DelayHistogram::GetBucketIndex (int64_t value)
+{
+  if (value < static_cast<int64_t> (SubBucketCount))
+    return value < 0 ? 0 : static_cast<uint32_t> (value);
+
+  uint32_t shift = MostSignificantBit (value) - SubBucketBits;
+  uint32_t mantissa = static_cast<uint32_t> (value >> shift); // in [SubBucketCount, 2*SubBucketCount)
+  return (shift + 1) * SubBucketCount + (mantissa - SubBucketCount);
+}
+
+int64_t
+DelayHistogram::GetBucketLowerBound (uint32_t index)
+{
+  if (index < SubBucketCount)
+    return index;
+
+  uint32_t shift = index / SubBucketCount - 1;
+  int64_t mantissa = index % SubBucketCount + SubBucketCount;
+  return mantissa << shift;
+}
+
+int64_t
+DelayHistogram::GetBucketUpperBound (uint32_t index)
+{
+  if (index < SubBucketCount)
+    return index;
+
+  uint32_t shift = index / SubBucketCount - 1;
+  return GetBucketLowerBound (index) + (static_cast<int64_t> (1) << shift) - 1;
+}
+
+void
+DelayHistogram::Add (int64_t value)
+{
+  if (value < 0)
+    value = 0;
+
+  uint32_t index = GetBucketIndex (value);
+  if (index >= m_buckets.size ())
+    m_buckets.resize (index + 1, 0);
+
+  m_buckets[index] ++;
+
+  if (m_count == 0 || value < m_min)
+    m_min = value;
+  if (m_count == 0 || value > m_max)
+    m_max = value;
+
+  m_count ++;
+  m_sum += value;
+}
+
+void
+DelayHistogram::Merge (const DelayHistogram &other)
+{
+  if (other.m_count == 0)
+    return;
+
+  if (other.m_buckets.size () > m_buckets.size ())
+    m_buckets.resize (other.m_buckets.size (), 0);
+
+  for (uint32_t i = 0; i < other.m_buckets.size (); i++)
+    m_buckets[i] += other.m_buckets[i];
+
+  if (m_count == 0 || other.m_min < m_min)
+    m_min = other.m_min;
+  if (m_count == 0 || other.m_max > m_max)
+    m_max = other.m_max;
+
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+}
+
+void
+DelayHistogram::Reset ()
+{
+  m_buckets.clear ();
+  m_count = 0;
+  m_sum = 0;
+  m_min = 0;
+  m_max = 0;
+}
+
+double
+DelayHistogram::GetMean () const
+{
+  if (m_count == 0)
+    return 0;
+
+  return m_sum / m_count;
+}
+
+int64_t
+DelayHistogram::GetQuantile (double quantile) const
+{
+  if (m_count == 0)
+    return 0;
+
+  if (quantile <= 0)
+    return m_min;
+  if (quantile >= 1.0)
+    return m_max;
+
+  uint64_t rank = static_cast<uint64_t> (std::ceil (quantile * m_count));
+  if (rank == 0)
+    rank = 1;
+
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < m_buckets.size (); i++)
+    {
+      seen += m_buckets[i];
+      if (seen >= rank)
+        {
+          int64_t estimate = GetBucketLowerBound (i) + (GetBucketUpperBound (i) - GetBucketLowerBound (i)) / 2;
+          if (estimate < m_min)
+            return m_min;
+          if (estimate > m_max)
+            return m_max;
+          return estimate;
+        }
+    }
+
+  return m_max;
+}
+
+void
+DelayHistogram::Serialize (std::ostream &os) const
+{
+  os << m_count << ";" << static_cast<int64_t> (m_sum) << ";" << GetMin () << ";" << GetMax () << ";";
+
+  bool first = true;
+  for (uint32_t i = 0; i < m_buckets.size (); i++)
+    {
+      if (m_buckets[i] == 0)
+        continue;
+
+      if (!first)
+        os << ",";
+      first = false;
+
+      os << i << ":" << m_buckets[i];
+    }
+}
+
+bool
+DelayHistogram::Deserialize (const std::string &str)
+{
+  Reset ();
+
+  std::istringstream is (str);
+  char separator = 0;
+  int64_t sum = 0;
+
+  is >> m_count >> separator;
+  if (!is || separator != ';')
+    {
+      Reset ();
+      return false;
+    }
+  is >> sum >> separator;
+  if (!is || separator != ';')
+    {
+      Reset ();
+      return false;
+    }
+  is >> m_min >> separator;
+  if (!is || separator != ';')
+    {
+      Reset ();
+      return false;
+    }
+  is >> m_max >> separator;
+  if (!is || separator != ';')
+    {
+      Reset ();
+      return false;
+    }
+  m_sum = sum;
+
+  uint64_t total = 0;
+  while (is.peek () != EOF)
+    {
+      uint32_t index = 0;
+      uint64_t count = 0;
+      is >> index >> separator >> count;
+      if (!is || separator != ':')
+        {
+          Reset ();
+          return false;
+        }
+
+      if (index >= m_buckets.size ())
+        m_buckets.resize (index + 1, 0);
+      m_buckets[index] += count;
+      total += count;
+
+      if (is.peek () == ',')
+        is.ignore ();
+    }
+
+  if (total != m_count)
+    {
+      Reset ();
+      return false;
+    }
+
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
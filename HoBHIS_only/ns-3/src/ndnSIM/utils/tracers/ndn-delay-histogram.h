@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_DELAY_HISTOGRAM_H
+#define NDN_DELAY_HISTOGRAM_H
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <iostream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Mergeable log-linear (HDR-style) histogram for non-negative integer samples
+ *
+ * Values below 2^SubBucketBits are counted exactly.  Larger values are grouped into
+ * buckets whose width never exceeds 1/2^SubBucketBits of the bucket's lower bound, so
+ * any quantile estimate has a bounded relative error (< 1.6%) regardless of the
+ * number of recorded samples.  Memory is proportional to the largest recorded value's
+ * magnitude, not to the number of samples.
+ *
+ * Two histograms can be combined with Merge (e.g., histograms of several nodes, or of
+ * the same node in several replicated runs).  The sparse textual form produced by
+ * Serialize can be read back with Deserialize, which makes it possible to merge
+ * sketches after the simulation is finished.
+ */
+class DelayHistogram
+{
+public:
+  static const uint32_t SubBucketBits = 6;
+  static const uint32_t SubBucketCount = 1 << SubBucketBits;
+
+  DelayHistogram ();
+
+  /**
+   * @brief Record one sample
+   */
+  void
+  Add (int64_t value);
+
+  /**
+   * @brief Add all samples recorded in other histogram
+   */
+  void
+  Merge (const DelayHistogram &other);
+
+  /**
+   * @brief Forget all recorded samples
+   */
+  void
+  Reset ();
+
+  inline uint64_t
+  GetCount () const
+  {
+    return m_count;
+  }
+
+  inline int64_t
+  GetMin () const
+  {
+    return m_count > 0 ? m_min : 0;
+  }
+
+  inline int64_t
+  GetMax () const
+  {
+    return m_count > 0 ? m_max : 0;
+  }
+
+  /**
+   * @brief Get mean of the recorded samples (exact, not estimated from buckets)
+   */
+  double
+  GetMean () const;
+
+  /**
+   * @brief Estimate value at the specified quantile
+   * @param quantile number in range [0, 1] (e.g., 0.99 for the 99th percentile)
+   *
+   * Estimate is the middle of the bucket containing the requested rank, clamped to
+   * the exact [min, max] of the recorded samples
+   */
+  int64_t
+  GetQuantile (double quantile) const;
+
+  /**
+   * @brief Write histogram in sparse textual form: count;sum;min;max;index:count,index:count,...
+   */
+  void
+  Serialize (std::ostream &os) const;
+
+  /**
+   * @brief Restore histogram from the form produced by Serialize
+   * @returns false if input cannot be parsed (histogram is left empty in this case)
+   */
+  bool
+  Deserialize (const std::string &str);
+
+  /**
+   * @brief Get index of the bucket that accounts for the value
+   */
+  static uint32_t
+  GetBucketIndex (int64_t value);
+
+  /**
+   * @brief Get smallest value that falls into the bucket
+   */
+  static int64_t
+  GetBucketLowerBound (uint32_t index);
+
+  /**
+   * @brief Get largest value that falls into the bucket
+   */
+  static int64_t
+  GetBucketUpperBound (uint32_t index);
+
+private:
+  std::vector<uint64_t> m_buckets;
+  uint64_t m_count;
+  double m_sum;
+  int64_t m_min;
+  int64_t m_max;
+};
+
+inline std::ostream &
+operator << (std::ostream &os, const DelayHistogram &histogram)
+{
+  histogram.Serialize (os);
+  return os;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DELAY_HISTOGRAM_H
@@ -64,27 +64,34 @@ L3Tracer::~L3Tracer ()
 void
 L3Tracer::Connect ()
 {
-  Config::Connect ("/NodeList/"+m_node+"/$ns3::ndn::ForwardingStrategy/OutInterests",
-                   MakeCallback (&L3Tracer::OutInterests, this));
-  Config::Connect ("/NodeList/"+m_node+"/$ns3::ndn::ForwardingStrategy/InInterests",
-                   MakeCallback (&L3Tracer::InInterests, this));
-  Config::Connect ("/NodeList/"+m_node+"/$ns3::ndn::ForwardingStrategy/DropInterests",
-                   MakeCallback (&L3Tracer::DropInterests, this));
-
-  Config::Connect ("/NodeList/"+m_node+"/$ns3::ndn::ForwardingStrategy/OutData",
-                   MakeCallback (&L3Tracer::OutData, this));
-  Config::Connect ("/NodeList/"+m_node+"/$ns3::ndn::ForwardingStrategy/InData",
-                   MakeCallback (&L3Tracer::InData, this));
-  Config::Connect ("/NodeList/"+m_node+"/$ns3::ndn::ForwardingStrategy/DropData",
-                   MakeCallback (&L3Tracer::DropData, this));
+  // all trace sources belong to the same object, which is looked up only once
+  const string prefix = "/NodeList/"+m_node+"/$ns3::ndn::ForwardingStrategy/";
+  vector<string> paths;
+  vector<CallbackBase> cbs;
+
+  paths.push_back (prefix+"OutInterests");
+  cbs.push_back (MakeCallback (&L3Tracer::OutInterests, this));
+  paths.push_back (prefix+"InInterests");
+  cbs.push_back (MakeCallback (&L3Tracer::InInterests, this));
+  paths.push_back (prefix+"DropInterests");
+  cbs.push_back (MakeCallback (&L3Tracer::DropInterests, this));
+
+  paths.push_back (prefix+"OutData");
+  cbs.push_back (MakeCallback (&L3Tracer::OutData, this));
+  paths.push_back (prefix+"InData");
+  cbs.push_back (MakeCallback (&L3Tracer::InData, this));
+  paths.push_back (prefix+"DropData");
+  cbs.push_back (MakeCallback (&L3Tracer::DropData, this));
 
   // only for some strategies
-  Config::Connect ("/NodeList/"+m_node+"/$ns3::ndn::ForwardingStrategy/OutNacks",
-                   MakeCallback (&L3Tracer::OutNacks, this));
-  Config::Connect ("/NodeList/"+m_node+"/$ns3::ndn::ForwardingStrategy/InNacks",
-                   MakeCallback (&L3Tracer::InNacks, this));
-  Config::Connect ("/NodeList/"+m_node+"/$ns3::ndn::ForwardingStrategy/DropNacks",
-                   MakeCallback (&L3Tracer::DropNacks, this));
+  paths.push_back (prefix+"OutNacks");
+  cbs.push_back (MakeCallback (&L3Tracer::OutNacks, this));
+  paths.push_back (prefix+"InNacks");
+  cbs.push_back (MakeCallback (&L3Tracer::InNacks, this));
+  paths.push_back (prefix+"DropNacks");
+  cbs.push_back (MakeCallback (&L3Tracer::DropNacks, this));
+
+  Config::ConnectAll (paths, cbs);
 }
 
 } // namespace ndn
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-profile-tracer.h"
+
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/log.h"
+
+#include <fstream>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ProfileTracer");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (ProfileTracer);
+
+TypeId
+ProfileTracer::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::ProfileTracer")
+    .SetGroupName ("Ndn")
+    .SetParent<Object> ()
+    .AddConstructor<ProfileTracer> ()
+    .AddAttribute ("Period", "How often snapshots of profiler statistics are taken",
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&ProfileTracer::m_period),
+                   MakeTimeChecker ())
+    .AddTraceSource ("Snapshot", "Profiler statistics collected during the last period",
+                     MakeTraceSourceAccessor (&ProfileTracer::m_snapshotTrace))
+    ;
+  return tid;
+}
+
+Ptr<ProfileTracer>
+ProfileTracer::Install (const std::string &file, Time period/* = Seconds (1.0)*/)
+{
+  Ptr<ProfileTracer> tracer = CreateObject<ProfileTracer> ();
+  tracer->SetAttribute ("Period", TimeValue (period));
+
+  if (!file.empty ())
+    {
+      boost::shared_ptr<std::ofstream> outputStream (new std::ofstream ());
+      outputStream->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      if (outputStream->is_open ())
+        {
+          tracer->SetStream (outputStream);
+        }
+    }
+
+  tracer->Start ();
+  return tracer;
+}
+
+ProfileTracer::ProfileTracer ()
+{
+}
+
+void
+ProfileTracer::Start ()
+{
+  Profiler::Enable ();
+
+  m_snapshotEvent.Cancel ();
+  m_snapshotEvent = Simulator::Schedule (m_period, &ProfileTracer::TakeSnapshot, this);
+}
+
+void
+ProfileTracer::SetStream (boost::shared_ptr<std::ostream> os)
+{
+  m_os = os;
+
+  PrintHeader (*m_os);
+  *m_os << "\n";
+}
+
+void
+ProfileTracer::DoDispose ()
+{
+  m_snapshotEvent.Cancel ();
+  m_os.reset ();
+  m_total.clear ();
+  m_snapshot.clear ();
+
+  Object::DoDispose ();
+}
+
+void
+ProfileTracer::TakeSnapshot ()
+{
+  m_snapshotTime = Simulator::Now ();
+  m_snapshot.clear ();
+
+  std::vector<ProfilerEntry> entries = Profiler::GetEntries ();
+  for (std::vector<ProfilerEntry>::const_iterator entry = entries.begin (); entry != entries.end (); entry++)
+    {
+      ProfilerEntry &total = m_total[std::make_pair (entry->context, entry->stage)];
+      if (entry->count < total.count)
+        {
+          total = ProfilerEntry (); // statistics were cleared
+        }
+
+      ProfilerEntry delta = *entry;
+      delta.count -= total.count;
+      delta.samples -= total.samples;
+      delta.cycles -= total.cycles;
+      total = *entry;
+
+      if (delta.count > 0)
+        {
+          m_snapshot.push_back (delta);
+        }
+    }
+
+  m_snapshotTrace (m_snapshotTime, m_snapshot);
+  if (m_os)
+    {
+      Print (*m_os);
+    }
+
+  m_snapshotEvent = Simulator::Schedule (m_period, &ProfileTracer::TakeSnapshot, this);
+}
+
+const std::vector<ProfilerEntry> &
+ProfileTracer::GetSnapshot () const
+{
+  return m_snapshot;
+}
+
+void
+ProfileTracer::PrintHeader (std::ostream &os) const
+{
+  os << "Time" << "\t"
+
+     << "Node" << "\t"
+
+     << "Stage" << "\t"
+     << "Count" << "\t"
+     << "Samples" << "\t"
+     << "AvgCycles" << "\t"
+     << "EstCycles";
+}
+
+void
+ProfileTracer::Print (std::ostream &os) const
+{
+  for (std::vector<ProfilerEntry>::const_iterator entry = m_snapshot.begin (); entry != m_snapshot.end (); entry++)
+    {
+      std::string node = "-"; // events without context
+      if (entry->context < NodeList::GetNNodes ())
+        {
+          Ptr<Node> nodePtr = NodeList::GetNode (entry->context);
+          node = Names::FindName (nodePtr);
+          if (node.empty ())
+            {
+              std::ostringstream id;
+              id << entry->context;
+              node = id.str ();
+            }
+        }
+
+      os << m_snapshotTime.ToDouble (Time::S) << "\t"
+         << node << "\t"
+         << entry->stage << "\t"
+         << entry->count << "\t"
+         << entry->samples << "\t"
+         << (entry->samples > 0 ? static_cast<double> (entry->cycles) / entry->samples : 0.0) << "\t"
+         << static_cast<uint64_t> (entry->GetEstimatedCycles ()) << "\n";
+    }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_PROFILE_TRACER_H
+#define NDN_PROFILE_TRACER_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+#include "ns3/profiler.h"
+
+#include <boost/shared_ptr.hpp>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Periodic per-node snapshots of the profiler statistics (see ns3::Profiler)
+ *
+ * Every period the tracer takes the difference of the profiler statistics since the previous
+ * snapshot and fires "Snapshot" trace source with it.  If installed with a file name, the
+ * snapshots are also written into the file (one line per node and stage).
+ */
+class ProfileTracer : public Object
+{
+public:
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * @brief Helper method to enable the profiler and install the tracer
+   *
+   * @param file File to which snapshots will be written (nothing is written if empty)
+   * @param period How often snapshots are taken
+   *
+   * @returns the tracer. !!! Attention !!! The tracer needs to be preserved for the lifetime of
+   *          simulation
+   */
+  static Ptr<ProfileTracer>
+  Install (const std::string &file, Time period = Seconds (1.0));
+
+  ProfileTracer ();
+
+  /**
+   * @brief Enable the profiler and schedule periodic snapshots
+   */
+  void
+  Start ();
+
+  /**
+   * @brief Set output stream for the snapshots
+   */
+  void
+  SetStream (boost::shared_ptr<std::ostream> os);
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   */
+  void
+  PrintHeader (std::ostream &os) const;
+
+  /**
+   * @brief Print the last snapshot
+   */
+  void
+  Print (std::ostream &os) const;
+
+  /**
+   * @brief Get the last snapshot (statistics collected during the last period)
+   */
+  const std::vector<ProfilerEntry> &
+  GetSnapshot () const;
+
+protected:
+  virtual void
+  DoDispose ();
+
+private:
+  void
+  TakeSnapshot ();
+
+private:
+  Time m_period;
+  EventId m_snapshotEvent;
+  Time m_snapshotTime;
+
+  boost::shared_ptr<std::ostream> m_os;
+
+  std::map<std::pair<uint32_t, std::string>, ProfilerEntry> m_total; ///< @brief statistics at the previous snapshot
+  std::vector<ProfilerEntry> m_snapshot;
+
+  TracedCallback<Time, const std::vector<ProfilerEntry> &> m_snapshotTrace;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PROFILE_TRACER_H
@@ -410,6 +410,21 @@ public:
   {
     return key_;
   }
+
+  /**
+   * @brief Get parent node of the trie (0 for the root node)
+   */
+  iterator
+  parent ()
+  {
+    return parent_;
+  }
+
+  const_iterator
+  parent () const
+  {
+    return parent_;
+  }
   
   inline void
   PrintStat (std::ostream &os) const;  
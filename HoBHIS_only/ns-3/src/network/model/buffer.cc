@@ -20,6 +20,7 @@
 #include "buffer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/thread-exit.h"
 
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
@@ -46,7 +47,7 @@ static struct Zeroes
 namespace ns3 {
 
 
-uint32_t Buffer::g_recommendedStart = 0;
+__thread uint32_t Buffer::g_recommendedStart __attribute__ ((tls_model ("initial-exec"))) = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -71,11 +72,19 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
+// free lists are per thread; the list of the main thread is released by the static
+// destructor, lists of other threads are released when they exit
+__thread uint32_t Buffer::g_maxSize __attribute__ ((tls_model ("initial-exec"))) = 0;
+__thread Buffer::FreeList *Buffer::g_freeList __attribute__ ((tls_model ("initial-exec"))) = 0;
 struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
+{
+  ReleaseFreeList ();
+}
+
+void
+Buffer::ReleaseFreeList (void)
 {
   if (IS_INITIALIZED (g_freeList))
     {
@@ -93,7 +102,12 @@ void
 Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_ASSERT (data->m_count == 0);
-  NS_ASSERT (!IS_UNINITIALIZED (g_freeList));
+  if (IS_UNINITIALIZED (g_freeList))
+    {
+      // buffer was created by another thread
+      g_freeList = new Buffer::FreeList ();
+      AtThreadExit (&Buffer::ReleaseFreeList);
+    }
   g_maxSize = std::max (g_maxSize, data->m_size);
   /* feed into free list */
   if (data->m_size < g_maxSize ||
@@ -116,6 +130,7 @@ Buffer::Create (uint32_t dataSize)
   if (IS_UNINITIALIZED (g_freeList))
     {
       g_freeList = new Buffer::FreeList ();
+      AtThreadExit (&Buffer::ReleaseFreeList);
     }
   else if (IS_INITIALIZED (g_freeList))
     {
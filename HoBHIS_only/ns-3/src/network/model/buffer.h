@@ -25,7 +25,7 @@
 #include <ostream>
 #include "ns3/assert.h"
 
-#define noBUFFER_FREE_LIST 1
+#define BUFFER_FREE_LIST 1
 
 namespace ns3 {
 
@@ -609,9 +609,9 @@ private:
   /**
    * location in a newly-allocated buffer where you should start
    * writing data. i.e., m_start should be initialized to this 
-   * value.
+   * value. (per thread, for parallel simulations)
    */
-  static uint32_t g_recommendedStart;
+  static __thread uint32_t g_recommendedStart;
 
   /* offset to the start of the virtual zero area from the start 
    * of m_data->m_data
@@ -636,8 +636,10 @@ private:
   {
     ~LocalStaticDestructor ();
   };
-  static uint32_t g_maxSize;
-  static FreeList *g_freeList;
+  /* release the free list of the current thread (at exit of the thread or the program) */
+  static void ReleaseFreeList (void);
+  static __thread uint32_t g_maxSize;
+  static __thread FreeList *g_freeList;
   static struct LocalStaticDestructor g_localStaticDestructor;
 #endif
 };
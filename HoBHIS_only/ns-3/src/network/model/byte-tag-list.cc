@@ -19,6 +19,7 @@
  */
 #include "byte-tag-list.h"
 #include "ns3/log.h"
+#include "ns3/thread-exit.h"
 #include <vector>
 #include <cstring>
 
@@ -38,22 +39,37 @@ struct ByteTagListData {
 };
 
 #ifdef USE_FREE_LIST
-static class ByteTagListDataFreeList : public std::vector<struct ByteTagListData *>
-{
-public:
-  ~ByteTagListDataFreeList ();
-} g_freeList;
-static uint32_t g_maxSize = 0;
+typedef std::vector<struct ByteTagListData *> ByteTagListDataFreeList;
+
+// free lists are per thread (for parallel simulations); the list of the main thread is
+// released by the static destructor, lists of other threads are released when they exit
+static __thread ByteTagListDataFreeList *g_freeList __attribute__ ((tls_model ("initial-exec"))) = 0;
+static __thread uint32_t g_maxSize __attribute__ ((tls_model ("initial-exec"))) = 0;
 
-ByteTagListDataFreeList::~ByteTagListDataFreeList ()
+static void
+ReleaseFreeList (void)
 {
-  for (ByteTagListDataFreeList::iterator i = begin ();
-       i != end (); i++)
+  if (g_freeList == 0)
+    {
+      return;
+    }
+  for (ByteTagListDataFreeList::iterator i = g_freeList->begin ();
+       i != g_freeList->end (); i++)
     {
       uint8_t *buffer = (uint8_t *)(*i);
       delete [] buffer;
     }
+  delete g_freeList;
+  g_freeList = 0;
 }
+
+static struct ByteTagListDataFreeListDestructor
+{
+  ~ByteTagListDataFreeListDestructor ()
+  {
+    ReleaseFreeList ();
+  }
+} g_freeListDestructor;
 #endif /* USE_FREE_LIST */
 
 ByteTagList::Iterator::Item::Item (TagBuffer buf_)
@@ -339,10 +355,10 @@ struct ByteTagListData *
 ByteTagList::Allocate (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
-  while (!g_freeList.empty ())
+  while (g_freeList != 0 && !g_freeList->empty ())
     {
-      struct ByteTagListData *data = g_freeList.back ();
-      g_freeList.pop_back ();
+      struct ByteTagListData *data = g_freeList->back ();
+      g_freeList->pop_back ();
       NS_ASSERT (data != 0);
       if (data->size >= size)
         {
@@ -353,7 +369,9 @@ ByteTagList::Allocate (uint32_t size)
       uint8_t *buffer = (uint8_t *)data;
       delete [] buffer;
     }
-  uint8_t *buffer = new uint8_t [std::max (size, g_maxSize) + sizeof (struct ByteTagListData) - 4];
+  // allocate as much as the largest recycled list, so the data can be reused for any list
+  size = std::max (size, g_maxSize);
+  uint8_t *buffer = new uint8_t [size + sizeof (struct ByteTagListData) - 4];
   struct ByteTagListData *data = (struct ByteTagListData *)buffer;
   data->count = 1;
   data->size = size;
@@ -373,7 +391,12 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
   data->count--;
   if (data->count == 0)
     {
-      if (g_freeList.size () > FREE_LIST_SIZE ||
+      if (g_freeList == 0)
+        {
+          g_freeList = new ByteTagListDataFreeList ();
+          AtThreadExit (&ReleaseFreeList);
+        }
+      if (g_freeList->size () > FREE_LIST_SIZE ||
           data->size < g_maxSize)
         {
           uint8_t *buffer = (uint8_t *)data;
@@ -381,7 +404,7 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
         }
       else
         {
-          g_freeList.push_back (data);
+          g_freeList->push_back (data);
         }
     }
 }
@@ -22,6 +22,7 @@
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/thread-exit.h"
 #include "packet-metadata.h"
 #include "buffer.h"
 #include "header.h"
@@ -34,17 +35,29 @@ namespace ns3 {
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
+__thread uint32_t PacketMetadata::m_maxSize __attribute__ ((tls_model ("initial-exec"))) = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+__thread PacketMetadata::DataFreeList *PacketMetadata::m_freeList __attribute__ ((tls_model ("initial-exec"))) = 0;
+struct PacketMetadata::LocalStaticDestructor PacketMetadata::m_localStaticDestructor;
 
-PacketMetadata::DataFreeList::~DataFreeList ()
+PacketMetadata::LocalStaticDestructor::~LocalStaticDestructor ()
 {
-  for (iterator i = begin (); i != end (); i++)
+  ReleaseFreeList ();
+  PacketMetadata::m_enable = false;
+}
+
+void
+PacketMetadata::ReleaseFreeList (void)
+{
+  if (m_freeList != 0)
     {
-      PacketMetadata::Deallocate (*i);
+      for (DataFreeList::iterator i = m_freeList->begin (); i != m_freeList->end (); i++)
+        {
+          PacketMetadata::Deallocate (*i);
+        }
+      delete m_freeList;
+      m_freeList = 0;
     }
-  PacketMetadata::m_enable = false;
 }
 
 void 
@@ -570,10 +583,10 @@ PacketMetadata::Create (uint32_t size)
     {
       m_maxSize = size;
     }
-  while (!m_freeList.empty ()) 
+  while (m_freeList != 0 && !m_freeList->empty ())
     {
-      struct PacketMetadata::Data *data = m_freeList.back ();
-      m_freeList.pop_back ();
+      struct PacketMetadata::Data *data = m_freeList->back ();
+      m_freeList->pop_back ();
       if (data->m_size >= size) 
         {
           NS_LOG_LOGIC ("create found size="<<data->m_size);
@@ -595,16 +608,21 @@ PacketMetadata::Recycle (struct PacketMetadata::Data *data)
       PacketMetadata::Deallocate (data);
       return;
     } 
-  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList.size ());
+  if (m_freeList == 0)
+    {
+      m_freeList = new DataFreeList ();
+      AtThreadExit (&PacketMetadata::ReleaseFreeList);
+    }
+  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList->size ());
   NS_ASSERT (data->m_count == 0);
-  if (m_freeList.size () > 1000 ||
+  if (m_freeList->size () > 1000 ||
       data->m_size < m_maxSize) 
     {
       PacketMetadata::Deallocate (data);
     } 
   else 
     {
-      m_freeList.push_back (data);
+      m_freeList->push_back (data);
     }
 }
 
@@ -632,6 +650,15 @@ PacketMetadata::Deallocate (struct PacketMetadata::Data *data)
 }
 
 
+PacketMetadata
+PacketMetadata::CreateFullCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  PacketMetadata copy = *this;
+  copy.ReserveCopy (0);
+  return copy;
+}
+
 PacketMetadata 
 PacketMetadata::CreateFragment (uint32_t start, uint32_t end) const
 {
@@ -147,6 +147,11 @@ private:
    * and then, RemoveAtEnd (end).
    */
   PacketMetadata CreateFragment (uint32_t start, uint32_t end) const;
+  /**
+   * \returns a copy of this metadata which does not share its internal
+   * buffer with this metadata.
+   */
+  PacketMetadata CreateFullCopy (void) const;
   void AddAtEnd (PacketMetadata const&o);
   void AddPaddingAtEnd (uint32_t end);
   void RemoveAtStart (uint32_t start);
@@ -292,13 +297,16 @@ private:
     uint64_t packetUid;
   };
 
-  class DataFreeList : public std::vector<struct Data *>
+  typedef std::vector<struct Data *> DataFreeList;
+  // releases the free list of the main thread
+  struct LocalStaticDestructor
   {
-public:
-    ~DataFreeList ();
+    ~LocalStaticDestructor ();
   };
+  // releases the free list of the current thread
+  static void ReleaseFreeList (void);
 
-  friend DataFreeList::~DataFreeList ();
+  friend struct LocalStaticDestructor;
   friend class ItemIterator;
 
   PacketMetadata ();
@@ -335,7 +343,9 @@ public:
   static struct PacketMetadata::Data *Allocate (uint32_t n);
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList;
+  // free lists are per thread (for parallel simulations)
+  static __thread DataFreeList *m_freeList;
+  static struct LocalStaticDestructor m_localStaticDestructor;
   static bool m_enable;
   static bool m_enableChecking;
 
@@ -344,7 +354,7 @@ public:
   // middle of a simulation, which isn't allowed.
   static bool m_metadataSkipped;
 
-  static uint32_t m_maxSize;
+  static __thread uint32_t m_maxSize;
   static uint16_t m_chunkUid;
 
   struct Data *m_data;
@@ -22,16 +22,45 @@
 #include "tag.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/thread-exit.h"
 #include <cstring>
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
+#define USE_FREE_LIST 1
+#define FREE_LIST_SIZE 1000
+
 namespace ns3 {
 
 #ifdef USE_FREE_LIST
 
-struct PacketTagList::TagData *PacketTagList::g_free = 0;
-uint32_t PacketTagList::g_nfree = 0;
+// free lists are per thread (for parallel simulations); the list of the main thread is
+// released by the static destructor, lists of other threads are released when they exit
+static __thread struct PacketTagList::TagData *g_free __attribute__ ((tls_model ("initial-exec"))) = 0;
+static __thread uint32_t g_nfree __attribute__ ((tls_model ("initial-exec"))) = 0;
+static __thread bool g_freeListAtExit __attribute__ ((tls_model ("initial-exec"))) = false;
+static bool g_freeListDestroyed = false;
+
+static void
+ReleaseFreeList (void)
+{
+  while (g_free != 0)
+    {
+      struct PacketTagList::TagData *next = g_free->next;
+      delete g_free;
+      g_free = next;
+    }
+  g_nfree = 0;
+}
+
+static struct PacketTagListFreeListDestructor
+{
+  ~PacketTagListFreeListDestructor ()
+  {
+    ReleaseFreeList ();
+    g_freeListDestroyed = true;
+  }
+} g_freeListDestructor;
 
 struct PacketTagList::TagData *
 PacketTagList::AllocData (void) const
@@ -41,7 +70,7 @@ PacketTagList::AllocData (void) const
   if (g_free != 0) 
     {
       retval = g_free;
-      g_free = g_free->m_next;
+      g_free = g_free->next;
       g_nfree--;
     } 
   else 
@@ -55,14 +84,18 @@ void
 PacketTagList::FreeData (struct TagData *data) const
 {
   NS_LOG_FUNCTION (g_nfree << data);
-  if (g_nfree > 1000) 
+  if (g_nfree > FREE_LIST_SIZE || g_freeListDestroyed) 
     {
       delete data;
       return;
     }
+  if (!g_freeListAtExit)
+    {
+      g_freeListAtExit = true;
+      AtThreadExit (&ReleaseFreeList);
+    }
   g_nfree++;
   data->next = g_free;
-  data->tid = TypeId ();
   g_free = data;
 }
 #else
@@ -167,6 +200,25 @@ PacketTagList::Peek (Tag &tag) const
   return false;
 }
 
+PacketTagList
+PacketTagList::CreateFullCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  PacketTagList copy;
+  struct TagData **prevNext = &copy.m_next;
+  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+    {
+      struct TagData *data = AllocData ();
+      data->tid = cur->tid;
+      data->count = 1;
+      data->next = 0;
+      std::memcpy (data->data, cur->data, PACKET_TAG_MAX_SIZE);
+      *prevNext = data;
+      prevNext = &data->next;
+    }
+  return copy;
+}
+
 const struct PacketTagList::TagData *
 PacketTagList::Head (void) const
 {
@@ -55,6 +55,10 @@ public:
   bool Remove (Tag &tag);
   bool Peek (Tag &tag) const;
   inline void RemoveAll (void);
+  /**
+   * \returns a copy of this list which does not share any tag data with this list
+   */
+  PacketTagList CreateFullCopy (void) const;
 
   const struct PacketTagList::TagData *Head (void) const;
 
@@ -64,9 +68,6 @@ private:
   struct PacketTagList::TagData *AllocData (void) const;
   void FreeData (struct TagData *data) const;
 
-  static struct PacketTagList::TagData *g_free;
-  static uint32_t g_nfree;
-
   struct TagData *m_next;
 };
 
@@ -21,8 +21,10 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/thread-exit.h"
 #include <string>
 #include <cstdarg>
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("Packet");
 
@@ -30,6 +32,83 @@ namespace ns3 {
 
 uint32_t Packet::m_globalUid = 0;
 
+#define PACKET_FREE_LIST_SIZE 1000
+
+namespace {
+
+struct FreePacket
+{
+  FreePacket *next;
+};
+
+// free lists are per thread (for parallel simulations); the list of the main thread is
+// released by the static destructor, lists of other threads are released when they exit
+__thread FreePacket *g_freePackets __attribute__ ((tls_model ("initial-exec"))) = 0;
+__thread uint32_t g_nFreePackets __attribute__ ((tls_model ("initial-exec"))) = 0;
+__thread bool g_freePacketsAtExit __attribute__ ((tls_model ("initial-exec"))) = false;
+bool g_freePacketsDestroyed = false;
+
+void
+ReleaseFreePackets (void)
+{
+  while (g_freePackets != 0)
+    {
+      FreePacket *next = g_freePackets->next;
+      ::operator delete (g_freePackets);
+      g_freePackets = next;
+    }
+  g_nFreePackets = 0;
+}
+
+struct PacketFreeListDestructor
+{
+  ~PacketFreeListDestructor ()
+  {
+    ReleaseFreePackets ();
+    g_freePacketsDestroyed = true;
+  }
+} g_packetFreeListDestructor;
+
+} // anonymous namespace
+
+void *
+Packet::operator new (size_t size)
+{
+  if (size != sizeof (Packet) || g_freePackets == 0)
+    {
+      return ::operator new (size);
+    }
+
+  FreePacket *packet = g_freePackets;
+  g_freePackets = packet->next;
+  g_nFreePackets--;
+  return packet;
+}
+
+void
+Packet::operator delete (void *p, size_t size)
+{
+  if (p == 0)
+    return;
+
+  if (size != sizeof (Packet) || g_nFreePackets >= PACKET_FREE_LIST_SIZE || g_freePacketsDestroyed)
+    {
+      ::operator delete (p);
+      return;
+    }
+
+  if (!g_freePacketsAtExit)
+    {
+      g_freePacketsAtExit = true;
+      AtThreadExit (&ReleaseFreePackets);
+    }
+
+  FreePacket *packet = static_cast<FreePacket *> (p);
+  packet->next = g_freePackets;
+  g_freePackets = packet;
+  g_nFreePackets++;
+}
+
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
 {
@@ -125,6 +204,12 @@ Packet::Copy (void) const
   return Ptr<Packet> (new Packet (*this), false);
 }
 
+uint32_t
+Packet::AllocateUid (void)
+{
+  return __sync_fetch_and_add (&m_globalUid, 1);
+}
+
 Packet::Packet ()
   : m_buffer (),
     m_byteTagList (),
@@ -135,10 +220,9 @@ Packet::Packet ()
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, 0),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | AllocateUid (), 0),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 
 Packet::Packet (const Packet &o)
@@ -177,10 +261,9 @@ Packet::Packet (uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | AllocateUid (), size),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
   : m_buffer (0, false),
@@ -203,10 +286,9 @@ Packet::Packet (uint8_t const*buffer, uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | AllocateUid (), size),
     m_nixVector (0)
 {
-  m_globalUid++;
   m_buffer.AddAtStart (size);
   Buffer::Iterator i = m_buffer.Begin ();
   i.Write (buffer, size);
@@ -222,6 +304,24 @@ Packet::Packet (const Buffer &buffer,  const ByteTagList &byteTagList,
 {
 }
 
+Ptr<Packet>
+Packet::CreateFullCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  Buffer buffer;
+  buffer.AddAtStart (m_buffer.GetSize ());
+  buffer.Begin ().Write (m_buffer.Begin (), m_buffer.End ());
+  ByteTagList byteTagList;
+  byteTagList.Add (m_byteTagList);
+  Ptr<Packet> copy = Ptr<Packet> (new Packet (buffer, byteTagList, m_packetTagList.CreateFullCopy (),
+                                              m_metadata.CreateFullCopy ()), false);
+  if (m_nixVector != 0)
+    {
+      copy->m_nixVector = m_nixVector->Copy ();
+    }
+  return copy;
+}
+
 Ptr<Packet>
 Packet::CreateFragment (uint32_t start, uint32_t length) const
 {
@@ -278,6 +378,16 @@ Packet::PeekHeader (Header &header) const
   NS_LOG_FUNCTION (this << header.GetInstanceTypeId ().GetName () << deserialized);
   return deserialized;
 }
+uint32_t
+Packet::PeekHeader (Header &header, uint32_t offset) const
+{
+  NS_ASSERT (offset <= m_buffer.GetSize ());
+  Buffer::Iterator start = m_buffer.Begin ();
+  start.Next (offset);
+  uint32_t deserialized = header.Deserialize (start);
+  NS_LOG_FUNCTION (this << header.GetInstanceTypeId ().GetName () << offset << deserialized);
+  return deserialized;
+}
 void
 Packet::AddTrailer (const Trailer &trailer)
 {
@@ -381,6 +491,19 @@ Packet::CopyData (uint8_t *buffer, uint32_t size) const
   return m_buffer.CopyData (buffer, size);
 }
 
+uint32_t
+Packet::CopyData (uint8_t *buffer, uint32_t size, uint32_t offset) const
+{
+  if (offset >= m_buffer.GetSize ())
+    return 0;
+
+  size = std::min (size, m_buffer.GetSize () - offset);
+  Buffer::Iterator start = m_buffer.Begin ();
+  start.Next (offset);
+  start.Read (buffer, size);
+  return size;
+}
+
 void
 Packet::CopyData (std::ostream *os, uint32_t size) const
 {
@@ -211,6 +211,16 @@ public:
   Packet ();
   Packet (const Packet &o);
   Packet &operator = (const Packet &o);
+
+  /**
+   * \brief Allocate memory for the packet from the (per-thread) pool of the released packets
+   */
+  static void *operator new (size_t size);
+  /**
+   * \brief Return memory of the packet to the (per-thread) pool
+   */
+  static void operator delete (void *p, size_t size);
+
   /**
    * Create a packet with a zero-filled payload.
    * The memory necessary for the payload is not allocated:
@@ -281,6 +291,16 @@ public:
    * \returns the number of bytes read from the packet.
    */
   uint32_t PeekHeader (Header &header) const;
+  /**
+   * Deserialize the header which starts \a offset bytes into the packet (e.g., the
+   * network-layer header after a link-layer header).  Neither the packet, nor its
+   * buffer is modified, so the call never results in a copy of the shared buffer.
+   *
+   * \param header a reference to the header to read from the internal buffer.
+   * \param offset offset (in bytes) of the header from the start of the packet
+   * \returns the number of bytes read from the packet.
+   */
+  uint32_t PeekHeader (Header &header, uint32_t offset) const;
   /**
    * Add trailer to this packet. This method invokes the
    * Trailer::GetSerializedSize and Trailer::Serialize
@@ -357,6 +377,17 @@ public:
    */
   uint32_t CopyData (uint8_t *buffer, uint32_t size) const;
 
+  /**
+   * \param buffer a pointer to a byte buffer where the packet data
+   *        should be copied.
+   * \param size the size of the byte buffer.
+   * \param offset offset (in bytes) from the start of the packet
+   * \returns the number of bytes read from the packet
+   *
+   * No more than \b size bytes, starting from \b offset, will be copied by this function.
+   */
+  uint32_t CopyData (uint8_t *buffer, uint32_t size, uint32_t offset) const;
+
   /**
    * \param os pointer to output stream in which we want
    *        to write the packet data.
@@ -374,6 +405,17 @@ public:
    */
   Ptr<Packet> Copy (void) const;
 
+  /**
+   * \returns a deep copy of the packet.
+   *
+   * Unlike Copy, the returned packet does not share any internal
+   * data (buffer, tags, metadata) with the original packet, so the
+   * two packets can be safely used from different threads (e.g., when
+   * a packet crosses partitions of a multithreaded simulation).  The
+   * copy has the same uid as the original packet.
+   */
+  Ptr<Packet> CreateFullCopy (void) const;
+
   /**
    * A packet is allocated a new uid when it is created
    * empty or with zero-filled payload.
@@ -567,6 +609,11 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector;
 
+  /**
+   * \brief Get the next packet uid (packets can be created from several threads)
+   */
+  static uint32_t AllocateUid (void);
+
   static uint32_t m_globalUid;
 };
 
@@ -24,6 +24,7 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/mtp-interface.h"
 
 NS_LOG_COMPONENT_DEFINE ("PointToPointChannel");
 
@@ -122,8 +123,22 @@ PointToPointChannel::TransmitStart (
     }
   //   }
   // continue normal operations
-  
-  Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode ()->GetId (),
+
+  // node of the destination may be processed by another thread, so its reference count is not touched
+  uint32_t dstNode = PeekPointer (m_link[wire].m_dst->m_node)->GetId ();
+
+  if (MtpInterface::IsEnabled () &&
+      MtpInterface::GetPartition (dstNode) != MtpInterface::GetPartition (PeekPointer (src->m_node)->GetId ()))
+    {
+      // the destination belongs to another partition of the multithreaded simulator: pass
+      // a deep copy of the packet, as packets share data without locking
+      Simulator::ScheduleWithContext (dstNode,
+                                      txTime + m_delay, &PointToPointNetDevice::Receive,
+                                      PeekPointer (m_link[wire].m_dst), p->CreateFullCopy ());
+      return true;
+    }
+
+  Simulator::ScheduleWithContext (dstNode,
                                   txTime + m_delay, &PointToPointNetDevice::Receive,
                                   m_link[wire].m_dst, p);
 
@@ -142,6 +142,9 @@ private:
    * net device, receiving net device, transmission time and 
    * packet receipt time.
    *
+   * The trace is not fired for packets passed to another partition of
+   * the multithreaded simulator (see MultithreadedSimulatorImpl).
+   *
    * @see class CallBackTraceSource
    */
   TracedCallback<uint32_t,          // channel ID
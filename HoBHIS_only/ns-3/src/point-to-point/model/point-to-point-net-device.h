@@ -189,6 +189,8 @@ protected:
   void DoMpiReceive (Ptr<Packet> p);
 
 private:
+  // the channel reads m_node of the destination device, which can belong to another thread
+  friend class PointToPointChannel;
 
   PointToPointNetDevice& operator = (const PointToPointNetDevice &);
   PointToPointNetDevice (const PointToPointNetDevice &);
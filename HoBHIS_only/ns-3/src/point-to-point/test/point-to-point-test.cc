@@ -3,6 +3,13 @@
 #include "ns3/simulator.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/global-value.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/mtp-interface.h"
 
 using namespace ns3;
 
@@ -13,6 +20,8 @@ public:
 
   virtual void DoRun (void);
 
+  static void SendOnePacketOn (Ptr<NetDevice> device, uint32_t size);
+
 private:
   void SendOnePacket (Ptr<PointToPointNetDevice> device);
 };
@@ -29,6 +38,12 @@ PointToPointTest::SendOnePacket (Ptr<PointToPointNetDevice> device)
   device->Send (p, device->GetBroadcast (), 0x800);
 }
 
+void
+PointToPointTest::SendOnePacketOn (Ptr<NetDevice> device, uint32_t size)
+{
+  device->Send (Create<Packet> (size), device->GetBroadcast (), 0x800);
+}
+
 
 void
 PointToPointTest::DoRun (void)
@@ -55,6 +70,244 @@ PointToPointTest::DoRun (void)
 
   Simulator::Destroy ();
 }
+//-----------------------------------------------------------------------------
+/**
+ * \brief Check that a chain of point-to-point links, where every node relays packets to
+ * the next node, produces the same receive times when nodes are simulated by several
+ * threads (links of the chain are cut between partitions)
+ */
+class PointToPointMultithreadedTest : public TestCase
+{
+public:
+  PointToPointMultithreadedTest ();
+
+  virtual void DoRun (void);
+
+private:
+  void RunChain (const std::string &implementation, std::vector<std::vector<Time> > &received);
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+
+  // every node records only its own receptions, so no locking is necessary
+  std::vector<std::vector<Time> > *m_received;
+  uint32_t m_partitions;
+};
+
+PointToPointMultithreadedTest::PointToPointMultithreadedTest ()
+  : TestCase ("PointToPoint chain with multithreaded simulator")
+  , m_received (0)
+  , m_partitions (0)
+{
+}
+
+bool
+PointToPointMultithreadedTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                        uint16_t protocol, const Address &from)
+{
+  Ptr<Node> node = device->GetNode ();
+  (*m_received)[node->GetId ()].push_back (Simulator::Now ());
+
+  // relay packet further along the chain (end nodes have only one device)
+  for (uint32_t i = 0; i < node->GetNDevices (); i++)
+    {
+      Ptr<NetDevice> next = node->GetDevice (i);
+      if (next != device)
+        {
+          next->Send (packet->Copy (), next->GetBroadcast (), protocol);
+        }
+    }
+  return true;
+}
+
+void
+PointToPointMultithreadedTest::RunChain (const std::string &implementation,
+                                         std::vector<std::vector<Time> > &received)
+{
+  const uint32_t size = 8;
+
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue (implementation));
+
+  NodeContainer nodes;
+  nodes.Create (size);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  for (uint32_t i = 0; i + 1 < size; i++)
+    {
+      p2p.Install (nodes.Get (i), nodes.Get (i + 1));
+    }
+
+  for (uint32_t i = 0; i < size; i++)
+    {
+      Ptr<Node> node = nodes.Get (i);
+      for (uint32_t j = 0; j < node->GetNDevices (); j++)
+        {
+          node->GetDevice (j)->SetReceiveCallback (MakeCallback (&PointToPointMultithreadedTest::Receive, this));
+        }
+    }
+
+  // packets from both ends of the chain, sent faster than a link can transmit them
+  Ptr<NetDevice> first = nodes.Get (0)->GetDevice (0);
+  Ptr<NetDevice> last = nodes.Get (size - 1)->GetDevice (0);
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      Simulator::ScheduleWithContext (0, MicroSeconds (500 * i),
+                                      &PointToPointTest::SendOnePacketOn, first, 1000);
+      Simulator::ScheduleWithContext (size - 1, MicroSeconds (700 * i),
+                                      &PointToPointTest::SendOnePacketOn, last, 500);
+    }
+
+  received.assign (size, std::vector<Time> ());
+  m_received = &received;
+
+  Simulator::Run ();
+  m_partitions = MtpInterface::IsEnabled () ? MtpInterface::GetSize () : 1;
+  Simulator::Destroy ();
+
+  m_received = 0;
+}
+
+void
+PointToPointMultithreadedTest::DoRun (void)
+{
+  std::vector<std::vector<Time> > sequential;
+  RunChain ("ns3::DefaultSimulatorImpl", sequential);
+
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (4));
+  std::vector<std::vector<Time> > parallel;
+  RunChain ("ns3::MultithreadedSimulatorImpl", parallel);
+  NS_TEST_EXPECT_MSG_EQ (m_partitions, 4, "Chain should be split into 4 partitions");
+
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+
+  NS_TEST_ASSERT_MSG_EQ (parallel.size (), sequential.size (), "Different number of nodes");
+  for (uint32_t i = 0; i < sequential.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_GT (sequential[i].size (), 0, "Node " << i << " has not received any packets");
+      NS_TEST_ASSERT_MSG_EQ (parallel[i].size (), sequential[i].size (), "Node " << i << " received different number of packets");
+      for (uint32_t j = 0; j < sequential[i].size (); j++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (parallel[i][j], sequential[i][j], "Node " << i << " received packet " << j << " at different time");
+        }
+    }
+}
+/**
+ * Checks that Simulator::Stop called from an event of a node stops the multithreaded
+ * simulator at the same point for any number of threads
+ */
+class PointToPointMultithreadedStopTest : public TestCase
+{
+public:
+  PointToPointMultithreadedStopTest ();
+
+  virtual void DoRun (void);
+
+private:
+  void RunChain (uint32_t threads, std::vector<std::vector<Time> > &events);
+  void Tick (Ptr<Node> node);
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+
+  // every node records only its own events, so no locking is necessary
+  std::vector<std::vector<Time> > *m_events;
+};
+
+PointToPointMultithreadedStopTest::PointToPointMultithreadedStopTest ()
+  : TestCase ("Simulator::Stop from a node event with multithreaded simulator")
+  , m_events (0)
+{
+}
+
+void
+PointToPointMultithreadedStopTest::Tick (Ptr<Node> node)
+{
+  (*m_events)[node->GetId ()].push_back (Simulator::Now ());
+  if (node->GetId () == 3 && Simulator::Now () == MilliSeconds (50))
+    {
+      Simulator::Stop ();
+    }
+
+  Ptr<NetDevice> device = node->GetDevice (0);
+  device->Send (Create<Packet> (1000), device->GetBroadcast (), 0x800);
+  Simulator::Schedule (MilliSeconds (10), &PointToPointMultithreadedStopTest::Tick, this, node);
+}
+
+bool
+PointToPointMultithreadedStopTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                            uint16_t protocol, const Address &from)
+{
+  (*m_events)[device->GetNode ()->GetId ()].push_back (Simulator::Now ());
+  return true;
+}
+
+void
+PointToPointMultithreadedStopTest::RunChain (uint32_t threads, std::vector<std::vector<Time> > &events)
+{
+  const uint32_t size = 8;
+
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::MultithreadedSimulatorImpl"));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (threads));
+
+  NodeContainer nodes;
+  nodes.Create (size);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  for (uint32_t i = 0; i + 1 < size; i++)
+    {
+      p2p.Install (nodes.Get (i), nodes.Get (i + 1));
+    }
+
+  for (uint32_t i = 0; i < size; i++)
+    {
+      Ptr<Node> node = nodes.Get (i);
+      for (uint32_t j = 0; j < node->GetNDevices (); j++)
+        {
+          node->GetDevice (j)->SetReceiveCallback (MakeCallback (&PointToPointMultithreadedStopTest::Receive, this));
+        }
+      Simulator::ScheduleWithContext (i, Seconds (0), &PointToPointMultithreadedStopTest::Tick, this, node);
+    }
+
+  events.assign (size, std::vector<Time> ());
+  m_events = &events;
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  m_events = 0;
+}
+
+void
+PointToPointMultithreadedStopTest::DoRun (void)
+{
+  // ticks of all nodes at 50ms are processed, packets sent at 50ms are not received
+  std::vector<std::vector<Time> > reference;
+  RunChain (1, reference);
+  for (uint32_t i = 0; i < reference.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (reference[i].empty (), false, "Node " << i << " has no events");
+      NS_TEST_EXPECT_MSG_EQ (reference[i].back (), MilliSeconds (50), "Node " << i << " was not stopped after the tick at 50ms");
+    }
+
+  uint32_t threads[] = { 2, 4, 8 };
+  for (uint32_t t = 0; t < sizeof (threads) / sizeof (threads[0]); t++)
+    {
+      std::vector<std::vector<Time> > events;
+      RunChain (threads[t], events);
+      for (uint32_t i = 0; i < reference.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (events[i].size (), reference[i].size (),
+                                 "Node " << i << " processed different number of events with " << threads[t] << " threads");
+          for (uint32_t j = 0; j < reference[i].size (); j++)
+            {
+              NS_TEST_EXPECT_MSG_EQ (events[i][j], reference[i][j], "Node " << i << " event " << j << " at different time");
+            }
+        }
+    }
+
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+}
+
 //-----------------------------------------------------------------------------
 class PointToPointTestSuite : public TestSuite
 {
@@ -66,6 +319,13 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest);
+
+  TypeId tid;
+  if (TypeId::LookupByNameFailSafe ("ns3::MultithreadedSimulatorImpl", &tid)) // needs threading support
+    {
+      AddTestCase (new PointToPointMultithreadedTest);
+      AddTestCase (new PointToPointMultithreadedStopTest);
+    }
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite;
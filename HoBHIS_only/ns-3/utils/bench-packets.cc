@@ -241,6 +241,47 @@ benchC (uint32_t n)
   }
 }
 
+// ndnSIM-like forwarding of a Data packet over several hops: the packet is copied on
+// every hop, link header is added and removed, NDN header is peeked by queue and by the
+// forwarding layer, and payload is stripped for the content store
+static void
+benchE (uint32_t n)
+{
+  BenchHeader<40> ndn;
+  BenchHeader<2> ppp;
+  BenchTag<4> hopCount;
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (1024);
+    p->AddHeader (ndn);
+    p->AddPacketTag (hopCount);
+
+    for (uint32_t hop = 0; hop < 4; hop++) {
+      // face: send a copy through the net device
+      Ptr<Packet> tx = p->Copy ();
+      tx->RemovePacketTag (hopCount);
+      tx->AddPacketTag (hopCount);
+      tx->AddHeader (ppp);
+
+      // queue: classify the packet
+      uint32_t offset = tx->PeekHeader (ppp);
+      tx->PeekHeader (ndn, offset);
+
+      // net device: remove link header
+      tx->RemoveHeader (ppp);
+
+      // forwarding: read the header of the received packet
+      Ptr<const Packet> rx = tx;
+      rx->PeekHeader (ndn);
+
+      // content store: keep the payload
+      Ptr<Packet> payload = rx->Copy ();
+      payload->RemoveHeader (ndn);
+
+      p = tx;
+    }
+  }
+}
 
 static void
 runBench (void (*bench) (uint32_t), uint32_t n, char const *name)
@@ -285,6 +326,7 @@ int main (int argc, char *argv[])
   runBench (&benchB, n, "b");
   runBench (&benchC, n, "c");
   runBench (&benchD, n, "d");
+  runBench (&benchE, n, "e");
 
   return 0;
 }
@@ -35,18 +35,27 @@ public:
   Bench ();
   void ReadDistribution (std::istream &istream);
   void SetTotal (uint32_t total);
+  void SetTimers (uint32_t timers);
   void RunBench (void);
 private:
   void Cb (void);
+  void Timer (void);
   std::vector<uint64_t> m_distribution;
   std::vector<uint64_t>::const_iterator m_current;
   uint32_t m_n;
   uint32_t m_total;
+  // pending timers which are rescheduled (removed and inserted again) by every event,
+  // like PIT cleaning and retransmission timers in NDN simulations
+  std::vector<EventId> m_timers;
+  uint32_t m_removed;
+  bool m_timersRemoved;
 };
 
 Bench::Bench ()
   : m_n (0),
-    m_total (0)
+    m_total (0),
+    m_removed (0),
+    m_timersRemoved (false)
 {}
 
 void 
@@ -55,6 +64,17 @@ Bench::SetTotal (uint32_t total)
   m_total = total;
 }
 
+void
+Bench::SetTimers (uint32_t timers)
+{
+  m_timers.resize (timers);
+}
+
+void
+Bench::Timer (void)
+{
+}
+
 void
 Bench::ReadDistribution (std::istream &input)
 {
@@ -86,10 +106,18 @@ Bench::RunBench (void)
     {
       Simulator::Schedule (NanoSeconds (*i), &Bench::Cb, this);
     }
+  for (uint32_t i = 0; i < m_timers.size (); i++)
+    {
+      m_timers[i] = Simulator::Schedule (Seconds (1000) + NanoSeconds (m_distribution[i % m_distribution.size ()]),
+                                         &Bench::Timer, this);
+    }
   init = time.End ();
   init /= 1000;
 
   m_current = m_distribution.begin ();
+  m_n = 0;
+  m_removed = 0;
+  m_timersRemoved = false;
 
   time.Start ();
   Simulator::Run ();
@@ -104,6 +132,10 @@ Bench::RunBench (void)
       "simu " << ((double)m_n) / simu<< " hold/s, avg hold=" << 
       simu / ((double)m_n) << "s" << std::endl
       ;
+  if (!m_timers.empty ())
+    {
+      std::cout << "simu " << m_removed << " timers removed and rescheduled" << std::endl;
+    }
 }
 
 void
@@ -111,6 +143,14 @@ Bench::Cb (void)
 {
   if (m_n > m_total) 
     {
+      if (!m_timersRemoved)
+        {
+          for (uint32_t i = 0; i < m_timers.size (); i++)
+            {
+              Simulator::Remove (m_timers[i]);
+            }
+          m_timersRemoved = true;
+        }
       return;
     }
   if (m_current == m_distribution.end ()) 
@@ -122,19 +162,64 @@ Bench::Cb (void)
       std::cerr << "event at " << Simulator::Now ().GetSeconds () << "s" << std::endl;
     }
   Simulator::Schedule (NanoSeconds (*m_current), &Bench::Cb, this);
+  if (!m_timers.empty ())
+    {
+      EventId &timer = m_timers[m_n % m_timers.size ()];
+      Simulator::Remove (timer);
+      timer = Simulator::Schedule (Seconds (1000) + NanoSeconds (*m_current), &Bench::Timer, this);
+      m_removed++;
+    }
   m_current++;
   m_n++;
 }
 
+static void
+EventFunction (uint32_t a, uint64_t b, double c)
+{
+}
+
+// creation and destruction of events (as done by Simulator::Schedule), without the scheduler
+static void
+BenchEvents (uint32_t n)
+{
+  const uint32_t pending = 1000;
+  Bench bench;
+  std::vector<EventImpl *> events (3 * pending);
+
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t done = 0; done < n; done += events.size ())
+    {
+      for (uint32_t i = 0; i < pending; i++)
+        {
+          events[3 * i] = MakeEvent (&Bench::RunBench, &bench);
+          events[3 * i + 1] = MakeEvent (&Bench::SetTotal, &bench, i);
+          events[3 * i + 2] = MakeEvent (&EventFunction, i, (uint64_t)done, 1.0);
+        }
+      for (std::vector<EventImpl *>::iterator i = events.begin (); i != events.end (); i++)
+        {
+          (*i)->Unref ();
+        }
+    }
+  double elapsed = time.End () / 1000.0;
+  std::cout << "event " << n / elapsed << " events/s, avg create+destroy=" << elapsed / n << "s" << std::endl;
+}
+
 void
 PrintHelp (void)
 {
   std::cout << "bench-simulator filename [options]"<<std::endl;
   std::cout << "  filename: a string which identifies the input distribution. \"-\" represents stdin." << std::endl;
+  std::cout << "    (utils/generate-ndn-distribution.sh extracts the distribution from an ndnSIM scenario)" << std::endl;
   std::cout << "  Options:"<<std::endl;
   std::cout << "      --list: use std::list scheduler"<<std::endl;
   std::cout << "      --map: use std::map cheduler"<<std::endl;
   std::cout << "      --heap: use Binary Heap scheduler"<<std::endl;
+  std::cout << "      --indexed-heap: use 4-ary Heap scheduler with O(log n) remove"<<std::endl;
+  std::cout << "      --calendar: use Calendar Queue scheduler"<<std::endl;
+  std::cout << "      --ladder: use Ladder Queue scheduler"<<std::endl;
+  std::cout << "      --timers=N: remove-heavy load, every event reschedules one of N pending timers"<<std::endl;
+  std::cout << "      --events=N: also measure creation and destruction of N events"<<std::endl;
   std::cout << "      --debug: enable some debugging"<<std::endl;
 }
 
@@ -144,6 +229,8 @@ int main (int argc, char *argv[])
   std::istream *input;
   uint32_t n = 1;
   uint32_t total = 20000;
+  uint32_t timers = 0;
+  uint32_t events = 0;
   if (argc == 1)
     {
       PrintHelp ();
@@ -174,14 +261,24 @@ int main (int argc, char *argv[])
         } 
       else if (strcmp ("--map", argv[0]) == 0) 
         {
-          factory.SetTypeId ("ns3::HeapScheduler");
+          factory.SetTypeId ("ns3::MapScheduler");
           Simulator::SetScheduler (factory);
         } 
+      else if (strcmp ("--indexed-heap", argv[0]) == 0)
+        {
+          factory.SetTypeId ("ns3::IndexedHeapScheduler");
+          Simulator::SetScheduler (factory);
+        }
       else if (strcmp ("--calendar", argv[0]) == 0)
         {
           factory.SetTypeId ("ns3::CalendarScheduler");
           Simulator::SetScheduler (factory);
         }
+      else if (strcmp ("--ladder", argv[0]) == 0)
+        {
+          factory.SetTypeId ("ns3::LadderScheduler");
+          Simulator::SetScheduler (factory);
+        }
       else if (strcmp ("--debug", argv[0]) == 0) 
         {
           g_debug = true;
@@ -194,6 +291,14 @@ int main (int argc, char *argv[])
         {
           n = atoi (argv[0]+strlen ("--n="));
         } 
+      else if (strncmp ("--timers=", argv[0], strlen("--timers=")) == 0)
+        {
+          timers = atoi (argv[0]+strlen ("--timers="));
+        }
+      else if (strncmp ("--events=", argv[0], strlen("--events=")) == 0)
+        {
+          events = atoi (argv[0]+strlen ("--events="));
+        }
 
       argc--;
       argv++;
@@ -201,10 +306,15 @@ int main (int argc, char *argv[])
   Bench *bench = new Bench ();
   bench->ReadDistribution (*input);
   bench->SetTotal (total);
+  bench->SetTimers (timers);
   for (uint32_t i = 0; i < n; i++)
     {
       bench->RunBench ();
     }
+  if (events > 0)
+    {
+      BenchEvents (events);
+    }
 
   return 0;
 }
@@ -0,0 +1,22 @@
+#!/bin/sh
+
+# Extract delays of all events scheduled during an ndnSIM scenario and print them
+# (in seconds) as an input distribution for bench-simulator.  Requires debug build,
+# must be run from the top-level ns-3 directory.
+#
+# Example:
+#
+#     utils/generate-ndn-distribution.sh ndn-congestion-topo-plugin > ndn.txt
+#     ./waf --run "bench-simulator ndn.txt --ladder --total=1000000"
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <scenario> [waf arguments]" >&2
+    exit 1
+fi
+
+scenario=$1
+shift
+
+NS_LOG="DefaultSimulatorImpl=level_function|prefix_func" ./waf --run "$scenario" "$@" 2>&1 >/dev/null | \
+    awk -F'[(,]' '/:Schedule\(/            { printf "%.9f\n", $3 / 1e9 }
+                  /:ScheduleWithContext\(/ { printf "%.9f\n", $4 / 1e9 }'